@@ -9,6 +9,8 @@
 #include "postgres_fe.h"
 #include "copy.h"
 
+#include <ctype.h>
+#include <pthread.h>
 #include <signal.h>
 #include <sys/stat.h>
 #ifndef WIN32
@@ -21,6 +23,7 @@
 #include "libpq/pqexpbuffer.h"
 #include "pqsignal.h"
 #include "dumputils.h"
+#include "mb/pg_wchar.h"
 
 #include "common.h"
 #include "prompt.h"
@@ -34,6 +37,7 @@
  * The documented syntax is:
  *	\copy tablename [(columnlist)] from|to filename [options]
  *	\copy ( select stmt ) to filename [options]
+ *	\copy tablename [(columnlist)] from filename [options] parallel N
  *
  * An undocumented fact is that you can still write BINARY before the
  * tablename; this is a hangover from the pre-7.3 syntax.  The options
@@ -43,6 +47,7 @@
  * table name can be double-quoted and can have a schema part.
  * column names can be double-quoted.
  * filename can be single-quoted like SQL literals.
+ * a trailing "parallel N" is taken by \copy itself, see do_parallel_copy_from.
  *
  * returns a malloc'ed structure with the options, or NULL on parsing error
  */
@@ -53,6 +58,7 @@ struct copy_options {
     char* file;          /* NULL = stdin/stdout */
     bool psql_inout;     /* true = use psql stdin/stdout */
     bool from;           /* true = FROM, false = TO */
+    int parallel;        /* connections loading the file, 0 = not given */
 };
 
 static void free_copy_options(struct copy_options* ptr)
@@ -96,6 +102,53 @@ static void xstrcat(char** var, const char* more)
     *var = newvar;
 }
 
+/*
+ * Take a trailing "parallel N" off the COPY options, it is not sent to the
+ * server.  Returns false if N is not a valid number of connections.
+ */
+static bool parse_copy_parallel(struct copy_options* opts)
+{
+    const char* keyword = "parallel";
+    size_t keylen = strlen(keyword);
+    char* opt = opts->after_tofrom;
+    char* numstart = NULL;
+    char* numend = NULL;
+    char* keystart = NULL;
+    char* keyend = NULL;
+    long num;
+
+    if (opt == NULL)
+        return true;
+
+    numend = opt + strlen(opt);
+    while (numend > opt && (isspace((unsigned char)numend[-1]) || numend[-1] == ';'))
+        numend--;
+    numstart = numend;
+    while (numstart > opt && isdigit((unsigned char)numstart[-1]))
+        numstart--;
+    keyend = numstart;
+    while (keyend > opt && isspace((unsigned char)keyend[-1]))
+        keyend--;
+
+    /* the number must be a separate word, following the keyword */
+    if (numstart == numend || keyend == numstart || (size_t)(keyend - opt) < keylen)
+        return true;
+    keystart = keyend - keylen;
+    if (pg_strncasecmp(keystart, keyword, keylen) != 0 ||
+        (keystart > opt && !isspace((unsigned char)keystart[-1])))
+        return true;
+
+    num = strtol(numstart, NULL, 10);
+    if (num <= 0 || num > MAX_STMTS) {
+        psql_error("\\copy: the valid parallel num is integer 1-%d.\n", MAX_STMTS);
+        return false;
+    }
+
+    *keystart = '\0';
+    opts->parallel = (int)num;
+    return true;
+}
+
 static struct copy_options* parse_slash_copy(const char* args)
 {
     struct copy_options* result = NULL;
@@ -212,6 +265,16 @@ static struct copy_options* parse_slash_copy(const char* args)
     if (NULL != token)
         result->after_tofrom = pg_strdup(token);
 
+    if (!parse_copy_parallel(result)) {
+        free_copy_options(result);
+        return NULL;
+    }
+    if (result->parallel > 0 && (!result->from || result->file == NULL)) {
+        psql_error("\\copy: parallel is only supported for loading from a file\n");
+        free_copy_options(result);
+        return NULL;
+    }
+
     return result;
 
 error:
@@ -224,6 +287,494 @@ error:
     return NULL;
 }
 
+/*
+ * Parallel \copy FROM a file.
+ *
+ * The file is read by the main thread and cut into chunks that end on a
+ * record boundary.  Each worker thread has its own connection running
+ * COPY FROM STDIN and sends it the chunks it takes from a shared queue, so
+ * parsing, datum input and insertion run in as many backends as there are
+ * workers.  Every connection commits its own rows, so the load is not
+ * atomic: once a worker fails the others abort the data they still hold,
+ * but the rows already committed by finished workers stay.  That is why it
+ * is only taken when asked for with "parallel N", in autocommit mode.
+ *
+ * The workers never print anything: psql_error and the notice processor
+ * are not thread safe.  The first error of the load and the notices of
+ * each connection are kept, and the main thread reports them once all the
+ * workers have ended.
+ */
+
+/* least size of a chunk handed to a worker */
+#define PARALLEL_COPY_CHUNK_SIZE (1024 * 1024)
+/* size of one read from the file */
+#define PARALLEL_COPY_READ_SIZE (64 * 1024)
+
+typedef struct CopyChunk {
+    char* data;
+    size_t len;
+} CopyChunk;
+
+typedef struct ParallelCopyState {
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty; /* a chunk is queued, or the load has ended */
+    pthread_cond_t notFull;  /* a queue slot is free, or the load failed */
+    CopyChunk* queue;        /* ring of chunks waiting for a worker */
+    int queueSize;
+    int head;
+    int count;
+    bool readDone; /* the whole file is queued */
+    bool failed;   /* stop the load, the workers abort their COPY */
+    char* errmsg;  /* first error of a worker, NULL if none */
+    const char* query;
+} ParallelCopyState;
+
+typedef struct ParallelCopyWorker {
+    pthread_t tid;
+    PGconn* conn;
+    ParallelCopyState* state;
+    bool ok;
+    uint64 rows;             /* rows loaded by this worker */
+    PQExpBufferData notices; /* notices of the connection, printed after the load */
+} ParallelCopyWorker;
+
+/*
+ * Returns true if word appears in the COPY options as a keyword, that is
+ * outside of quoted names and literals.
+ */
+static bool copy_option_present(const char* opts, const char* word)
+{
+    const char* p = opts;
+    size_t wordlen = strlen(word);
+
+    if (p == NULL)
+        return false;
+
+    while (*p != '\0') {
+        if (*p == '\'' || *p == '"') {
+            const char* close = strchr(p + 1, *p);
+
+            if (close == NULL)
+                return false;
+            p = close + 1;
+        } else if (isalnum((unsigned char)*p) || *p == '_') {
+            const char* start = p;
+
+            while (isalnum((unsigned char)*p) || *p == '_')
+                p++;
+            if ((size_t)(p - start) == wordlen && pg_strncasecmp(start, word, wordlen) == 0)
+                return true;
+        } else {
+            p++;
+        }
+    }
+    return false;
+}
+
+/*
+ * Parallel load has to find the record boundaries of the file by itself,
+ * so it only takes the text and csv formats with their default quoting.
+ * Other loads run on the current connection as before.
+ */
+static bool parallel_copy_supported(const struct copy_options* options)
+{
+    static const char* const serialOptions[] = {"binary", "fixed", "header", "quote", "escape", "eol"};
+
+    if (pset.decryptInfo.encryptInclude)
+        return false;
+
+    /* the scan for quotes and backslashes must not match inside a character */
+    if (!PG_VALID_BE_ENCODING(pset.encoding))
+        return false;
+
+    if (copy_option_present(options->before_tofrom, "binary"))
+        return false;
+    for (size_t i = 0; i < lengthof(serialOptions); i++) {
+        if (copy_option_present(options->after_tofrom, serialOptions[i]))
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Open a connection for a worker, with the settings of the current one.
+ */
+static PGconn* parallel_copy_connect(void)
+{
+    PGconn* conn = NULL;
+    char* decode_pwd = NULL;
+    GS_UINT32 pwd_len = 0;
+    errno_t rc = EOK;
+    char* old_conninfo_values = NULL;
+
+    if (pset.connInfo.values[3] != NULL) {
+        decode_pwd = SEC_decodeBase64(pset.connInfo.values[3], &pwd_len);
+        if (decode_pwd == NULL) {
+            psql_error("%s: decode the parallel connect value failed.\n", pset.progname);
+            return NULL;
+        }
+        old_conninfo_values = pset.connInfo.values[3];
+        pset.connInfo.values[3] = decode_pwd;
+    }
+
+    conn = PQconnectdbParams(pset.connInfo.keywords, pset.connInfo.values, true);
+
+    /* Clear sensitive memory of decode_pwd. */
+    if (decode_pwd != NULL) {
+        rc = memset_s(decode_pwd, strlen(decode_pwd), 0, strlen(decode_pwd));
+        securec_check_c(rc, "\0", "\0");
+        OPENSSL_free(decode_pwd);
+        decode_pwd = NULL;
+        pset.connInfo.values[3] = old_conninfo_values;
+    }
+
+    if (PQstatus(conn) == CONNECTION_BAD) {
+        psql_error("%s", PQerrorMessage(conn));
+        PQfinish(conn);
+        return NULL;
+    }
+
+    (void)PQsetErrorVerbosity(conn, pset.verbosity);
+    (void)PQsetNoticeProcessor(conn, NoticeProcessor, NULL);
+
+    /* replay the SET statements of the session, ignoring their errors like \parallel does */
+    for (int i = 0; i < pset.num_guc_stmt; i++) {
+        PQclear(PQexec(conn, pset.guc_stmt[i]));
+    }
+    return conn;
+}
+
+/*
+ * Queue a chunk for the workers, it is freed here if the load has failed.
+ */
+static bool parallel_copy_put(ParallelCopyState* state, char* data, size_t len)
+{
+    bool queued = false;
+
+    (void)pthread_mutex_lock(&state->lock);
+    while (state->count == state->queueSize && !state->failed)
+        (void)pthread_cond_wait(&state->notFull, &state->lock);
+    if (!state->failed) {
+        int tail = (state->head + state->count) % state->queueSize;
+
+        state->queue[tail].data = data;
+        state->queue[tail].len = len;
+        state->count++;
+        queued = true;
+        (void)pthread_cond_signal(&state->notEmpty);
+    }
+    (void)pthread_mutex_unlock(&state->lock);
+
+    if (!queued)
+        free(data);
+    return queued;
+}
+
+/*
+ * Take the next chunk, returns false once the file is used up or the load
+ * has failed.
+ */
+static bool parallel_copy_get(ParallelCopyState* state, CopyChunk* chunk)
+{
+    bool found = false;
+
+    (void)pthread_mutex_lock(&state->lock);
+    while (state->count == 0 && !state->readDone && !state->failed)
+        (void)pthread_cond_wait(&state->notEmpty, &state->lock);
+    if (state->count > 0 && !state->failed) {
+        *chunk = state->queue[state->head];
+        state->head = (state->head + 1) % state->queueSize;
+        state->count--;
+        found = true;
+        (void)pthread_cond_signal(&state->notFull);
+    }
+    (void)pthread_mutex_unlock(&state->lock);
+
+    return found;
+}
+
+/*
+ * End the load, successfully once the whole file is queued.  The errmsg of
+ * the first call that fails the load is kept for the main thread to report,
+ * the errors of the workers it makes abort are not.
+ */
+static void parallel_copy_stop(ParallelCopyState* state, bool failed, const char* errmsg)
+{
+    (void)pthread_mutex_lock(&state->lock);
+    if (failed) {
+        if (!state->failed && errmsg != NULL)
+            state->errmsg = strdup(errmsg);
+        state->failed = true;
+    } else {
+        state->readDone = true;
+    }
+    (void)pthread_cond_broadcast(&state->notEmpty);
+    (void)pthread_cond_broadcast(&state->notFull);
+    (void)pthread_mutex_unlock(&state->lock);
+}
+
+/* Notice processor of the worker connections, see do_parallel_copy_from */
+static void parallel_copy_notice(void* arg, const char* message)
+{
+    ParallelCopyWorker* worker = (ParallelCopyWorker*)arg;
+
+    appendPQExpBufferStr(&worker->notices, message);
+}
+
+static void* parallel_copy_worker(void* arg)
+{
+    ParallelCopyWorker* worker = (ParallelCopyWorker*)arg;
+    ParallelCopyState* state = worker->state;
+    PGconn* conn = worker->conn;
+    PGresult* res = NULL;
+    CopyChunk chunk;
+    char* errmsg = NULL;
+    bool failed = false;
+
+    res = PQexec(conn, state->query);
+    if (PQresultStatus(res) != PGRES_COPY_IN) {
+        parallel_copy_stop(state, true, PQerrorMessage(conn));
+        PQclear(res);
+        return NULL;
+    }
+    PQclear(res);
+
+    worker->ok = true;
+    while (parallel_copy_get(state, &chunk)) {
+        int ret = PQputCopyData(conn, chunk.data, (int)chunk.len);
+
+        free(chunk.data);
+        if (ret <= 0) {
+            errmsg = strdup(PQerrorMessage(conn));
+            worker->ok = false;
+            break;
+        }
+    }
+
+    /* the rows sent so far are rolled back if the load has failed anywhere */
+    (void)pthread_mutex_lock(&state->lock);
+    failed = state->failed;
+    (void)pthread_mutex_unlock(&state->lock);
+
+    if (PQputCopyEnd(conn, (worker->ok && !failed) ? NULL : _("aborted because of parallel copy failure")) <= 0)
+        worker->ok = false;
+
+    while ((res = PQgetResult(conn)) != NULL) {
+        if (PQresultStatus(res) == PGRES_COPY_IN) {
+            worker->ok = false;
+            (void)PQputCopyEnd(conn, _("trying to exit copy mode"));
+        } else if (PQresultStatus(res) == PGRES_COMMAND_OK) {
+            worker->rows += strtoul(PQcmdTuples(res), NULL, 10);
+        } else {
+            if (errmsg == NULL)
+                errmsg = strdup(PQresultErrorMessage(res));
+            worker->ok = false;
+        }
+        PQclear(res);
+    }
+
+    if (!worker->ok)
+        parallel_copy_stop(state, true, errmsg);
+    free(errmsg);
+    return NULL;
+}
+
+/* The end-of-data line the serial \copy stops at, too */
+static inline bool is_copy_end_marker(const char* line, size_t len)
+{
+    return (len == strlen("\\.\n") && strncmp(line, "\\.\n", len) == 0) ||
+           (len == strlen("\\.\r\n") && strncmp(line, "\\.\r\n", len) == 0);
+}
+
+/*
+ * Read the file and queue it in chunks of whole records.  A newline ends a
+ * record unless it is inside csv quotes, or escaped by a backslash in text
+ * format.
+ */
+static bool parallel_copy_read(ParallelCopyState* state, FILE* copystream, bool csv)
+{
+    size_t bufsize = PARALLEL_COPY_CHUNK_SIZE + PARALLEL_COPY_READ_SIZE;
+    char* buf = (char*)pg_malloc(bufsize);
+    size_t len = 0;       /* bytes in buf */
+    size_t scanned = 0;   /* the lines before this are scanned */
+    size_t recordEnd = 0; /* end of the last whole record */
+    bool inRecord = false; /* the last newline scanned is part of a record */
+    bool eof = false;
+
+    for (;;) {
+        if (!eof) {
+            size_t nread;
+
+            if (bufsize - len < PARALLEL_COPY_READ_SIZE) {
+                bufsize *= 2;
+                buf = (char*)pg_realloc(buf, bufsize);
+            }
+            nread = fread(buf + len, 1, PARALLEL_COPY_READ_SIZE, copystream);
+            if (nread == 0) {
+                if (ferror(copystream)) {
+                    psql_error("could not read COPY data: %s\n", strerror(errno));
+                    free(buf);
+                    return false;
+                }
+                eof = true;
+            }
+            len += nread;
+        }
+
+        while (scanned < len) {
+            char* nl = (char*)memchr(buf + scanned, '\n', len - scanned);
+            size_t lineEnd = (nl != NULL) ? (size_t)(nl - buf) + 1 : len;
+
+            if (nl == NULL && !eof)
+                break;
+            if (is_copy_end_marker(buf + scanned, lineEnd - scanned)) {
+                len = scanned;
+                eof = true;
+                break;
+            }
+
+            if (csv) {
+                for (size_t i = scanned; i < lineEnd; i++) {
+                    if (buf[i] == '"')
+                        inRecord = !inRecord;
+                }
+            } else if (nl != NULL) {
+                size_t nbackslash = 0;
+
+                while (buf + scanned + nbackslash < nl && nl[-1 - (ssize_t)nbackslash] == '\\')
+                    nbackslash++;
+                inRecord = (nbackslash % 2 == 1);
+            }
+
+            scanned = lineEnd;
+            if (!inRecord)
+                recordEnd = lineEnd;
+        }
+
+        if (cancel_pressed) {
+            psql_error("\\copy: canceled by user\n");
+            free(buf);
+            return false;
+        }
+
+        /* at the end an unfinished record goes as it is, the server reports it */
+        if (eof)
+            recordEnd = len;
+        if (recordEnd >= PARALLEL_COPY_CHUNK_SIZE || (eof && recordEnd > 0)) {
+            size_t rest = len - recordEnd;
+            char* next = (char*)pg_malloc(bufsize);
+
+            if (rest > 0) {
+                errno_t rc = memcpy_s(next, bufsize, buf + recordEnd, rest);
+                securec_check_c(rc, "\0", "\0");
+            }
+            if (!parallel_copy_put(state, buf, recordEnd)) {
+                free(next);
+                return false;
+            }
+            buf = next;
+            len = rest;
+            scanned -= recordEnd;
+            recordEnd = 0;
+        }
+
+        if (eof)
+            break;
+    }
+
+    free(buf);
+    return true;
+}
+
+/*
+ * Load the file through nworkers connections, each running query.
+ */
+static bool do_parallel_copy_from(const char* query, FILE* copystream, int nworkers, bool csv)
+{
+    ParallelCopyState state;
+    ParallelCopyWorker* workers = (ParallelCopyWorker*)pg_calloc(nworkers, sizeof(ParallelCopyWorker));
+    int started = 0;
+    bool success = true;
+    uint64 rows = 0;
+
+    (void)pthread_mutex_init(&state.lock, NULL);
+    (void)pthread_cond_init(&state.notEmpty, NULL);
+    (void)pthread_cond_init(&state.notFull, NULL);
+    state.queueSize = 2 * nworkers;
+    state.queue = (CopyChunk*)pg_calloc(state.queueSize, sizeof(CopyChunk));
+    state.head = 0;
+    state.count = 0;
+    state.readDone = false;
+    state.failed = false;
+    state.errmsg = NULL;
+    state.query = query;
+
+    for (int i = 0; i < nworkers; i++) {
+        workers[i].state = &state;
+        initPQExpBuffer(&workers[i].notices);
+        workers[i].conn = parallel_copy_connect();
+        if (workers[i].conn == NULL) {
+            success = false;
+            break;
+        }
+        (void)PQsetNoticeProcessor(workers[i].conn, parallel_copy_notice, &workers[i]);
+        int err = pthread_create(&workers[i].tid, NULL, parallel_copy_worker, &workers[i]);
+        if (err != 0) {
+            psql_error("\\copy: could not create parallel copy thread: %s\n", strerror(err));
+            PQfinish(workers[i].conn);
+            success = false;
+            break;
+        }
+        started++;
+    }
+
+    if (success)
+        success = parallel_copy_read(&state, copystream, csv);
+    parallel_copy_stop(&state, !success, NULL);
+
+    for (int i = 0; i < started; i++) {
+        (void)pthread_join(workers[i].tid, NULL);
+        success = success && workers[i].ok;
+        rows += workers[i].rows;
+        PQfinish(workers[i].conn);
+    }
+
+    /* the workers have ended, what they had to say can be printed now */
+    for (int i = 0; i < nworkers; i++) {
+        if (workers[i].notices.data != NULL && workers[i].notices.len > 0)
+            psql_error("%s", workers[i].notices.data);
+        termPQExpBuffer(&workers[i].notices);
+    }
+    if (state.errmsg != NULL) {
+        psql_error("%s", state.errmsg);
+        free(state.errmsg);
+    }
+
+    /* chunks left behind by a failed load */
+    while (state.count > 0) {
+        free(state.queue[state.head].data);
+        state.head = (state.head + 1) % state.queueSize;
+        state.count--;
+    }
+    free(state.queue);
+    free(workers);
+    (void)pthread_cond_destroy(&state.notFull);
+    (void)pthread_cond_destroy(&state.notEmpty);
+    (void)pthread_mutex_destroy(&state.lock);
+
+    if (success) {
+        if (!pset.quiet)
+            fprintf(pset.queryFout, "COPY " UINT64_FORMAT "\n", rows);
+        if (pset.logfile != NULL)
+            fprintf(pset.logfile, "COPY " UINT64_FORMAT "\n", rows);
+    } else if (started > 0) {
+        /* the load is not atomic, say what stays in the table */
+        psql_error("\\copy: parallel load failed, " UINT64_FORMAT " rows committed by finished connections are kept\n",
+            rows);
+    }
+    return success;
+}
+
 /*
  * Execute a \copy command (frontend copy). We have to open a file, then
  * submit a COPY query to the backend and either feed it data from the
@@ -296,11 +847,29 @@ bool do_copy(const char* args)
     if (NULL != options->after_tofrom)
         appendPQExpBufferStr(&query, options->after_tofrom);
 
-    /* Run it like a user command, interposing the data source or sink. */
-    save_file = *override_file;
-    *override_file = copystream;
-    success = SendQuery(query.data);
-    *override_file = save_file;
+    if (options->parallel > 1 && parallel_copy_supported(options)) {
+        if (pset.db == NULL) {
+            psql_error("You are currently not connected to a database.\n");
+            success = false;
+        } else if (PQtransactionStatus(pset.db) != PQTRANS_IDLE) {
+            /* the other connections could not see the work of this transaction */
+            psql_error("Parallel within transaction is not supported\n");
+            success = false;
+        } else if (!pset.autocommit) {
+            /* each connection commits its own rows, which is not what autocommit off asks for */
+            psql_error("\\copy: parallel is not supported when AUTOCOMMIT is off\n");
+            success = false;
+        } else {
+            success = do_parallel_copy_from(
+                query.data, copystream, options->parallel, copy_option_present(options->after_tofrom, "csv"));
+        }
+    } else {
+        /* Run it like a user command, interposing the data source or sink. */
+        save_file = *override_file;
+        *override_file = copystream;
+        success = SendQuery(query.data);
+        *override_file = save_file;
+    }
     termPQExpBuffer(&query);
 
     if (options->file != NULL) {
@@ -202,7 +202,7 @@ void slashUsage(unsigned short int pager)
     if (currdb == NULL)
         currdb = "";
 
-    output = PageOutput(98, pager);
+    output = PageOutput(100, pager);
 
     /* if you add/remove a line here, change the row count above */
 
@@ -224,6 +224,8 @@ void slashUsage(unsigned short int pager)
 
     fprintf(output, _("Input/Output\n"));
     fprintf(output, _("  \\copy ...              perform SQL COPY with data stream to the client host\n"));
+    fprintf(output, _("                         (FROM a file, \"parallel N\" loads it over N connections,\n"));
+    fprintf(output, _("                         each committing its own rows)\n"));
     fprintf(output, _("  \\echo [STRING]         write string to standard output\n"));
     /* Database Security: Data importing/dumping support AES128. */
     fprintf(output, _("  \\i FILE                execute commands from file\n"));
@@ -1231,6 +1231,26 @@ static HashJoin* _copyHashJoin(const HashJoin* from)
     return newnode;
 }
 
+/*
+ * _copyMemoize
+ */
+static Memoize* _copyMemoize(const Memoize* from)
+{
+    Memoize* newnode = makeNode(Memoize);
+
+    /*
+     * copy node superclass fields
+     */
+    CopyPlanFields((const Plan*)from, (Plan*)newnode);
+    COPY_SCALAR_FIELD(numKeys);
+    COPY_POINTER_FIELD(hashOperators, from->numKeys * sizeof(Oid));
+    COPY_NODE_FIELD(param_exprs);
+    COPY_SCALAR_FIELD(binary_mode);
+    COPY_SCALAR_FIELD(est_entries);
+
+    return newnode;
+}
+
 /*
  * _copyMaterial
  */
@@ -1249,15 +1269,13 @@ static Material* _copyMaterial(const Material* from)
 }
 
 /*
- * _copySort
+ * CopySortFields
+ *
+ *		This function copies the fields of the Sort node.  It is used by
+ *		all the copy functions for classes which inherit from Sort.
  */
-static Sort* _copySort(const Sort* from)
+static void CopySortFields(const Sort* from, Sort* newnode)
 {
-    Sort* newnode = makeNode(Sort);
-
-    /*
-     * copy node superclass fields
-     */
     CopyPlanFields((const Plan*)from, (Plan*)newnode);
 
     COPY_SCALAR_FIELD(numCols);
@@ -1272,6 +1290,39 @@ static Sort* _copySort(const Sort* from)
 #endif
 
     CopyMemInfoFields(&from->mem_info, &newnode->mem_info);
+}
+
+/*
+ * _copySort
+ */
+static Sort* _copySort(const Sort* from)
+{
+    Sort* newnode = makeNode(Sort);
+
+    /*
+     * copy node superclass fields
+     */
+    CopySortFields(from, newnode);
+
+    return newnode;
+}
+
+/*
+ * _copyIncrementalSort
+ */
+static IncrementalSort* _copyIncrementalSort(const IncrementalSort* from)
+{
+    IncrementalSort* newnode = makeNode(IncrementalSort);
+
+    /*
+     * copy node superclass fields
+     */
+    CopySortFields((const Sort*)from, (Sort*)newnode);
+
+    /*
+     * copy remainder of node
+     */
+    COPY_SCALAR_FIELD(nPresortedCols);
 
     return newnode;
 }
@@ -6155,9 +6206,15 @@ void* copyObject(const void* from)
         case T_Material:
             retval = _copyMaterial((Material*)from);
             break;
+        case T_Memoize:
+            retval = _copyMemoize((Memoize*)from);
+            break;
         case T_Sort:
             retval = _copySort((Sort*)from);
             break;
+        case T_IncrementalSort:
+            retval = _copyIncrementalSort((IncrementalSort*)from);
+            break;
         case T_Group:
             retval = _copyGroup((Group*)from);
             break;
@@ -62,7 +62,9 @@ static const TagStr g_tagStrArr[] = {{T_Invalid, "Invalid"},
     {T_MergeJoin, "MergeJoin"},
     {T_HashJoin, "HashJoin"},
     {T_Material, "Material"},
+    {T_Memoize, "Memoize"},
     {T_Sort, "Sort"},
+    {T_IncrementalSort, "IncrementalSort"},
     {T_Group, "Group"},
     {T_Agg, "Agg"},
     {T_WindowAgg, "WindowAgg"},
@@ -127,7 +129,9 @@ static const TagStr g_tagStrArr[] = {{T_Invalid, "Invalid"},
     {T_MergeJoinState, "MergeJoinState"},
     {T_HashJoinState, "HashJoinState"},
     {T_MaterialState, "MaterialState"},
+    {T_MemoizeState, "MemoizeState"},
     {T_SortState, "SortState"},
+    {T_IncrementalSortState, "IncrementalSortState"},
     {T_GroupState, "GroupState"},
     {T_AggState, "AggState"},
     {T_WindowAggState, "WindowAggState"},
@@ -250,6 +254,7 @@ static const TagStr g_tagStrArr[] = {{T_Invalid, "Invalid"},
     {T_MergeAppendPath, "MergeAppendPath"},
     {T_ResultPath, "ResultPath"},
     {T_MaterialPath, "MaterialPath"},
+    {T_MemoizePath, "MemoizePath"},
     {T_UniquePath, "UniquePath"},
     {T_PartIteratorPath, "PartIteratorPath"},
     {T_EquivalenceClass, "EquivalenceClass"},
@@ -1674,6 +1674,18 @@ static void _outMaterial(StringInfo str, Material* node)
     out_mem_info(str, &node->mem_info);
 }
 
+static void _outMemoize(StringInfo str, Memoize* node)
+{
+    WRITE_NODE_TYPE("MEMOIZE");
+
+    _outPlanInfo(str, (Plan*)node);
+    WRITE_INT_FIELD(numKeys);
+    WRITE_GRPOP_FIELD(hashOperators, numKeys);
+    WRITE_NODE_FIELD(param_exprs);
+    WRITE_BOOL_FIELD(binary_mode);
+    WRITE_FLOAT_FIELD(est_entries, "%.0f");
+}
+
 static void _outSimpleSort(StringInfo str, SimpleSort* node)
 {
     int i;
@@ -1715,12 +1727,10 @@ static void _outSimpleSort(StringInfo str, SimpleSort* node)
     WRITE_BOOL_FIELD(sortToStore);
 }
 
-static void _outSort(StringInfo str, Sort* node)
+static void _outSortInfo(StringInfo str, Sort* node)
 {
     int i;
 
-    WRITE_NODE_TYPE("SORT");
-
     _outPlanInfo(str, (Plan*)node);
 
     WRITE_INT_FIELD(numCols);
@@ -1757,6 +1767,22 @@ static void _outSort(StringInfo str, Sort* node)
     out_mem_info(str, &node->mem_info);
 }
 
+static void _outSort(StringInfo str, Sort* node)
+{
+    WRITE_NODE_TYPE("SORT");
+
+    _outSortInfo(str, node);
+}
+
+static void _outIncrementalSort(StringInfo str, IncrementalSort* node)
+{
+    WRITE_NODE_TYPE("INCREMENTALSORT");
+
+    _outSortInfo(str, (Sort*)node);
+
+    WRITE_INT_FIELD(nPresortedCols);
+}
+
 static void _outUnique(StringInfo str, Unique* node)
 {
     int i;
@@ -2941,6 +2967,20 @@ static void _outMaterialPath(StringInfo str, MaterialPath* node)
     WRITE_BOOL_FIELD(materialize_all);
 }
 
+static void _outMemoizePath(StringInfo str, MemoizePath* node)
+{
+    WRITE_NODE_TYPE("MEMOIZEPATH");
+
+    _outPathInfo(str, (Path*)node);
+
+    WRITE_NODE_FIELD(subpath);
+    WRITE_NODE_FIELD(hash_operators);
+    WRITE_NODE_FIELD(param_exprs);
+    WRITE_BOOL_FIELD(binary_mode);
+    WRITE_FLOAT_FIELD(calls, "%.0f");
+    WRITE_FLOAT_FIELD(est_entries, "%.0f");
+}
+
 static void _outUniquePath(StringInfo str, UniquePath* node)
 {
     WRITE_NODE_TYPE("UNIQUEPATH");
@@ -5275,9 +5315,15 @@ static void _outNode(StringInfo str, const void* obj)
             case T_Material:
                 _outMaterial(str, (Material*)obj);
                 break;
+            case T_Memoize:
+                _outMemoize(str, (Memoize*)obj);
+                break;
             case T_Sort:
                 _outSort(str, (Sort*)obj);
                 break;
+            case T_IncrementalSort:
+                _outIncrementalSort(str, (IncrementalSort*)obj);
+                break;
             case T_Unique:
                 _outUnique(str, (Unique*)obj);
                 break;
@@ -5491,6 +5537,9 @@ static void _outNode(StringInfo str, const void* obj)
             case T_MaterialPath:
                 _outMaterialPath(str, (MaterialPath*)obj);
                 break;
+            case T_MemoizePath:
+                _outMemoizePath(str, (MemoizePath*)obj);
+                break;
             case T_UniquePath:
                 _outUniquePath(str, (UniquePath*)obj);
                 break;
@@ -3449,6 +3449,18 @@ static Sort* _readSort(Sort* local_node)
     READ_DONE();
 }
 
+static IncrementalSort* _readIncrementalSort(IncrementalSort* local_node)
+{
+    READ_LOCALS_NULL(IncrementalSort);
+    READ_TEMP_LOCALS();
+
+    // Read Sort
+    (void)_readSort(&local_node->sort);
+
+    READ_INT_FIELD(nPresortedCols);
+    READ_DONE();
+}
+
 static Unique* _readUnique(Unique* local_node)
 {
     READ_LOCALS_NULL(Unique);
@@ -3745,6 +3757,22 @@ static Material* _readMaterial(Material* local_node)
     READ_DONE();
 }
 
+static Memoize* _readMemoize(Memoize* local_node)
+{
+    READ_LOCALS_NULL(Memoize);
+    READ_TEMP_LOCALS();
+
+    // Read Plan
+    _readPlan(&local_node->plan);
+    READ_INT_FIELD(numKeys);
+    READ_OPERATOROID_ARRAY(hashOperators, numKeys);
+    READ_NODE_FIELD(param_exprs);
+    READ_BOOL_FIELD(binary_mode);
+    READ_FLOAT_FIELD(est_entries);
+
+    READ_DONE();
+}
+
 static Append* _readAppend(Append* local_node)
 {
     READ_LOCALS_NULL(Append);
@@ -5401,6 +5429,8 @@ Node* parseNodeString(void)
         return_value = _readPlan(NULL);
     } else if (MATCH("MATERIAL", 8)) {
         return_value = _readMaterial(NULL);
+    } else if (MATCH("MEMOIZE", 7)) {
+        return_value = _readMemoize(NULL);
     } else if (MATCH("APPEND", 6)) {
         return_value = _readAppend(NULL);
     } else if (MATCH("MERGEAPPEND", 11)) {
@@ -5411,6 +5441,8 @@ Node* parseNodeString(void)
         return_value = _readSimpleSort(NULL);
     } else if (MATCH("SORT", 4)) {
         return_value = _readSort(NULL);
+    } else if (MATCH("INCREMENTALSORT", 15)) {
+        return_value = _readIncrementalSort(NULL);
     } else if (MATCH("UNIQUE", 6)) {
         return_value = _readUnique(NULL);
     } else if (MATCH("PLANNEDSTMT", 11)) {
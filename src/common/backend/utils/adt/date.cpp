@@ -343,6 +343,7 @@ Datum date_sortsupport(PG_FUNCTION_ARGS)
     SortSupport ssup = (SortSupport)PG_GETARG_POINTER(0);
 
     ssup->comparator = date_fastcmp;
+    ssup->ssup_int_width = sizeof(DateADT);
     PG_RETURN_VOID();
 }
 
@@ -2093,6 +2093,9 @@ Datum timestamp_sortsupport(PG_FUNCTION_ARGS)
     SortSupport ssup = (SortSupport)PG_GETARG_POINTER(0);
 
     ssup->comparator = timestamp_fastcmp;
+#ifdef HAVE_INT64_TIMESTAMP
+    ssup->ssup_int_width = sizeof(Timestamp);
+#endif
     PG_RETURN_VOID();
 }
 
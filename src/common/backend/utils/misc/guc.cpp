@@ -371,6 +371,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "enable_cluster_resize",
 #endif
     "enable_compress_spill",
+    "enable_compress_sort_tape",
     "resource_track_level",
     "fault_mon_timeout",
     "trace_sort",
@@ -1333,6 +1334,16 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_cstore_bloom_filter",
+             PGC_USERSET,
+             QUERY_TUNING_METHOD,
+             gettext_noop("Enable filtering column store scans by the bloom filters of hash joins."),
+             NULL},
+            &u_sess->attr.attr_sql.enable_cstore_bloom_filter,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_codegen", PGC_USERSET, QUERY_TUNING_METHOD, gettext_noop("Enable llvm for executor."), NULL},
             &u_sess->attr.attr_sql.enable_codegen,
             true,
@@ -1487,6 +1498,16 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_compress_sort_tape",
+             PGC_USERSET,
+             QUERY_TUNING_METHOD,
+             gettext_noop("Enables compressing the tapes of sorts which spill to disk."),
+             NULL},
+            &u_sess->attr.attr_sql.enable_compress_sort_tape,
+            false,
+            NULL,
+            NULL,
+            NULL},
 
         {{"enable_hashagg",
              PGC_USERSET,
@@ -1508,6 +1529,26 @@ static void InitConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_incremental_sort",
+             PGC_USERSET,
+             QUERY_TUNING_METHOD,
+             gettext_noop("Enables the planner's use of incremental sort steps."),
+             NULL},
+            &u_sess->attr.attr_sql.enable_incremental_sort,
+            false,
+            NULL,
+            NULL,
+            NULL},
+        {{"enable_memoize",
+             PGC_USERSET,
+             QUERY_TUNING_METHOD,
+             gettext_noop("Enables the planner's use of memoization for parameterized nestloop inner sides."),
+             NULL},
+            &u_sess->attr.attr_sql.enable_memoize,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_nestloop",
              PGC_USERSET,
              QUERY_TUNING_METHOD,
@@ -718,6 +718,8 @@ void Batchsortstate::InitCommon(int64 workMem, bool randomAccess)
     m_allowedMem = workMem * 1024L - 1;
     m_bounded = false;
     m_boundUsed = false;
+    m_boundProbe.m_values = NULL;
+    m_boundProbe.m_nulls = NULL;
     m_availMem = m_allowedMem;
     m_lastFetchCursor = 0;
     m_curFetchCursor = 0;
@@ -1390,6 +1392,7 @@ void Batchsortstate::InitTapes()
     int maxTapes, j;
 
     long tapeSpace;
+    bool compress = false;
 
     /* Compute number of tapes to use: merge order plus 1 */
     maxTapes = GetSortMergeOrder() + 1;
@@ -1419,7 +1422,8 @@ void Batchsortstate::InitTapes()
      * account for tuple space, so we don't care if LACKMEM becomes
      * inaccurate.)
      */
-    tapeSpace = maxTapes * TAPE_BUFFER_OVERHEAD;
+    compress = u_sess->attr.attr_sql.enable_compress_sort_tape && !m_randomAccess;
+    tapeSpace = maxTapes * TAPE_BUFFER_OVERHEAD + LogicalTapeSetCompressSpace(maxTapes, compress);
 
     if (tapeSpace + (long)GetMemoryChunkSpace(m_storeColumns.m_memValues) < m_allowedMem)
         UseMem(tapeSpace);
@@ -1431,9 +1435,10 @@ void Batchsortstate::InitTapes()
     PrepareTempTablespaces();
 
     /*
-     * Create the tape set and allocate the per-tape data arrays.
+     * Create the tape set and allocate the per-tape data arrays.  Compressed
+     * tapes can only be read forward, so not under random access.
      */
-    m_tapeset = LogicalTapeSetCreate(maxTapes);
+    m_tapeset = LogicalTapeSetCreate(maxTapes, compress);
     m_lastFileBlocks = 0L;
 
     m_mergeActive = (bool*)palloc0(maxTapes * sizeof(bool));
@@ -1652,9 +1657,55 @@ void Batchsortstate::MakeBoundedHeap()
     }
 
     Assert(m_storeColumns.m_memRowNum == m_bound);
+
+    if (m_boundProbe.m_values == NULL) {
+        /* one more slot for the abbreviated leading key, as in CopyMultiColumn */
+        m_boundProbe.m_values = (Datum*)palloc0((m_colNum + 1) * sizeof(Datum));
+        m_boundProbe.m_nulls = (uint8*)palloc0(m_colNum * sizeof(uint8));
+        m_boundProbe.idx = 0;
+        m_boundProbe.size = 0;
+    }
     m_status = BS_BOUNDED;
 }
 
+/*
+ * @Description: Check whether a row of the input batch would enter the full
+ * 	bounded heap, that is whether it sorts before the current largest entry.
+ * 	Only the sort key columns are looked at and nothing is copied, so the
+ * 	other columns of a row are only copied if it enters the heap.
+ */
+bool Batchsortstate::BoundedHeapAccepts(VectorBatch* batch, int row)
+{
+    ScanKey scanKey = m_scanKeys;
+
+    for (int nkey = 0; nkey < m_nKeys; ++nkey, ++scanKey) {
+        int col = scanKey->sk_attno - 1;
+        uint8 flag = batch->m_arr[col].m_flag[row];
+
+        m_boundProbe.m_nulls[col] = flag;
+        if (!IS_NULL(flag)) {
+            ScalarValue val = batch->m_arr[col].m_vals[row];
+            m_boundProbe.m_values[col] = NeedDecode(col) ? ScalarVector::Decode(val) : PointerGetDatum(val);
+        }
+    }
+
+    /*
+     * The heap entries carry the abbreviated leading key in their last slot,
+     * and the comparator looks at it first, so the probe needs it as well.
+     * Abbreviation is never aborted once the heap is bounded.
+     */
+    if (sortKeys->abbrev_converter) {
+        int col = sortKeys->ssup_attno - 1;
+
+        if (!IS_NULL(m_boundProbe.m_nulls[col]))
+            m_boundProbe.m_values[m_colNum] = sortKeys->abbrev_converter(m_boundProbe.m_values[col], sortKeys);
+        else
+            m_boundProbe.m_values[m_colNum] = m_boundProbe.m_values[col];
+    }
+
+    return compareMultiColumn(&m_boundProbe, m_storeColumns.m_memValues, this) > 0;
+}
+
 void Batchsortstate::SortBoundedHeap()
 {
     int rowCount = m_storeColumns.m_memRowNum;
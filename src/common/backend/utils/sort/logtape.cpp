@@ -67,6 +67,14 @@
  * There will always be the same number of runs as input tapes, and the same
  * number of input tapes as participants (worker Tuplesortstates).
  *
+ * The merge reads every input tape sequentially, so while a block of a tape
+ * is consumed we ask the kernel to read the next blocks of the same tape in
+ * the background, and output blocks written at consecutive positions are
+ * handed to writeback in groups instead of piling up as dirty pages.  If the
+ * tape set is created with compression, the data of each tape is cut into
+ * frames of BLCKSZ bytes that are compressed with LZ4 before being written
+ * to the blocks of the tape.  Such tapes can only be read forward.
+ *
  * Portions Copyright (c) 1996-2012, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
  *
@@ -79,6 +87,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "lz4.h"
 #include "storage/buf/buffile.h"
 #include "utils/logtape.h"
 
@@ -88,6 +97,22 @@
  */
 #define BLOCKS_PER_INDIR_BLOCK ((int)(BLCKSZ / sizeof(long)))
 
+/*
+ * Number of blocks of a tape being read that we ask the kernel to prefetch
+ * at once, and the number of consecutive written blocks that are handed
+ * to writeback at once.
+ */
+#define LTS_READ_AHEAD_BLOCKS 8
+#define LTS_WRITE_BEHIND_BLOCKS 32
+
+/*
+ * A compressed frame is stored as two int32s, the compressed size and the
+ * raw size, followed by the compressed data.  If compression does not make
+ * the frame smaller, both sizes are equal and the raw data is stored.
+ */
+#define LTS_FRAME_SIZE BLCKSZ
+#define LTS_FRAME_HDRSZ (2 * sizeof(int32))
+
 /*
  * We use a struct like this for each active indirection level of each
  * logical tape.  If the indirect block is not the highest level of its
@@ -134,6 +159,15 @@ typedef struct LogicalTape {
     long curBlockNumber; /* this block's logical blk# within tape */
     int pos;             /* next read/write position in buffer */
     int nbytes;          /* total # of valid bytes in buffer */
+
+    /*
+     * Uncompressed frame of a compressed tape.  While writing, data is
+     * collected here until the frame is full; while reading, the frame last
+     * decompressed from the blocks is consumed from here.
+     */
+    char* frame;  /* frame buffer (separately palloc'd), or NULL */
+    int framePos; /* next read/write position in frame */
+    int frameLen; /* total # of valid bytes in frame */
 } LogicalTape;
 
 /*
@@ -146,6 +180,16 @@ struct LogicalTapeSet {
     BufFile* pfile;   /* underlying file for whole tape set */
     long nFileBlocks; /* # of blocks used in underlying file */
 
+    /*
+     * Written blocks not yet handed to writeback.  They are always a run of
+     * consecutive block numbers starting at wbStart.
+     */
+    long wbStart;
+    int wbBlocks;
+
+    bool compress; /* are tapes stored as LZ4 compressed frames? */
+    char* zbuf;    /* compressed frame workspace, shared by all tapes */
+
     /*
      * We store the numbers of recycled-and-available blocks in freeBlocks[].
      * When there are no such blocks, we extend the underlying file.
@@ -183,6 +227,12 @@ static long ltsRewindFrozenIndirectBlock(LogicalTapeSet* lts, IndirectBlock* ind
 static long ltsRecallNextBlockNum(LogicalTapeSet* lts, IndirectBlock* indirect, bool frozen);
 static long ltsRecallPrevBlockNum(LogicalTapeSet* lts, IndirectBlock* indirect);
 static void ltsDumpBuffer(LogicalTapeSet* lts, LogicalTape* lt);
+static void ltsWriteBehind(LogicalTapeSet* lts, long blocknum);
+static void ltsReadAhead(LogicalTapeSet* lts, IndirectBlock* indirect);
+static void ltsWriteData(LogicalTapeSet* lts, LogicalTape* lt, void* ptr, size_t size);
+static size_t ltsReadData(LogicalTapeSet* lts, LogicalTape* lt, void* ptr, size_t size);
+static void ltsFlushFrame(LogicalTapeSet* lts, LogicalTape* lt);
+static bool ltsLoadFrame(LogicalTapeSet* lts, LogicalTape* lt);
 
 /*
  * Write a block-sized buffer to the specified block of the underlying file.
@@ -201,6 +251,7 @@ static void ltsWriteBlock(LogicalTapeSet* lts, long blocknum, void* buffer)
             (errcode_for_file_access(),
                 errmsg("could not write block %ld of temporary file: %m", blocknum),
                 errhint("Perhaps out of disk space?")));
+    ltsWriteBehind(lts, blocknum);
 }
 
 /*
@@ -217,6 +268,69 @@ static void ltsReadBlock(LogicalTapeSet* lts, long blocknum, void* buffer)
             (errcode_for_file_access(), errmsg("could not read block %ld of temporary file: %m", blocknum)));
 }
 
+/*
+ * Remember a block just written, and start writeback of the written blocks
+ * once enough consecutive ones have been collected.  The initial runs are
+ * written sequentially, so they are written back in large pieces; during
+ * merge passes recycled blocks are reused in increasing order, which still
+ * gives short runs.  Runs too short to be worth a system call are left to
+ * the kernel.
+ */
+static void ltsWriteBehind(LogicalTapeSet* lts, long blocknum)
+{
+    if (lts->wbBlocks > 0 && blocknum == lts->wbStart + lts->wbBlocks) {
+        if (++lts->wbBlocks >= LTS_WRITE_BEHIND_BLOCKS) {
+            BufFileWritebackBlocks(lts->pfile, lts->wbStart, lts->wbBlocks);
+            lts->wbBlocks = 0;
+        }
+        return;
+    }
+
+    if (lts->wbBlocks >= LTS_WRITE_BEHIND_BLOCKS / 4)
+        BufFileWritebackBlocks(lts->pfile, lts->wbStart, lts->wbBlocks);
+    lts->wbStart = blocknum;
+    lts->wbBlocks = 1;
+}
+
+/*
+ * Prefetch the data blocks a tape is going to read next.  This is called
+ * just after the next data block number has been taken from the bottom
+ * indirect block.  Once per LTS_READ_AHEAD_BLOCKS blocks, the blocks one
+ * window ahead are requested, so that the kernel has a window's worth of
+ * reading time to bring them in; the first block of an indirect block
+ * requests the first two windows.  Consecutive block numbers are requested
+ * together.
+ */
+static void ltsReadAhead(LogicalTapeSet* lts, IndirectBlock* indirect)
+{
+    int current;
+    int slot;
+    int end;
+
+    if (indirect == NULL || indirect->nextSlot == 0)
+        return;
+    current = indirect->nextSlot - 1;
+    if (current % LTS_READ_AHEAD_BLOCKS != 0)
+        return;
+
+    slot = (current == 0) ? 1 : current + LTS_READ_AHEAD_BLOCKS;
+    end = Min(current + 2 * LTS_READ_AHEAD_BLOCKS, BLOCKS_PER_INDIR_BLOCK);
+    /* the blocks in between are known to exist unless we meet a sentinel */
+    for (int i = current + 1; i < slot && i < end; i++) {
+        if (indirect->ptrs[i] == -1L)
+            return;
+    }
+    while (slot < end && indirect->ptrs[slot] != -1L) {
+        long first = indirect->ptrs[slot];
+        int n = 1;
+
+        while (slot + n < end && indirect->ptrs[slot + n] == first + n)
+            n++;
+        BufFilePrefetchBlocks(lts->pfile, first, n);
+        slot += n;
+    }
+}
+
 /*
  * qsort comparator for sorting freeBlocks[] into decreasing order.
  */
@@ -469,9 +583,10 @@ static long ltsRecallPrevBlockNum(LogicalTapeSet* lts, IndirectBlock* indirect)
 /*
  * Create a set of logical tapes in a temporary underlying file.
  *
- * Each tape is initialized in write state.
+ * Each tape is initialized in write state.  If compress is true, the tapes
+ * are stored compressed; the caller must then never seek or backspace them.
  */
-LogicalTapeSet* LogicalTapeSetCreate(int ntapes)
+LogicalTapeSet* LogicalTapeSetCreate(int ntapes, bool compress)
 {
     LogicalTapeSet* lts = NULL;
     LogicalTape* lt = NULL;
@@ -485,6 +600,10 @@ LogicalTapeSet* LogicalTapeSetCreate(int ntapes)
     lts = (LogicalTapeSet*)palloc(sizeof(LogicalTapeSet) + (ntapes - 1) * sizeof(LogicalTape));
     lts->pfile = BufFileCreateTemp(false);
     lts->nFileBlocks = 0L;
+    lts->wbStart = 0L;
+    lts->wbBlocks = 0;
+    lts->compress = compress;
+    lts->zbuf = compress ? (char*)palloc(LZ4_COMPRESSBOUND(LTS_FRAME_SIZE)) : NULL;
     lts->forgetFreeSpace = false;
     lts->blocksSorted = true; /* a zero-length array is sorted ... */
     lts->freeBlocksLen = 32;  /* reasonable initial guess */
@@ -510,10 +629,25 @@ LogicalTapeSet* LogicalTapeSetCreate(int ntapes)
         lt->curBlockNumber = 0L;
         lt->pos = 0;
         lt->nbytes = 0;
+        lt->frame = NULL;
+        lt->framePos = 0;
+        lt->frameLen = 0;
     }
     return lts;
 }
 
+/*
+ * Memory a tape set of ntapes tapes needs for compression, on top of the
+ * block buffers of its tapes: one frame per tape and the shared workspace.
+ * Callers charge it to their sort memory like the tape buffers.
+ */
+long LogicalTapeSetCompressSpace(int ntapes, bool compress)
+{
+    if (!compress)
+        return 0L;
+    return (long)ntapes * LTS_FRAME_SIZE + LZ4_COMPRESSBOUND(LTS_FRAME_SIZE);
+}
+
 /*
  * Close a logical tape set and release all resources.
  */
@@ -533,7 +667,11 @@ void LogicalTapeSetClose(LogicalTapeSet* lts)
         }
         if (lt->buffer != NULL)
             pfree_ext(lt->buffer);
+        if (lt->frame != NULL)
+            pfree_ext(lt->frame);
     }
+    if (lts->zbuf != NULL)
+        pfree_ext(lts->zbuf);
     pfree_ext(lts->freeBlocks);
     pfree_ext(lts);
 }
@@ -567,19 +705,12 @@ static void ltsDumpBuffer(LogicalTapeSet* lts, LogicalTape* lt)
 }
 
 /*
- * Write to a logical tape.
- *
- * There are no error returns; we ereport() on failure.
+ * Write data to the blocks of a logical tape.
  */
-void LogicalTapeWrite(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size)
+static void ltsWriteData(LogicalTapeSet* lts, LogicalTape* lt, void* ptr, size_t size)
 {
-    LogicalTape* lt = NULL;
     size_t nthistime;
 
-    Assert(tapenum >= 0 && tapenum < lts->nTapes);
-    lt = &lts->tapes[tapenum];
-    Assert(lt->writing);
-
     /* Allocate data buffer and first indirect block on first write */
     if (lt->buffer == NULL)
         lt->buffer = (char*)palloc(BLCKSZ);
@@ -621,6 +752,68 @@ void LogicalTapeWrite(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size)
     }
 }
 
+/*
+ * Compress the collected frame of a compressed tape and write it out.
+ */
+static void ltsFlushFrame(LogicalTapeSet* lts, LogicalTape* lt)
+{
+    int32 hdr[2];
+
+    if (lt->framePos == 0)
+        return;
+
+    hdr[0] = LZ4_compress_default(lt->frame, lts->zbuf, lt->framePos, LZ4_COMPRESSBOUND(LTS_FRAME_SIZE));
+    hdr[1] = lt->framePos;
+    if (hdr[0] <= 0 || hdr[0] >= hdr[1]) {
+        hdr[0] = hdr[1];
+        ltsWriteData(lts, lt, (void*)hdr, LTS_FRAME_HDRSZ);
+        ltsWriteData(lts, lt, (void*)lt->frame, hdr[1]);
+    } else {
+        ltsWriteData(lts, lt, (void*)hdr, LTS_FRAME_HDRSZ);
+        ltsWriteData(lts, lt, (void*)lts->zbuf, hdr[0]);
+    }
+    lt->framePos = 0;
+}
+
+/*
+ * Write to a logical tape.
+ *
+ * There are no error returns; we ereport() on failure.
+ */
+void LogicalTapeWrite(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size)
+{
+    LogicalTape* lt = NULL;
+    size_t nthistime;
+
+    Assert(tapenum >= 0 && tapenum < lts->nTapes);
+    lt = &lts->tapes[tapenum];
+    Assert(lt->writing);
+
+    if (!lts->compress) {
+        ltsWriteData(lts, lt, ptr, size);
+        return;
+    }
+
+    if (lt->frame == NULL)
+        lt->frame = (char*)palloc(LTS_FRAME_SIZE);
+
+    while (size > 0) {
+        if (lt->framePos >= LTS_FRAME_SIZE)
+            ltsFlushFrame(lts, lt);
+
+        nthistime = LTS_FRAME_SIZE - lt->framePos;
+        if (nthistime > size)
+            nthistime = size;
+
+        errno_t rc = memcpy_s(lt->frame + lt->framePos, nthistime, ptr, nthistime);
+        securec_check(rc, "\0", "\0");
+
+        lt->framePos += nthistime;
+        ptr = (void*)((char*)ptr + nthistime);
+        size -= nthistime;
+    }
+}
+
 /*
  * Rewind logical tape and switch from writing to reading or vice versa.
  *
@@ -642,6 +835,8 @@ void LogicalTapeRewind(LogicalTapeSet* lts, int tapenum, bool forWrite)
              * flush any partial indirect blocks, rewind for normal
              * (destructive) read.
              */
+            if (lts->compress)
+                ltsFlushFrame(lts, lt);
             if (lt->dirty)
                 ltsDumpBuffer(lts, lt);
             lt->lastBlockBytes = lt->nbytes;
@@ -659,7 +854,10 @@ void LogicalTapeRewind(LogicalTapeSet* lts, int tapenum, bool forWrite)
         lt->curBlockNumber = 0L;
         lt->pos = 0;
         lt->nbytes = 0;
+        lt->framePos = 0;
+        lt->frameLen = 0;
         if (datablocknum != -1L) {
+            ltsReadAhead(lts, lt->indirect);
             ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
             if (!lt->frozen)
                 ltsReleaseBlock(lts, datablocknum);
@@ -694,24 +892,19 @@ void LogicalTapeRewind(LogicalTapeSet* lts, int tapenum, bool forWrite)
         lt->curBlockNumber = 0L;
         lt->pos = 0;
         lt->nbytes = 0;
+        lt->framePos = 0;
+        lt->frameLen = 0;
     }
 }
 
 /*
- * Read from a logical tape.
- *
- * Early EOF is indicated by return value less than #bytes requested.
+ * Read data from the blocks of a logical tape.
  */
-size_t LogicalTapeRead(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size)
+static size_t ltsReadData(LogicalTapeSet* lts, LogicalTape* lt, void* ptr, size_t size)
 {
-    LogicalTape* lt = NULL;
     size_t nread = 0;
     size_t nthistime;
 
-    Assert(tapenum >= 0 && tapenum < lts->nTapes);
-    lt = &lts->tapes[tapenum];
-    Assert(!lt->writing);
-
     while (size > 0) {
         if (lt->pos >= lt->nbytes) {
             /* Try to load more data into buffer. */
@@ -719,6 +912,7 @@ size_t LogicalTapeRead(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size)
 
             if (datablocknum == -1L)
                 break; /* EOF */
+            ltsReadAhead(lts, lt->indirect);
             lt->curBlockNumber++;
             lt->pos = 0;
             ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
@@ -746,6 +940,75 @@ size_t LogicalTapeRead(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size)
     return nread;
 }
 
+/*
+ * Read and decompress the next frame of a compressed tape.  Returns false
+ * at the end of the tape.
+ */
+static bool ltsLoadFrame(LogicalTapeSet* lts, LogicalTape* lt)
+{
+    int32 hdr[2];
+    size_t nread;
+
+    nread = ltsReadData(lts, lt, (void*)hdr, LTS_FRAME_HDRSZ);
+    if (nread == 0)
+        return false;
+    if (nread != LTS_FRAME_HDRSZ || hdr[1] <= 0 || hdr[1] > LTS_FRAME_SIZE || hdr[0] <= 0 || hdr[0] > hdr[1])
+        ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("invalid compressed frame in temporary file")));
+
+    if (lt->frame == NULL)
+        lt->frame = (char*)palloc(LTS_FRAME_SIZE);
+
+    if (hdr[0] == hdr[1]) {
+        if (ltsReadData(lts, lt, (void*)lt->frame, hdr[1]) != (size_t)hdr[1])
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("unexpected end of tape")));
+    } else {
+        if (ltsReadData(lts, lt, (void*)lts->zbuf, hdr[0]) != (size_t)hdr[0] ||
+            LZ4_decompress_safe(lts->zbuf, lt->frame, hdr[0], LTS_FRAME_SIZE) != hdr[1])
+            ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("invalid compressed frame in temporary file")));
+    }
+    lt->framePos = 0;
+    lt->frameLen = hdr[1];
+    return true;
+}
+
+/*
+ * Read from a logical tape.
+ *
+ * Early EOF is indicated by return value less than #bytes requested.
+ */
+size_t LogicalTapeRead(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size)
+{
+    LogicalTape* lt = NULL;
+    size_t nread = 0;
+    size_t nthistime;
+
+    Assert(tapenum >= 0 && tapenum < lts->nTapes);
+    lt = &lts->tapes[tapenum];
+    Assert(!lt->writing);
+
+    if (!lts->compress)
+        return ltsReadData(lts, lt, ptr, size);
+
+    while (size > 0) {
+        if (lt->framePos >= lt->frameLen && !ltsLoadFrame(lts, lt))
+            break; /* EOF */
+
+        nthistime = lt->frameLen - lt->framePos;
+        if (nthistime > size)
+            nthistime = size;
+
+        errno_t rc = memcpy_s(ptr, nthistime, lt->frame + lt->framePos, nthistime);
+        securec_check(rc, "\0", "\0");
+
+        lt->framePos += nthistime;
+        ptr = (void*)((char*)ptr + nthistime);
+        size -= nthistime;
+        nread += nthistime;
+    }
+
+    return nread;
+}
+
 /*
  * "Freeze" the contents of a tape so that it can be read multiple times
  * and/or read backwards.  Once a tape is frozen, its contents will not
@@ -770,6 +1033,8 @@ void LogicalTapeFreeze(LogicalTapeSet* lts, int tapenum)
      * Completion of a write phase.  Flush last partial data block, flush any
      * partial indirect blocks, rewind for nondestructive read.
      */
+    if (lts->compress)
+        ltsFlushFrame(lts, lt);
     if (lt->dirty)
         ltsDumpBuffer(lts, lt);
     lt->lastBlockBytes = lt->nbytes;
@@ -780,7 +1045,10 @@ void LogicalTapeFreeze(LogicalTapeSet* lts, int tapenum)
     lt->curBlockNumber = 0L;
     lt->pos = 0;
     lt->nbytes = 0;
+    lt->framePos = 0;
+    lt->frameLen = 0;
     if (datablocknum != -1L) {
+        ltsReadAhead(lts, lt->indirect);
         ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
         lt->nbytes = (lt->curBlockNumber < lt->numFullBlocks) ? BLCKSZ : lt->lastBlockBytes;
     }
@@ -806,6 +1074,8 @@ bool LogicalTapeBackspace(LogicalTapeSet* lts, int tapenum, size_t size)
     Assert(tapenum >= 0 && tapenum < lts->nTapes);
     lt = &lts->tapes[tapenum];
     Assert(lt->frozen);
+    if (lts->compress)
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("cannot backspace a compressed logical tape")));
 
     /*
      * Easy case for seek within current block.
@@ -865,6 +1135,8 @@ bool LogicalTapeSeek(LogicalTapeSet* lts, int tapenum, long blocknum, int offset
     lt = &lts->tapes[tapenum];
     Assert(lt->frozen);
     Assert(offset >= 0 && offset <= BLCKSZ);
+    if (lts->compress)
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("cannot seek in a compressed logical tape")));
 
     /*
      * Easy case for seek within current block.
@@ -911,6 +1183,8 @@ bool LogicalTapeSeek(LogicalTapeSet* lts, int tapenum, long blocknum, int offset
  *
  * NOTE: it'd be OK to do this during write phase with intention of using
  * the position for a seek after freezing.	Not clear if anyone needs that.
+ * For a compressed tape the position is that of the compressed data, which
+ * is good for nothing but comparing positions.
  */
 void LogicalTapeTell(LogicalTapeSet* lts, int tapenum, long* blocknum, int* offset)
 {
@@ -16,8 +16,10 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/nbtree.h"
 #include "fmgr.h"
 #include "utils/lsyscache.h"
+#include "utils/rel.h"
 #include "utils/sortsupport.h"
 
 /* Info needed to use an old-style comparison function as a sort comparator */
@@ -140,3 +142,42 @@ void PrepareSortSupportFromOrderingOp(Oid orderingOp, SortSupport ssup)
         PrepareSortSupportComparisonShim(sortFunction, ssup);
     }
 }
+
+/*
+ * Fill in SortSupport given an index relation, attribute, and strategy.
+ *
+ * Caller must previously have zeroed the SortSupportData structure and then
+ * filled in ssup_cxt, ssup_attno, ssup_collation, and ssup_nulls_first.  This
+ * will fill in ssup_reverse (based on the supplied strategy), as well as the
+ * comparator function pointer.
+ */
+void PrepareSortSupportFromIndexRel(Relation indexRel, int16 strategy, SortSupport ssup)
+{
+    Oid opfamily = indexRel->rd_opfamily[ssup->ssup_attno - 1];
+    Oid opcintype = indexRel->rd_opcintype[ssup->ssup_attno - 1];
+    Oid sortFunction;
+
+    Assert(ssup->comparator == NULL);
+
+    if (strategy != BTGreaterStrategyNumber && strategy != BTLessStrategyNumber)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("unexpected sort support strategy: %d", strategy)));
+    ssup->ssup_reverse = (strategy == BTGreaterStrategyNumber);
+
+    sortFunction = get_opfamily_proc(opfamily, opcintype, opcintype, BTSORTSUPPORT_PROC);
+    if (OidIsValid(sortFunction)) {
+        /* The sort support function should provide a comparator */
+        OidFunctionCall1(sortFunction, PointerGetDatum(ssup));
+        Assert(ssup->comparator != NULL);
+        return;
+    }
+
+    /* We'll use a shim to call the old-style btree comparator */
+    sortFunction = get_opfamily_proc(opfamily, opcintype, opcintype, BTORDER_PROC);
+    if (!OidIsValid(sortFunction))
+        ereport(ERROR,
+            (errcode(ERRCODE_UNDEFINED_FUNCTION),
+                errmsg("missing support function %d(%u,%u) in opfamily %u",
+                    BTORDER_PROC, opcintype, opcintype, opfamily)));
+
+    PrepareSortSupportComparisonShim(sortFunction, ssup);
+}
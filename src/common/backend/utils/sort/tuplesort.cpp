@@ -107,6 +107,9 @@
 #include "knl/knl_variable.h"
 
 #include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <algorithm>
 
 #include "access/nbtree.h"
 #include "access/tableam.h"
@@ -214,8 +217,28 @@ typedef enum {
 #define TAPE_BUFFER_OVERHEAD (BLCKSZ * 3)
 #define MERGE_BUFFER_SIZE (BLCKSZ * 32)
 
+/*
+ * Single-key sorts on integer-like keys are radix sorted when there are at
+ * least RADIX_SORT_MIN_TUPLES tuples.  Buckets smaller than
+ * RADIX_SORT_QSORT_TUPLES are finished by qsort_ssup().
+ */
+#define RADIX_SORT_MIN_TUPLES 1024
+#define RADIX_SORT_QSORT_TUPLES 64
+
+/* each sort thread gets a slice of at least this many tuples */
+#define PARALLEL_SORT_MIN_TUPLES 65536
+
 typedef int (*SortTupleComparator)(const SortTuple* a, const SortTuple* b, Tuplesortstate* state);
 
+/* A slice of memtuples sorted by its own thread */
+typedef struct SortSlice {
+    Tuplesortstate* state;
+    SortTuple* tuples;
+    int ntuples;
+    pthread_t thread;
+    bool started; /* is a thread sorting it? */
+} SortSlice;
+
 /*
  * Private state of a Tuplesort operation.
  */
@@ -394,6 +417,8 @@ struct Tuplesortstate {
     /* These are specific to the index_btree subcase: */
     ScanKey indexScanKey;
     bool enforceUnique; /* complain if we find duplicate tuples */
+    bool deferUnique;   /* duplicates are checked after a parallel sort */
+    int sortWorkers;    /* threads sorting slices of memtuples, see sort_slices */
 
     /* These are specific to the index_hash subcase: */
     uint32 hash_mask; /* mask for sortable part of hash code */
@@ -591,6 +616,7 @@ static void readtup_cluster(Tuplesortstate* state, SortTuple* stup, int tapenum,
 static int comparetup_index_btree(const SortTuple* a, const SortTuple* b, Tuplesortstate* state);
 static int comparetup_index_hash(const SortTuple* a, const SortTuple* b, Tuplesortstate* state);
 static void copytup_index(Tuplesortstate* state, SortTuple* stup, void* tup);
+static void set_index_leading_key(Tuplesortstate* state, SortTuple* stup);
 static void writetup_index(Tuplesortstate* state, int tapenum, SortTuple* stup);
 static void readtup_index(Tuplesortstate* state, SortTuple* stup, int tapenum, unsigned int len);
 static void reversedirection_index_btree(Tuplesortstate* state);
@@ -603,6 +629,8 @@ static void reversedirection_datum(Tuplesortstate* state);
 static void free_sort_tuple(Tuplesortstate* state, SortTuple* stup);
 static void dumpbatch(Tuplesortstate *state, bool alltuples);
 static void tuplesort_sort_memtuples(Tuplesortstate *state);
+static int sort_slices(Tuplesortstate* state, SortSlice* slices, bool checkUnique);
+static bool merge_sorted_slices(Tuplesortstate* state);
 
 /*
  * Special versions of qsort just for SortTuple objects.  qsort_tuple() sorts
@@ -879,6 +907,7 @@ Tuplesortstate* tuplesort_begin_index_btree(
 {
     Tuplesortstate* state = tuplesort_begin_common(workMem, randomAccess);
     MemoryContext oldcontext;
+    int i;
 
     oldcontext = MemoryContextSwitchTo(state->sortcontext);
 
@@ -910,6 +939,47 @@ Tuplesortstate* tuplesort_begin_index_btree(
     state->indexScanKey = _bt_mkscankey_nodata(indexRel);
     state->enforceUnique = enforceUnique;
     state->maxMem = maxMem * 1024L;
+    state->abbrevNext = 10;
+
+    /*
+     * Prepare SortSupport data for each column, so that the comparisons go
+     * through the opclass fast comparators and the leading key may be
+     * abbreviated, instead of calling the btree support function by fmgr.
+     */
+    state->sortKeys = (SortSupport)palloc0(state->nKeys * sizeof(SortSupportData));
+
+    for (i = 0; i < state->nKeys; i++) {
+        SortSupport sortKey = state->sortKeys + i;
+        ScanKey scanKey = state->indexScanKey + i;
+        int16 strategy;
+
+        sortKey->ssup_cxt = CurrentMemoryContext;
+        sortKey->ssup_collation = scanKey->sk_collation;
+        sortKey->ssup_nulls_first = ((uint32)scanKey->sk_flags & SK_BT_NULLS_FIRST) != 0;
+        sortKey->ssup_attno = scanKey->sk_attno;
+        /* Convey if abbreviation optimization is applicable in principle */
+        sortKey->abbreviate = (i == 0);
+
+        Assert(sortKey->ssup_attno != 0);
+
+        strategy = (((uint32)scanKey->sk_flags & SK_BT_DESC) != 0) ? BTGreaterStrategyNumber : BTLessStrategyNumber;
+
+        PrepareSortSupportFromIndexRel(indexRel, strategy, sortKey);
+    }
+
+    /*
+     * Slices of memtuples are sorted by plain threads, which must not palloc,
+     * ereport or check for interrupts.  Only the integer-like comparators are
+     * known to be safe: they compare the Datums directly, and the tuples are
+     * deformed by index_getattr without allocating.  Abbreviated keys are
+     * excluded, their full comparator may detoast.
+     */
+    state->sortWorkers = Min(RelationGetParallelWorkers(indexRel, 0), BTREE_MAX_SORT_WORKERS);
+    for (i = 0; i < state->nKeys; i++) {
+        if (state->sortKeys[i].ssup_int_width == 0 || state->sortKeys[i].abbrev_converter != NULL) {
+            state->sortWorkers = 0;
+        }
+    }
 
     (void)MemoryContextSwitchTo(oldcontext);
 
@@ -1357,7 +1427,7 @@ void tuplesort_putindextuplevalues(
     ((IndexTuple)stup.tuple)->t_tid = *self;
     USEMEM(state, GetMemoryChunkSpace(stup.tuple));
     /* set up first-column key value */
-    stup.datum1 = index_getattr((IndexTuple)stup.tuple, 1, RelationGetDescr(state->indexRel), &stup.isnull1);
+    set_index_leading_key(state, &stup);
     puttuple_common(state, &stup);
 
     (void)MemoryContextSwitchTo(oldcontext);
@@ -2103,6 +2173,7 @@ static void inittapes(Tuplesortstate* state)
 {
     int maxTapes, j;
     long tapeSpace;
+    bool compress = false;
 
     /* Compute number of tapes to use: merge order plus 1 */
     maxTapes = tuplesort_merge_order(state->allowedMem) + 1;
@@ -2133,7 +2204,8 @@ static void inittapes(Tuplesortstate* state)
      * account for tuple space, so we don't care if LACKMEM becomes
      * inaccurate.)
      */
-    tapeSpace = (long)maxTapes * TAPE_BUFFER_OVERHEAD;
+    compress = u_sess->attr.attr_sql.enable_compress_sort_tape && !state->randomAccess;
+    tapeSpace = (long)maxTapes * TAPE_BUFFER_OVERHEAD + LogicalTapeSetCompressSpace(maxTapes, compress);
     if (tapeSpace + (long)(GetMemoryChunkSpace(state->memtuples)) < state->allowedMem)
         USEMEM(state, tapeSpace);
 
@@ -2144,9 +2216,10 @@ static void inittapes(Tuplesortstate* state)
     PrepareTempTablespaces();
 
     /*
-     * Create the tape set and allocate the per-tape data arrays.
+     * Create the tape set and allocate the per-tape data arrays.  Compressed
+     * tapes can only be read forward, so not under random access.
      */
-    state->tapeset = LogicalTapeSetCreate(maxTapes);
+    state->tapeset = LogicalTapeSetCreate(maxTapes, compress);
 
     state->mergeactive = (bool*)palloc0(maxTapes * sizeof(bool));
     state->mergenext = (int*)palloc0(maxTapes * sizeof(int));
@@ -2699,7 +2772,16 @@ static void dumpbatch(Tuplesortstate *state, bool alltuples)
     }
 #endif
 
-    tuplesort_sort_memtuples(state);
+    /*
+     * Slices sorted by the sort threads become runs of their own, the merge
+     * takes care of them like of any other run.
+     */
+    SortSlice slices[BTREE_MAX_SORT_WORKERS];
+    int nslices = sort_slices(state, slices, true);
+
+    if (nslices == 1) {
+        tuplesort_sort_memtuples(state);
+    }
 
 #ifdef TRACE_SORT
     if (u_sess->attr.attr_common.trace_sort) {
@@ -2707,15 +2789,24 @@ static void dumpbatch(Tuplesortstate *state, bool alltuples)
     }
 #endif
 
-    memtupwrite = state->memtupcount;
-    for (i = 0; i < memtupwrite; i++) {
-        WRITETUP(state, state->tp_tapenum[state->destTape], &state->memtuples[i]);
-        state->memtupcount--;
-    }
+    for (int j = 0; j < nslices; j++) {
+        SortTuple* tuples = (nslices == 1) ? state->memtuples : slices[j].tuples;
 
-    markrunend(state, state->tp_tapenum[state->destTape]);
-    state->tp_runs[state->destTape]++;
-    state->tp_dummy[state->destTape]--;
+        if (j > 0) {
+            selectnewtape(state);
+            state->currentRun++;
+        }
+
+        memtupwrite = (nslices == 1) ? state->memtupcount : slices[j].ntuples;
+        for (i = 0; i < memtupwrite; i++) {
+            WRITETUP(state, state->tp_tapenum[state->destTape], &tuples[i]);
+            state->memtupcount--;
+        }
+
+        markrunend(state, state->tp_tapenum[state->destTape]);
+        state->tp_runs[state->destTape]++;
+        state->tp_dummy[state->destTape]--;
+    }
 
 #ifdef TRACE_SORT
     if (u_sess->attr.attr_common.trace_sort) {
@@ -2998,10 +3089,327 @@ static void tuplesort_heap_insert(Tuplesortstate* state, SortTuple* tuple, int t
     memtuples[j] = *tuple;
 }
 
+/*
+ * Map the integer key of a tuple to an unsigned value with the same order,
+ * so that it can be sorted byte by byte.
+ */
+static inline uint64 radix_sort_key(const SortTuple* tuple, SortSupport ssup)
+{
+    int64 value;
+    uint64 key;
+
+    switch (ssup->ssup_int_width) {
+        case sizeof(int16):
+            value = DatumGetInt16(tuple->datum1);
+            break;
+        case sizeof(int32):
+            value = DatumGetInt32(tuple->datum1);
+            break;
+        default:
+            value = DatumGetInt64(tuple->datum1);
+            break;
+    }
+
+    /* flip the sign bit of the key width, only its low bytes are used */
+    key = (uint64)value + ((uint64)1 << (ssup->ssup_int_width * BITS_PER_BYTE - 1));
+
+    return ssup->ssup_reverse ? ~key : key;
+}
+
+/*
+ * In-place MSD radix sort (American flag sort) of not null tuples, starting
+ * from the given byte of the key.  Needs no memory besides the stack, so it
+ * may be used for the runs of an external sort too.
+ */
+static void radix_sort_tuple(SortTuple* tuples, int ntuples, int byte, SortSupport ssup)
+{
+    int count[256];
+    int head[256];
+    int tail[256];
+    int shift;
+    int i;
+
+    for (;;) {
+        if (ntuples < RADIX_SORT_QSORT_TUPLES) {
+            qsort_ssup(tuples, ntuples, ssup);
+            return;
+        }
+
+        shift = byte * BITS_PER_BYTE;
+        errno_t rc = memset_s(count, sizeof(count), 0, sizeof(count));
+        securec_check(rc, "\0", "\0");
+        for (i = 0; i < ntuples; i++) {
+            count[(radix_sort_key(&tuples[i], ssup) >> shift) & 0xFF]++;
+        }
+
+        /* all keys share this byte, go on with the next one */
+        if (count[(radix_sort_key(&tuples[0], ssup) >> shift) & 0xFF] == ntuples) {
+            if (byte == 0) {
+                return;
+            }
+            byte--;
+            continue;
+        }
+        break;
+    }
+
+    head[0] = 0;
+    for (i = 0; i < 256; i++) {
+        if (i > 0) {
+            head[i] = tail[i - 1];
+        }
+        tail[i] = head[i] + count[i];
+    }
+
+    /* move every tuple into its bucket, following the permutation cycles */
+    for (i = 0; i < 256; i++) {
+        while (head[i] < tail[i]) {
+            SortTuple tuple = tuples[head[i]];
+            int bucket = (int)((radix_sort_key(&tuple, ssup) >> shift) & 0xFF);
+
+            while (bucket != i) {
+                SortTuple swap = tuples[head[bucket]];
+
+                tuples[head[bucket]++] = tuple;
+                tuple = swap;
+                bucket = (int)((radix_sort_key(&tuple, ssup) >> shift) & 0xFF);
+            }
+            tuples[head[i]++] = tuple;
+        }
+    }
+
+    if (byte == 0) {
+        return;
+    }
+
+    for (i = 0; i < 256; i++) {
+        int start = tail[i] - count[i];
+
+        if (count[i] > 1) {
+            radix_sort_tuple(tuples + start, count[i], byte - 1, ssup);
+        }
+    }
+}
+
+/*
+ * Radix sort memtuples for a single integer-like key.  NULLs are moved to
+ * the end which the sort order asks for first, the rest is sorted by key.
+ */
+static void tuplesort_radix_sort(Tuplesortstate* state)
+{
+    SortSupport ssup = state->onlyKey;
+    SortTuple* tuples = state->memtuples;
+    int ntuples = state->memtupcount;
+    int lo = 0;
+    int hi = ntuples;
+
+    /* partition the NULLs off, their order doesn't matter */
+    while (lo < hi) {
+        if (tuples[lo].isnull1 == ssup->ssup_nulls_first) {
+            lo++;
+        } else {
+            SortTuple swap = tuples[lo];
+
+            tuples[lo] = tuples[--hi];
+            tuples[hi] = swap;
+        }
+    }
+
+    if (ssup->ssup_nulls_first) {
+        radix_sort_tuple(tuples + lo, ntuples - lo, ssup->ssup_int_width - 1, ssup);
+    } else {
+        radix_sort_tuple(tuples, lo, ssup->ssup_int_width - 1, ssup);
+    }
+}
+
+/*
+ * Sort one slice.  qsort_tuple() checks for interrupts, which must not happen
+ * outside of the backend thread, so std::sort is used instead.  It neither
+ * allocates nor looks at any backend state, and comparetup_index_btree() can't
+ * ereport while deferUnique is set.
+ */
+static void* sort_slice_thread(void* arg)
+{
+    SortSlice* slice = (SortSlice*)arg;
+    Tuplesortstate* state = slice->state;
+
+    std::sort(slice->tuples, slice->tuples + slice->ntuples, [state](const SortTuple& a, const SortTuple& b) {
+        return state->comparetup(&a, &b, state) < 0;
+    });
+    return NULL;
+}
+
+/*
+ * Sort memtuples in slices, one per sort thread, if the sort is large enough
+ * for it.  Returns the number of sorted slices, or 1 if nothing was done and
+ * memtuples is still to be sorted as a whole.
+ *
+ * The slices partition memtuples, so together they never hold more than the
+ * work_mem the leader already accounted, each about work_mem / nslices.  The
+ * threads sort in place and allocate nothing of their own.
+ *
+ * The unique check of index builds can't ereport from the threads.  If asked
+ * to, it is done here afterwards on the neighbours within each slice, else
+ * the caller has to do it.
+ */
+static int sort_slices(Tuplesortstate* state, SortSlice* slices, bool checkUnique)
+{
+    int nslices = Min(state->sortWorkers, state->memtupcount / PARALLEL_SORT_MIN_TUPLES);
+    int start = 0;
+    int i;
+
+    if (nslices <= 1) {
+        return 1;
+    }
+
+    Assert(nslices <= BTREE_MAX_SORT_WORKERS);
+
+    for (i = 0; i < nslices; i++) {
+        slices[i].state = state;
+        slices[i].tuples = state->memtuples + start;
+        slices[i].ntuples = state->memtupcount / nslices + ((i < state->memtupcount % nslices) ? 1 : 0);
+        slices[i].started = false;
+        start += slices[i].ntuples;
+    }
+
+    /* no ereport may happen while the threads are looking at memtuples */
+    HOLD_INTERRUPTS();
+    state->deferUnique = true;
+
+    /* the sort threads inherit the signal mask, keep the backend's signals away from them */
+    sigset_t allSigs;
+    sigset_t oldSigs;
+    (void)sigfillset(&allSigs);
+    (void)pthread_sigmask(SIG_SETMASK, &allSigs, &oldSigs);
+
+    for (i = 1; i < nslices; i++) {
+        slices[i].started = (pthread_create(&slices[i].thread, NULL, sort_slice_thread, &slices[i]) == 0);
+    }
+
+    (void)pthread_sigmask(SIG_SETMASK, &oldSigs, NULL);
+
+    /* the slices whose thread could not be started are sorted here */
+    for (i = 0; i < nslices; i++) {
+        if (!slices[i].started) {
+            (void)sort_slice_thread(&slices[i]);
+        }
+    }
+
+    for (i = 1; i < nslices; i++) {
+        if (slices[i].started) {
+            (void)pthread_join(slices[i].thread, NULL);
+        }
+    }
+
+    state->deferUnique = false;
+    RESUME_INTERRUPTS();
+
+    if (state->enforceUnique && checkUnique) {
+        for (i = 0; i < nslices; i++) {
+            for (int j = 1; j < slices[i].ntuples; j++) {
+                (void)COMPARETUP(state, &slices[i].tuples[j - 1], &slices[i].tuples[j]);
+            }
+        }
+    }
+
+    return nslices;
+}
+
+/*
+ * Merge the sorted slices into a new memtuples array, when there is room
+ * for the second array.  Returns false if memtuples is left as it was.
+ */
+static bool merge_sorted_slices(Tuplesortstate* state)
+{
+    SortSlice slices[BTREE_MAX_SORT_WORKERS];
+    int heap[BTREE_MAX_SORT_WORKERS];
+    int pos[BTREE_MAX_SORT_WORKERS];
+    SortTuple* merged = NULL;
+    int nslices;
+    int nheap = 0;
+    int i;
+
+    if (state->sortWorkers <= 1 ||
+        state->availMem < (int64)(state->memtupsize * sizeof(SortTuple)) + ALLOCSET_DEFAULT_INITSIZE) {
+        return false;
+    }
+
+    nslices = sort_slices(state, slices, false);
+    if (nslices == 1) {
+        return false;
+    }
+
+    merged = (SortTuple*)palloc(state->memtupsize * sizeof(SortTuple));
+    USEMEM(state, GetMemoryChunkSpace(merged));
+
+    /* binary heap of the slices, ordered by their current tuple */
+    for (i = 0; i < nslices; i++) {
+        int j = nheap++;
+
+        pos[i] = 0;
+        while (j > 0) {
+            int parent = (j - 1) / 2;
+
+            if (COMPARETUP(state, &slices[heap[parent]].tuples[0], &slices[i].tuples[0]) <= 0) {
+                break;
+            }
+            heap[j] = heap[parent];
+            j = parent;
+        }
+        heap[j] = i;
+    }
+
+    for (int out = 0; out < state->memtupcount; out++) {
+        int top = heap[0];
+        int j = 0;
+
+        merged[out] = slices[top].tuples[pos[top]++];
+        if (pos[top] == slices[top].ntuples) {
+            top = heap[--nheap];
+        }
+
+        /* sift the new top down */
+        while (nheap > 0) {
+            int child = 2 * j + 1;
+
+            if (child >= nheap) {
+                break;
+            }
+            if (child + 1 < nheap && COMPARETUP(state, &slices[heap[child + 1]].tuples[pos[heap[child + 1]]],
+                &slices[heap[child]].tuples[pos[heap[child]]]) < 0) {
+                child++;
+            }
+            if (COMPARETUP(state, &slices[top].tuples[pos[top]], &slices[heap[child]].tuples[pos[heap[child]]]) <= 0) {
+                break;
+            }
+            heap[j] = heap[child];
+            j = child;
+        }
+        if (nheap > 0) {
+            heap[j] = top;
+        }
+    }
+
+    FREEMEM(state, GetMemoryChunkSpace(state->memtuples));
+    pfree(state->memtuples);
+    state->memtuples = merged;
+
+    if (state->enforceUnique) {
+        for (i = 1; i < state->memtupcount; i++) {
+            (void)COMPARETUP(state, &merged[i - 1], &merged[i]);
+        }
+    }
+
+    return true;
+}
+
 static void tuplesort_sort_memtuples(Tuplesortstate *state)
 {
-    if (state->memtupcount > 1) {
-        if (state->onlyKey != NULL) {
+    if (state->memtupcount > 1 && !merge_sorted_slices(state)) {
+        if (state->onlyKey != NULL && state->onlyKey->ssup_int_width != 0 &&
+            state->memtupcount >= RADIX_SORT_MIN_TUPLES) {
+            tuplesort_radix_sort(state);
+        } else if (state->onlyKey != NULL) {
             qsort_ssup(state->memtuples, state->memtupcount, state->onlyKey);
         } else {
             qsort_tuple(state->memtuples, state->memtupcount, state->comparetup, state);
@@ -3495,7 +3903,7 @@ static int comparetup_index_btree(const SortTuple* a, const SortTuple* b, Tuples
      * whether any null fields are present.  Also see the special treatment
      * for equal keys at the end.
      */
-    ScanKey scanKey = state->indexScanKey;
+    SortSupport sortKey = state->sortKeys;
     IndexTuple tuple1;
     IndexTuple tuple2;
     int keysz;
@@ -3503,34 +3911,42 @@ static int comparetup_index_btree(const SortTuple* a, const SortTuple* b, Tuples
     bool equal_hasnull = false;
     int nkey;
     int32 compare;
+    Datum datum1, datum2;
+    bool isnull1 = false, isnull2 = false;
 
     /* Compare the leading sort key */
-    compare = inlineApplySortFunction(
-        &scanKey->sk_func, scanKey->sk_flags, scanKey->sk_collation, a->datum1, a->isnull1, b->datum1, b->isnull1);
+    compare = ApplySortComparator(a->datum1, a->isnull1, b->datum1, b->isnull1, sortKey);
     if (compare != 0) {
         return compare;
     }
 
-    /* they are equal, so we only need to examine one null flag */
-    if (a->isnull1) {
-        equal_hasnull = true;
-    }
-
     /* Compare additional sort keys */
     tuple1 = (IndexTuple)a->tuple;
     tuple2 = (IndexTuple)b->tuple;
     keysz = state->nKeys;
     tupDes = RelationGetDescr(state->indexRel);
-    scanKey++;
-    for (nkey = 2; nkey <= keysz; nkey++, scanKey++) {
-        Datum datum1, datum2;
-        bool isnull1 = false, isnull2 = false;
 
+    if (sortKey->abbrev_converter) {
+        datum1 = index_getattr(tuple1, 1, tupDes, &isnull1);
+        datum2 = index_getattr(tuple2, 1, tupDes, &isnull2);
+
+        compare = ApplySortAbbrevFullComparator(datum1, isnull1, datum2, isnull2, sortKey);
+        if (compare != 0) {
+            return compare;
+        }
+    }
+
+    /* they are equal, so we only need to examine one null flag */
+    if (a->isnull1) {
+        equal_hasnull = true;
+    }
+
+    sortKey++;
+    for (nkey = 2; nkey <= keysz; nkey++, sortKey++) {
         datum1 = index_getattr(tuple1, nkey, tupDes, &isnull1);
         datum2 = index_getattr(tuple2, nkey, tupDes, &isnull2);
 
-        compare = inlineApplySortFunction(
-            &scanKey->sk_func, scanKey->sk_flags, scanKey->sk_collation, datum1, isnull1, datum2, isnull2);
+        compare = ApplySortComparator(datum1, isnull1, datum2, isnull2, sortKey);
         if (compare != 0) {
             return compare; /* done when we find unequal attributes */
         }
@@ -3550,7 +3966,7 @@ static int comparetup_index_btree(const SortTuple* a, const SortTuple* b, Tuples
      * sort algorithm wouldn't have checked whether one must appear before the
      * other.
      */
-    if (state->enforceUnique && !equal_hasnull) {
+    if (state->enforceUnique && !equal_hasnull && !state->deferUnique) {
         Datum values[INDEX_MAX_KEYS];
         bool isnull[INDEX_MAX_KEYS];
         char* key_desc = NULL;
@@ -3658,6 +4074,49 @@ static int comparetup_index_hash(const SortTuple* a, const SortTuple* b, Tupleso
     return 0;
 }
 
+/*
+ * Set up the first-column key value of an index tuple, abbreviated if the
+ * leading sort key supports it.
+ */
+static void set_index_leading_key(Tuplesortstate* state, SortTuple* stup)
+{
+    Datum original = index_getattr((IndexTuple)stup->tuple, 1, RelationGetDescr(state->indexRel), &stup->isnull1);
+
+    if (state->sortKeys == NULL || !state->sortKeys->abbrev_converter || stup->isnull1) {
+        /*
+         * Store ordinary Datum representation, or NULL value.  If there is a
+         * converter it won't expect NULL values, and cost model is not
+         * required to account for NULL, so in that case we avoid calling
+         * converter and just set datum1 to "void" representation (to be
+         * consistent).
+         */
+        stup->datum1 = original;
+    } else if (!consider_abort_common(state)) {
+        /* Store abbreviated key representation */
+        stup->datum1 = state->sortKeys->abbrev_converter(original, state->sortKeys);
+    } else {
+        /* Abort abbreviation */
+        int i;
+
+        stup->datum1 = original;
+
+        /*
+         * Set state to be consistent with never trying abbreviation.
+         *
+         * Alter datum1 representation in already-copied tuples, so as to
+         * ensure a consistent representation (current tuple was just handled).
+         * Note that we rely on all tuples copied so far actually being
+         * contained within memtuples array.
+         */
+        for (i = 0; i < state->memtupcount; i++) {
+            SortTuple* mtup = &state->memtuples[i];
+
+            mtup->datum1 =
+                index_getattr((IndexTuple)mtup->tuple, 1, RelationGetDescr(state->indexRel), &mtup->isnull1);
+        }
+    }
+}
+
 static void copytup_index(Tuplesortstate* state, SortTuple* stup, void* tup)
 {
     IndexTuple tuple = (IndexTuple)tup;
@@ -3672,7 +4131,7 @@ static void copytup_index(Tuplesortstate* state, SortTuple* stup, void* tup)
     USEMEM(state, GetMemoryChunkSpace(newtuple));
     stup->tuple = (void*)newtuple;
     /* set up first-column key value */
-    stup->datum1 = index_getattr(newtuple, 1, RelationGetDescr(state->indexRel), &stup->isnull1);
+    set_index_leading_key(state, stup);
 }
 
 static void writetup_index(Tuplesortstate* state, int tapenum, SortTuple* stup)
@@ -3717,11 +4176,18 @@ static void readtup_index(Tuplesortstate* state, SortTuple* stup, int tapenum, u
 static void reversedirection_index_btree(Tuplesortstate* state)
 {
     ScanKey scanKey = state->indexScanKey;
+    SortSupport sortKey = state->sortKeys;
     int nkey;
 
     for (nkey = 0; nkey < state->nKeys; nkey++, scanKey++) {
         scanKey->sk_flags ^= (SK_BT_DESC | SK_BT_NULLS_FIRST);
     }
+
+    /* the cluster sort only uses the scan keys */
+    for (nkey = 0; sortKey != NULL && nkey < state->nKeys; nkey++, sortKey++) {
+        sortKey->ssup_reverse = !sortKey->ssup_reverse;
+        sortKey->ssup_nulls_first = !sortKey->ssup_nulls_first;
+    }
 }
 
 static void reversedirection_index_hash(Tuplesortstate* state)
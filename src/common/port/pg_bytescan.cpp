@@ -0,0 +1,167 @@
+/* -------------------------------------------------------------------------
+ *
+ * pg_bytescan.cpp
+ *	  Skip the bytes of a buffer that are not in a small set of bytes.
+ *
+ * The vector versions compare 16 (SSE4.2, NEON) or 32 (AVX2) bytes per
+ * step against every byte of the set.  On x86 the version used is chosen
+ * on the first call, the same way as pg_comp_crc32c does.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ *
+ * IDENTIFICATION
+ *    src/common/port/pg_bytescan.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "c.h"
+
+#include "port/pg_bytescan.h"
+
+#ifdef __aarch64__
+#include <arm_neon.h>
+#else
+#include <immintrin.h>
+#endif
+
+/*
+ * Scalar version, also used for the tail bytes of the vector versions.
+ */
+size_t pg_skip_plain_bytes_scalar(const char* s, size_t len, const PgByteScanSet* set)
+{
+    for (size_t i = 0; i < len; i++) {
+        char c = s[i];
+
+        if (set->highbit && IS_HIGHBIT_SET(c))
+            return i;
+        for (int j = 0; j < set->nchars; j++) {
+            if (c == set->chars[j])
+                return i;
+        }
+    }
+    return len;
+}
+
+#ifdef __aarch64__
+
+/*
+ * NEON version.  NEON has no movemask, so the compare result is narrowed
+ * to four bits per byte to find the first hit.
+ */
+static size_t pg_skip_plain_bytes_neon(const char* s, size_t len, const PgByteScanSet* set)
+{
+    uint8x16_t needles[PG_BYTESCAN_MAX_CHARS];
+    const uint8x16_t highbits = vdupq_n_u8(set->highbit ? 0x80 : 0);
+    size_t i = 0;
+
+    for (int j = 0; j < set->nchars; j++) {
+        needles[j] = vdupq_n_u8((uint8)set->chars[j]);
+    }
+
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t hay = vld1q_u8((const uint8*)(s + i));
+        uint8x16_t hit = vtstq_u8(hay, highbits);
+        uint64 mask;
+
+        for (int j = 0; j < set->nchars; j++) {
+            hit = vorrq_u8(hit, vceqq_u8(hay, needles[j]));
+        }
+        mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+        if (mask != 0) {
+            return i + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+
+    return i + pg_skip_plain_bytes_scalar(s + i, len - i, set);
+}
+
+PgSkipPlainBytesFunc pg_skip_plain_bytes = pg_skip_plain_bytes_neon;
+
+#else
+
+/*
+ * SSE4.2 version, PCMPESTRI finds the first byte equal to any of the set.
+ */
+__attribute__((target("sse4.2"))) static size_t pg_skip_plain_bytes_sse42(
+    const char* s, size_t len, const PgByteScanSet* set)
+{
+    const __m128i needles = _mm_loadl_epi64((const __m128i*)set->chars);
+    const int nchars = set->nchars;
+    size_t i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i hay = _mm_loadu_si128((const __m128i*)(s + i));
+        int first = _mm_cmpestri(
+            needles, nchars, hay, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+
+        if (set->highbit) {
+            int highmask = _mm_movemask_epi8(hay);
+
+            if (highmask != 0) {
+                first = Min(first, __builtin_ctz((unsigned int)highmask));
+            }
+        }
+        if (first < 16) {
+            return i + first;
+        }
+    }
+
+    return i + pg_skip_plain_bytes_scalar(s + i, len - i, set);
+}
+
+/*
+ * AVX2 version, compares 32 bytes with every byte of the set.
+ */
+__attribute__((target("avx2"))) static size_t pg_skip_plain_bytes_avx2(
+    const char* s, size_t len, const PgByteScanSet* set)
+{
+    __m256i needles[PG_BYTESCAN_MAX_CHARS];
+    size_t i = 0;
+
+    for (int j = 0; j < set->nchars; j++) {
+        needles[j] = _mm256_set1_epi8(set->chars[j]);
+    }
+
+    for (; i + 32 <= len; i += 32) {
+        __m256i hay = _mm256_loadu_si256((const __m256i*)(s + i));
+        __m256i hit = _mm256_setzero_si256();
+        unsigned int mask;
+
+        for (int j = 0; j < set->nchars; j++) {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(hay, needles[j]));
+        }
+        mask = (unsigned int)_mm256_movemask_epi8(hit);
+        if (set->highbit) {
+            mask |= (unsigned int)_mm256_movemask_epi8(hay);
+        }
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + pg_skip_plain_bytes_scalar(s + i, len - i, set);
+}
+
+/*
+ * This gets called on the first call. It replaces the function pointer
+ * so that subsequent calls are routed directly to the chosen implementation.
+ */
+static size_t pg_skip_plain_bytes_choose(const char* s, size_t len, const PgByteScanSet* set)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        pg_skip_plain_bytes = pg_skip_plain_bytes_avx2;
+    } else if (__builtin_cpu_supports("sse4.2")) {
+        pg_skip_plain_bytes = pg_skip_plain_bytes_sse42;
+    } else {
+        pg_skip_plain_bytes = pg_skip_plain_bytes_scalar;
+    }
+
+    return pg_skip_plain_bytes(s, len, set);
+}
+
+PgSkipPlainBytesFunc pg_skip_plain_bytes = pg_skip_plain_bytes_choose;
+
+#endif /* __aarch64__ */
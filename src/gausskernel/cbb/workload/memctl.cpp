@@ -341,6 +341,7 @@ static bool IsMemoryIntensiveOperator(Node* node)
         case T_Material:
         case T_VecMaterial:
         case T_Sort:
+        case T_IncrementalSort:
         case T_HashJoin:
         case T_VecHashJoin:
         case T_VecSort:
@@ -3145,6 +3146,7 @@ static void AssignMemOpConsumption(MethodPlanWalkerContext* context, Plan* node)
             ASS_AND_ADJ_MEM(node->lefttree->operatorMaxMem);
         } break;
         case T_Sort:
+        case T_IncrementalSort:
         case T_VecSort: {
             Sort* plan = (Sort*)node;
             ASS_AND_ADJ_MEM(node->lefttree->operatorMaxMem);
@@ -3395,6 +3397,7 @@ static void AdjustMemOpConsumption(MethodPlanWalkerContext* context, Plan* node)
             ADJ_OP_MEM;
         } break;
         case T_Sort:
+        case T_IncrementalSort:
         case T_VecSort: {
             Sort* plan = (Sort*)node;
             ADJ_OP_MEM;
@@ -3558,6 +3561,7 @@ static void CalcDecreaseRegressCost(OpMemItem* item, int dMem)
             PLAN_REGRESSION_COST;
         } break;
         case T_Sort:
+        case T_IncrementalSort:
         case T_VecSort: {
             Sort* plan = (Sort*)node;
             PLAN_REGRESSION_COST;
@@ -56,6 +56,7 @@
 #include "pgxc/execRemote.h"
 #include "pgxc/locator.h"
 #include "pgxc/remotecopy.h"
+#include "port/pg_bytescan.h"
 #include "nodes/nodes.h"
 #include "foreign/fdwapi.h"
 #include "pgxc/poolmgr.h"
@@ -5823,6 +5824,7 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
     bool last_was_esc = false;
     char quotec = '\0';
     char escapec = '\0';
+    PgByteScanSet special;
 
     if (csv_mode) {
         quotec = cstate->quote[0];
@@ -5833,6 +5835,23 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
         }
     }
 
+    /*
+     * The bytes the loop below has to look at one by one, any other byte is
+     * just part of the line.  escapec is added even when it is '\0', since
+     * the loop compares it with the data all the same.
+     */
+    pg_bytescan_init(&special, cstate->encoding_embeds_ascii);
+    pg_bytescan_add(&special, '\n');
+    pg_bytescan_add(&special, '\r');
+    pg_bytescan_add(&special, '\\');
+    if (csv_mode) {
+        pg_bytescan_add(&special, quotec);
+        pg_bytescan_add(&special, escapec);
+    }
+    if (cstate->eol_type == EOL_UD) {
+        pg_bytescan_add(&special, cstate->eol[0]);
+    }
+
     mblen_str[1] = '\0';
 
     /*
@@ -5862,6 +5881,7 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
 
     for (;;) {
         int prev_raw_ptr;
+        int nplain;
         char c;
 
         /*
@@ -5897,6 +5917,20 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
             need_data = false;
         }
 
+        /*
+         * Step over the plain bytes in one go.  None of them is an escape,
+         * so this has the same effect as taking them one at a time.
+         */
+        nplain = (int)pg_skip_plain_bytes(copy_raw_buf + raw_buf_ptr, copy_buf_len - raw_buf_ptr, &special);
+        if (nplain > 0) {
+            raw_buf_ptr += nplain;
+            first_char_in_line = false;
+            last_was_esc = false;
+            if (raw_buf_ptr >= copy_buf_len) {
+                continue;
+            }
+        }
+
         /* OK to fetch a character */
         prev_raw_ptr = raw_buf_ptr;
         c = copy_raw_buf[raw_buf_ptr++];
@@ -161,6 +161,7 @@ static void show_sort_info(SortState* sortstate, ExplainState* es);
 static void show_hash_info(HashState* hashstate, ExplainState* es);
 static void show_vechash_info(VecHashJoinState* hashstate, ExplainState* es);
 static void show_instrumentation_count(const char* qlabel, int which, const PlanState* planstate, ExplainState* es);
+static void show_late_read_info(const PlanState* planstate, ExplainState* es);
 static void show_removed_rows(int which, const PlanState* planstate, int idx, int smpIdx, int* removeRows);
 static void show_foreignscan_info(ForeignScanState* fsstate, ExplainState* es);
 static void show_dfs_block_info(PlanState* planstate, ExplainState* es);
@@ -230,6 +231,9 @@ static void get_oper_time(ExplainState* es, PlanState* planstate, const Instrume
 static void show_peak_memory(ExplainState* es, int plan_size);
 static bool get_execute_mode(const ExplainState* es, int idx);
 static void show_setop_info(SetOpState* setopstate, ExplainState* es);
+static void show_memoize_info(MemoizeState* mstate, ExplainState* es);
+static void show_incremental_sort_keys(IncrementalSortState* incrsortstate, List* ancestors, ExplainState* es);
+static void show_incremental_sort_info(IncrementalSortState* incrsortstate, ExplainState* es);
 static void show_grouping_sets(PlanState* planstate, Agg* agg, List* ancestors, ExplainState* es);
 static void show_group_keys(GroupState* gstate, List* ancestors, ExplainState* es);
 static void show_sort_group_keys(PlanState* planstate, const char* qlabel, int nkeys, const AttrNumber* keycols,
@@ -2485,6 +2489,8 @@ static void ExplainNode(
             show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 1, planstate, es);
+            if (IsA(plan, CStoreScan))
+                show_late_read_info(planstate, es);
             show_llvm_info(planstate, es);
             break;
         case T_DfsScan: {
@@ -2665,6 +2671,10 @@ static void ExplainNode(
             show_sort_info((SortState*)planstate, es);
             show_llvm_info(planstate, es);
             break;
+        case T_IncrementalSort:
+            show_incremental_sort_keys((IncrementalSortState*)planstate, ancestors, es);
+            show_incremental_sort_info((IncrementalSortState*)planstate, es);
+            break;
         case T_MergeAppend:
             show_merge_append_keys((MergeAppendState*)planstate, ancestors, es);
             break;
@@ -2691,6 +2701,9 @@ static void ExplainNode(
         case T_RecursiveUnion:
             show_recursive_info((RecursiveUnionState*)planstate, es);
             break;
+        case T_Memoize:
+            show_memoize_info((MemoizeState*)planstate, es);
+            break;
 
         default:
             break;
@@ -3056,6 +3069,7 @@ static void CalculateProcessedRows(
             break;
         case T_Agg:
         case T_Sort:
+        case T_IncrementalSort:
         case T_SetOp:
         case T_VecSetOp:
         case T_VecAgg:
@@ -3673,6 +3687,34 @@ static void show_sort_keys(SortState* sortstate, List* ancestors, ExplainState*
         es);
 }
 
+/*
+ * Likewise, for an IncrementalSort node, which also shows the presorted
+ * prefix of the sort keys.
+ */
+static void show_incremental_sort_keys(IncrementalSortState* incrsortstate, List* ancestors, ExplainState* es)
+{
+    IncrementalSort* plan = (IncrementalSort*)incrsortstate->ss.ps.plan;
+
+    show_sort_group_keys((PlanState*)incrsortstate,
+        "Sort Key",
+        plan->sort.numCols,
+        plan->sort.sortColIdx,
+        plan->sort.sortOperators,
+        plan->sort.collations,
+        plan->sort.nullsFirst,
+        ancestors,
+        es);
+    show_sort_group_keys((PlanState*)incrsortstate,
+        "Presorted Key",
+        plan->nPresortedCols,
+        plan->sort.sortColIdx,
+        plan->sort.sortOperators,
+        plan->sort.collations,
+        plan->sort.nullsFirst,
+        ancestors,
+        es);
+}
+
 /*
  * Likewise, for a MergeAppend node.
  */
@@ -4372,6 +4414,136 @@ static void show_setop_info(SetOpState* setopstate, ExplainState* es)
     }
 }
 
+/*
+ * @Description: Show the cache statistics of a memoize node. The
+ * 	counters of all datanodes are summed up.
+ * @in mstate: MemoizeState node.
+ * @in es: Explain state.
+ */
+static void show_memoize_info(MemoizeState* mstate, ExplainState* es)
+{
+    PlanState* planstate = (PlanState*)mstate;
+    MemoizeInfo info = {0, 0, 0, 0, 0};
+
+    if (!es->analyze)
+        return;
+
+    if (planstate->plan->plan_node_id > 0 && u_sess->instr_cxt.global_instr &&
+        u_sess->instr_cxt.global_instr->isFromDataNode(planstate->plan->plan_node_id)) {
+        for (int i = 0; i < u_sess->instr_cxt.global_instr->getInstruNodeNum(); i++) {
+            Instrumentation* instr = u_sess->instr_cxt.global_instr->getInstrSlot(i, planstate->plan->plan_node_id);
+            if (instr == NULL)
+                continue;
+            info.hits += instr->memoizeinfo.hits;
+            info.misses += instr->memoizeinfo.misses;
+            info.evictions += instr->memoizeinfo.evictions;
+            info.overflows += instr->memoizeinfo.overflows;
+            info.spacePeak = Max(info.spacePeak, instr->memoizeinfo.spacePeak);
+        }
+    } else {
+        info.hits = mstate->hits;
+        info.misses = mstate->misses;
+        info.evictions = mstate->evictions;
+        info.overflows = mstate->overflows;
+        info.spacePeak = mstate->mem_peak;
+    }
+
+    if (info.hits == 0 && info.misses == 0)
+        return;
+
+    long peak_kb = (long)((info.spacePeak + 1023) / 1024);
+    if (es->format != EXPLAIN_FORMAT_TEXT) {
+        ExplainPropertyLong("Cache Hits", (long)info.hits, es);
+        ExplainPropertyLong("Cache Misses", (long)info.misses, es);
+        ExplainPropertyLong("Cache Evictions", (long)info.evictions, es);
+        ExplainPropertyLong("Cache Overflows", (long)info.overflows, es);
+        ExplainPropertyLong("Peak Memory Usage", peak_kb, es);
+    } else {
+        StringInfo str = es->str;
+        if (t_thrd.explain_cxt.explain_perf_mode != EXPLAIN_NORMAL && es->planinfo != NULL &&
+            es->planinfo->m_staticInfo != NULL) {
+            es->planinfo->m_staticInfo->set_plan_name<true, true>();
+            str = es->planinfo->m_staticInfo->info_str;
+        } else {
+            appendStringInfoSpaces(str, es->indent * 2);
+        }
+        appendStringInfo(str,
+            "Hits: %ld  Misses: %ld  Evictions: %ld  Overflows: %ld  Memory Usage: %ldkB\n",
+            (long)info.hits,
+            (long)info.misses,
+            (long)info.evictions,
+            (long)info.overflows,
+            peak_kb);
+    }
+}
+
+/*
+ * @Description: Show the number of batches an incremental sort node
+ * 	sorted, with the method and space of its largest batch. The batches
+ * 	of all datanodes are summed up.
+ * @in incrsortstate: IncrementalSortState node.
+ * @in es: Explain state.
+ */
+static void show_incremental_sort_info(IncrementalSortState* incrsortstate, ExplainState* es)
+{
+    PlanState* planstate = (PlanState*)incrsortstate;
+    int64 groups = 0;
+    int sortMethodId = 0;
+    int spaceTypeId = 0;
+    long spaceUsed = 0;
+
+    if (!es->analyze)
+        return;
+
+    if (planstate->plan->plan_node_id > 0 && u_sess->instr_cxt.global_instr &&
+        u_sess->instr_cxt.global_instr->isFromDataNode(planstate->plan->plan_node_id)) {
+        for (int i = 0; i < u_sess->instr_cxt.global_instr->getInstruNodeNum(); i++) {
+            Instrumentation* instr = u_sess->instr_cxt.global_instr->getInstrSlot(i, planstate->plan->plan_node_id);
+            if (instr == NULL || instr->sorthashinfo.sortMethodId < (int)HEAPSORT ||
+                instr->sorthashinfo.sortMethodId > (int)STILLINPROGRESS)
+                continue;
+            groups += instr->sorthashinfo.sort_groups;
+            if (instr->sorthashinfo.spaceUsed >= spaceUsed) {
+                sortMethodId = instr->sorthashinfo.sortMethodId;
+                spaceTypeId = instr->sorthashinfo.spaceTypeId;
+                spaceUsed = instr->sorthashinfo.spaceUsed;
+            }
+        }
+    } else {
+        groups = incrsortstate->groupsSorted;
+        sortMethodId = incrsortstate->sortMethodId;
+        spaceTypeId = incrsortstate->spaceTypeId;
+        spaceUsed = incrsortstate->maxSpaceUsed;
+    }
+
+    if (groups == 0)
+        return;
+
+    const char* sortMethod = sortmessage[sortMethodId].sortName;
+    const char* spaceType = (spaceTypeId == SORT_IN_DISK) ? "Disk" : "Memory";
+    if (es->format != EXPLAIN_FORMAT_TEXT) {
+        ExplainPropertyLong("Sort Groups", (long)groups, es);
+        ExplainPropertyText("Sort Method", sortMethod, es);
+        ExplainPropertyLong("Peak Sort Space Used", spaceUsed, es);
+        ExplainPropertyText("Sort Space Type", spaceType, es);
+    } else {
+        StringInfo str = es->str;
+        if (t_thrd.explain_cxt.explain_perf_mode != EXPLAIN_NORMAL && es->planinfo != NULL &&
+            es->planinfo->m_staticInfo != NULL) {
+            es->planinfo->m_staticInfo->set_plan_name<true, true>();
+            str = es->planinfo->m_staticInfo->info_str;
+        } else {
+            appendStringInfoSpaces(str, es->indent * 2);
+        }
+        appendStringInfo(str,
+            "Sort Groups: %ld  Sort Method: %s  Peak %s: %ldkB\n",
+            (long)groups,
+            sortMethod,
+            spaceType,
+            spaceUsed);
+    }
+}
+
 /*
  * @Description: Show hashagg build and probe time info
  * @in planstate: PlanState node.+ * @in es: Explain state.
@@ -7158,6 +7330,60 @@ static void show_instrumentation_count(const char* qlabel, int which, const Plan
     }
 }
 
+/*
+ * @Description: Show how many rows got their late read columns filled by a
+ *               column store scan, and how many were filtered by the qual before
+ *               that. Rows dropped by runtime filters are not counted here.
+ * @in planstate: plan state of the column store scan.
+ * @in es: explain state.
+ */
+static void show_late_read_info(const PlanState* planstate, ExplainState* es)
+{
+    uint64 read_rows = 0;
+    uint64 skip_rows = 0;
+    Instrumentation* instr = NULL;
+    int dop = planstate->plan->parallel_enabled ? u_sess->opt_cxt.query_dop : 1;
+
+    if (!es->analyze || !planstate->instrument)
+        return;
+
+    if (planstate->plan->plan_node_id > 0 && u_sess->instr_cxt.global_instr &&
+        u_sess->instr_cxt.global_instr->isFromDataNode(planstate->plan->plan_node_id)) {
+        for (int i = 0; i < u_sess->instr_cxt.global_instr->getInstruNodeNum(); i++) {
+            for (int j = 0; j < dop; j++) {
+                instr = u_sess->instr_cxt.global_instr->getInstrSlot(i, planstate->plan->plan_node_id, j);
+                if (instr != NULL && instr->nloops > 0) {
+                    read_rows += instr->rcInfo.m_lateReadRows;
+                    skip_rows += instr->rcInfo.m_lateSkipRows;
+                }
+            }
+        }
+    } else {
+        read_rows = planstate->instrument->rcInfo.m_lateReadRows;
+        skip_rows = planstate->instrument->rcInfo.m_lateSkipRows;
+    }
+
+    /* nothing to show when no column is late read */
+    if (read_rows == 0 && skip_rows == 0)
+        return;
+
+    if (t_thrd.explain_cxt.explain_perf_mode == EXPLAIN_NORMAL) {
+        if (es->format == EXPLAIN_FORMAT_TEXT) {
+            appendStringInfoSpaces(es->str, es->indent * 2);
+            appendStringInfo(es->str, "Late Read Rows: " UINT64_FORMAT "  Skipped By Qual: " UINT64_FORMAT "\n",
+                read_rows, skip_rows);
+        } else {
+            ExplainPropertyLong("Late Read Rows", (long)read_rows, es);
+            ExplainPropertyLong("Late Read Skipped By Qual", (long)skip_rows, es);
+        }
+    } else if (es->planinfo->m_detailInfo && es->format == EXPLAIN_FORMAT_TEXT) {
+        es->planinfo->m_detailInfo->set_plan_name<false, true>();
+        appendStringInfo(es->planinfo->m_detailInfo->info_str,
+            "Late Read Rows: " UINT64_FORMAT "  Skipped By Qual: " UINT64_FORMAT "\n",
+            read_rows, skip_rows);
+    }
+}
+
 /*
  * Show removed rows by filters.
  */
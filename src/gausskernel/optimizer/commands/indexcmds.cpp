@@ -23,6 +23,7 @@
 #include "catalog/catalog.h"
 #include "catalog/index.h"
 #include "catalog/indexing.h"
+#include "catalog/pg_am.h"
 #include "catalog/pg_constraint.h"
 #include "catalog/pg_opclass.h"
 #include "catalog/pg_opfamily.h"
@@ -331,6 +332,8 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
     HeapTuple tuple;
     Form_pg_am accessMethodForm;
     bool amcanorder = false;
+    bool amcanunique = false;
+    bool amcanmulticol = false;
     RegProcedure amoptions;
     Datum reloptions;
     int16* coloptions = NULL;
@@ -720,12 +723,25 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
     }
     accessMethodId = HeapTupleGetOid(tuple);
     accessMethodForm = (Form_pg_am)GETSTRUCT(tuple);
-    if (stmt->unique && !accessMethodForm->amcanunique)
+    amcanunique = accessMethodForm->amcanunique;
+    amcanmulticol = accessMethodForm->amcanmulticol;
+#ifdef ENABLE_MOT
+    /*
+     * MOT builds its own indexes, and its hash index hashes the whole key, so it
+     * can enforce uniqueness over any number of columns.
+     */
+    if (accessMethodId == HASH_AM_OID && rel->rd_rel->relkind == RELKIND_FOREIGN_TABLE &&
+        isMOTFromTblOid(relationId)) {
+        amcanunique = true;
+        amcanmulticol = true;
+    }
+#endif
+    if (stmt->unique && !amcanunique)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support unique indexes", accessMethodName)));
 
-    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol)
+    if (numberOfAttributes > 1 && !amcanmulticol)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support multicolumn indexes", accessMethodName)));
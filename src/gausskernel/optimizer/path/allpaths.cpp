@@ -4083,6 +4083,9 @@ static void print_path(PlannerInfo* root, Path* path, int indent)
         case T_Material:
             subpath = ((MaterialPath*)path)->subpath;
             break;
+        case T_Memoize:
+            subpath = ((MemoizePath*)path)->subpath;
+            break;
         case T_Unique:
             subpath = ((UniquePath*)path)->subpath;
             break;
@@ -74,6 +74,7 @@
 #include "executor/executor.h"
 #include "executor/hashjoin.h"
 #include "executor/nodeHash.h"
+#include "executor/nodeIncrementalSort.h"
 #include "miscadmin.h"
 #include "nodes/nodeFuncs.h"
 #include "optimizer/bucketpruning.h"
@@ -122,6 +123,8 @@ static int calc_distributekey_width(Path* path, int* width, bool vectorized, boo
 static Cost get_subqueryscan_stream_cost(Plan* subplan);
 static bool is_predpush_dest(PlannerInfo* root, Relids indexes);
 static bool enable_parametrized_path(PlannerInfo* root, RelOptInfo* baserel, Path* path);
+static void cost_memoize_rescan(
+    PlannerInfo* root, MemoizePath* mpath, Cost* rescan_startup_cost, Cost* rescan_total_cost);
 
 extern bool isExprSonicEnable(Expr* node);
 extern bool isAggrefSonicEnable(Oid aggfnoid);
@@ -2152,6 +2155,81 @@ void cost_sort(Path* path, List* pathkeys, Cost input_cost, double tuples, int w
             (g_instance.cost_cxt.disable_cost_enlarge_factor * g_instance.cost_cxt.disable_cost_enlarge_factor);
 }
 
+/*
+ * cost_incremental_sort
+ *	  Determines and returns the cost of sorting a relation incrementally,
+ *	  when the input is already sorted on the first presorted_keys pathkeys.
+ *
+ * The input is sorted in batches of equal presorted columns, so the startup
+ * cost only covers reading and sorting the first batch.  The number of
+ * batches is estimated from the distinct values of the presorted columns.
+ */
+void cost_incremental_sort(Path* path, PlannerInfo* root, List* pathkeys, int presorted_keys, Cost input_startup_cost,
+    Cost input_total_cost, double input_tuples, int width, Cost comparison_cost, int sort_mem)
+{
+    Cost startup_cost;
+    Cost run_cost;
+    Cost input_run_cost = input_total_cost - input_startup_cost;
+    double group_tuples;
+    double input_groups;
+    Cost group_startup_cost;
+    Cost group_run_cost;
+    Cost group_input_run_cost;
+    List* presorted_exprs = NIL;
+    ListCell* l = NULL;
+    int i = 0;
+    Path sort_path;
+
+    AssertEreport(presorted_keys > 0 && presorted_keys < list_length(pathkeys),
+        MOD_OPT,
+        "incremental sort needs a partially sorted input");
+
+    if (input_tuples < 2.0)
+        input_tuples = 2.0;
+
+    /* the first member of each equivalence class stands for the presorted column */
+    foreach (l, pathkeys) {
+        PathKey* key = (PathKey*)lfirst(l);
+        EquivalenceMember* member = (EquivalenceMember*)linitial(key->pk_eclass->ec_members);
+
+        if (i++ >= presorted_keys)
+            break;
+        presorted_exprs = lappend(presorted_exprs, member->em_expr);
+    }
+
+    input_groups = estimate_num_groups(root, presorted_exprs, input_tuples, 1);
+    list_free_ext(presorted_exprs);
+
+    /* small groups are merged into one batch by the executor */
+    input_groups = clamp_row_est(Min(input_groups, input_tuples / INCSORT_MIN_GROUP_SIZE));
+    group_tuples = input_tuples / input_groups;
+    group_input_run_cost = input_run_cost / input_groups;
+
+    /*
+     * Cost one batch as a full sort of the group.  Estimates of the number of
+     * groups are unreliable, so assume the groups are 50% larger to stay on
+     * the safe side against skew.
+     */
+    cost_sort(&sort_path, NIL, 0.0, 1.5 * group_tuples, width, comparison_cost, sort_mem, -1.0, false);
+    group_startup_cost = sort_path.startup_cost;
+    group_run_cost = sort_path.total_cost - sort_path.startup_cost;
+
+    /* the first batch has to be read and sorted before returning anything */
+    startup_cost = input_startup_cost + group_input_run_cost + group_startup_cost;
+
+    /* the remaining batches are read and sorted while the output is returned */
+    run_cost = group_run_cost + (group_run_cost + group_startup_cost) * (input_groups - 1) +
+               group_input_run_cost * (input_groups - 1);
+
+    /* every input tuple is compared with the pivot, and every batch starts a new tuplesort */
+    run_cost += u_sess->attr.attr_sql.cpu_tuple_cost * input_tuples;
+    run_cost += 2.0 * u_sess->attr.attr_sql.cpu_tuple_cost * input_groups;
+
+    path->startup_cost = startup_cost;
+    path->total_cost = startup_cost + run_cost;
+    path->stream_cost = 0;
+}
+
 /*
  * compute_sort_disk_cost
  *	compute disk spill cost of sort operator
@@ -4388,6 +4466,9 @@ void cost_rescan(PlannerInfo* root, Path* path, Cost* rescan_startup_cost, /* ou
                 root->glob->vectorized,
                 dop);
         } break;
+        case T_Memoize:
+            cost_memoize_rescan(root, (MemoizePath*)path, rescan_startup_cost, rescan_total_cost);
+            break;
         default:
             *rescan_startup_cost = path->startup_cost;
             *rescan_total_cost = path->total_cost;
@@ -4395,6 +4476,74 @@ void cost_rescan(PlannerInfo* root, Path* path, Cost* rescan_startup_cost, /* ou
     }
 }
 
+/*
+ * cost_memoize_rescan
+ *	  Estimate the average cost of one rescan of a memoize node.
+ *
+ * The number of distinct parameter values among the calls and the number
+ * of entries that fit in work_mem give the expected hit ratio.  A hit only
+ * costs reading the cached tuples, a miss costs a full rescan of the
+ * subpath plus storing its tuples.  The estimated number of cache entries
+ * is saved in the path, it sizes the hash table at execution.
+ */
+static void cost_memoize_rescan(
+    PlannerInfo* root, MemoizePath* mpath, Cost* rescan_startup_cost, Cost* rescan_total_cost)
+{
+    Path* subpath = mpath->subpath;
+    double tuples = PATH_LOCAL_ROWS(subpath);
+    double calls = Max(mpath->calls, 1.0);
+    int nkeys = list_length(mpath->param_exprs);
+    double work_mem_bytes = (double)u_sess->opt_cxt.op_work_mem * 1024.0;
+    double entry_bytes;
+    double cache_entries;
+    double ndistinct;
+    double hit_ratio;
+    double evict_ratio;
+    Cost sub_startup_cost;
+    Cost sub_total_cost;
+    Cost startup_cost;
+    Cost total_cost;
+
+    /* the subpath is rescanned on a miss, which may itself be cheaper than a first scan */
+    cost_rescan(root, subpath, &sub_startup_cost, &sub_total_cost, NULL);
+
+    entry_bytes = relation_byte_size(tuples, subpath->parent->width, false, true, false) +
+                  relation_byte_size(1, (int)(nkeys * sizeof(Datum)), false, true, false);
+    cache_entries = Max(floor(work_mem_bytes / Max(entry_bytes, 1.0)), 1.0);
+
+    ndistinct = estimate_num_groups(
+        root, mpath->param_exprs, calls, ng_get_dest_num_data_nodes(root, subpath->parent), STATS_TYPE_LOCAL);
+    if (ndistinct <= 0 || ndistinct > calls)
+        ndistinct = calls;
+
+    mpath->est_entries = Min(ndistinct, cache_entries);
+
+    /*
+     * The first call of each distinct key misses.  When not all of them fit
+     * in the cache, only the fraction that stays cached can hit later on.
+     */
+    hit_ratio = ((calls - ndistinct) / calls) * (cache_entries / Max(ndistinct, cache_entries));
+    hit_ratio = Max(hit_ratio, 0.0);
+    evict_ratio = 1.0 - Min(cache_entries, ndistinct) / ndistinct;
+
+    startup_cost = sub_startup_cost * (1.0 - hit_ratio);
+    total_cost = sub_total_cost * (1.0 - hit_ratio);
+
+    /* building the cache key and the hash lookup */
+    startup_cost += u_sess->attr.attr_sql.cpu_operator_cost * nkeys + u_sess->attr.attr_sql.cpu_tuple_cost;
+    total_cost += u_sess->attr.attr_sql.cpu_operator_cost * nkeys + u_sess->attr.attr_sql.cpu_tuple_cost;
+
+    /* returning the tuples from the cache, and storing them on a miss */
+    total_cost += u_sess->attr.attr_sql.cpu_tuple_cost * tuples * hit_ratio;
+    total_cost += u_sess->attr.attr_sql.cpu_operator_cost * tuples * (1.0 - hit_ratio);
+
+    /* removing evicted entries */
+    total_cost += u_sess->attr.attr_sql.cpu_tuple_cost * evict_ratio;
+
+    *rescan_startup_cost = startup_cost;
+    *rescan_total_cost = Max(total_cost, startup_cost);
+}
+
 /*
  * cost_rescan_material
  *	Calculate rescan cost of the materialize node
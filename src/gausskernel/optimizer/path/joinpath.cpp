@@ -30,6 +30,7 @@
 #include "optimizer/paths.h"
 #include "optimizer/restrictinfo.h"
 #include "optimizer/streampath.h"
+#include "optimizer/var.h"
 #include "parser/parse_hint.h"
 #include "utils/guc.h"
 #include "utils/lsyscache.h"
@@ -39,6 +40,7 @@
 #include "utils/rel_gs.h"
 #include "utils/selfuncs.h"
 #include "utils/syscache.h"
+#include "utils/typcache.h"
 #include "optimizer/streamplan.h"
 #include "pgxc/pgxc.h"
 #include "parser/parsetree.h"
@@ -52,6 +54,8 @@ static void sort_inner_and_outer(PlannerInfo* root, RelOptInfo* joinrel, RelOptI
 static void match_unsorted_outer(PlannerInfo* root, RelOptInfo* joinrel, RelOptInfo* outerrel, RelOptInfo* innerrel,
     List* restrictlist, List* mergeclause_list, JoinType jointype, SpecialJoinInfo* sjinfo,
     SemiAntiJoinFactors* semifactors, Relids param_source_rels);
+static Path* get_memoize_path(
+    PlannerInfo* root, RelOptInfo* innerrel, RelOptInfo* outerrel, Path* inner_path, Path* outer_path, JoinType jointype);
 static void hash_inner_and_outer(PlannerInfo* root, RelOptInfo* joinrel, RelOptInfo* outerrel, RelOptInfo* innerrel,
     List* restrictlist, JoinType jointype, SpecialJoinInfo* sjinfo, SemiAntiJoinFactors* semifactors,
     Relids param_source_rels);
@@ -1140,6 +1144,123 @@ static void sort_inner_and_outer(PlannerInfo* root, RelOptInfo* joinrel, RelOptI
         pfree_ext(join_used);
 }
 
+/*
+ * get_memoize_path
+ *	  If possible, make a path caching the results of the parameterized
+ *	  'inner_path' for the nestloop with 'outer_path'.  Return NULL if
+ *	  memoize isn't enabled or can't be used for this pair of paths.
+ *
+ * The cache key is made of the outer side of the clauses the inner path is
+ * parameterized by, plus the lateral references of the inner rel.  Every
+ * parameter the inner side gets from the outer rel must be part of the key,
+ * otherwise the cache would have to be flushed on each rescan.  All keys must
+ * be hashable, so that equal parameter values can share one cache entry.
+ */
+static Path* get_memoize_path(
+    PlannerInfo* root, RelOptInfo* innerrel, RelOptInfo* outerrel, Path* inner_path, Path* outer_path, JoinType jointype)
+{
+    List* param_exprs = NIL;
+    List* hash_operators = NIL;
+    List* ppi_clauses = NIL;
+    ListCell* lc = NULL;
+    bool binary_mode = false;
+
+    if (!u_sess->attr.attr_sql.enable_memoize)
+        return NULL;
+
+    /*
+     * Semi and anti joins stop reading the inner side after the first match,
+     * so the cache would hardly ever be completed.
+     */
+    if (jointype != JOIN_INNER && jointype != JOIN_LEFT)
+        return NULL;
+
+    /* nothing can be reused when the inner side is scanned once */
+    if (PATH_LOCAL_ROWS(outer_path) < 2)
+        return NULL;
+
+    if (inner_path->param_info != NULL)
+        ppi_clauses = inner_path->param_info->ppi_clauses;
+    if (ppi_clauses == NIL && innerrel->lateral_vars == NIL)
+        return NULL;
+    if (!bms_is_subset(PATH_REQ_OUTER(inner_path), outerrel->relids))
+        return NULL;
+    if (inner_path->pathtype == T_Material || inner_path->pathtype == T_Memoize)
+        return NULL;
+
+    /* volatile quals may give different results for the same parameters */
+    foreach (lc, innerrel->baserestrictinfo) {
+        RestrictInfo* rinfo = (RestrictInfo*)lfirst(lc);
+
+        if (contain_volatile_functions((Node*)rinfo->clause))
+            return NULL;
+    }
+
+    foreach (lc, ppi_clauses) {
+        RestrictInfo* rinfo = (RestrictInfo*)lfirst(lc);
+        OpExpr* opexpr = NULL;
+        Node* expr = NULL;
+        Oid lefttype = InvalidOid;
+        Oid righttype = InvalidOid;
+
+        if (!IsA(rinfo->clause, OpExpr) || list_length(((OpExpr*)rinfo->clause)->args) != 2 ||
+            contain_volatile_functions((Node*)rinfo->clause))
+            return NULL;
+        opexpr = (OpExpr*)rinfo->clause;
+
+        if (bms_is_subset(rinfo->left_relids, outerrel->relids) &&
+            bms_is_subset(rinfo->right_relids, innerrel->relids))
+            expr = (Node*)linitial(opexpr->args);
+        else if (bms_is_subset(rinfo->left_relids, innerrel->relids) &&
+                 bms_is_subset(rinfo->right_relids, outerrel->relids))
+            expr = (Node*)lsecond(opexpr->args);
+        else
+            return NULL;
+
+        /*
+         * Entries are matched with the clause's own operator, so that the cache
+         * agrees with the inner side about which values are equal.  The cached
+         * keys are all of the outer type, so the operator has to take that type
+         * on both sides.
+         */
+        op_input_types(opexpr->opno, &lefttype, &righttype);
+        if (lefttype != exprType(expr) || righttype != exprType(expr) ||
+            !op_hashjoinable(opexpr->opno, exprType(expr)))
+            return NULL;
+
+        param_exprs = lappend(param_exprs, expr);
+        hash_operators = lappend_oid(hash_operators, opexpr->opno);
+    }
+
+    /*
+     * Lateral references are parameters of the inner side as well.  They come
+     * without an operator, and the inner side may use them in ways the equality
+     * of their type does not cover, e.g. numeric 1.0 and 1.00 are equal but
+     * print differently.  So the cache then matches all of its keys by their
+     * binary image.
+     */
+    foreach (lc, innerrel->lateral_vars) {
+        Node* expr = (Node*)lfirst(lc);
+        Relids relids = pull_varnos(expr);
+        TypeCacheEntry* typentry = NULL;
+
+        if (!bms_is_subset(relids, outerrel->relids))
+            return NULL;
+
+        typentry = lookup_type_cache(exprType(expr), TYPECACHE_EQ_OPR | TYPECACHE_HASH_PROC);
+        if (!OidIsValid(typentry->eq_opr) || !OidIsValid(typentry->hash_proc) ||
+            !op_hashjoinable(typentry->eq_opr, exprType(expr)))
+            return NULL;
+
+        param_exprs = lappend(param_exprs, expr);
+        hash_operators = lappend_oid(hash_operators, typentry->eq_opr);
+        binary_mode = true;
+    }
+
+    return (Path*)create_memoize_path(root, innerrel, inner_path, param_exprs, hash_operators, binary_mode,
+        PATH_LOCAL_ROWS(outer_path));
+}
+
 /*
  * match_unsorted_outer
  *	  Creates possible join paths for processing a single join relation
@@ -1352,6 +1473,7 @@ static void match_unsorted_outer(PlannerInfo* root, RelOptInfo* joinrel, RelOptI
 
                     foreach (llc2, all_paths) {
                         Path* innerpath = (Path*)lfirst(llc2);
+                        Path* mpath = NULL;
 
                         try_nestloop_path(root,
                             joinrel,
@@ -1364,6 +1486,22 @@ static void match_unsorted_outer(PlannerInfo* root, RelOptInfo* joinrel, RelOptI
                             innerpath,
                             restrictlist,
                             merge_pathkeys);
+
+                        /* Also consider caching the results of a parameterized inner path */
+                        if (PATH_PARAM_BY_REL(innerpath, outerrel))
+                            mpath = get_memoize_path(root, innerrel, outerrel, innerpath, outerpath, jointype);
+                        if (mpath != NULL)
+                            try_nestloop_path(root,
+                                joinrel,
+                                jointype,
+                                save_jointype,
+                                sjinfo,
+                                semifactors,
+                                param_source_rels,
+                                outerpath,
+                                mpath,
+                                restrictlist,
+                                merge_pathkeys);
                     }
 
                     list_free_ext(all_paths);
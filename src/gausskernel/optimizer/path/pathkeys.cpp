@@ -394,6 +394,35 @@ bool pathkeys_contained_in(List* keys1, List* keys2)
     return false;
 }
 
+/*
+ * pathkeys_count_contained_in
+ *	  Same as pathkeys_contained_in, but also sets *n_common to the length
+ *	  of the longest common prefix of keys1 and keys2.  An incremental sort
+ *	  can make use of the prefix when keys2 is not sorted well enough.
+ */
+bool pathkeys_count_contained_in(List* keys1, List* keys2, int* n_common)
+{
+    int n = 0;
+    ListCell* key1 = NULL;
+    ListCell* key2 = NULL;
+
+    /* as in compare_pathkeys, canonical pathkeys can be compared by pointer */
+    if (keys1 == keys2) {
+        *n_common = list_length(keys1);
+        return true;
+    }
+
+    forboth(key1, keys1, key2, keys2)
+    {
+        if (lfirst(key1) != lfirst(key2))
+            break;
+        n++;
+    }
+
+    *n_common = n;
+    return (key1 == NULL);
+}
+
 /*
  * get_cheapest_path_for_pathkeys
  *	  Find the cheapest path (according to the specified criterion) that
@@ -89,6 +89,7 @@ static Plan* create_merge_append_plan(PlannerInfo* root, MergeAppendPath* best_p
 static BaseResult* create_result_plan(PlannerInfo* root, ResultPath* best_path);
 static void adjust_scan_targetlist(ResultPath* best_path, Plan* subplan);
 static Material* create_material_plan(PlannerInfo* root, MaterialPath* best_path);
+static Memoize* create_memoize_plan(PlannerInfo* root, MemoizePath* best_path);
 static Plan* create_unique_plan(PlannerInfo* root, UniquePath* best_path);
 static SeqScan* create_seqscan_plan(PlannerInfo* root, Path* best_path, List* tlist, List* scan_clauses);
 static CStoreScan* create_cstorescan_plan(PlannerInfo* root, Path* best_path, List* tlist, List* scan_clauses);
@@ -378,6 +379,9 @@ static Plan* create_plan_recurse(PlannerInfo* root, Path* best_path)
         case T_Material:
             plan = (Plan*)create_material_plan(root, (MaterialPath*)best_path);
             break;
+        case T_Memoize:
+            plan = (Plan*)create_memoize_plan(root, (MemoizePath*)best_path);
+            break;
         case T_Unique:
             plan = create_unique_plan(root, (UniquePath*)best_path);
             break;
@@ -1448,6 +1452,54 @@ static Material* create_material_plan(PlannerInfo* root, MaterialPath* best_path
     return plan;
 }
 
+/*
+ * create_memoize_plan
+ *	  Create a Memoize plan for 'best_path' and (recursively) plans
+ *	  for its subpaths.
+ *
+ *	  Returns a Plan node.
+ */
+static Memoize* create_memoize_plan(PlannerInfo* root, MemoizePath* best_path)
+{
+    Memoize* plan = makeNode(Memoize);
+    Plan* subplan = NULL;
+    ListCell* lc = NULL;
+    int i = 0;
+
+    subplan = create_plan_recurse(root, best_path->subpath);
+
+    /* We don't want any excess columns in the cached tuples */
+    disuse_physical_tlist(subplan, best_path->subpath);
+
+    plan->plan.targetlist = subplan->targetlist;
+    plan->plan.qual = NIL;
+    plan->plan.lefttree = subplan;
+    plan->plan.righttree = NULL;
+    plan->plan.dop = subplan->dop;
+    plan->plan.hasUniqueResults = subplan->hasUniqueResults;
+#ifdef STREAMPLAN
+    inherit_plan_locator_info(&plan->plan, subplan);
+#endif
+
+    /* the outer relation's Vars in the cache keys become nestloop params */
+    plan->param_exprs = (List*)replace_nestloop_params(root, (Node*)best_path->param_exprs);
+    plan->numKeys = list_length(best_path->param_exprs);
+    plan->hashOperators = (Oid*)palloc(plan->numKeys * sizeof(Oid));
+    foreach (lc, best_path->hash_operators) {
+        plan->hashOperators[i++] = lfirst_oid(lc);
+    }
+    plan->binary_mode = best_path->binary_mode;
+    plan->est_entries = best_path->est_entries;
+
+    copy_path_costsize(&plan->plan, (Path*)best_path);
+
+    if (root->isPartIteratorPlanning) {
+        plan->plan.ispwj = true;
+    }
+
+    return plan;
+}
+
 /*
  * create_unique_plan
  *	  Create a Unique plan for 'best_path' and (recursively) plans
@@ -3315,9 +3367,11 @@ static void ModifyWorktableWtParam(Node* planNode, int oldWtParam, int newWtPara
         case T_Limit:
         case T_LockRows:
         case T_Material:
+        case T_Memoize:
         case T_PartIterator:
         case T_SetOp:
         case T_Sort:
+        case T_IncrementalSort:
         case T_Stream:
         case T_Unique:
         case T_WindowAgg: {
@@ -4421,6 +4475,7 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
     }
 
     switch (nodeTag(plan)) {
+        case T_CStoreScan:
         case T_ForeignScan:
         case T_DfsScan: {
             if (IsA(plan, ForeignScan)) {
@@ -4432,6 +4487,10 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
                 }
             }
 
+            if (IsA(plan, CStoreScan) ? !u_sess->attr.attr_sql.enable_cstore_bloom_filter : !IS_STREAM_PLAN) {
+                return;
+            }
+
             /* Find equal expr from scan plan targetlist, if found append it to scan var_list. */
             if (find_var_from_targetlist(expr, plan->targetlist)) {
                 if (context->add_index) {
@@ -4485,6 +4544,7 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
         }
         case T_Material:
         case T_Sort:
+        case T_IncrementalSort:
         case T_Unique:
         case T_SetOp:
         case T_Limit:
@@ -4809,7 +4869,13 @@ static HashJoin* create_hashjoin_plan(PlannerInfo* root, HashPath* best_path, Pl
 
     join_plan->isSonicHash = u_sess->attr.attr_sql.enable_sonic_hashjoin && isSonicHashJoinEnable(join_plan);
 
-    if (IS_STREAM_PLAN && u_sess->attr.attr_sql.enable_bloom_filter) {
+    /*
+     * Column store scans apply runtime bloom filters in any plan when
+     * enable_cstore_bloom_filter is set, hdfs and foreign scans only get
+     * them in stream plans.
+     */
+    if (u_sess->attr.attr_sql.enable_bloom_filter &&
+        (IS_STREAM_PLAN || u_sess->attr.attr_sql.enable_cstore_bloom_filter)) {
         left_relids = best_path->jpath.outerjoinpath->parent->relids;
         set_bloomfilter(root, left_relids, join_plan);
     }
@@ -7217,6 +7283,50 @@ Sort* make_sort_from_pathkeys(PlannerInfo* root, Plan* lefttree, List* pathkeys,
     return make_sort(root, lefttree, numsortkeys, sortColIdx, sortOperators, collations, nullsFirst, limit_tuples);
 }
 
+/*
+ * make_incrementalsort_from_pathkeys
+ *	  Create incremental sort plan to sort according to given pathkeys
+ *
+ *	  'lefttree' is the node which yields input tuples, already sorted on
+ *				the first 'presorted_keys' of the pathkeys
+ *	  'pathkeys' is the list of pathkeys by which the result is to be sorted
+ *	  'limit_tuples' is the bound on the number of output tuples;
+ *				-1 if no bound
+ */
+IncrementalSort* make_incrementalsort_from_pathkeys(
+    PlannerInfo* root, Plan* lefttree, List* pathkeys, int presorted_keys, double limit_tuples)
+{
+    IncrementalSort* node = makeNode(IncrementalSort);
+    Sort* sort = make_sort_from_pathkeys(root, lefttree, pathkeys, limit_tuples, true);
+    Plan* plan = &node->sort.plan;
+    Path sort_path; /* dummy for result of cost_incremental_sort */
+    int width;
+
+    /* the Sort fields stay the same, only the node type and costs differ */
+    node->sort = *sort;
+    plan->type = T_IncrementalSort;
+    node->nPresortedCols = presorted_keys;
+    pfree_ext(sort);
+
+    /* prepare_sort_from_pathkeys may have put a Result above lefttree */
+    lefttree = plan->lefttree;
+    width = get_plan_actual_total_width(lefttree, root->glob->vectorized, OP_SORT);
+    cost_incremental_sort(&sort_path,
+        root,
+        pathkeys,
+        presorted_keys,
+        lefttree->startup_cost,
+        lefttree->total_cost,
+        PLAN_LOCAL_ROWS(lefttree),
+        width,
+        0.0,
+        u_sess->opt_cxt.op_work_mem);
+    plan->startup_cost = sort_path.startup_cost;
+    plan->total_cost = sort_path.total_cost;
+
+    return node;
+}
+
 /*
  * make_sort_from_sortclauses
  *	  Create sort plan to sort according to given sortclauses
@@ -9051,7 +9161,9 @@ bool is_projection_capable_plan(Plan* plan)
     switch (nodeTag(plan)) {
         case T_Hash:
         case T_Material:
+        case T_Memoize:
         case T_Sort:
+        case T_IncrementalSort:
         case T_Unique:
         case T_SetOp:
         case T_LockRows:
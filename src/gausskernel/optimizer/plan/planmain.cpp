@@ -32,12 +32,15 @@
 #include "optimizer/placeholder.h"
 #include "optimizer/planmain.h"
 #include "optimizer/randomplan.h"
+#include "optimizer/streamplan.h"
 #include "optimizer/tlist.h"
 #include "utils/selfuncs.h"
 
 /* Local functions */
 static void canonicalize_all_pathkeys(PlannerInfo* root);
 static void debug_print_log(PlannerInfo* root, Path* sortedpath, int debug_log_level);
+static Path* get_cheapest_incremental_sort_path(PlannerInfo* root, RelOptInfo* final_rel, Path* cheapestpath,
+    double tuple_fraction, double limit_tuples);
 
 /*
  * query_planner
@@ -495,10 +498,107 @@ void query_planner(PlannerInfo* root, List* tlist, double tuple_fraction, double
         }
     }
 
+    /*
+     * Without a fully presorted path, a path sorted on a prefix of the
+     * pathkeys may still win once grouping_planner sorts it incrementally.
+     */
+    root->incremental_sort_path = NULL;
+    if (sortedpath == NULL && OPTIMIZE_PLAN == u_sess->attr.attr_sql.plan_mode_seed &&
+        cheapestpath == linitial(final_rel->cheapest_total_path))
+        sortedpath = get_cheapest_incremental_sort_path(root, final_rel, cheapestpath, tuple_fraction, limit_tuples);
+
     *cheapest_path = cheapestpath;
     *sorted_path = sortedpath;
 }
 
+/*
+ * get_cheapest_incremental_sort_path
+ *	  Find the path sorted on a prefix of the query pathkeys that is the
+ *	  cheapest at the tuple fraction once sorted incrementally, if it beats
+ *	  a full sort of the cheapest-total path.
+ *
+ * This is the only place deciding on incremental sort: the chosen path is
+ * remembered in root->incremental_sort_path, and the final sort step of
+ * grouping_planner sorts exactly that path incrementally.  If it is the
+ * cheapest-total path, NULL is returned since that one is used anyway.
+ *
+ * Only plain ORDER BY queries of row engine plans without stream or smp are
+ * considered, since the final sort of grouping_planner is the only place
+ * an incremental sort is built.
+ */
+static Path* get_cheapest_incremental_sort_path(PlannerInfo* root, RelOptInfo* final_rel, Path* cheapestpath,
+    double tuple_fraction, double limit_tuples)
+{
+    Query* parse = root->parse;
+    Path* bestpath = NULL;
+    Path best_sort_path; /* dummy for result of cost_incremental_sort */
+    Path sort_path;      /* dummy for result of cost_sort */
+    double rows = RELOPTINFO_LOCAL_FIELD(root, final_rel, rows);
+    ListCell* lc = NULL;
+
+    if (!u_sess->attr.attr_sql.enable_incremental_sort || IS_STREAM_PLAN || root->glob->vectorized ||
+        u_sess->opt_cxt.query_dop > 1)
+        return NULL;
+
+    if (root->query_pathkeys == NIL ||
+        compare_pathkeys(root->query_pathkeys, root->sort_pathkeys) != PATHKEYS_EQUAL)
+        return NULL;
+    if (parse->groupClause || parse->groupingSets || parse->hasAggs || parse->hasWindowFuncs ||
+        parse->distinctClause || root->hasHavingQual)
+        return NULL;
+
+    /* the cheapest-total path may itself be partially sorted */
+    if (pathkeys_contained_in(root->query_pathkeys, cheapestpath->pathkeys))
+        return NULL;
+    cost_sort(&sort_path,
+        root->query_pathkeys,
+        cheapestpath->total_cost,
+        rows,
+        final_rel->width,
+        0.0,
+        u_sess->opt_cxt.op_work_mem,
+        limit_tuples,
+        false);
+    best_sort_path.startup_cost = sort_path.startup_cost;
+    best_sort_path.total_cost = sort_path.total_cost;
+
+    foreach (lc, final_rel->pathlist) {
+        Path* path = (Path*)lfirst(lc);
+        Path incr_sort_path;
+        int presorted_keys = 0;
+
+        if (path->param_info != NULL || path->hint_value < cheapestpath->hint_value)
+            continue;
+        if (pathkeys_count_contained_in(root->query_pathkeys, path->pathkeys, &presorted_keys) ||
+            presorted_keys == 0)
+            continue;
+
+        cost_incremental_sort(&incr_sort_path,
+            root,
+            root->query_pathkeys,
+            presorted_keys,
+            path->startup_cost,
+            path->total_cost,
+            rows,
+            final_rel->width,
+            0.0,
+            u_sess->opt_cxt.op_work_mem);
+        if (compare_fractional_path_costs(&incr_sort_path, &best_sort_path, tuple_fraction) < 0) {
+            bestpath = path;
+            best_sort_path.startup_cost = incr_sort_path.startup_cost;
+            best_sort_path.total_cost = incr_sort_path.total_cost;
+        }
+    }
+
+    root->incremental_sort_path = bestpath;
+
+    /* a partially sorted cheapest-total path is the one used anyway */
+    if (bestpath == cheapestpath)
+        bestpath = NULL;
+
+    return bestpath;
+}
+
 static void debug_print_log(PlannerInfo* root, Path* sortedpath, int debug_log_level)
 {
     if (log_min_messages > debug_log_level)
@@ -2472,6 +2472,7 @@ static Plan* grouping_planner(PlannerInfo* root, double tuple_fraction)
     bool tested_hashed_distinct = false;
     bool needs_stream = false;
     bool has_second_agg_sort = false;
+    bool use_incremental_sort = false;
     List* collectiveGroupExpr = NIL;
     RelOptInfo* rel_info = NULL;
     char PlanContextName[NAMEDATALEN] = {0};
@@ -2941,6 +2942,8 @@ static Plan* grouping_planner(PlannerInfo* root, double tuple_fraction)
          */
         best_path = choose_best_path((use_hashed_grouping || use_hashed_distinct || sorted_path == NULL),
                                     root, cheapest_path, sorted_path);
+        /* query_planner costed this path with an incremental final sort */
+        use_incremental_sort = (root->incremental_sort_path != NULL && best_path == root->incremental_sort_path);
 
         (void)MemoryContextSwitchTo(PlanGenerateContext);
 
@@ -4096,10 +4099,16 @@ static Plan* grouping_planner(PlannerInfo* root, double tuple_fraction)
          */
         rebuild_pathkey_for_groupingSet<sort_pathkey>(root, tlist, NULL, collectiveGroupExpr);
 
+        int presorted_keys = 0;
+
         /* we also need to add sort if the sub node is parallized. */
-        if (!pathkeys_contained_in(root->sort_pathkeys, current_pathkeys) ||
+        if (!pathkeys_count_contained_in(root->sort_pathkeys, current_pathkeys, &presorted_keys) ||
             (result_plan->dop > 1 && root->sort_pathkeys)) {
-            result_plan = (Plan*)make_sort_from_pathkeys(root, result_plan, root->sort_pathkeys, limit_tuples);
+            if (use_incremental_sort && presorted_keys > 0 && presorted_keys < list_length(root->sort_pathkeys))
+                result_plan = (Plan*)make_incrementalsort_from_pathkeys(
+                    root, result_plan, root->sort_pathkeys, presorted_keys, limit_tuples);
+            else
+                result_plan = (Plan*)make_sort_from_pathkeys(root, result_plan, root->sort_pathkeys, limit_tuples);
 #ifdef PGXC
 #ifdef STREAMPLAN
             if (IS_STREAM_PLAN && check_sort_for_upsert(root))
@@ -8478,6 +8487,8 @@ static bool vector_engine_walker(Plan* result_plan, bool check_rescan)
         case T_LockRows:
         case T_MergeAppend:
         case T_RecursiveUnion:
+        case T_Memoize:
+        case T_IncrementalSort:
             return true;
 
         case T_RemoteQuery:
@@ -8745,6 +8756,8 @@ static Plan* fallback_plan(Plan* result_plan)
         case T_Sort:
         case T_Stream:
         case T_Material:
+        case T_Memoize:
+        case T_IncrementalSort:
         case T_WindowAgg:
         case T_Hash:
         case T_Agg:
@@ -581,6 +581,7 @@ static Plan* set_plan_refs(PlannerInfo* root, Plan* plan, int rtoffset)
         case T_Material:
         case T_VecMaterial:
         case T_Sort:
+        case T_IncrementalSort:
         case T_VecSort:
         case T_Unique:
         case T_VecUnique:
@@ -604,6 +605,17 @@ static Plan* set_plan_refs(PlannerInfo* root, Plan* plan, int rtoffset)
              */
             AssertEreport(plan->qual == NIL, MOD_OPT, "qual should be null");
             break;
+        case T_Memoize: {
+            Memoize* mplan = (Memoize*)plan;
+
+            /*
+             * Memoize doesn't evaluate its tlist or quals either, but its
+             * cache keys are expressions of the nestloop parameters.
+             */
+            set_dummy_tlist_references(plan, rtoffset);
+            AssertEreport(plan->qual == NIL, MOD_OPT, "qual should be null");
+            mplan->param_exprs = fix_scan_list(root, mplan->param_exprs, rtoffset);
+        } break;
         case T_LockRows: {
             LockRows* splan = (LockRows*)plan;
 
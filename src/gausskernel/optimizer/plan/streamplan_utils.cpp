@@ -340,6 +340,10 @@ void stream_path_walker(Path* path, ContainStreamContext* context)
 
         break;
 
+        case T_Memoize: {
+            stream_path_walker(((MemoizePath*)path)->subpath, context);
+        } break;
+
         case T_PartIterator: {
             stream_path_walker(((PartIteratorPath*)path)->subPath, context);
         } break;
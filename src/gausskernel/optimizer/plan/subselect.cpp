@@ -2768,9 +2768,14 @@ static Bitmapset* finalize_plan(PlannerInfo* root, Plan* plan, Bitmapset* valid_
             (void)finalize_primnode(((WindowAgg*)plan)->endOffset, &context);
             break;
 
+        case T_Memoize:
+            (void)finalize_primnode((Node*)((Memoize*)plan)->param_exprs, &context);
+            break;
+
         case T_Hash:
         case T_Material:
         case T_Sort:
+        case T_IncrementalSort:
         case T_Unique:
         case T_SetOp:
         case T_Group:
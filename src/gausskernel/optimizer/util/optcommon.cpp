@@ -321,9 +321,15 @@ void GetPlanNodePlainText(
         case T_VecMaterial:
             *pname = *sname = *pt_operation = "Vector Materialize";
             break;
+        case T_Memoize:
+            *pname = *sname = *pt_operation = "Memoize";
+            break;
         case T_Sort:
             *pname = *sname = *pt_operation = "Sort";
             break;
+        case T_IncrementalSort:
+            *pname = *sname = *pt_operation = "Incremental Sort";
+            break;
         case T_VecSort:
             *pname = *sname = *pt_operation = "Vector Sort";
             break;
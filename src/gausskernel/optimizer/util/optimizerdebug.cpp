@@ -176,6 +176,9 @@ static const char* debug1_print_pathtype(Path* path, NodeTag pathtype, Path** su
         case T_Material:
             *subpath = ((MaterialPath*)path)->subpath;
             break;
+        case T_Memoize:
+            *subpath = ((MemoizePath*)path)->subpath;
+            break;
         case T_Unique:
             *subpath = ((UniquePath*)path)->subpath;
             break;
@@ -2464,6 +2464,49 @@ MaterialPath* create_material_path(Path* subpath, bool materialize_all)
     return pathnode;
 }
 
+/*
+ * create_memoize_path
+ *	  Creates a path corresponding to a Memoize plan, returning the
+ *	  pathnode.  'calls' is the expected number of rescans, used together
+ *	  with the cache keys 'param_exprs' to estimate the hit ratio.  With
+ *	  'binary_mode' the keys are matched by their binary image instead of
+ *	  by 'hash_operators'.
+ */
+MemoizePath* create_memoize_path(PlannerInfo* root, RelOptInfo* rel, Path* subpath, List* param_exprs,
+    List* hash_operators, bool binary_mode, double calls)
+{
+    MemoizePath* pathnode = makeNode(MemoizePath);
+
+    pathnode->path.pathtype = T_Memoize;
+    pathnode->path.parent = rel;
+    pathnode->path.param_info = subpath->param_info;
+    pathnode->path.pathkeys = subpath->pathkeys;
+    pathnode->path.dop = subpath->dop;
+
+#ifdef STREAMPLAN
+    inherit_path_locator_info((Path*)pathnode, subpath);
+#endif
+
+    pathnode->subpath = subpath;
+    pathnode->hash_operators = hash_operators;
+    pathnode->param_exprs = param_exprs;
+    pathnode->binary_mode = binary_mode;
+    pathnode->calls = calls;
+    /* set by cost_rescan, which knows how many entries fit in the cache */
+    pathnode->est_entries = 0;
+    set_path_rows(&pathnode->path, subpath->rows, subpath->multiple);
+
+    /*
+     * The first scan costs about the same as the subpath, adding the cost
+     * of the cache lookup. The saving is on the rescans, see cost_rescan.
+     */
+    pathnode->path.startup_cost = subpath->startup_cost + u_sess->attr.attr_sql.cpu_tuple_cost;
+    pathnode->path.total_cost = subpath->total_cost + u_sess->attr.attr_sql.cpu_tuple_cost;
+    pathnode->path.stream_cost = subpath->stream_cost;
+
+    return pathnode;
+}
+
 /*
  * create_unique_path
  *	  Creates a path representing elimination of distinct rows from the
@@ -7551,6 +7551,25 @@ MotMemoryDetail* GetMotMemoryDetail(uint32* num, bool isGlobal)
 
     return returnDetailArray;
 }
+
+MotTableFragmentationDetail* GetMotTableFragmentationDetail(uint32* num)
+{
+    MotTableFragmentationDetail* returnDetailArray = NULL;
+    ForeignDataWrapper* fdw = NULL;
+    FdwRoutine* fdwroutine = NULL;
+
+    *num = 0;
+
+    fdw = GetForeignDataWrapperByName(MOT_FDW, false);
+    if (fdw != NULL) {
+        fdwroutine = GetFdwRoutine(fdw->fdwhandler);
+        if (fdwroutine != NULL && fdwroutine->GetForeignTableFragmentation != NULL) {
+            returnDetailArray = fdwroutine->GetForeignTableFragmentation(num);
+        }
+    }
+
+    return returnDetailArray;
+}
 #endif
 
 int64 getCpuTime(void)
@@ -30,11 +30,13 @@
 #include "executor/nodeGroup.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
+#include "executor/nodeIncrementalSort.h"
 #include "executor/nodeIndexonlyscan.h"
 #include "executor/nodeIndexscan.h"
 #include "executor/nodeLimit.h"
 #include "executor/nodeLockRows.h"
 #include "executor/nodeMaterial.h"
+#include "executor/nodeMemoize.h"
 #include "executor/nodeMergeAppend.h"
 #include "executor/nodeMergejoin.h"
 #include "executor/nodeModifyTable.h"
@@ -207,10 +209,18 @@ void ExecReScanByType(PlanState* node)
             ExecReScanMaterial((MaterialState*)node);
             break;
 
+        case T_MemoizeState:
+            ExecReScanMemoize((MemoizeState*)node);
+            break;
+
         case T_SortState:
             ExecReScanSort((SortState*)node);
             break;
 
+        case T_IncrementalSortState:
+            ExecReScanIncrementalSort((IncrementalSortState*)node);
+            break;
+
         case T_GroupState:
             ExecReScanGroup((GroupState*)node);
             break;
@@ -439,6 +439,42 @@ TupleHashEntry FindTupleHashEntry(
     return entry;
 }
 
+/*
+ * Remove the hashtable entry matching the given tuple, which must be the
+ * same type as the hashtable entries.  The caller must free any data it
+ * keeps in the entry beforehand; the entry's firstTuple is not freed either,
+ * as the caller may have stored it in the slot.
+ */
+void RemoveTupleHashEntry(TupleHashTable hashtable, TupleTableSlot* slot)
+{
+    MemoryContext oldContext;
+    TupleHashTable saveCurHT;
+    TupleHashEntryData dummy;
+    TupleHashEntry entry;
+    bool found = false;
+
+    Assert(hashtable->tableslot != NULL && slot != hashtable->tableslot);
+
+    /* Need to run the hash functions in short-lived context */
+    oldContext = MemoryContextSwitchTo(hashtable->tempcxt);
+
+    hashtable->inputslot = slot;
+    hashtable->in_hash_funcs = hashtable->tab_hash_funcs;
+    hashtable->cur_eq_funcs = hashtable->tab_eq_funcs;
+
+    saveCurHT = u_sess->exec_cxt.cur_tuple_hash_table;
+    u_sess->exec_cxt.cur_tuple_hash_table = hashtable;
+
+    dummy.firstTuple = NULL; /* flag to reference inputslot */
+    entry = (TupleHashEntry)hash_search(hashtable->hashtab, &dummy, HASH_REMOVE, &found);
+    if (found && hashtable->add_width)
+        hashtable->width -= entry->firstTuple->t_len;
+
+    u_sess->exec_cxt.cur_tuple_hash_table = saveCurHT;
+
+    MemoryContextSwitchTo(oldContext);
+}
+
 /*
  * Compute the hash value for a tuple
  *
@@ -92,11 +92,13 @@
 #include "executor/nodeGroup.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
+#include "executor/nodeIncrementalSort.h"
 #include "executor/nodeIndexonlyscan.h"
 #include "executor/nodeIndexscan.h"
 #include "executor/nodeLimit.h"
 #include "executor/nodeLockRows.h"
 #include "executor/nodeMaterial.h"
+#include "executor/nodeMemoize.h"
 #include "executor/nodeMergeAppend.h"
 #include "executor/nodeMergejoin.h"
 #include "executor/nodeModifyTable.h"
@@ -302,8 +304,12 @@ PlanState* ExecInitNodeByType(Plan* node, EState* estate, int eflags)
             return (PlanState*)ExecInitHashJoin((HashJoin*)node, estate, eflags);
         case T_Material:
             return (PlanState*)ExecInitMaterial((Material*)node, estate, eflags);
+        case T_Memoize:
+            return (PlanState*)ExecInitMemoize((Memoize*)node, estate, eflags);
         case T_Sort:
             return (PlanState*)ExecInitSort((Sort*)node, estate, eflags);
+        case T_IncrementalSort:
+            return (PlanState*)ExecInitIncrementalSort((IncrementalSort*)node, estate, eflags);
         case T_Group:
             return (PlanState*)ExecInitGroup((Group*)node, estate, eflags);
         case T_Agg:
@@ -655,8 +661,12 @@ TupleTableSlot* ExecProcNodeByType(PlanState* node)
              */
         case T_MaterialState:
             return ExecMaterial((MaterialState*)node);
+        case T_MemoizeState:
+            return ExecMemoize((MemoizeState*)node);
         case T_SortState:
             return ExecSort((SortState*)node);
+        case T_IncrementalSortState:
+            return ExecIncrementalSort((IncrementalSortState*)node);
         case T_GroupState:
             return ExecGroup((GroupState*)node);
         case T_AggState:
@@ -1200,10 +1210,18 @@ static void ExecEndNodeByType(PlanState* node)
             ExecEndMaterial((MaterialState*)node);
             break;
 
+        case T_MemoizeState:
+            ExecEndMemoize((MemoizeState*)node);
+            break;
+
         case T_SortState:
             ExecEndSort((SortState*)node);
             break;
 
+        case T_IncrementalSortState:
+            ExecEndIncrementalSort((IncrementalSortState*)node);
+            break;
+
         case T_GroupState:
             ExecEndGroup((GroupState*)node);
             break;
@@ -1177,10 +1177,18 @@ Instrumentation* ThreadInstrumentation::allocInstrSlot(int plan_node_id, int par
             pname = "Vector Materialize";
             plan_type = IO_OP;
             break;
+        case T_Memoize:
+            pname = "Memoize";
+            plan_type = IO_OP;
+            break;
         case T_Sort:
             pname = "Sort";
             plan_type = SORT_OP;
             break;
+        case T_IncrementalSort:
+            pname = "Incremental Sort";
+            plan_type = SORT_OP;
+            break;
         case T_VecSort:
             pname = "Vector Sort";
             plan_type = SORT_OP;
@@ -144,6 +144,7 @@
 #include "utils/syscache.h"
 #include "utils/tuplesort.h"
 #include "utils/datum.h"
+#include "utils/dynahash.h"
 #include "utils/memprot.h"
 #include "workload/workload.h"
 
@@ -171,6 +172,9 @@ static void agg_fill_hash_table(AggState* aggstate);
 static TupleTableSlot* agg_retrieve_hash_table(AggState* aggstate);
 static TupleTableSlot* agg_retrieve(AggState* node);
 static bool prepare_data_source(AggState* node);
+static bool agg_next_spill_file(AggState* node);
+static void agg_push_spill_set(AggWriteFileControl* TempFileControl);
+static void agg_free_spill_files(AggWriteFileControl* TempFileControl);
 static TupleTableSlot* fetch_input_tuple(AggState* aggstate);
 
 /*
@@ -1314,7 +1318,7 @@ static AggHashEntry lookup_hash_entry(AggState* aggstate, TupleTableSlot* inputs
             agg_spill_to_disk(TempFileControl,
                             aggstate->hashtable,
                             aggstate->hashslot,
-                            ((Agg*)aggstate->ss.ps.plan)->numGroups,
+                            (int)Min(TempFileControl->passGroups, INT_MAX),
                             true,
                             aggstate->ss.ps.plan->plan_node_id,
                             SET_DOP(aggstate->ss.ps.plan->dop),
@@ -1335,7 +1339,9 @@ static AggHashEntry lookup_hash_entry(AggState* aggstate, TupleTableSlot* inputs
             oldContext = MemoryContextSwitchTo(aggstate->tmpcontext->ecxt_per_tuple_memory);
             hashvalue = ComputeHashValue(aggstate->hashtable);
             MemoryContextSwitchTo(oldContext);
-            TempFileControl->filesource->writeTup(tuple, hashvalue & (TempFileControl->filenum - 1));
+            /* the levels above used the low bits, take the next ones to pick the file */
+            TempFileControl->filesource->writeTup(
+                tuple, (hashvalue >> TempFileControl->hashShift) & (TempFileControl->filenum - 1));
         }
     } else if (((Agg *)aggstate->ss.ps.plan)->unique_check) {
         ereport(ERROR,
@@ -1363,30 +1369,8 @@ static bool prepare_data_source(AggState* node)
         }
         TempFileControl->m_hashAggSource = New(CurrentMemoryContext) hashOpSource(outerPlanState(node));
     /* get data from temp file */
-    } else if (TempFileControl->strategy == DIST_HASHAGG) { 
-        TempFileControl->m_hashAggSource = TempFileControl->filesource;
-        if (TempFileControl->curfile >= 0) {
-            TempFileControl->filesource->close(TempFileControl->curfile);
-        }
-        TempFileControl->curfile++;
-        while (TempFileControl->curfile < TempFileControl->filenum) {
-            int currfileidx = TempFileControl->curfile;
-            if (TempFileControl->filesource->m_rownum[currfileidx] != 0) {
-                TempFileControl->filesource->setCurrentIdx(currfileidx);
-                MemoryContextResetAndDeleteChildren(node->aggcontexts[0]);
-                build_hash_table(node);
-
-                TempFileControl->filesource->rewind(currfileidx);
-                node->table_filled = false;
-                node->agg_done = false;
-                break;
-            /* no data in this temp file */
-            } else {
-                TempFileControl->filesource->close(currfileidx);
-                TempFileControl->curfile++;
-            }
-        }
-        if (TempFileControl->curfile == TempFileControl->filenum) {
+    } else if (TempFileControl->strategy == DIST_HASHAGG) {
+        if (!agg_next_spill_file(node)) {
             return false;
         }
     } else {
@@ -1396,6 +1380,121 @@ static bool prepare_data_source(AggState* node)
     return true;
 }
 
+/*
+ * agg_next_spill_file
+ *	Set up the next spilled file to aggregate, return false if none is left.
+ *
+ * A file is aggregated like the outer input, so the groups that don't fit
+ * in memory are spilled again, into files picked by the next bits of the
+ * hash value.  The files of the latest spill are taken first, which keeps
+ * the recursion depth first.
+ */
+static bool agg_next_spill_file(AggState* node)
+{
+    AggWriteFileControl* TempFileControl = (AggWriteFileControl*)node->aggTempFileControl;
+
+    while (TempFileControl->spillSets != NIL) {
+        AggSpillSet* set = (AggSpillSet*)linitial(TempFileControl->spillSets);
+
+        if (set->curfile >= 0) {
+            set->source->close(set->curfile);
+        }
+        set->curfile++;
+        /* skip the files without data */
+        while (set->curfile < set->filenum && set->source->m_rownum[set->curfile] == 0) {
+            set->source->close(set->curfile);
+            set->curfile++;
+        }
+
+        if (set->curfile < set->filenum) {
+            int currfileidx = set->curfile;
+
+            set->source->setCurrentIdx(currfileidx);
+            set->source->rewind(currfileidx);
+            TempFileControl->m_hashAggSource = set->source;
+
+            MemoryContextResetAndDeleteChildren(node->aggcontexts[0]);
+            build_hash_table(node);
+            node->table_filled = false;
+            node->agg_done = false;
+
+            TempFileControl->hashShift = set->hashShift + my_log2(set->filenum);
+            TempFileControl->spillDepth = set->depth + 1;
+            TempFileControl->passGroups = set->source->m_rownum[currfileidx];
+            TempFileControl->inmemoryRownum = 0;
+            if (TempFileControl->hashShift + my_log2(HASH_MAX_FILENUMBER) <= HASH_SPILL_HASH_BITS) {
+                TempFileControl->spillToDisk = false;
+                TempFileControl->finishwrite = false;
+            } else {
+                /* no hash bits are left to split the file, so it is aggregated in memory */
+                TempFileControl->spillToDisk = true;
+                TempFileControl->finishwrite = true;
+            }
+            return true;
+        }
+
+        /* all the files of this set are aggregated */
+        set->source->freeFileSource();
+        TempFileControl->spillSets = list_delete_first(TempFileControl->spillSets);
+        pfree_ext(set);
+    }
+
+    return false;
+}
+
+/*
+ * agg_push_spill_set
+ *	Queue the files spilled by the current pass, they are aggregated before
+ *	the remaining files of the upper levels.
+ */
+static void agg_push_spill_set(AggWriteFileControl* TempFileControl)
+{
+    AggSpillSet* set = (AggSpillSet*)palloc(sizeof(AggSpillSet));
+
+    set->source = TempFileControl->filesource;
+    set->filenum = TempFileControl->filenum;
+    set->curfile = -1;
+    set->hashShift = TempFileControl->hashShift;
+    set->depth = TempFileControl->spillDepth;
+    TempFileControl->spillSets = lcons(set, TempFileControl->spillSets);
+    TempFileControl->filesource = NULL;
+}
+
+/*
+ * agg_free_spill_files
+ *	Close and free the files being written and all the queued spill files.
+ */
+static void agg_free_spill_files(AggWriteFileControl* TempFileControl)
+{
+    ListCell* lc = NULL;
+    hashFileSource* file = TempFileControl->filesource;
+
+    if (file != NULL) {
+        for (int i = 0; i < TempFileControl->filenum; i++) {
+            file->close(i);
+        }
+        file->freeFileSource();
+    }
+
+    /*
+     * After close the temp file and free the filesource, setting the filesource to NULL
+     * preventing free or close wrong object the next time here.
+     * Problem Scenario: when the first rescan need spill to disk and second rescan
+     * doesn't need, without this set will lead core in freeFileSource as m_tuple was
+     * set to null in the first rescan.
+     */
+    TempFileControl->filesource = NULL;
+
+    foreach (lc, TempFileControl->spillSets) {
+        AggSpillSet* set = (AggSpillSet*)lfirst(lc);
+
+        set->source->closeAll();
+        set->source->freeFileSource();
+        pfree_ext(set);
+    }
+    list_free_ext(TempFileControl->spillSets);
+}
+
 /* agg_retrieve
  * retrieving groups from hash table;
  */
@@ -1417,7 +1516,10 @@ static TupleTableSlot* agg_retrieve(AggState* node)
                 tmptup = agg_retrieve_hash_table(node);
                 if (tmptup != NULL) {
                     return tmptup;
-                } else if (tmptup == NULL && TempFileControl->spillToDisk == true) {
+                } else if (TempFileControl->filesource != NULL || TempFileControl->spillSets != NIL) {
+                    if (TempFileControl->filesource != NULL) {
+                        agg_push_spill_set(TempFileControl);
+                    }
                     TempFileControl->runState = HASHAGG_PREPARE;
                     TempFileControl->strategy = DIST_HASHAGG;
                 } else {
@@ -1839,8 +1941,11 @@ static void agg_fill_hash_table(AggState* aggstate)
         TempFileControl->finishwrite = true;
         if (HAS_INSTR(&aggstate->ss, true)) {
             PlanState* planstate = &aggstate->ss.ps;
-            planstate->instrument->sorthashinfo.hash_FileNum = (TempFileControl->filenum);
+            planstate->instrument->sorthashinfo.hash_FileNum += (TempFileControl->filenum);
             planstate->instrument->sorthashinfo.hash_writefile = true;
+            /* a spilled file spilled again */
+            if (TempFileControl->spillDepth > 0)
+                planstate->instrument->sorthashinfo.hash_spillNum++;
         }
     }
     /* Initialize to walk the hash table */
@@ -2597,6 +2702,10 @@ AggState* ExecInitAgg(Agg* node, EState* estate, int eflags)
     TempFilePara->m_hashAggSource = NULL;
     TempFilePara->maxMem = maxMem * 1024L;
     TempFilePara->spreadNum = 0;
+    TempFilePara->spillSets = NIL;
+    TempFilePara->hashShift = 0;
+    TempFilePara->spillDepth = 0;
+    TempFilePara->passGroups = node->numGroups;
     aggstate->aggTempFileControl = TempFilePara;
     return aggstate;
 }
@@ -2619,15 +2728,8 @@ void ExecEndAgg(AggState* node)
     int aggno, setno;
     AggWriteFileControl* TempFileControl = (AggWriteFileControl*)node->aggTempFileControl;
     int numGroupingSets = Max(node->maxsets, 1);
-    int fileNum = TempFileControl->filenum;
-    hashFileSource* file = TempFileControl->filesource;
 
-    if (file != NULL) {
-        for (int i = 0; i < fileNum; i++) {
-            file->close(i);
-        }
-        file->freeFileSource();
-    }
+    agg_free_spill_files(TempFileControl);
 
     /*
      * Clean up sort_slot first before tuplesort_end(node->sort_in)
@@ -2721,7 +2823,8 @@ void ExecReScanAgg(AggState* node)
          * rescan the existing hash table, and have not spill to disk;
          * no need to build it again.
          */
-        if (node->ss.ps.lefttree->chgParam == NULL && TempFilePara->spillToDisk == false &&
+        if (node->ss.ps.lefttree->chgParam == NULL && TempFilePara->strategy == MEMORY_HASHAGG &&
+            TempFilePara->spillToDisk == false &&
             aggnode->aggParams == NULL && !EXEC_IN_RECURSIVE_MODE(node->ss.ps.plan)) {
             ResetTupleHashIterator(node->hashtable, &node->hashiter);
             return;
@@ -2777,29 +2880,11 @@ void ExecReScanAgg(AggState* node)
 
     if (aggnode->aggstrategy == AGG_HASHED) {
         AggWriteFileControl* TempFileControl = (AggWriteFileControl*)node->aggTempFileControl;
-
-        int fileNum = TempFileControl->filenum;
         int64 workMem = SET_NODEMEM(aggnode->plan.operatorMemKB[0], aggnode->plan.dop);
         int64 maxMem =
             (aggnode->plan.operatorMaxMem > 0) ? SET_NODEMEM(aggnode->plan.operatorMaxMem, aggnode->plan.dop) : 0;
 
-        hashFileSource* file = TempFileControl->filesource;
-
-        if (file != NULL) {
-            for (int i = 0; i < fileNum; i++) {
-                file->close(i);
-            }
-            file->freeFileSource();
-        }
-
-        /*
-         * After close the temp file and free the filesource, setting the filesource to NULL
-         * preventing free or close wrong object the next time here.
-         * Problem Scenario: when the first rescan need spill to disk and second rescan
-         * doesn't need, without this set will lead core in freeFileSource as m_tuple was
-         * set to null in the first rescan.
-         */
-        TempFileControl->filesource = NULL;
+        agg_free_spill_files(TempFileControl);
 
         /* Rebuild an empty hash table */
         build_hash_table(node);
@@ -2816,6 +2901,14 @@ void ExecReScanAgg(AggState* node)
         TempFilePara->filenum = 0;
         TempFilePara->maxMem = maxMem * 1024L;
         TempFilePara->spreadNum = 0;
+        TempFilePara->hashShift = 0;
+        TempFilePara->spillDepth = 0;
+        TempFilePara->passGroups = aggnode->numGroups;
+        /* the spill counters add up the passes of one scan only */
+        if (node->ss.ps.instrument != NULL) {
+            node->ss.ps.instrument->sorthashinfo.hash_FileNum = 0;
+            node->ss.ps.instrument->sorthashinfo.hash_spillNum = 0;
+        }
     } else {
         /*
          * Reset the per-group state (in particular, mark transvalues null)
@@ -2904,7 +2997,14 @@ FORCE_INLINE void agg_spill_to_disk(AggWriteFileControl* TempFileControl, TupleH
         AllocSetContext* set = (AllocSetContext*)(hashtable->tablecxt);
         int64 totalSize = set->totalSpace;
         TempFileControl->inmemoryRownum++; /* add 1 when insert one slot to hash table */
-        /* compute totalSize of AggContext and TupleHashTable */
+        /*
+         * compute totalSize of AggContext and TupleHashTable. The by-ref
+         * transition values live in the AggContext too, but the contexts an
+         * internal-type state creates for itself are not counted, and a group
+         * whose state keeps growing is only checked when the next new group
+         * comes in. Such a group never moves to a spill file, respilling only
+         * splits the groups between files.
+         */
         int64 usedSize = totalSize + TempFileControl->inmemoryRownum * hashtable->entrysize;
         bool sysBusy = gs_sysmemory_busy(usedSize * dop, false);
         /* next slot will be inserted into temp file when that useful memory more than total memory */
@@ -2985,19 +3085,12 @@ void ExecEarlyFreeAggregation(AggState* node)
     int aggno, setno;
     AggWriteFileControl* TempFileControl = (AggWriteFileControl*)node->aggTempFileControl;
     int numGroupingSets = Max(node->maxsets, 1);
-    int fileNum = TempFileControl->filenum;
-    hashFileSource* file = TempFileControl->filesource;
     PlanState* plan_state = &node->ss.ps;
 
     if (plan_state->earlyFreed)
         return;
 
-    if (file != NULL) {
-        for (int i = 0; i < fileNum; i++) {
-            file->close(i);
-        }
-        file->freeFileSource();
-    }
+    agg_free_spill_files(TempFileControl);
 
     /*
      * Clean up sort_slot first before tuplesort_end(node->sort_in)
@@ -3131,27 +3224,10 @@ void ExecReSetAgg(AggState* node)
 
     if (aggnode->aggstrategy == AGG_HASHED) {
         AggWriteFileControl* TempFileControl = (AggWriteFileControl*)node->aggTempFileControl;
-        int fileNum = TempFileControl->filenum;
         int64 workMem = SET_NODEMEM(aggnode->plan.operatorMemKB[0], aggnode->plan.dop);
         int64 maxMem =
             (aggnode->plan.operatorMaxMem > 0) ? SET_NODEMEM(aggnode->plan.operatorMaxMem, aggnode->plan.dop) : 0;
-        hashFileSource* file = TempFileControl->filesource;
-
-        if (file != NULL) {
-            for (int i = 0; i < fileNum; i++) {
-                file->close(i);
-            }
-            file->freeFileSource();
-        }
-
-        /*
-         * After close the temp file and free the filesource, setting the filesource to NULL
-         * preventing free or close wrong object the next time here.
-         * Problem Scenario: when the first rescan need spill to disk and second rescan
-         * doesn't need, without this set will lead core in freeFileSource as m_tuple was
-         * set to null in the first rescan.
-         */
-        TempFileControl->filesource = NULL;
+        agg_free_spill_files(TempFileControl);
 
         /* Rebuild an empty hash table */
         build_hash_table(node);
@@ -3168,6 +3244,14 @@ void ExecReSetAgg(AggState* node)
         TempFilePara->filenum = 0;
         TempFilePara->maxMem = maxMem * 1024L;
         TempFilePara->spreadNum = 0;
+        TempFilePara->hashShift = 0;
+        TempFilePara->spillDepth = 0;
+        TempFilePara->passGroups = aggnode->numGroups;
+        /* the spill counters add up the passes of one scan only */
+        if (node->ss.ps.instrument != NULL) {
+            node->ss.ps.instrument->sorthashinfo.hash_FileNum = 0;
+            node->ss.ps.instrument->sorthashinfo.hash_spillNum = 0;
+        }
     } else {
         /*
          * Reset the per-group state (in particular, mark transvalues null)
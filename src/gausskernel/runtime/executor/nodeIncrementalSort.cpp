@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * nodeIncrementalSort.cpp
+ *	  Routines to handle incremental sorting of relations.
+ *
+ * The input of an incremental sort is already sorted on a prefix of the
+ * sort columns.  Instead of reading all of it before returning the first
+ * tuple, the input is cut into batches at a change of the prefix columns,
+ * and every batch is sorted on all the sort columns and returned before
+ * the next one is read.  For example, with input sorted on (a) and the
+ * sort key (a, b):
+ *
+ *		a | b				sorted batches
+ *		1 | 5				(1,2) (1,5)
+ *		1 | 2				(2,3) (2,9) (2,9)
+ *		2 | 9	  --->		...
+ *		2 | 3
+ *		2 | 9
+ *
+ * Sorting tiny batches one by one costs more than sorting them together,
+ * so a batch takes at least INCSORT_MIN_GROUP_SIZE tuples and then runs up
+ * to the next change of the prefix columns.  That way the memory used is
+ * bounded by the largest group of equal prefix values instead of the whole
+ * input, and a LIMIT above the node stops reading early.
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/runtime/executor/nodeIncrementalSort.cpp
+ *
+ * -------------------------------------------------------------------------
+ *
+ * INTERFACE ROUTINES
+ *		ExecIncrementalSort			- return the next tuple of the sorted batches
+ *		ExecInitIncrementalSort		- initialize node and subnodes
+ *		ExecEndIncrementalSort		- shutdown node and subnodes
+ *		ExecReScanIncrementalSort	- rescan the node
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "executor/execdebug.h"
+#include "executor/executor.h"
+#include "executor/nodeIncrementalSort.h"
+#include "miscadmin.h"
+#include "pgstat.h"
+#include "utils/lsyscache.h"
+#include "utils/tuplesort.h"
+
+/* states of ExecIncrementalSort */
+#define INCSORT_LOADING 1 /* read the next batch from the outer node */
+#define INCSORT_READING 2 /* return tuples of the sorted batch */
+
+/*
+ * Check whether the presorted columns of the tuple in slot equal those of
+ * the group pivot.  The equality functions may leak into the per-tuple
+ * memory, which is reset before each comparison since nothing else of the
+ * node lives there.
+ */
+static bool is_same_group(IncrementalSortState* node, TupleTableSlot* slot)
+{
+    IncrementalSort* plan_node = (IncrementalSort*)node->ss.ps.plan;
+
+    ResetExprContext(node->ss.ps.ps_ExprContext);
+
+    return execTuplesMatch(node->group_pivot,
+        slot,
+        plan_node->nPresortedCols,
+        plan_node->sort.sortColIdx,
+        node->presortedEqfuncs,
+        node->ss.ps.ps_ExprContext->ecxt_per_tuple_memory);
+}
+
+/*
+ * Add a tuple to the batch being loaded.  The tuple completing the minimal
+ * batch size becomes the pivot the following tuples are compared with.
+ */
+static void incsort_put_tuple(IncrementalSortState* node, TupleTableSlot* slot, int64* ntuples)
+{
+    tuplesort_puttupleslot((Tuplesortstate*)node->tuplesortstate, slot);
+    (*ntuples)++;
+    if (*ntuples == INCSORT_MIN_GROUP_SIZE)
+        (void)ExecCopySlot(node->group_pivot, slot);
+}
+
+/*
+ * Read the next batch from the outer node into a new tuplesort and sort it.
+ */
+static void incsort_load_batch(IncrementalSortState* node)
+{
+    IncrementalSort* plan_node = (IncrementalSort*)node->ss.ps.plan;
+    PlanState* outer_node = outerPlanState(node);
+    Tuplesortstate* tuple_sortstate = NULL;
+    TupleTableSlot* slot = NULL;
+    int64 sort_mem = SET_NODEMEM(plan_node->sort.plan.operatorMemKB[0], plan_node->sort.plan.dop);
+    int64 max_mem = (plan_node->sort.plan.operatorMaxMem > 0)
+                        ? SET_NODEMEM(plan_node->sort.plan.operatorMaxMem, plan_node->sort.plan.dop)
+                        : 0;
+    int64 ntuples = 0;
+
+    if (node->tuplesortstate != NULL) {
+        tuplesort_end((Tuplesortstate*)node->tuplesortstate);
+        node->tuplesortstate = NULL;
+    }
+
+    tuple_sortstate = tuplesort_begin_heap(ExecGetResultType(outer_node),
+        plan_node->sort.numCols,
+        plan_node->sort.sortColIdx,
+        plan_node->sort.sortOperators,
+        plan_node->sort.collations,
+        plan_node->sort.nullsFirst,
+        sort_mem,
+        false,
+        max_mem,
+        plan_node->sort.plan.plan_node_id,
+        SET_DOP(plan_node->sort.plan.dop));
+    node->tuplesortstate = (void*)tuple_sortstate;
+
+    /* a bounded sort never needs more than what is left of the bound */
+    if (node->bounded && node->bound > node->bound_Done)
+        tuplesort_set_bound(tuple_sortstate, node->bound - node->bound_Done);
+
+    /* the tuple that ended the previous batch starts this one */
+    if (!TupIsNull(node->transfer_tuple)) {
+        incsort_put_tuple(node, node->transfer_tuple, &ntuples);
+        (void)ExecClearTuple(node->transfer_tuple);
+    }
+
+    for (;;) {
+        slot = ExecProcNode(outer_node);
+        if (TupIsNull(slot)) {
+            node->outerNodeDone = true;
+            break;
+        }
+
+        if (ntuples < INCSORT_MIN_GROUP_SIZE || is_same_group(node, slot)) {
+            incsort_put_tuple(node, slot, &ntuples);
+            continue;
+        }
+
+        /* the presorted columns changed, keep the tuple for the next batch */
+        (void)ExecCopySlot(node->transfer_tuple, slot);
+        break;
+    }
+
+    tuplesort_performsort(tuple_sortstate);
+    node->groupsSorted++;
+
+    if (node->ss.ps.instrument != NULL) {
+        int sort_method = 0;
+        int space_type = 0;
+        long space_used = 0;
+        int64 peak_memory = (int64)tuplesort_get_peak_memory(tuple_sortstate);
+
+        tuplesort_get_stats(tuple_sortstate, &sort_method, &space_type, &space_used);
+        if (space_used >= node->maxSpaceUsed) {
+            node->sortMethodId = sort_method;
+            node->spaceTypeId = space_type;
+            node->maxSpaceUsed = space_used;
+        }
+        if (node->ss.ps.instrument->memoryinfo.peakOpMemory < peak_memory)
+            node->ss.ps.instrument->memoryinfo.peakOpMemory = peak_memory;
+
+        node->ss.ps.instrument->sorthashinfo.sortMethodId = node->sortMethodId;
+        node->ss.ps.instrument->sorthashinfo.spaceTypeId = node->spaceTypeId;
+        node->ss.ps.instrument->sorthashinfo.spaceUsed = node->maxSpaceUsed;
+        node->ss.ps.instrument->sorthashinfo.sort_groups = node->groupsSorted;
+    }
+}
+
+/* ----------------------------------------------------------------
+ *		ExecIncrementalSort
+ *
+ *		Returns the next tuple of the current sorted batch, loading
+ *		and sorting the next batch when the current one is used up.
+ * ----------------------------------------------------------------
+ */
+TupleTableSlot* ExecIncrementalSort(IncrementalSortState* node)
+{
+    EState* estate = node->ss.ps.state;
+    ScanDirection dir = estate->es_direction;
+    TupleTableSlot* slot = node->ss.ps.ps_ResultTupleSlot;
+
+    /* incremental sort doesn't support backward scans, see ExecSupportsBackwardScan */
+    Assert(ScanDirectionIsForward(dir));
+
+    for (;;) {
+        if (node->status == INCSORT_READING) {
+            if (tuplesort_gettupleslot((Tuplesortstate*)node->tuplesortstate, true, slot, NULL)) {
+                node->bound_Done++;
+                return slot;
+            }
+
+            if (node->outerNodeDone)
+                return ExecClearTuple(slot);
+
+            node->status = INCSORT_LOADING;
+        }
+
+        SO1_printf("ExecIncrementalSort: %s\n", "loading the next batch");
+        WaitState old_status = pgstat_report_waitstatus(STATE_EXEC_SORT);
+
+        estate->es_direction = ForwardScanDirection;
+        incsort_load_batch(node);
+        estate->es_direction = dir;
+
+        (void)pgstat_report_waitstatus(old_status);
+        node->status = INCSORT_READING;
+    }
+}
+
+/* ----------------------------------------------------------------
+ *		ExecInitIncrementalSort
+ *
+ *		Creates the run-time state information for the incremental
+ *		sort node produced by the planner and initializes its outer
+ *		subtree.
+ * ----------------------------------------------------------------
+ */
+IncrementalSortState* ExecInitIncrementalSort(IncrementalSort* node, EState* estate, int eflags)
+{
+    IncrementalSortState* incrsortstate = NULL;
+    Oid* eq_operators = NULL;
+
+    SO1_printf("ExecInitIncrementalSort: %s\n", "initializing sort node");
+
+    /* the batches are thrown away once returned, so no rewind or backward scan */
+    Assert((eflags & (EXEC_FLAG_BACKWARD | EXEC_FLAG_MARK)) == 0);
+
+    incrsortstate = makeNode(IncrementalSortState);
+    incrsortstate->ss.ps.plan = (Plan*)node;
+    incrsortstate->ss.ps.state = estate;
+    incrsortstate->bounded = false;
+    incrsortstate->bound_Done = 0;
+    incrsortstate->status = INCSORT_LOADING;
+    incrsortstate->outerNodeDone = false;
+    incrsortstate->tuplesortstate = NULL;
+
+    /* the ExprContext gives the memory to compare the presorted columns in */
+    ExecAssignExprContext(estate, &incrsortstate->ss.ps);
+
+    ExecInitResultTupleSlot(estate, &incrsortstate->ss.ps);
+    ExecInitScanTupleSlot(estate, &incrsortstate->ss);
+
+    eflags &= ~(EXEC_FLAG_REWIND | EXEC_FLAG_BACKWARD | EXEC_FLAG_MARK);
+    outerPlanState(incrsortstate) = ExecInitNode(outerPlan(node), estate, eflags);
+
+    ExecAssignScanTypeFromOuterPlan(&incrsortstate->ss);
+    ExecAssignResultTypeFromTL(
+        &incrsortstate->ss.ps, incrsortstate->ss.ss_ScanTupleSlot->tts_tupleDescriptor->tdTableAmType);
+    incrsortstate->ss.ps.ps_ProjInfo = NULL;
+
+    TupleDesc outer_desc = ExecGetResultType(outerPlanState(incrsortstate));
+    incrsortstate->group_pivot = ExecInitExtraTupleSlot(estate, outer_desc->tdTableAmType);
+    ExecSetSlotDescriptor(incrsortstate->group_pivot, outer_desc);
+    incrsortstate->transfer_tuple = ExecInitExtraTupleSlot(estate, outer_desc->tdTableAmType);
+    ExecSetSlotDescriptor(incrsortstate->transfer_tuple, outer_desc);
+
+    /* look up the equality functions of the presorted columns */
+    eq_operators = (Oid*)palloc(node->nPresortedCols * sizeof(Oid));
+    for (int i = 0; i < node->nPresortedCols; i++) {
+        eq_operators[i] = get_equality_op_for_ordering_op(node->sort.sortOperators[i], NULL);
+        if (!OidIsValid(eq_operators[i]))
+            ereport(ERROR,
+                (errcode(ERRCODE_UNDEFINED_FUNCTION),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("could not find equality operator for ordering operator %u",
+                        node->sort.sortOperators[i])));
+    }
+    incrsortstate->presortedEqfuncs = execTuplesMatchPrepare(node->nPresortedCols, eq_operators);
+    pfree(eq_operators);
+
+    SO1_printf("ExecInitIncrementalSort: %s\n", "sort node initialized");
+
+    return incrsortstate;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecEndIncrementalSort
+ * ----------------------------------------------------------------
+ */
+void ExecEndIncrementalSort(IncrementalSortState* node)
+{
+    SO1_printf("ExecEndIncrementalSort: %s\n", "shutting down sort node");
+
+    ExecFreeExprContext(&node->ss.ps);
+    (void)ExecClearTuple(node->ss.ss_ScanTupleSlot);
+    (void)ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
+    (void)ExecClearTuple(node->group_pivot);
+    (void)ExecClearTuple(node->transfer_tuple);
+
+    if (node->tuplesortstate != NULL)
+        tuplesort_end((Tuplesortstate*)node->tuplesortstate);
+    node->tuplesortstate = NULL;
+
+    ExecEndNode(outerPlanState(node));
+
+    SO1_printf("ExecEndIncrementalSort: %s\n", "sort node shutdown");
+}
+
+/* ----------------------------------------------------------------
+ *		ExecReScanIncrementalSort
+ *
+ *		Batches are not kept once returned, so a rescan always reads
+ *		and sorts the input again.
+ * ----------------------------------------------------------------
+ */
+void ExecReScanIncrementalSort(IncrementalSortState* node)
+{
+    PlanState* outer_node = outerPlanState(node);
+
+    (void)ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
+    (void)ExecClearTuple(node->group_pivot);
+    (void)ExecClearTuple(node->transfer_tuple);
+
+    if (node->tuplesortstate != NULL) {
+        tuplesort_end((Tuplesortstate*)node->tuplesortstate);
+        node->tuplesortstate = NULL;
+    }
+
+    node->status = INCSORT_LOADING;
+    node->outerNodeDone = false;
+    node->bound_Done = 0;
+
+    /*
+     * if chgParam of subnode is not null then plan will be re-scanned by
+     * first ExecProcNode.
+     */
+    if (outer_node->chgParam == NULL)
+        ExecReScan(outer_node);
+}
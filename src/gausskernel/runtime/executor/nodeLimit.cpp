@@ -307,6 +307,16 @@ static void pass_down_bound(LimitState* node, PlanState* child_node)
             sortState->bounded = true;
             sortState->bound = tuples_needed;
         }
+    } else if (IsA(child_node, IncrementalSortState)) {
+        IncrementalSortState* incrsortState = (IncrementalSortState*)child_node;
+        int64 tuples_needed = node->count + node->offset;
+
+        if (node->noCount || tuples_needed < 0) {
+            incrsortState->bounded = false;
+        } else {
+            incrsortState->bounded = true;
+            incrsortState->bound = tuples_needed;
+        }
     } else if (IsA(child_node, MergeAppendState)) {
         MergeAppendState* maState = (MergeAppendState*)child_node;
         int i;
@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * nodeMemoize.cpp
+ *	  Routines to cache the results of a parameterized subplan.
+ *
+ * A Memoize node sits above the inner side of a parameterized nestloop.
+ * Every rescan looks up the current parameter values in a hash table.  On
+ * a hit the cached tuples are returned without running the subplan; on a
+ * miss the subplan runs and its tuples are added to the cache as they are
+ * returned.  An entry is only used once the subplan was read to its end.
+ *
+ * The cache may use operator memory.  When it is full, entries are evicted
+ * in least recently used order.  If a single entry does not fit, it is
+ * dropped and the rest of that scan bypasses the cache.
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/runtime/executor/nodeMemoize.cpp
+ *
+ * -------------------------------------------------------------------------
+ *
+ * INTERFACE ROUTINES
+ *		ExecMemoize			- lookup the cache, run the subplan on a miss
+ *		ExecInitMemoize		- initialize node and subnodes
+ *		ExecEndMemoize		- shutdown node and subnodes
+ *		ExecReScanMemoize	- prepare the lookup of new parameter values
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/hash.h"
+#include "executor/executor.h"
+#include "executor/nodeMemoize.h"
+#include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "utils/datum.h"
+#include "utils/memutils.h"
+
+/* states of the ExecMemoize state machine */
+#define MEMO_CACHE_LOOKUP 1           /* lookup the cache for the current key */
+#define MEMO_CACHE_FETCH_NEXT_TUPLE 2 /* return the next tuple of a cached entry */
+#define MEMO_FILLING_CACHE 3          /* read the subplan and cache its tuples */
+#define MEMO_CACHE_BYPASS_MODE 4      /* read the subplan without caching */
+#define MEMO_END_OF_SCAN 5            /* nothing more until the next rescan */
+
+/* a tuple cached in an entry */
+typedef struct MemoizeTuple {
+    MinimalTuple mintuple;
+    struct MemoizeTuple* next;
+} MemoizeTuple;
+
+/* a cache entry, kept in the TupleHashTable */
+typedef struct MemoizeEntry {
+    TupleHashEntryData shared; /* common header, must be first */
+    struct MemoizeEntry* lru_prev;
+    struct MemoizeEntry* lru_next;
+    MemoizeTuple* tuplehead;
+    MemoizeTuple* tupletail;
+    int64 mem;     /* bytes used by the entry and its tuples */
+    bool complete; /* was the subplan read to its end? */
+} MemoizeEntry;
+
+/* type of a key matched by its binary image, the fn_extra of its functions */
+typedef struct MemoizeKeyType {
+    int16 typlen;
+    bool typbyval;
+} MemoizeKeyType;
+
+static bool collect_exec_params_walker(Node* node, Bitmapset** paramids)
+{
+    if (node == NULL)
+        return false;
+    if (IsA(node, Param) && ((Param*)node)->paramkind == PARAM_EXEC) {
+        *paramids = bms_add_member(*paramids, ((Param*)node)->paramid);
+        return false;
+    }
+    return expression_tree_walker(node, (bool (*)())collect_exec_params_walker, (void*)paramids);
+}
+
+/*
+ * Equality and hash of keys in binary mode.  Varlena keys are compared
+ * without their header, the cached copy of a key may have a packed one.
+ */
+static Datum memoize_binary_eq(PG_FUNCTION_ARGS)
+{
+    const MemoizeKeyType* keytype = (const MemoizeKeyType*)fcinfo->flinfo->fn_extra;
+    Datum value1 = PG_GETARG_DATUM(0);
+    Datum value2 = PG_GETARG_DATUM(1);
+    bool result = false;
+
+    if (keytype->typlen == -1) {
+        struct varlena* arg1 = PG_DETOAST_DATUM_PACKED(value1);
+        struct varlena* arg2 = PG_DETOAST_DATUM_PACKED(value2);
+        Size len = VARSIZE_ANY_EXHDR(arg1);
+
+        result = (len == VARSIZE_ANY_EXHDR(arg2) && memcmp(VARDATA_ANY(arg1), VARDATA_ANY(arg2), len) == 0);
+        if ((Pointer)arg1 != DatumGetPointer(value1))
+            pfree(arg1);
+        if ((Pointer)arg2 != DatumGetPointer(value2))
+            pfree(arg2);
+    } else {
+        result = datumIsEqual(value1, value2, keytype->typbyval, keytype->typlen);
+    }
+
+    PG_RETURN_BOOL(result);
+}
+
+static Datum memoize_binary_hash(PG_FUNCTION_ARGS)
+{
+    const MemoizeKeyType* keytype = (const MemoizeKeyType*)fcinfo->flinfo->fn_extra;
+    Datum value = PG_GETARG_DATUM(0);
+    Datum result;
+
+    if (keytype->typbyval) {
+        result = hash_any((unsigned char*)&value, sizeof(Datum));
+    } else if (keytype->typlen == -1) {
+        struct varlena* arg = PG_DETOAST_DATUM_PACKED(value);
+
+        result = hash_any((unsigned char*)VARDATA_ANY(arg), (int)VARSIZE_ANY_EXHDR(arg));
+        if ((Pointer)arg != DatumGetPointer(value))
+            pfree(arg);
+    } else {
+        result = hash_any(
+            (unsigned char*)DatumGetPointer(value), (int)datumGetSize(value, keytype->typbyval, keytype->typlen));
+    }
+
+    return result;
+}
+
+/*
+ * Match all keys by their binary image instead of by the hash operators, for
+ * caches keyed on lateral references (see get_memoize_path).
+ */
+static void memoize_use_binary_keys(MemoizeState* mstate, TupleDesc key_desc)
+{
+    for (int i = 0; i < mstate->nkeys; i++) {
+        MemoizeKeyType* keytype = (MemoizeKeyType*)palloc(sizeof(MemoizeKeyType));
+
+        keytype->typlen = key_desc->attrs[i]->attlen;
+        keytype->typbyval = key_desc->attrs[i]->attbyval;
+        mstate->eqfunctions[i].fn_addr = memoize_binary_eq;
+        mstate->eqfunctions[i].fn_extra = keytype;
+        mstate->hashfunctions[i].fn_addr = memoize_binary_hash;
+        mstate->hashfunctions[i].fn_extra = keytype;
+    }
+}
+
+static void lru_unlink(MemoizeState* node, MemoizeEntry* entry)
+{
+    if (entry->lru_prev != NULL)
+        entry->lru_prev->lru_next = entry->lru_next;
+    else
+        node->lru_head = entry->lru_next;
+    if (entry->lru_next != NULL)
+        entry->lru_next->lru_prev = entry->lru_prev;
+    else
+        node->lru_tail = entry->lru_prev;
+    entry->lru_prev = entry->lru_next = NULL;
+}
+
+static void lru_push_tail(MemoizeState* node, MemoizeEntry* entry)
+{
+    entry->lru_prev = node->lru_tail;
+    entry->lru_next = NULL;
+    if (node->lru_tail != NULL)
+        node->lru_tail->lru_next = entry;
+    else
+        node->lru_head = entry;
+    node->lru_tail = entry;
+}
+
+/*
+ * cache_reset
+ *	  Throw away all entries and build an empty hash table.
+ */
+static void cache_reset(MemoizeState* node)
+{
+    Memoize* plan = (Memoize*)node->ss.ps.plan;
+    long nbuckets = (long)Min(Max(plan->est_entries, 16.0), (double)INT_MAX);
+
+    MemoryContextResetAndDeleteChildren(node->tableContext);
+    node->hashtable = BuildTupleHashTable(node->nkeys,
+        node->keyColIdx,
+        node->eqfunctions,
+        node->hashfunctions,
+        nbuckets,
+        sizeof(MemoizeEntry),
+        node->tableContext,
+        node->tempContext,
+        (int)(node->mem_limit / 1024L));
+    node->lru_head = NULL;
+    node->lru_tail = NULL;
+    node->entry = NULL;
+    node->last_tuple = NULL;
+    node->mem_used = 0;
+}
+
+/*
+ * cache_free_tuples
+ *	  Release the tuples of an entry, leaving it empty and incomplete.
+ */
+static void cache_free_tuples(MemoizeState* node, MemoizeEntry* entry)
+{
+    MemoizeTuple* tuple = entry->tuplehead;
+
+    while (tuple != NULL) {
+        MemoizeTuple* next = tuple->next;
+        int64 size = GetMemoryChunkSpace(tuple->mintuple) + GetMemoryChunkSpace(tuple);
+
+        entry->mem -= size;
+        node->mem_used -= size;
+        pfree(tuple->mintuple);
+        pfree(tuple);
+        tuple = next;
+    }
+    entry->tuplehead = NULL;
+    entry->tupletail = NULL;
+    entry->complete = false;
+}
+
+static void cache_remove_entry(MemoizeState* node, MemoizeEntry* entry)
+{
+    MinimalTuple key = entry->shared.firstTuple;
+
+    cache_free_tuples(node, entry);
+    lru_unlink(node, entry);
+    node->mem_used -= entry->mem;
+
+    (void)ExecStoreMinimalTuple(key, node->evictslot, false);
+    RemoveTupleHashEntry(node->hashtable, node->evictslot);
+    (void)ExecClearTuple(node->evictslot);
+    pfree(key);
+}
+
+/*
+ * cache_reduce_memory
+ *	  Evict the least recently used entries, but not keep, until the cache
+ *	  fits in its memory again.  Returns false if that is impossible.
+ */
+static bool cache_reduce_memory(MemoizeState* node, MemoizeEntry* keep)
+{
+    MemoizeEntry* victim = node->lru_head;
+
+    while (node->mem_used > node->mem_limit && victim != NULL) {
+        MemoizeEntry* next = victim->lru_next;
+
+        if (victim != keep) {
+            cache_remove_entry(node, victim);
+            node->evictions++;
+        }
+        victim = next;
+    }
+
+    return node->mem_used <= node->mem_limit;
+}
+
+/*
+ * cache_store_tuple
+ *	  Append the tuple in slot to the current entry.  If the entry can't fit
+ *	  in the cache, it is removed and false is returned.
+ */
+static bool cache_store_tuple(MemoizeState* node, TupleTableSlot* slot)
+{
+    MemoizeEntry* entry = node->entry;
+    MemoryContext old_context = MemoryContextSwitchTo(node->tableContext);
+    MemoizeTuple* tuple = (MemoizeTuple*)palloc(sizeof(MemoizeTuple));
+    int64 size;
+
+    tuple->mintuple = ExecCopySlotMinimalTuple(slot);
+    tuple->next = NULL;
+    MemoryContextSwitchTo(old_context);
+
+    if (entry->tupletail != NULL)
+        entry->tupletail->next = tuple;
+    else
+        entry->tuplehead = tuple;
+    entry->tupletail = tuple;
+
+    size = GetMemoryChunkSpace(tuple->mintuple) + GetMemoryChunkSpace(tuple);
+    entry->mem += size;
+    node->mem_used += size;
+
+    if (node->mem_used > node->mem_limit && !cache_reduce_memory(node, entry)) {
+        cache_remove_entry(node, entry);
+        node->entry = NULL;
+        node->overflows++;
+        return false;
+    }
+    node->mem_peak = Max(node->mem_peak, node->mem_used);
+
+    return true;
+}
+
+/*
+ * cache_lookup
+ *	  Find or create the entry for the current parameter values.
+ */
+static MemoizeEntry* cache_lookup(MemoizeState* node, bool* found)
+{
+    ExprContext* econtext = node->ss.ps.ps_ExprContext;
+    TupleTableSlot* probeslot = node->probeslot;
+    MemoizeEntry* entry = NULL;
+    ListCell* lc = NULL;
+    bool isnew = false;
+    int i = 0;
+
+    /* evaluate the cache key into the probe slot */
+    ResetExprContext(econtext);
+    (void)ExecClearTuple(probeslot);
+    foreach (lc, node->param_exprs) {
+        ExprState* key_state = (ExprState*)lfirst(lc);
+
+        probeslot->tts_values[i] = ExecEvalExpr(key_state, econtext, &probeslot->tts_isnull[i], NULL);
+        i++;
+    }
+    (void)ExecStoreVirtualTuple(probeslot);
+
+    entry = (MemoizeEntry*)LookupTupleHashEntry(node->hashtable, probeslot, &isnew);
+    if (isnew) {
+        entry->mem = sizeof(MemoizeEntry) + GetMemoryChunkSpace(entry->shared.firstTuple);
+        node->mem_used += entry->mem;
+    } else {
+        lru_unlink(node, entry);
+    }
+    lru_push_tail(node, entry);
+    *found = !isnew;
+
+    return entry;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecMemoize
+ * ----------------------------------------------------------------
+ */
+TupleTableSlot* ExecMemoize(MemoizeState* node)
+{
+    PlanState* outer_node = outerPlanState(node);
+    TupleTableSlot* slot = NULL;
+
+    switch (node->mstatus) {
+        case MEMO_CACHE_LOOKUP: {
+            bool found = false;
+            MemoizeEntry* entry = cache_lookup(node, &found);
+
+            if (found && entry->complete) {
+                node->hits++;
+                node->entry = entry;
+                node->last_tuple = entry->tuplehead;
+                if (entry->tuplehead == NULL) {
+                    node->mstatus = MEMO_END_OF_SCAN;
+                    return NULL;
+                }
+                node->mstatus = MEMO_CACHE_FETCH_NEXT_TUPLE;
+                return ExecStoreMinimalTuple(entry->tuplehead->mintuple, node->ss.ps.ps_ResultTupleSlot, false);
+            }
+
+            /* an entry left incomplete by a scan that stopped early is refilled */
+            if (found)
+                cache_free_tuples(node, entry);
+            node->misses++;
+            node->entry = entry;
+            node->last_tuple = NULL;
+
+            slot = ExecProcNode(outer_node);
+            if (TupIsNull(slot)) {
+                entry->complete = true;
+                node->mstatus = MEMO_END_OF_SCAN;
+                return NULL;
+            }
+            node->mstatus = cache_store_tuple(node, slot) ? MEMO_FILLING_CACHE : MEMO_CACHE_BYPASS_MODE;
+            return slot;
+        }
+
+        case MEMO_CACHE_FETCH_NEXT_TUPLE:
+            node->last_tuple = node->last_tuple->next;
+            if (node->last_tuple == NULL) {
+                node->mstatus = MEMO_END_OF_SCAN;
+                return NULL;
+            }
+            return ExecStoreMinimalTuple(node->last_tuple->mintuple, node->ss.ps.ps_ResultTupleSlot, false);
+
+        case MEMO_FILLING_CACHE:
+            slot = ExecProcNode(outer_node);
+            if (TupIsNull(slot)) {
+                node->entry->complete = true;
+                node->mstatus = MEMO_END_OF_SCAN;
+                return NULL;
+            }
+            if (!cache_store_tuple(node, slot))
+                node->mstatus = MEMO_CACHE_BYPASS_MODE;
+            return slot;
+
+        case MEMO_CACHE_BYPASS_MODE:
+            slot = ExecProcNode(outer_node);
+            if (TupIsNull(slot)) {
+                node->mstatus = MEMO_END_OF_SCAN;
+                return NULL;
+            }
+            return slot;
+
+        case MEMO_END_OF_SCAN:
+            return NULL;
+
+        default:
+            ereport(ERROR,
+                (errcode(ERRCODE_UNRECOGNIZED_NODE_TYPE),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("unrecognized memoize state: %d", node->mstatus)));
+            return NULL;
+    }
+}
+
+/* ----------------------------------------------------------------
+ *		ExecInitMemoize
+ * ----------------------------------------------------------------
+ */
+MemoizeState* ExecInitMemoize(Memoize* node, EState* estate, int eflags)
+{
+    MemoizeState* mstate = makeNode(MemoizeState);
+    TupleDesc key_desc;
+    ListCell* lc = NULL;
+    int i;
+
+    /* check for unsupported flags */
+    Assert(!(eflags & (EXEC_FLAG_BACKWARD | EXEC_FLAG_MARK)));
+
+    mstate->ss.ps.plan = (Plan*)node;
+    mstate->ss.ps.state = estate;
+
+    int64 operator_mem = SET_NODEMEM(((Plan*)node)->operatorMemKB[0], ((Plan*)node)->dop);
+    AllocSetContext* set = (AllocSetContext*)(estate->es_query_cxt);
+    set->maxSpaceSize = operator_mem * 1024L + SELF_GENRIC_MEMCTX_LIMITATION;
+
+    /* the cache key expressions are evaluated in the node's ExprContext */
+    ExecAssignExprContext(estate, &mstate->ss.ps);
+
+    ExecInitResultTupleSlot(estate, &mstate->ss.ps);
+
+    outerPlanState(mstate) = ExecInitNode(outerPlan(node), estate, eflags);
+
+    /* memoize nodes don't project, the result type is the subplan's */
+    ExecAssignResultTypeFromTL(&mstate->ss.ps, ExecGetResultType(outerPlanState(mstate))->tdTableAmType);
+    mstate->ss.ps.ps_ProjInfo = NULL;
+
+    /* set up the cache keys */
+    mstate->nkeys = node->numKeys;
+    key_desc = CreateTemplateTupleDesc(node->numKeys, false);
+    i = 1;
+    foreach (lc, node->param_exprs) {
+        Node* expr = (Node*)lfirst(lc);
+
+        TupleDescInitEntry(key_desc, (AttrNumber)i, NULL, exprType(expr), exprTypmod(expr), 0);
+        i++;
+    }
+    mstate->probeslot = ExecInitExtraTupleSlot(estate);
+    ExecSetSlotDescriptor(mstate->probeslot, key_desc);
+    mstate->evictslot = ExecInitExtraTupleSlot(estate);
+    ExecSetSlotDescriptor(mstate->evictslot, key_desc);
+
+    mstate->keyColIdx = (AttrNumber*)palloc(node->numKeys * sizeof(AttrNumber));
+    for (i = 0; i < node->numKeys; i++)
+        mstate->keyColIdx[i] = (AttrNumber)(i + 1);
+    execTuplesHashPrepare(node->numKeys, node->hashOperators, &mstate->eqfunctions, &mstate->hashfunctions);
+    if (node->binary_mode)
+        memoize_use_binary_keys(mstate, key_desc);
+
+    mstate->param_exprs = (List*)ExecInitExpr((Expr*)node->param_exprs, (PlanState*)mstate);
+    (void)collect_exec_params_walker((Node*)node->param_exprs, &mstate->keyparamids);
+
+    mstate->tableContext = AllocSetContextCreate(CurrentMemoryContext,
+        "MemoizeHashTable",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+    mstate->tempContext = AllocSetContextCreate(CurrentMemoryContext,
+        "MemoizeHashTemp",
+        ALLOCSET_SMALL_MINSIZE,
+        ALLOCSET_SMALL_INITSIZE,
+        ALLOCSET_SMALL_MAXSIZE);
+    mstate->mem_limit = operator_mem * 1024L;
+    cache_reset(mstate);
+
+    mstate->mstatus = MEMO_CACHE_LOOKUP;
+
+    return mstate;
+}
+
+/*
+ * Save the cache statistics for EXPLAIN ANALYZE
+ */
+static void memoize_update_instr(MemoizeState* node)
+{
+    if (node->ss.ps.instrument != NULL) {
+        MemoizeInfo* info = &node->ss.ps.instrument->memoizeinfo;
+
+        info->hits = node->hits;
+        info->misses = node->misses;
+        info->evictions = node->evictions;
+        info->overflows = node->overflows;
+        info->spacePeak = node->mem_peak;
+    }
+}
+
+/* ----------------------------------------------------------------
+ *		ExecEndMemoize
+ * ----------------------------------------------------------------
+ */
+void ExecEndMemoize(MemoizeState* node)
+{
+    memoize_update_instr(node);
+
+    ExecFreeExprContext(&node->ss.ps);
+    (void)ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
+    (void)ExecClearTuple(node->probeslot);
+    (void)ExecClearTuple(node->evictslot);
+
+    MemoryContextDelete(node->tableContext);
+    MemoryContextDelete(node->tempContext);
+
+    ExecEndNode(outerPlanState(node));
+}
+
+/* ----------------------------------------------------------------
+ *		ExecReScanMemoize
+ * ----------------------------------------------------------------
+ */
+void ExecReScanMemoize(MemoizeState* node)
+{
+    PlanState* outer_node = outerPlanState(node);
+
+    memoize_update_instr(node);
+
+    node->mstatus = MEMO_CACHE_LOOKUP;
+    node->entry = NULL;
+    node->last_tuple = NULL;
+
+    /*
+     * If chgParam of subnode is not null then plan will be re-scanned by
+     * first ExecProcNode, which only happens on a cache miss.
+     */
+    if (outer_node->chgParam == NULL)
+        ExecReScan(outer_node);
+
+    /*
+     * A parameter outside of the cache key changed, so nothing cached is valid.
+     * The planner puts every parameter coming from the nestloop into the key, so
+     * this only happens when an upper query level hands in new values.
+     */
+    if (bms_nonempty_difference(outer_node->chgParam, node->keyparamids))
+        cache_reset(node);
+}
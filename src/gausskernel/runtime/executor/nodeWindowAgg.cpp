@@ -60,6 +60,11 @@ static void finalize_windowaggregate(WindowAggState* winstate, WindowStatePerFun
     WindowStatePerAgg peraggstate, Datum* result, bool* is_null);
 
 static void eval_windowaggregates(WindowAggState* winstate);
+static void eval_windowaggregates_sliding(WindowAggState* winstate);
+static void combine_windowaggregate(WindowAggState* winstate, WindowStatePerFunc perfuncstate,
+    WindowStatePerAgg peraggstate, Datum* value, bool* is_null, Datum new_value, bool new_is_null);
+static void flip_sliding_queue(WindowAggState* winstate);
+static void grow_sliding_queue(WindowAggState* winstate);
 static void eval_windowfunction(WindowAggState* winstate, WindowStatePerFunc perfuncstate, Datum* result, bool* is_null);
 
 static void begin_partition(WindowAggState* winstate);
@@ -261,6 +266,11 @@ static void eval_windowaggregates(WindowAggState* winstate)
     if (num_aggs == 0) {
         return; /* nothing to do */
     }
+    /* moving frame heads are handled without rerunning the aggregates */
+    if (winstate->slidingaggs) {
+        eval_windowaggregates_sliding(winstate);
+        return;
+    }
     /* final output execution is in ps_ExprContext */
     econtext = winstate->ss.ps.ps_ExprContext;
     agg_winobj = winstate->agg_winobj;
@@ -297,11 +307,9 @@ static void eval_windowaggregates(WindowAggState* winstate)
      * accumulated into the aggregate transition values.  Whenever we start a
      * new peer group, we accumulate forward to the end of the peer group.
      *
-     * Rerunning aggregates from the frame start can be pretty slow. For
-     * some aggregates like SUM and COUNT we could avoid that by implementing
-     * a "negative transition function" that would be called for each row as
-     * it exits the frame.	We'd have to think about avoiding recalculation of
-     * volatile arguments of aggregate functions, too.
+     * Rerunning aggregates from the frame start can be pretty slow, so
+     * when every aggregate has a collection function we slide the frame
+     * instead, see eval_windowaggregates_sliding.
      */
     /*
      * First, update the frame head position.
@@ -437,6 +445,310 @@ static void eval_windowaggregates(WindowAggState* winstate)
     }
 }
 
+/*
+ * combine_windowaggregate
+ * merge the transition value new_value into *value using the collection
+ * function, parallel to advance_collection_function in nodeAgg.c
+ *
+ * *value must be a copy owned by the caller, since the collection function
+ * is allowed to modify its first input in place.  new_value is not changed.
+ */
+static void combine_windowaggregate(WindowAggState* winstate, WindowStatePerFunc perfuncstate,
+    WindowStatePerAgg peraggstate, Datum* value, bool* is_null, Datum new_value, bool new_is_null)
+{
+    FunctionCallInfoData fcinfo;
+    Datum result;
+    MemoryContext old_context;
+
+    if (peraggstate->collectfn.fn_strict) {
+        /* nothing to merge for a strict collectfn */
+        if (new_is_null)
+            return;
+        if (*is_null) {
+            old_context = MemoryContextSwitchTo(winstate->aggcontext);
+            *value = datumCopy(new_value, peraggstate->transtypeByVal, peraggstate->transtypeLen);
+            *is_null = false;
+            MemoryContextSwitchTo(old_context);
+            return;
+        }
+    }
+
+    old_context = MemoryContextSwitchTo(winstate->tmpcontext->ecxt_per_tuple_memory);
+    InitFunctionCallInfoData(
+        fcinfo, &(peraggstate->collectfn), 2, perfuncstate->winCollation, (Node*)winstate, NULL);
+    fcinfo.arg[0] = *value;
+    fcinfo.argnull[0] = *is_null;
+    fcinfo.arg[1] = new_value;
+    fcinfo.argnull[1] = new_is_null;
+    result = FunctionCallInvoke(&fcinfo);
+
+    /*
+     * If pass-by-ref datatype, must copy the new value into aggcontext and
+     * pfree the prior value, unless collectfn returned its first input.
+     */
+    if (!peraggstate->transtypeByVal && DatumGetPointer(result) != DatumGetPointer(*value)) {
+        if (!fcinfo.isnull) {
+            MemoryContextSwitchTo(winstate->aggcontext);
+            result = datumCopy(result, peraggstate->transtypeByVal, peraggstate->transtypeLen);
+        }
+        if (!*is_null)
+            pfree(DatumGetPointer(*value));
+    }
+    MemoryContextSwitchTo(old_context);
+
+    *value = result;
+    *is_null = fcinfo.isnull;
+}
+
+/*
+ * Copy a transition value into aggcontext.
+ */
+static inline Datum copy_windowaggregate(WindowAggState* winstate, WindowStatePerAgg peraggstate, Datum value)
+{
+    MemoryContext old_context = MemoryContextSwitchTo(winstate->aggcontext);
+
+    value = datumCopy(value, peraggstate->transtypeByVal, peraggstate->transtypeLen);
+    MemoryContextSwitchTo(old_context);
+    return value;
+}
+
+static inline void free_windowaggregate(WindowStatePerAgg peraggstate, Datum value, bool is_null)
+{
+    if (!peraggstate->transtypeByVal && !is_null)
+        pfree(DatumGetPointer(value));
+}
+
+/*
+ * grow_sliding_queue
+ * enlarge the queue of per-row transition values, keeping the rows
+ * [aggregatedbase, aggregatedupto) at their position modulo the new size.
+ */
+static void grow_sliding_queue(WindowAggState* winstate)
+{
+    int64 old_size = winstate->slidequeuesize;
+    int64 new_size = Max(old_size * 2, 64);
+    MemoryContext old_context = MemoryContextSwitchTo(winstate->partcontext);
+
+    for (int i = 0; i < winstate->numaggs; i++) {
+        WindowStatePerAgg peraggstate = &winstate->peragg[i];
+        Datum* row_values = (Datum*)palloc(sizeof(Datum) * new_size);
+        bool* row_nulls = (bool*)palloc(sizeof(bool) * new_size);
+        Datum* suffix_values = (Datum*)palloc(sizeof(Datum) * new_size);
+        bool* suffix_nulls = (bool*)palloc(sizeof(bool) * new_size);
+
+        for (int64 pos = winstate->aggregatedbase; pos < winstate->aggregatedupto; pos++) {
+            row_values[pos % new_size] = peraggstate->rowValues[pos % old_size];
+            row_nulls[pos % new_size] = peraggstate->rowValueIsNull[pos % old_size];
+            suffix_values[pos % new_size] = peraggstate->suffixValues[pos % old_size];
+            suffix_nulls[pos % new_size] = peraggstate->suffixValueIsNull[pos % old_size];
+        }
+
+        if (old_size > 0) {
+            pfree(peraggstate->rowValues);
+            pfree(peraggstate->rowValueIsNull);
+            pfree(peraggstate->suffixValues);
+            pfree(peraggstate->suffixValueIsNull);
+        }
+        peraggstate->rowValues = row_values;
+        peraggstate->rowValueIsNull = row_nulls;
+        peraggstate->suffixValues = suffix_values;
+        peraggstate->suffixValueIsNull = suffix_nulls;
+    }
+
+    MemoryContextSwitchTo(old_context);
+    winstate->slidequeuesize = new_size;
+}
+
+/*
+ * flip_sliding_queue
+ * turn all rows of the frame into older rows, computing for each of them
+ * the combination of its own value with the values of the rows after it.
+ */
+static void flip_sliding_queue(WindowAggState* winstate)
+{
+    int64 size = winstate->slidequeuesize;
+
+    for (int i = 0; i < winstate->numaggs; i++) {
+        WindowStatePerAgg peraggstate = &winstate->peragg[i];
+        WindowStatePerFunc perfuncstate = &winstate->perfunc[peraggstate->wfuncno];
+
+        for (int64 pos = winstate->aggregatedupto - 1; pos >= winstate->aggregatedbase; pos--) {
+            int64 slot = pos % size;
+            Datum value = peraggstate->rowValues[slot];
+            bool is_null = peraggstate->rowValueIsNull[slot];
+
+            if (!is_null)
+                value = copy_windowaggregate(winstate, peraggstate, value);
+            if (pos + 1 < winstate->aggregatedupto) {
+                int64 next = (pos + 1) % size;
+
+                combine_windowaggregate(winstate, perfuncstate, peraggstate, &value, &is_null,
+                    peraggstate->suffixValues[next], peraggstate->suffixValueIsNull[next]);
+            }
+            peraggstate->suffixValues[slot] = value;
+            peraggstate->suffixValueIsNull[slot] = is_null;
+        }
+
+        free_windowaggregate(peraggstate, peraggstate->backValue, peraggstate->backValueIsNull);
+        peraggstate->backValueIsNull = true;
+    }
+    ResetExprContext(winstate->tmpcontext);
+    winstate->slidefrontend = winstate->aggregatedupto;
+}
+
+/*
+ * eval_windowaggregates_sliding
+ * evaluate plain aggregates over a frame whose head moves
+ *
+ * The rows of the frame are kept as a queue of per-row transition values,
+ * split in two parts.  For the older rows [aggregatedbase, slidefrontend)
+ * suffixValues holds the combination of each row with the older rows after
+ * it; for the newer rows [slidefrontend, aggregatedupto) backValue holds
+ * their combination.  A row entering the frame is combined into backValue,
+ * a row leaving it just drops its suffixValue, and the frame value is the
+ * suffixValue of the head combined with backValue.  When the older rows run
+ * out, the newer rows are flipped, so every row is combined a constant
+ * number of times and each output row costs O(1) amortized, whatever the
+ * frame size.  The collection function of the aggregate does the combining.
+ */
+static void eval_windowaggregates_sliding(WindowAggState* winstate)
+{
+    int num_aggs = winstate->numaggs;
+    ExprContext* econtext = winstate->ss.ps.ps_ExprContext;
+    WindowObject agg_winobj = winstate->agg_winobj;
+    TupleTableSlot* agg_row_slot = winstate->agg_row_slot;
+    int64 old_head = winstate->frameheadpos;
+    int i;
+
+    update_frameheadpos(agg_winobj, winstate->temp_slot_1);
+
+    /* The queue arrays live in partcontext, which is reset per partition */
+    if (winstate->currentpos == 0) {
+        MemoryContextResetAndDeleteChildren(winstate->aggcontext);
+        for (i = 0; i < num_aggs; i++) {
+            WindowStatePerAgg peraggstate = &winstate->peragg[i];
+
+            peraggstate->rowValues = NULL;
+            peraggstate->rowValueIsNull = NULL;
+            peraggstate->suffixValues = NULL;
+            peraggstate->suffixValueIsNull = NULL;
+            peraggstate->backValueIsNull = true;
+        }
+        winstate->slidequeuesize = 0;
+        (void)ExecClearTuple(agg_row_slot);
+        winstate->aggregatedbase = winstate->frameheadpos;
+        winstate->aggregatedupto = winstate->frameheadpos;
+        winstate->slidefrontend = winstate->frameheadpos;
+        old_head = -1;
+    }
+
+    /* Drop the rows that left the frame */
+    while (winstate->aggregatedbase < winstate->frameheadpos &&
+           winstate->aggregatedbase < winstate->aggregatedupto) {
+        int64 slot = winstate->aggregatedbase % winstate->slidequeuesize;
+
+        if (winstate->slidefrontend == winstate->aggregatedbase)
+            flip_sliding_queue(winstate);
+        for (i = 0; i < num_aggs; i++) {
+            WindowStatePerAgg peraggstate = &winstate->peragg[i];
+
+            free_windowaggregate(peraggstate, peraggstate->rowValues[slot], peraggstate->rowValueIsNull[slot]);
+            free_windowaggregate(peraggstate, peraggstate->suffixValues[slot], peraggstate->suffixValueIsNull[slot]);
+        }
+        winstate->aggregatedbase++;
+    }
+    if (winstate->aggregatedbase < winstate->frameheadpos) {
+        /* the head skipped over rows never aggregated, the queue is empty */
+        (void)ExecClearTuple(agg_row_slot);
+        winstate->aggregatedbase = winstate->frameheadpos;
+        winstate->aggregatedupto = winstate->frameheadpos;
+        winstate->slidefrontend = winstate->frameheadpos;
+    }
+
+    /* keep the mark pushed up to frame head, as eval_windowaggregates does */
+    if (agg_winobj->markptr >= 0 && winstate->frameheadpos != old_head)
+        WinSetMarkPosition(agg_winobj, winstate->frameheadpos);
+
+    /*
+     * Add the rows that entered the frame.  agg_row_slot is either empty or
+     * holds the row at position aggregatedupto.
+     */
+    for (;;) {
+        if (TupIsNull(agg_row_slot)) {
+            if (!window_gettupleslot(agg_winobj, winstate->aggregatedupto, agg_row_slot))
+                break; /* must be end of partition */
+        }
+        if (!row_is_in_frame(winstate, winstate->aggregatedupto, agg_row_slot))
+            break;
+
+        if (winstate->aggregatedupto - winstate->aggregatedbase >= winstate->slidequeuesize)
+            grow_sliding_queue(winstate);
+
+        winstate->tmpcontext->ecxt_outertuple = agg_row_slot;
+        for (i = 0; i < num_aggs; i++) {
+            WindowStatePerAgg peraggstate = &winstate->peragg[i];
+            WindowStatePerFunc perfuncstate = &winstate->perfunc[peraggstate->wfuncno];
+            int64 slot = winstate->aggregatedupto % winstate->slidequeuesize;
+
+            /* the transition value of this row alone */
+            initialize_windowaggregate(winstate, perfuncstate, peraggstate);
+            advance_windowaggregate(winstate, perfuncstate, peraggstate);
+            peraggstate->rowValues[slot] = peraggstate->transValue;
+            peraggstate->rowValueIsNull[slot] = peraggstate->transValueIsNull;
+            peraggstate->suffixValueIsNull[slot] = true;
+
+            if (winstate->slidefrontend == winstate->aggregatedupto) {
+                if (!peraggstate->transValueIsNull)
+                    peraggstate->backValue = copy_windowaggregate(winstate, peraggstate, peraggstate->transValue);
+                peraggstate->backValueIsNull = peraggstate->transValueIsNull;
+            } else {
+                combine_windowaggregate(winstate, perfuncstate, peraggstate, &peraggstate->backValue,
+                    &peraggstate->backValueIsNull, peraggstate->transValue, peraggstate->transValueIsNull);
+            }
+        }
+
+        ResetExprContext(winstate->tmpcontext);
+        winstate->aggregatedupto++;
+        (void)ExecClearTuple(agg_row_slot);
+    }
+
+    /* Combine the two parts of the queue and finalize */
+    for (i = 0; i < num_aggs; i++) {
+        WindowStatePerAgg peraggstate = &winstate->peragg[i];
+        WindowStatePerFunc perfuncstate = &winstate->perfunc[peraggstate->wfuncno];
+        bool has_front = winstate->aggregatedbase < winstate->slidefrontend;
+        bool has_back = winstate->slidefrontend < winstate->aggregatedupto;
+        bool owned = false;
+
+        if (has_front) {
+            int64 slot = winstate->aggregatedbase % winstate->slidequeuesize;
+
+            peraggstate->transValue = peraggstate->suffixValues[slot];
+            peraggstate->transValueIsNull = peraggstate->suffixValueIsNull[slot];
+            if (has_back) {
+                if (!peraggstate->transValueIsNull)
+                    peraggstate->transValue = copy_windowaggregate(winstate, peraggstate, peraggstate->transValue);
+                combine_windowaggregate(winstate, perfuncstate, peraggstate, &peraggstate->transValue,
+                    &peraggstate->transValueIsNull, peraggstate->backValue, peraggstate->backValueIsNull);
+                owned = true;
+            }
+        } else if (has_back) {
+            peraggstate->transValue = peraggstate->backValue;
+            peraggstate->transValueIsNull = peraggstate->backValueIsNull;
+        } else {
+            /* empty frame */
+            initialize_windowaggregate(winstate, perfuncstate, peraggstate);
+            owned = true;
+        }
+
+        finalize_windowaggregate(winstate, perfuncstate, peraggstate, &econtext->ecxt_aggvalues[peraggstate->wfuncno],
+            &econtext->ecxt_aggnulls[peraggstate->wfuncno]);
+        if (owned)
+            free_windowaggregate(peraggstate, peraggstate->transValue, peraggstate->transValueIsNull);
+    }
+    ResetExprContext(winstate->tmpcontext);
+}
+
 /*
  * eval_windowfunction
  *
@@ -1344,6 +1656,22 @@ WindowAggState* ExecInitWindowAgg(WindowAgg* node, EState* estate, int eflags)
     /* copy frame options to state node for easy access */
     winstate->frameOptions = node->frameOptions;
 
+    /*
+     * If the frame head can move and all aggregates can combine their
+     * transition values, slide the aggregates along with the frame instead
+     * of rerunning them.  Volatile arguments would be evaluated a different
+     * number of times, so keep the old way for them.
+     */
+    winstate->slidingaggs =
+        (winstate->numaggs > 0 && !(winstate->frameOptions & FRAMEOPTION_START_UNBOUNDED_PRECEDING));
+    for (aggno = 0; aggno < winstate->numaggs && winstate->slidingaggs; aggno++) {
+        WindowStatePerAgg peraggstate = &winstate->peragg[aggno];
+
+        if (!OidIsValid(peraggstate->collectfn_oid) ||
+            contain_volatile_functions((Node*)perfunc[peraggstate->wfuncno].wfunc))
+            winstate->slidingaggs = false;
+    }
+
     /* initialize frame bound offset expressions */
     winstate->startOffset = ExecInitExpr((Expr*)node->startOffset, (PlanState*)winstate);
     winstate->endOffset = ExecInitExpr((Expr*)node->endOffset, (PlanState*)winstate);
@@ -1442,6 +1770,10 @@ WindowStatePerAggData* initialize_peragg(WindowAggState* winstate, WindowFunc* w
     Oid transfn_oid, finalfn_oid;
     Expr* transfnexpr = NULL;
     Expr* finalfnexpr = NULL;
+#ifdef PGXC
+    Oid collectfn_oid;
+    Expr* collectfnexpr = NULL;
+#endif
     Datum text_initVal;
     int i;
     ListCell* lc = NULL;
@@ -1467,6 +1799,9 @@ WindowStatePerAggData* initialize_peragg(WindowAggState* winstate, WindowFunc* w
      */
     peraggstate->transfn_oid = transfn_oid = aggform->aggtransfn;
     peraggstate->finalfn_oid = finalfn_oid = aggform->aggfinalfn;
+#ifdef PGXC
+    peraggstate->collectfn_oid = collectfn_oid = aggform->aggcollectfn;
+#endif
 
     /* Check that aggregate owner has permission to call component fns */
     {
@@ -1490,11 +1825,27 @@ WindowStatePerAggData* initialize_peragg(WindowAggState* winstate, WindowFunc* w
             if (aclresult != ACLCHECK_OK)
                 aclcheck_error(aclresult, ACL_KIND_PROC, get_func_name(finalfn_oid));
         }
+#ifdef PGXC
+        if (OidIsValid(collectfn_oid)) {
+            aclresult = pg_proc_aclcheck(collectfn_oid, agg_owner, ACL_EXECUTE);
+            if (aclresult != ACLCHECK_OK)
+                aclcheck_error(aclresult, ACL_KIND_PROC, get_func_name(collectfn_oid));
+        }
+#endif
     }
 
     /* resolve actual type of transition state, if polymorphic */
     agg_trans_type = resolve_aggregate_transtype(wfunc->winfnoid, aggform->aggtranstype, input_types, num_arguments);
 
+#ifdef PGXC
+    /*
+     * The collection function is only used to slide the frame, which copies
+     * transition values around, so it can't work with an internal state.
+     */
+    if (agg_trans_type == INTERNALOID)
+        peraggstate->collectfn_oid = collectfn_oid = InvalidOid;
+#endif
+
     /* build expression trees using actual argument & result types */
     build_trans_aggregate_fnexprs(num_arguments,
         0, /* no ordered-set window functions yet */
@@ -1517,6 +1868,25 @@ WindowStatePerAggData* initialize_peragg(WindowAggState* winstate, WindowFunc* w
         fmgr_info_set_expr((Node*)finalfnexpr, &peraggstate->finalfn);
     }
 
+#ifdef PGXC
+    if (OidIsValid(collectfn_oid)) {
+        Expr* dummyexpr = NULL;
+
+        /* same trick as ExecInitAgg: a collectfn is a transfn of the transtype */
+        build_aggregate_fnexprs(&agg_trans_type,
+            1,
+            agg_trans_type,
+            wfunc->wintype,
+            wfunc->inputcollid,
+            collectfn_oid,
+            InvalidOid,
+            &collectfnexpr,
+            &dummyexpr);
+        fmgr_info(collectfn_oid, &peraggstate->collectfn);
+        peraggstate->collectfn.fn_expr = (Node*)collectfnexpr;
+    }
+#endif
+
     get_typlenbyval(wfunc->wintype, &peraggstate->resulttypeLen, &peraggstate->resulttypeByVal);
     get_typlenbyval(agg_trans_type, &peraggstate->transtypeLen, &peraggstate->transtypeByVal);
 
@@ -171,6 +171,14 @@ VectorBatch* VectorEngine(PlanState* node)
     result = VectorEngineRunner[GetRunnerIdx(nodeTag(node))](node);
     t_thrd.pgxc_cxt.GlobalNetInstr = NULL;
 
+    /*
+     * Only a parent which set vecAcceptSel may see a batch whose pack was deferred.
+     * Agg, join, sort and the other operators read all m_rows rows, so compact the
+     * batch for them here in case a child deferred anyway.
+     */
+    if (!BatchIsNull(result) && result->m_checkSel && !node->vecAcceptSel)
+        result->PackSelection();
+
     if (node->instrument) {
         switch (nodeTag(node)) {
             case T_VecModifyTableState:
@@ -198,7 +206,7 @@ VectorBatch* VectorEngine(PlanState* node)
                 node->instrument->firsttuple = INSTR_TIME_GET_DOUBLE(first_tuple);
                 break;
             default:
-                InstrStopNode(node->instrument, BatchIsNull(result) ? 0.0 : result->m_rows);
+                InstrStopNode(node->instrument, BatchIsNull(result) ? 0.0 : result->SelectedRows());
                 break;
         }
         node->instrument->memoryinfo.operatorMemory = node->plan->operatorMemKB[0];
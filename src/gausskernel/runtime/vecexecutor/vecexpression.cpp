@@ -363,6 +363,8 @@ static ScalarVector* ExecEvalVecScalarArrayOp(ScalarArrayOpExprState* sstate, Ex
     bool elemNull = false;
     ScalarVector* arg0 = NULL;
     ScalarVector* arg1 = NULL;
+    /* rows of the same dictionary value share one pointer, see VarMemo */
+    VarMemo memo;
 
     bool* pSel = sstate->pSel;
     bool savedUseSelection = econtext->m_fUseSelection;
@@ -433,6 +435,13 @@ static ScalarVector* ExecEvalVecScalarArrayOp(ScalarArrayOpExprState* sstate, Ex
             continue;
         }
 
+        /* the same scalar against the same array gives the same result */
+        if (sstate->vecMemo && NOT_NULL(arg0->m_flag[i]) &&
+            memo.Lookup(arg0->m_vals[i], arg1->m_vals[i], &pVector->m_vals[i], &pVector->m_flag[i])) {
+            pSel[i] = false;
+            continue;
+        }
+
         /* Get array infomation */
         if (sstate->element_type != ARR_ELEMTYPE(arr)) {
             get_typlenbyvalalign(ARR_ELEMTYPE(arr), &sstate->typlen, &sstate->typbyval, &sstate->typalign);
@@ -555,6 +564,10 @@ static ScalarVector* ExecEvalVecScalarArrayOp(ScalarArrayOpExprState* sstate, Ex
                 }
             }
         }
+
+        if (sstate->vecMemo && NOT_NULL(arg0->m_flag[i])) {
+            memo.Remember(arg0->m_vals[i], arg1->m_vals[i], pVector->m_vals[i], pVector->m_flag[i]);
+        }
     }
 
     econtext->m_fUseSelection = savedUseSelection;
@@ -2620,6 +2633,7 @@ ExprState* ExecInitVecExpr(Expr* node, PlanState* parent)
             sstate->fxprstate.func.fn_oid = InvalidOid; /* not initialized */
             sstate->element_type = InvalidOid;          /* ditto */
             sstate->pSel = (bool*)palloc(sizeof(bool) * BatchMaxSize);
+            sstate->vecMemo = (func_volatile(opexpr->opfuncid) == PROVOLATILE_IMMUTABLE);
             sstate->tmpVecLeft = New(CurrentMemoryContext) ScalarVector;
             sstate->tmpVecLeft->init(CurrentMemoryContext, desc);
             sstate->tmpVecRight = New(CurrentMemoryContext) ScalarVector;
@@ -58,6 +58,7 @@
 #include "catalog/pg_partition_fn.h"
 #include "pgxc/redistrib.h"
 #include "optimizer/pruning.h"
+#include "utils/bloom_filter.h"
 
 
 extern bool CodeGenThreadObjectReady();
@@ -68,6 +69,8 @@ static Datum GetParamExternConstValue(Oid left_type, Expr* expr, PlanState* ps,
 static void ExecInitNextPartitionForCStoreScan(CStoreScanState* node);
 static void ExecCStoreBuildScanKeys(CStoreScanState* scan_stat, List* quals, CStoreScanKey* scan_keys, int* num_scan_keys,
     CStoreScanRunTimeKeyInfo** runtime_key_info, int* runtime_keys_num);
+static void ExecCStoreInitRuntimeFilter(CStoreScanState* node);
+static void ExecCStoreApplyRuntimeFilter(CStoreScanState* node, VectorBatch* batch);
 static void ExecCStoreScanEvalRuntimeKeys(
     ExprContext* expr_ctx, CStoreScanRunTimeKeyInfo* runtime_keys, int num_runtime_keys);
 
@@ -175,6 +178,20 @@ void OptimizeProjectionAndFilter(CStoreScanState* node)
     node->m_fSimpleMap = simple_map;
 }
 
+/*
+ * @Description: Record how many rows got their late read columns filled and how
+ *               many were filtered out before, shown by EXPLAIN ANALYZE.
+ * @in node: column store scan state.
+ * @in read_rows: rows whose late read columns are filled.
+ * @in skip_rows: rows which are filtered before the late read.
+ */
+static inline void CStoreScanCountLateRead(CStoreScanState* node, uint64 read_rows, uint64 skip_rows)
+{
+    if (node->ps.instrument != NULL && node->m_CStore->GetLateReadCtid() != -1) {
+        node->ps.instrument->rcInfo.AddLateReadRows(read_rows, skip_rows);
+    }
+}
+
 VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan_batch, ExprDoneCond* done)
 {
     List* qual = NIL;
@@ -183,7 +200,9 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
     VectorBatch* p_out_batch = NULL;
     bool simple_map = false;
     int late_read_ctid = 0;
+    bool defer_pack = false;
     uint64 input_rows = p_scan_batch->m_rows;
+    uint64 qual_input_rows = 0;
 
     VECCSTORE_SCAN_TRACE_START(node, CSTORE_PROJECT);
 
@@ -198,6 +217,13 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
         }
     }
 
+    if (p_scan_batch->m_rows != 0 && node->m_runtimeFilterNum > 0) {
+        ExecCStoreApplyRuntimeFilter(node, p_scan_batch);
+    }
+
+    /* the late read counters only cover the rows the qual sees, not those dropped by runtime filters */
+    qual_input_rows = p_scan_batch->m_rows;
+
     if (p_scan_batch->m_rows != 0) {
         ResetExprContext(econtext);
         initEcontextBatch(p_scan_batch, NULL, NULL, NULL);
@@ -214,24 +240,32 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
             // If no matched rows, fetch again.
             //
             if (p_vector == NULL) {
+                if (!node->ss_deltaScan) {
+                    CStoreScanCountLateRead(node, 0, qual_input_rows);
+                }
                 p_out_batch->m_rows = 0;
                 goto done;
             }
 
             /*
-             * Call optimized PackT function when codegen is turned on.
+             * Only move the columns which are still needed after the qual. The qual-only
+             * columns are dead from here on, and the late read columns only hold the ctid
+             * until they are filled, so packing the whole batch is wasted work.
+             * When there is nothing to late read and the projection only picks
+             * columns, a parent which honors the selection vector needs no pack.
              */
             if (econtext->ecxt_scanbatch->m_sel) {
-                if (u_sess->attr.attr_sql.enable_codegen) {
-                    late_read_ctid = node->m_CStore->GetLateReadCtid();
-                    if (node->ss_deltaScan || late_read_ctid == -1) {
-                        p_scan_batch->OptimizePack(econtext->ecxt_scanbatch->m_sel, proj->pi_PackTCopyVars);
-                    } else {
-                        p_scan_batch->OptimizePackForLateRead(
-                            econtext->ecxt_scanbatch->m_sel, proj->pi_PackLateAccessVarNumbers, late_read_ctid);
-                    }
-                } else
-                    p_scan_batch->Pack(econtext->ecxt_scanbatch->m_sel);
+                late_read_ctid = node->m_CStore->GetLateReadCtid();
+                defer_pack = node->ps.vecAcceptSel && late_read_ctid == -1 &&
+                             (simple_map || proj->pi_targetlist == NIL);
+                if (defer_pack) {
+                    /* nothing to move, the output batch carries the selection */
+                } else if (node->ss_deltaScan || late_read_ctid == -1) {
+                    p_scan_batch->OptimizePack(econtext->ecxt_scanbatch->m_sel, proj->pi_PackTCopyVars);
+                } else {
+                    p_scan_batch->OptimizePackForLateRead(
+                        econtext->ecxt_scanbatch->m_sel, proj->pi_PackLateAccessVarNumbers, late_read_ctid);
+                }
             }
         }
 
@@ -239,6 +273,7 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
         // Now we have finished filter check, and then we can read other columns
         //
         if (!node->ss_deltaScan) {
+            CStoreScanCountLateRead(node, p_scan_batch->m_rows, qual_input_rows - p_scan_batch->m_rows);
             VECCSTORE_SCAN_TRACE_START(node, FILL_LATER_BATCH);
             node->m_CStore->FillScanBatchLateIfNeed(p_scan_batch);
             VECCSTORE_SCAN_TRACE_END(node, FILL_LATER_BATCH);
@@ -274,17 +309,128 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
         p_out_batch->FixRowCount();
     }
 
+    p_out_batch->m_checkSel = false;
+    if (defer_pack) {
+        p_out_batch->DeferPack(p_scan_batch->m_sel);
+    }
+
 done:
 
     VECCSTORE_SCAN_TRACE_END(node, CSTORE_PROJECT);
 
     // collect information of removed rows
-    InstrCountFiltered1(node, input_rows - p_out_batch->m_rows);
+    InstrCountFiltered1(node, input_rows - p_out_batch->SelectedRows());
 
     // Check fullness of return batch and refill it does not contain enough?
     return p_out_batch;
 }
 
+/*
+ * @Description: Collect the runtime bloom filters built by the hash joins
+ *	above this scan, see set_bloomfilter() in createplan.cpp.
+ * @in node - cstore scan state.
+ */
+static void ExecCStoreInitRuntimeFilter(CStoreScanState* node)
+{
+    Plan* plan = node->ps.plan;
+    EState* estate = node->ps.state;
+    int bf_count = list_length(plan->var_list);
+
+    node->m_runtimeFilterNum = 0;
+    if (!u_sess->attr.attr_sql.enable_bloom_filter || bf_count == 0 || estate->es_bloom_filter.bfarray == NULL) {
+        return;
+    }
+
+    Assert(bf_count == list_length(plan->filterIndexList));
+    if (node->m_runtimeFilters == NULL) {
+        node->m_runtimeFilters =
+            (filter::BloomFilter**)MemoryContextAlloc(estate->es_query_cxt, sizeof(filter::BloomFilter*) * bf_count);
+        node->m_runtimeFilterCols = (int*)MemoryContextAlloc(estate->es_query_cxt, sizeof(int) * bf_count);
+    }
+
+    for (int i = 0; i < bf_count; i++) {
+        Var* var = (Var*)list_nth(plan->var_list, i);
+        int idx = list_nth_int(plan->filterIndexList, i);
+        filter::BloomFilter* bf = estate->es_bloom_filter.bfarray[idx];
+
+        if (bf == NULL || var->varattno <= 0 || var->varattno > node->ss_currentRelation->rd_att->natts) {
+            continue;
+        }
+
+        /*
+         * The filter holds the datums of the inner join key, so it can only be
+         * probed with values of exactly the same type, e.g. not with the float4
+         * or int4 values of a column joined to a float8 key.
+         */
+        Form_pg_attribute attr = node->ss_currentRelation->rd_att->attrs[var->varattno - 1];
+        if (attr->atttypid != bf->getDataType() || attr->atttypmod != bf->getTypeMod()) {
+            continue;
+        }
+
+        /*
+         * Probing a string bloom filter converts every value to a cstring in
+         * the filter's memory context, which is not reset during the scan.
+         * So only numeric filters are applied per row.
+         */
+        switch (bf->getDataType()) {
+            case INT2OID:
+            case INT4OID:
+            case INT8OID:
+            case FLOAT4OID:
+            case FLOAT8OID:
+                break;
+            default:
+                continue;
+        }
+
+        node->m_runtimeFilters[node->m_runtimeFilterNum] = bf;
+        node->m_runtimeFilterCols[node->m_runtimeFilterNum] = var->varattno - 1;
+        node->m_runtimeFilterNum++;
+    }
+}
+
+/*
+ * @Description: Remove the rows of the scan batch that can not find a join
+ *	partner according to the runtime bloom filters. It runs before the quals,
+ *	and columns which are read late have no values yet, so they are skipped.
+ *	Null keys are left to the join.
+ * @in node - cstore scan state.
+ * @in batch - scan batch.
+ */
+static void ExecCStoreApplyRuntimeFilter(CStoreScanState* node, VectorBatch* batch)
+{
+    bool* sel = batch->m_sel;
+    int rows = batch->m_rows;
+    bool filtered = false;
+
+    for (int i = 0; i < rows; i++) {
+        sel[i] = true;
+    }
+
+    for (int i = 0; i < node->m_runtimeFilterNum; i++) {
+        int col = node->m_runtimeFilterCols[i];
+        if (!node->ss_deltaScan) {
+            int seq = node->m_CStore->GetColumnSeq(col);
+            if (seq < 0 || node->m_CStore->IsLateRead(seq)) {
+                continue;
+            }
+        }
+
+        filter::BloomFilter* bf = node->m_runtimeFilters[i];
+        ScalarVector* vec = &batch->m_arr[col];
+        for (int j = 0; j < rows; j++) {
+            if (sel[j] && NOT_NULL(vec->m_flag[j]) && !bf->includeDatum((Datum)vec->m_vals[j])) {
+                sel[j] = false;
+                filtered = true;
+            }
+        }
+    }
+
+    if (filtered) {
+        batch->Pack(sel);
+    }
+}
+
 TupleDesc BuildTupleDescByTargetList(List* tlist)
 {
     ListCell* lc = NULL;
@@ -322,6 +468,14 @@ VectorBatch* ExecCStoreScan(CStoreScanState* node)
         node->m_ScanRunTimeKeysReady = true;
     }
 
+    // The hash joins above have built their inner sides by now, pick up
+    // the bloom filters they pushed down.
+    //
+    if (!node->m_runtimeFilterReady) {
+        ExecCStoreInitRuntimeFilter(node);
+        node->m_runtimeFilterReady = true;
+    }
+
     p_out_batch = node->m_pCurrentBatch;
     p_scan_batch = node->m_pScanBatch;
 
@@ -1151,6 +1305,13 @@ void ExecReScanCStoreScan(CStoreScanState* node)
     }
     node->m_ScanRunTimeKeysReady = true;
 
+    /*
+     * The hash join may rebuild its inner side for the next outer pass, so drop
+     * the filters of the previous pass and fetch them again on the next call.
+     */
+    node->m_runtimeFilterNum = 0;
+    node->m_runtimeFilterReady = false;
+
     scan = (TableScanDesc)(node->ss_currentScanDesc);
     if (node->isPartTbl) {
         if (PointerIsValid(node->partitions)) {
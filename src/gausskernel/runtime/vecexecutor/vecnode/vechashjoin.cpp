@@ -918,6 +918,11 @@ void HashJoinTbl::PushDownFilterIfNeed()
     filter::BloomFilter** bf_array = m_runtime->bf_runtime.bf_array;
     List* bf_var_list = m_runtime->bf_runtime.bf_var_list;
 
+    /* A rebuilt hash table may not push down a filter, the one of a previous build must not filter the outer side */
+    for (int i = 0; i < list_length(bf_var_list); i++) {
+        bf_array[list_nth_int(m_runtime->bf_runtime.bf_filter_index, i)] = NULL;
+    }
+
     if (u_sess->attr.attr_sql.enable_bloom_filter && MEMORY_HASH == m_strategy && !m_complicateJoinKey &&
         list_length(m_cache) != 0 && m_rows <= DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5) {
         for (int i = 0; i < list_length(bf_var_list); i++) {
@@ -144,9 +144,13 @@ VectorBatch* ExecVecScan(ScanState* node, ExecVecScanAccessMtd accessMtd, /* fun
             result_batch = batch;
 
             /*
-             * The pack operator must be done defore the projection.
+             * The pack operator must be done defore the projection, unless the
+             * projection only picks columns and the parent honors the selection
+             * vector. Then nothing is moved here at all.
              */
-            if (econtext->ecxt_scanbatch->m_sel) {
+            bool defer_pack = (qual != NULL && node->ps.vecAcceptSel &&
+                               (proj_info == NULL || proj_info->pi_targetlist == NIL));
+            if (econtext->ecxt_scanbatch->m_sel && !defer_pack) {
                 econtext->ecxt_scanbatch->Pack(econtext->ecxt_scanbatch->m_sel);
             }
 
@@ -161,6 +165,11 @@ VectorBatch* ExecVecScan(ScanState* node, ExecVecScanAccessMtd accessMtd, /* fun
                 result_batch->FixRowCount();
             }
 
+            result_batch->m_checkSel = false;
+            if (defer_pack) {
+                result_batch->DeferPack(batch->m_sel);
+            }
+
             if (result_batch->m_rows > 0) {
                 /*
                  * @hdfs
@@ -171,6 +180,7 @@ VectorBatch* ExecVecScan(ScanState* node, ExecVecScanAccessMtd accessMtd, /* fun
                     foreign_scan = (ForeignScan*)(node->ps.plan);
                     if (foreign_scan->scan.scan_qual_optimized) {
                         node->is_scan_end = true;
+                        result_batch->PackSelection();
                         result_batch->m_rows = 1;
                     }
                 }
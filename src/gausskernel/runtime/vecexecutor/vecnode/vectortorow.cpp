@@ -106,6 +106,16 @@ void DevectorizeOneBatch(VecToRowState* state)
     MemoryContext old_context;
 
     current_batch = state->m_pCurrentBatch;
+
+    /*
+     * If the child deferred its pack, converting the unselected rows too is
+     * cheaper than packing as long as most of the rows are selected. They are
+     * skipped when the tuples are returned.
+     */
+    if (current_batch->m_checkSel && current_batch->SelectedRows() * 2 < current_batch->m_rows) {
+        current_batch->PackSelection();
+    }
+
     rows = current_batch->m_rows;
     cols = state->nattrs;
 
@@ -136,6 +146,17 @@ void DevectorizeOneBatch(VecToRowState* state)
     return;
 }
 
+/* Move the current row past the rows the child filtered out. */
+static inline void VecToRowSkipUnselected(VecToRowState* state)
+{
+    VectorBatch* current_batch = state->m_pCurrentBatch;
+
+    if (current_batch->m_checkSel) {
+        while (state->m_currentRow < current_batch->m_rows && !current_batch->m_sel[state->m_currentRow])
+            state->m_currentRow++;
+    }
+}
+
 TupleTableSlot* ExecVecToRow(VecToRowState* state) /* return: a tuple or NULL */
 {
     PlanState* outer_plan = NULL;
@@ -154,6 +175,7 @@ TupleTableSlot* ExecVecToRow(VecToRowState* state) /* return: a tuple or NULL */
         state->m_currentRow = 0;
         // Convert the batch into row based tuple
         DevectorizeOneBatch(state);
+        VecToRowSkipUnselected(state);
     }
 
     // retrieve rows from current batch
@@ -164,10 +186,12 @@ TupleTableSlot* ExecVecToRow(VecToRowState* state) /* return: a tuple or NULL */
         tuple->tts_isnull[i] = state->m_ttsisnull[tuple_subscript + i];
     }
     state->m_currentRow++;
+    VecToRowSkipUnselected(state);
 
     if (state->m_currentRow >= current_batch->m_rows) {
         // make it empty as all rows in the batch done
         current_batch->m_rows = 0;
+        current_batch->m_checkSel = false;
         state->m_currentRow = 0;
     }
 
@@ -241,6 +265,7 @@ VecToRowState* ExecInitVecToRow(VecToRow* node, EState* estate, int eflags)
     if ((uint32)eflags & EXEC_FLAG_BACKWARD)
         ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("column store doesn't support backward scan")));
     outerPlanState(state) = ExecInitNode(outerPlan(node), estate, eflags);
+    outerPlanState(state)->vecAcceptSel = true;
 
     RecordCstorePartNum(state, node);
 
@@ -120,6 +120,9 @@ vbpchar_sop(PG_FUNCTION_ARGS)
 	Oid				collation = PG_GET_COLLATION();
 	int				i;
 	bool			result = false;
+	/* rows of the same dictionary value share one pointer, compare them once */
+	VarMemo			memo;
+	uint8			memo_flag;
 	
 
     if(likely(pselection == NULL))
@@ -128,10 +131,14 @@ vbpchar_sop(PG_FUNCTION_ARGS)
 		{
 			if (BOTH_NOT_NULL(pflags1[i], pflags2[i]))
 			{
-				value1= ScalarVector::Decode(parg1[i]);
-				value2 = ScalarVector::Decode(parg2[i]);
-				result = bpchar_sop<sop>(value1, value2, collation);
-				presult[i] = result;
+				if (!memo.Lookup(parg1[i], parg2[i], &presult[i], &memo_flag))
+				{
+					value1= ScalarVector::Decode(parg1[i]);
+					value2 = ScalarVector::Decode(parg2[i]);
+					result = bpchar_sop<sop>(value1, value2, collation);
+					presult[i] = result;
+					memo.Remember(parg1[i], parg2[i], presult[i], 0);
+				}
 				SET_NOTNULL(pflag[i]);
 			}
 			else
@@ -146,10 +153,14 @@ vbpchar_sop(PG_FUNCTION_ARGS)
 			{
 				if (BOTH_NOT_NULL(pflags1[i], pflags2[i]))
 				{
-					value1= ScalarVector::Decode(parg1[i]);
-					value2 = ScalarVector::Decode(parg2[i]);
-					result = bpchar_sop<sop>(value1, value2, collation);
-					presult[i] = result;
+					if (!memo.Lookup(parg1[i], parg2[i], &presult[i], &memo_flag))
+					{
+						value1= ScalarVector::Decode(parg1[i]);
+						value2 = ScalarVector::Decode(parg2[i]);
+						result = bpchar_sop<sop>(value1, value2, collation);
+						presult[i] = result;
+						memo.Remember(parg1[i], parg2[i], presult[i], 0);
+					}
 					SET_NOTNULL(pflag[i]);
 				}
 				else
@@ -184,6 +195,9 @@ vtext_sop(PG_FUNCTION_ARGS)
 	Oid          	collation = PG_GET_COLLATION();
 	int				i;
 	bool			result = false;
+	/* rows of the same dictionary value share one pointer, compare them once */
+	VarMemo			memo;
+	uint8			memo_flag;
 
     if(likely(pselection == NULL))
     {
@@ -191,10 +205,14 @@ vtext_sop(PG_FUNCTION_ARGS)
 		{
 			if (BOTH_NOT_NULL(pflags1[i], pflags2[i]))
 			{
-				value1= ScalarVector::Decode(parg1[i]);
-				value2 = ScalarVector::Decode(parg2[i]);
-				result = text_sop<sop>(value1, value2, collation);
-				presult[i] = result;
+				if (!memo.Lookup(parg1[i], parg2[i], &presult[i], &memo_flag))
+				{
+					value1= ScalarVector::Decode(parg1[i]);
+					value2 = ScalarVector::Decode(parg2[i]);
+					result = text_sop<sop>(value1, value2, collation);
+					presult[i] = result;
+					memo.Remember(parg1[i], parg2[i], presult[i], 0);
+				}
 				SET_NOTNULL(pflag[i]);
 			}
 			else
@@ -209,10 +227,14 @@ vtext_sop(PG_FUNCTION_ARGS)
 			{
 				if (BOTH_NOT_NULL(pflags1[i], pflags2[i]))
 				{
-					value1= ScalarVector::Decode(parg1[i]);
-					value2 = ScalarVector::Decode(parg2[i]);
-					result = text_sop<sop>(value1, value2, collation);
-					presult[i] = result;
+					if (!memo.Lookup(parg1[i], parg2[i], &presult[i], &memo_flag))
+					{
+						value1= ScalarVector::Decode(parg1[i]);
+						value2 = ScalarVector::Decode(parg2[i]);
+						result = text_sop<sop>(value1, value2, collation);
+						presult[i] = result;
+						memo.Remember(parg1[i], parg2[i], presult[i], 0);
+					}
 					SET_NOTNULL(pflag[i]);
 				}
 				else
@@ -563,6 +563,47 @@ void VectorBatch::Pack(const bool* sel)
         PackT<true, true>(sel);
 }
 
+/*
+ * @Description	: Defer the pack of the batch. Packing moves every column of every
+ *				  selected row, so when the consumer can skip the unselected rows by
+ *				  itself the copy is just wasted.
+ * @in sel		: flag which row is selected, may be m_sel itself.
+ */
+void VectorBatch::DeferPack(const bool* sel)
+{
+    if (sel != m_sel) {
+        errno_t rc = memcpy_s(m_sel, BatchMaxSize * sizeof(bool), sel, m_rows * sizeof(bool));
+        securec_check(rc, "\0", "\0");
+    }
+    m_checkSel = true;
+}
+
+/*
+ * @Description	: Pack the batch whose pack was deferred. Columns of a projected
+ *				  batch may share the same values, that is fine since the rows are
+ *				  moved one by one.
+ */
+void VectorBatch::PackSelection()
+{
+    if (m_checkSel) {
+        m_checkSel = false;
+        Pack(m_sel);
+    }
+}
+
+int VectorBatch::SelectedRows() const
+{
+    int rows = 0;
+
+    if (!m_checkSel)
+        return m_rows;
+
+    for (int i = 0; i < m_rows; i++)
+        rows += m_sel[i] ? 1 : 0;
+
+    return rows;
+}
+
 void VectorBatch::CreateSysColContainer(MemoryContext cxt, List* sys_var_list)
 {
     ListCell* c = NULL;
@@ -364,16 +364,16 @@ void SonicHash::hashInteger(char* val, uint8* flag, int nval, uint32* res, FmgrI
     containerType* arrval = (containerType*)val;
     uint32* res1 = res;
 
+    /*
+     * Compute the crc for null values too and select the result afterwards,
+     * so that the loop has no data dependent branch and the crc instructions
+     * of adjacent rows can be pipelined.
+     */
     for (int i = 0; i < nval; i++) {
-        if (likely(NOT_NULL(*flag))) {
-            if (rehash)
-                *res1 = HASH_INT32_CRC(*res1, (uint32)(realType)(*arrval));
-            else
-                *res1 = HASH_INT32_CRC(HASH_CRC_SEED, (uint32)(realType)(*arrval));
-        } else {
-            if (!rehash)
-                *res1 = 0;
-        }
+        uint32 seed = rehash ? *res1 : HASH_CRC_SEED;
+        uint32 hash_val = HASH_INT32_CRC(seed, (uint32)(realType)(*arrval));
+        uint32 null_val = rehash ? *res1 : 0;
+        *res1 = NOT_NULL(*flag) ? hash_val : null_val;
         res1++;
         arrval++;
         flag++;
@@ -393,19 +393,15 @@ void SonicHash::hashInteger8(char* val, uint8* flag, int nval, uint32* res, Fmgr
     int64* arrval = (int64*)val;
     uint32* res1 = res;
 
+    /* Branch free as in hashInteger. */
     for (int i = 0; i < nval; i++) {
-        if (likely(NOT_NULL(*flag))) {
-            uint32 lohalf = (uint32)(*arrval);
-            uint32 hihalf = (uint32)((unsigned int64)(*arrval) >> 32);
-            lohalf ^= (*arrval >= 0) ? hihalf : ~hihalf;
-            if (rehash)
-                *res1 = HASH_INT32_CRC(*res1, lohalf);
-            else
-                *res1 = HASH_INT32_CRC(HASH_CRC_SEED, lohalf);
-        } else {
-            if (!rehash)
-                *res1 = 0;
-        }
+        uint32 lohalf = (uint32)(*arrval);
+        uint32 hihalf = (uint32)((unsigned int64)(*arrval) >> 32);
+        lohalf ^= (*arrval >= 0) ? hihalf : ~hihalf;
+        uint32 seed = rehash ? *res1 : HASH_CRC_SEED;
+        uint32 hash_val = HASH_INT32_CRC(seed, lohalf);
+        uint32 null_val = rehash ? *res1 : 0;
+        *res1 = NOT_NULL(*flag) ? hash_val : null_val;
         res1++;
         arrval++;
         flag++;
@@ -471,16 +467,22 @@ inline void SonicHash::hashbpchar(char* val, uint8* flag, int nval, uint32* res,
     char* key_data = NULL;
     int key_len;
     uint32* res1 = res;
+    /* rows of the same dictionary value share one pointer, hash them once */
+    VarMemo memo;
+    ScalarValue seed;
+    ScalarValue hash_val;
+    uint8 memo_flag;
 
     for (int i = 0; i < nval; i++) {
         if (likely(NOT_NULL(*flag))) {
-            key_data = VARDATA_ANY((BpChar*)*key);
-            key_len = bcTruelen((BpChar*)*key);
-
-            if (rehash)
-                *res1 = hashquickany(*res1, (unsigned char*)key_data, key_len);
-            else
-                *res1 = hashquickany(HASH_CRC_SEED, (unsigned char*)key_data, key_len);
+            seed = rehash ? *res1 : HASH_CRC_SEED;
+            if (!memo.Lookup(*key, seed, &hash_val, &memo_flag)) {
+                key_data = VARDATA_ANY((BpChar*)*key);
+                key_len = bcTruelen((BpChar*)*key);
+                hash_val = hashquickany((uint32)seed, (unsigned char*)key_data, key_len);
+                memo.Remember(*key, seed, hash_val, 0);
+            }
+            *res1 = (uint32)hash_val;
         } else {
             if (!rehash)
                 *res1 = 0;
@@ -506,16 +508,22 @@ inline void SonicHash::hashtext(char* val, uint8* flag, int nval, uint32* res, F
     char* key_data = NULL;
     int key_len;
     uint32* res1 = res;
+    /* rows of the same dictionary value share one pointer, hash them once */
+    VarMemo memo;
+    ScalarValue seed;
+    ScalarValue hash_val;
+    uint8 memo_flag;
 
     for (int i = 0; i < nval; i++) {
         if (likely(NOT_NULL(*flag))) {
-            key_data = VARDATA_ANY((text*)*key);
-            key_len = VARSIZE_ANY_EXHDR((text*)*key);
-
-            if (rehash)
-                *res1 = hashquickany(*res1, (unsigned char*)key_data, key_len);
-            else
-                *res1 = hashquickany(HASH_CRC_SEED, (unsigned char*)key_data, key_len);
+            seed = rehash ? *res1 : HASH_CRC_SEED;
+            if (!memo.Lookup(*key, seed, &hash_val, &memo_flag)) {
+                key_data = VARDATA_ANY((text*)*key);
+                key_len = VARSIZE_ANY_EXHDR((text*)*key);
+                hash_val = hashquickany((uint32)seed, (unsigned char*)key_data, key_len);
+                memo.Remember(*key, seed, hash_val, 0);
+            }
+            *res1 = (uint32)hash_val;
         } else {
             if (!rehash)
                 *res1 = 0;
@@ -543,16 +551,22 @@ inline void SonicHash::hashtext_compatible(char* val, uint8* flag, int nval, uin
     char* key_data = NULL;
     int key_len;
     uint32* res1 = res;
+    /* rows of the same dictionary value share one pointer, hash them once */
+    VarMemo memo;
+    ScalarValue seed;
+    ScalarValue hash_val;
+    uint8 memo_flag;
 
     for (int i = 0; i < nval; i++) {
         if (likely(NOT_NULL(*flag))) {
-            key_data = VARDATA_ANY((text*)*key);
-            key_len = bcTruelen((text*)*key);
-
-            if (rehash)
-                *res1 = hashquickany(*res1, (unsigned char*)key_data, key_len);
-            else
-                *res1 = hashquickany(HASH_CRC_SEED, (unsigned char*)key_data, key_len);
+            seed = rehash ? *res1 : HASH_CRC_SEED;
+            if (!memo.Lookup(*key, seed, &hash_val, &memo_flag)) {
+                key_data = VARDATA_ANY((text*)*key);
+                key_len = bcTruelen((text*)*key);
+                hash_val = hashquickany((uint32)seed, (unsigned char*)key_data, key_len);
+                memo.Remember(*key, seed, hash_val, 0);
+            }
+            *res1 = (uint32)hash_val;
         } else {
             if (!rehash)
                 *res1 = 0;
@@ -1179,6 +1179,22 @@ inline VectorBatch* SonicHashJoin::probeMemoryTable(SonicHashSource* probeP)
                 loc3 = m_hashVal;
                 loc1 = m_selectIndx;
                 loc2 = m_loc;
+
+                /*
+                 * Compute all bucket positions of the batch first, and fetch
+                 * the bucket heads SONIC_PROBE_PREFETCH_DISTANCE rows ahead
+                 * of their use, so the cache misses on the (large) bucket
+                 * array overlap with each other.
+                 */
+                if (!isSegHashTable) {
+                    for (int i = 0; i < nrows; i++) {
+                        m_partLoc[i] = GETLOCID(m_hashVal[i], mask);
+                    }
+                    for (int i = 0; i < nrows && i < SONIC_PROBE_PREFETCH_DISTANCE; i++) {
+                        SonicPrefetch(&hashBucket[m_partLoc[i]]);
+                    }
+                }
+
                 /*
                  * Iterate probe data to find whether
                  * the hash value between build and probe is same.
@@ -1187,7 +1203,10 @@ inline VectorBatch* SonicHashJoin::probeMemoryTable(SonicHashSource* probeP)
                     if (isSegHashTable) {
                         loc_id = (BucketType)mem_partition->m_segBucket->getNthDatum(GETLOCID(*loc3, mask));
                     } else {
-                        loc_id = hashBucket[GETLOCID(*loc3, mask)];
+                        if (i + SONIC_PROBE_PREFETCH_DISTANCE < nrows) {
+                            SonicPrefetch(&hashBucket[m_partLoc[i + SONIC_PROBE_PREFETCH_DISTANCE]]);
+                        }
+                        loc_id = hashBucket[m_partLoc[i]];
                     }
 
                     /*
@@ -1529,6 +1548,9 @@ inline VectorBatch* SonicHashJoin::innerJoin(VectorBatch* batch)
             if (isSegHashTable) {
                 loc_id = (BucketType)mem_partition->m_segNext->getNthDatum(*loc2++);
             } else {
+                if (i + SONIC_PROBE_PREFETCH_DISTANCE < m_selectRows) {
+                    SonicPrefetch(&hashNext[m_loc[i + SONIC_PROBE_PREFETCH_DISTANCE]]);
+                }
                 loc_id = hashNext[*loc2++];
             }
 
@@ -2787,6 +2809,11 @@ void SonicHashJoin::pushDownFilterIfNeed()
     ScalarValue val;
     SonicHashMemPartition* mem_partition = NULL;
 
+    /* A rebuilt hash table may not push down a filter, the one of a previous build must not filter the outer side */
+    for (int i = 0; i < list_length(bf_var_list); i++) {
+        bf_array[list_nth_int(m_runtime->bf_runtime.bf_filter_index, i)] = NULL;
+    }
+
     if (u_sess->attr.attr_sql.enable_bloom_filter && MEMORY_HASH == m_strategy && !m_complicatekey &&
         m_rows <= DEFAULT_ORC_BLOOM_FILTER_ENTRIES * 5) {
         Assert(m_probeIdx == 0);
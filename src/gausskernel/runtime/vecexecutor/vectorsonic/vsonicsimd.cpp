@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ *
+ * -------------------------------------------------------------------------
+ * vsonicsimd.cpp
+ *              Batched probe kernels for sonic hash join.
+ *              The kernel used is chosen on the first call, the same way
+ *              as pg_comp_crc32c does.
+ *
+ * IDENTIFICATION
+ *      Code/src/gausskernel/runtime/vecexecutor/vectorsonic/vsonicsimd.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "c.h"
+#include "vectorsonic/vsonicsimd.h"
+#ifdef __aarch64__
+#include <arm_neon.h>
+#else
+#include <immintrin.h>
+#endif
+
+/*
+ * @Description: Combine the key comparison result of one candidate
+ * 	with its null flags and the former match result.
+ */
+static FORCE_INLINE void sonic_match_lane(const uint8* outerFlag, const uint16* selIdx, const uint8* innerFlag,
+    bool* match, int i, bool keyEqual, bool nullEqNull)
+{
+    uint8 oflag = outerFlag[selIdx[i]];
+    bool notnullcheck = BOTH_NOT_NULL(oflag, innerFlag[i]);
+    bool nullcheck = nullEqNull && BOTH_NULL((unsigned char)oflag, (unsigned char)innerFlag[i]);
+
+    match[i] = match[i] && (nullcheck || (notnullcheck && keyEqual));
+}
+
+/*
+ * @Description: Scalar version of key matching. Also used for the tail
+ * 	rows of the vectorized versions.
+ */
+void sonic_match_int_key_scalar(const ScalarValue* outerVals, const uint8* outerFlag, const uint16* selIdx,
+    const Datum* innerVals, const uint8* innerFlag, bool* match, int nrows, uint64 keyMask, bool nullEqNull)
+{
+    for (int i = 0; i < nrows; i++) {
+        bool key_equal = ((((uint64)outerVals[selIdx[i]]) ^ ((uint64)innerVals[i])) & keyMask) == 0;
+        sonic_match_lane(outerFlag, selIdx, innerFlag, match, i, key_equal, nullEqNull);
+    }
+}
+
+#ifdef __aarch64__
+
+/*
+ * @Description: NEON version of key matching, two keys per compare.
+ * 	NEON has no gather load, so the probe keys are collected first.
+ */
+static void sonic_match_int_key_neon(const ScalarValue* outerVals, const uint8* outerFlag, const uint16* selIdx,
+    const Datum* innerVals, const uint8* innerFlag, bool* match, int nrows, uint64 keyMask, bool nullEqNull)
+{
+    uint64 outer_keys[2];
+    uint64x2_t mask = vdupq_n_u64(keyMask);
+    int i = 0;
+
+    for (; i + 2 <= nrows; i += 2) {
+        outer_keys[0] = (uint64)outerVals[selIdx[i]];
+        outer_keys[1] = (uint64)outerVals[selIdx[i + 1]];
+
+        uint64x2_t outer = vld1q_u64(outer_keys);
+        uint64x2_t inner = vld1q_u64((const uint64*)(innerVals + i));
+        uint64x2_t diff = vandq_u64(veorq_u64(outer, inner), mask);
+        uint64x2_t eq = vceqq_u64(diff, vdupq_n_u64(0));
+
+        sonic_match_lane(outerFlag, selIdx, innerFlag, match, i, vgetq_lane_u64(eq, 0) != 0, nullEqNull);
+        sonic_match_lane(outerFlag, selIdx, innerFlag, match, i + 1, vgetq_lane_u64(eq, 1) != 0, nullEqNull);
+    }
+
+    sonic_match_int_key_scalar(outerVals, outerFlag, selIdx + i, innerVals + i, innerFlag + i, match + i,
+        nrows - i, keyMask, nullEqNull);
+}
+
+SonicMatchIntKeyFunc sonic_match_int_key = sonic_match_int_key_neon;
+
+#else
+
+/*
+ * @Description: AVX2 version of key matching. The probe keys are
+ * 	gathered through the selection index, four keys per compare.
+ */
+__attribute__((target("avx2"))) static void sonic_match_int_key_avx2(const ScalarValue* outerVals,
+    const uint8* outerFlag, const uint16* selIdx, const Datum* innerVals, const uint8* innerFlag, bool* match,
+    int nrows, uint64 keyMask, bool nullEqNull)
+{
+    const __m256i mask = _mm256_set1_epi64x((long long)keyMask);
+    const __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+
+    for (; i + 4 <= nrows; i += 4) {
+        __m128i idx = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(selIdx + i)));
+        __m256i outer = _mm256_i32gather_epi64((const long long*)outerVals, idx, sizeof(ScalarValue));
+        __m256i inner = _mm256_loadu_si256((const __m256i*)(innerVals + i));
+        __m256i diff = _mm256_and_si256(_mm256_xor_si256(outer, inner), mask);
+        int eq_bits = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(diff, zero)));
+
+        for (int j = 0; j < 4; j++) {
+            sonic_match_lane(outerFlag, selIdx, innerFlag, match, i + j, ((eq_bits >> j) & 1) != 0, nullEqNull);
+        }
+    }
+
+    sonic_match_int_key_scalar(outerVals, outerFlag, selIdx + i, innerVals + i, innerFlag + i, match + i,
+        nrows - i, keyMask, nullEqNull);
+}
+
+/*
+ * This gets called on the first call. It replaces the function pointer
+ * so that subsequent calls are routed directly to the chosen implementation.
+ */
+static void sonic_match_int_key_choose(const ScalarValue* outerVals, const uint8* outerFlag, const uint16* selIdx,
+    const Datum* innerVals, const uint8* innerFlag, bool* match, int nrows, uint64 keyMask, bool nullEqNull)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        sonic_match_int_key = sonic_match_int_key_avx2;
+    } else {
+        sonic_match_int_key = sonic_match_int_key_scalar;
+    }
+
+    sonic_match_int_key(outerVals, outerFlag, selIdx, innerVals, innerFlag, match, nrows, keyMask, nullEqNull);
+}
+
+SonicMatchIntKeyFunc sonic_match_int_key = sonic_match_int_key_choose;
+
+#endif /* __aarch64__ */
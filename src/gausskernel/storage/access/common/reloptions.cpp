@@ -117,6 +117,11 @@ static relopt_int intRelOpts[] = {
      BTREE_DEFAULT_FILLFACTOR,
      BTREE_MIN_FILLFACTOR,
      100 },
+    {{ "parallel_workers", "Number of threads sorting in parallel while building this btree index",
+       RELOPT_KIND_BTREE },
+     0,
+     0,
+     BTREE_MAX_SORT_WORKERS },
     {{ "fillfactor", "Packs hash index pages only to this percentage", RELOPT_KIND_HASH },
      HASH_DEFAULT_FILLFACTOR,
      HASH_MIN_FILLFACTOR,
@@ -1584,6 +1589,7 @@ bytea *default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         { "gather_interval", RELOPT_TYPE_STRING, offsetof(StdRdOptions, gather_interval) },
         { "version", RELOPT_TYPE_STRING, offsetof(StdRdOptions, version) },
         { "compresslevel", RELOPT_TYPE_INT, offsetof(StdRdOptions, compresslevel) },
+        { "parallel_workers", RELOPT_TYPE_INT, offsetof(StdRdOptions, parallel_workers) },
         { "ignore_enable_hadoop_env", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, ignore_enable_hadoop_env) },
         { "append_mode", RELOPT_TYPE_STRING, offsetof(StdRdOptions, append_mode) },
         { "merge_list", RELOPT_TYPE_STRING, offsetof(StdRdOptions, merge_list) },
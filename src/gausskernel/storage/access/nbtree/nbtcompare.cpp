@@ -82,6 +82,7 @@ Datum btint2sortsupport(PG_FUNCTION_ARGS)
     SortSupport ssup = (SortSupport)PG_GETARG_POINTER(0);
 
     ssup->comparator = btint2fastcmp;
+    ssup->ssup_int_width = sizeof(int16);
     PG_RETURN_VOID();
 }
 
@@ -114,6 +115,7 @@ Datum btint4sortsupport(PG_FUNCTION_ARGS)
     SortSupport ssup = (SortSupport)PG_GETARG_POINTER(0);
 
     ssup->comparator = btint4fastcmp;
+    ssup->ssup_int_width = sizeof(int32);
     PG_RETURN_VOID();
 }
 
@@ -146,6 +148,7 @@ Datum btint8sortsupport(PG_FUNCTION_ARGS)
     SortSupport ssup = (SortSupport)PG_GETARG_POINTER(0);
 
     ssup->comparator = btint8fastcmp;
+    ssup->ssup_int_width = sizeof(int64);
     PG_RETURN_VOID();
 }
 
@@ -36,6 +36,7 @@
 #include "gds_mt.h"
 #include "package.h"
 #include "utils/memutils.h"
+#include "port/pg_bytescan.h"
 #endif
 
 #ifdef OBS_SERVER
@@ -45,6 +46,7 @@
 #include "access/obs/obs_am.h"
 #include "commands/obs_stream.h"
 #include "utils/plog.h"
+#include "port/pg_bytescan.h"
 #endif
 
 #ifdef WIN32
@@ -64,7 +66,6 @@
 #define MAX_SEGMENT_NUM 2147483600
 #define SEGMENT_SIZE 2147483648
 #define FILEHEADER_BUF_SIZE (1024 * 1024)
-#define CHUNK_SZ 128
 #define InvalidSymbol "../"
 const int GDS_HEADER_LEN = 4;
 
@@ -111,23 +112,17 @@ static void NopCleanup(Parser* self);
 
 static char* FindEolChar(char* s, size_t len, const char* eol, int* eol_cur, int* eol_cur_saved)
 {
-    char* end = NULL;
-    char* cr = NULL;
-    char* lf = NULL;
-    end = s + len;
     if (eol == NULL) {
-        while (s < end) {
-            size_t chunk = (s + CHUNK_SZ < end) ? CHUNK_SZ : (end - s);
-            cr = (char*)memchr(s, '\r', chunk);
-            lf = (char*)memchr(s, '\n', chunk);
-            if (cr != NULL) {
-                if (lf != NULL && lf < cr)
-                    return lf;
-                return cr;
-            } else if (lf != NULL)
-                return lf;
-            s += CHUNK_SZ;
-        }
+        /* one pass for both \r and \n */
+        PgByteScanSet eolChars;
+        size_t plain;
+
+        pg_bytescan_init(&eolChars, false);
+        pg_bytescan_add(&eolChars, '\r');
+        pg_bytescan_add(&eolChars, '\n');
+        plain = pg_skip_plain_bytes(s, len, &eolChars);
+        if (plain < len)
+            return s + plain;
     } else {
         int eol_len = strlen(eol);
         *eol_cur_saved = *eol_cur;
@@ -536,6 +531,14 @@ inline static ParserResult CSVReadLine(CSVParser* self, LineBuffer& buf)
     char c;
     int begin_index = self->cur;
     int raw_buf_ptr = self->cur_need_flush;
+    PgByteScanSet special;
+
+    /* the bytes that can change the quoting or end the line */
+    pg_bytescan_init(&special, false);
+    pg_bytescan_add(&special, quotec);
+    pg_bytescan_add(&special, escapec);
+    pg_bytescan_add(&special, '\n');
+    pg_bytescan_add(&special, '\r');
 
     /*
      * Flush already parsed lines to LineBuffer
@@ -605,6 +608,20 @@ inline static ParserResult CSVReadLine(CSVParser* self, LineBuffer& buf)
             continue;
         }
 
+        /* any byte ends the line right after a \r, otherwise step over the plain ones */
+        if (!*in_cr) {
+            int nplain = (int)pg_skip_plain_bytes(raw_buffer + raw_buf_ptr, self->used_len - raw_buf_ptr, &special);
+
+            if (nplain > 0) {
+                raw_buf_ptr += nplain;
+                *last_was_esc = false;
+                if (raw_buf_ptr == self->used_len) {
+                    need_data = true;
+                    continue;
+                }
+            }
+        }
+
         c = raw_buffer[raw_buf_ptr++];
 
         // is escape char
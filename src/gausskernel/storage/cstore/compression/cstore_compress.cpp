@@ -858,7 +858,7 @@ int StringCoder::Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg
     int outSize = dict->Decompress((char*)m_dicCodes, m_dicCodesNum * sizeof(DicCodeType), out.buf, out.sz);
     delete dict;
 
-    if (m_dicCodes) {
+    if (m_dicCodes && !m_keep_dict_codes) {
         pfree(m_dicCodes);
         m_dicCodes = NULL;
     }
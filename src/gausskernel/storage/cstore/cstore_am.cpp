@@ -56,6 +56,7 @@
 #include "vecexecutor/vecnodes.h"
 #include "vecexecutor/vecnoderowtovector.h"
 #include "access/cstore_roughcheck_func.h"
+#include "utils/bloom_filter.h"
 #include "utils/snapmgr.h"
 #include "catalog/storage.h"
 #include "miscadmin.h"
@@ -1183,6 +1184,43 @@ bool CStore::RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx)
     return hitCU;
 }
 
+/*
+ * @Description: check CU min/max against the value range of runtime bloom
+ *	filters pushed down from hash joins. Only integer columns are checked,
+ *	because the bloom filter keeps its min/max as int64 for them.
+ * @Param[IN] state: cstore scan state holding the runtime filters
+ * @Param[IN] cuDescIdx: index of load cudesc info
+ * @Return: true--hit, false--not hit
+ */
+bool CStore::RuntimeFilterRoughCheck(CStoreScanState* state, int cuDescIdx)
+{
+    for (int i = 0; i < state->m_runtimeFilterNum; i++) {
+        filter::BloomFilter* bf = state->m_runtimeFilters[i];
+        int seq = GetColumnSeq(state->m_runtimeFilterCols[i]);
+        if (seq < 0 || !bf->hasMinMax()) {
+            continue;
+        }
+
+        Oid typeOid = m_relation->rd_att->attrs[m_colId[seq]]->atttypid;
+        if (typeOid != INT2OID && typeOid != INT4OID && typeOid != INT8OID) {
+            continue;
+        }
+
+        CUDesc* cudesc = &(m_CUDescInfo[seq]->cuDescArray[cuDescIdx]);
+        if (cudesc->IsNullCU() || cudesc->IsNoMinMaxCU()) {
+            continue;
+        }
+
+        /* the CU range [min, max] must overlap the inner side range [bfmin, bfmax] */
+        RoughCheckFunc geFunc = GetRoughCheckFunc(typeOid, CStoreGreaterEqualStrategyNumber, InvalidOid);
+        RoughCheckFunc leFunc = GetRoughCheckFunc(typeOid, CStoreLessEqualStrategyNumber, InvalidOid);
+        if (!geFunc(cudesc, bf->getMin()) || !leFunc(cudesc, bf->getMax())) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
 {
     int nkeys = state->csss_NumScanKeys;
@@ -1197,7 +1235,7 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
         return;
     }
 
-    if (likely(nkeys == 0 || scanKey == NULL || m_colNum == 0)) {
+    if (likely(((nkeys == 0 || scanKey == NULL) && state->m_runtimeFilterNum == 0) || m_colNum == 0)) {
         /* when no where condition, we also need set m_lastNumCUDescIdx and m_NumCUDescIdx for prefetch once */
         ADIO_RUN()
         {
@@ -1223,7 +1261,7 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
     lastLoadNum = m_CUDescInfo[0]->lastLoadNum;
     curLoadNum = m_CUDescInfo[0]->curLoadNum;
     for (int i = (int)lastLoadNum; i != (int)curLoadNum; IncLoadCuDescIdx(i), IncLoadCuDescIdx(cudesc_idx_tmp)) {
-        hitCU = RoughCheck(scanKey, nkeys, i);
+        hitCU = RoughCheck(scanKey, nkeys, i) && RuntimeFilterRoughCheck(state, i);
         if (hitCU) {
             // fliter CU not hit
             ADIO_RUN()
@@ -1243,7 +1281,12 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
             RCInfo* rcPtr = &(planstate->instrument->rcInfo);
 
             if (!hitCU) {
-                int seq = scanKey[0].cs_attno;
+                /*
+                 * A CU pruned by a runtime filter has no scan key column, and the
+                 * filter column may not be loaded at all; every loaded column has
+                 * the row count, so take the first one.
+                 */
+                int seq = (nkeys > 0) ? scanKey[0].cs_attno : 0;
                 CUDesc *cudesc = &(m_CUDescInfo[seq]->cuDescArray[i]);
                 planstate->instrument->nfiltered1 += cudesc->row_count;
 
@@ -1416,6 +1459,15 @@ void CStore::ResetLateRead()
         m_lateRead[i] = false;
 }
 
+int CStore::GetColumnSeq(int colIdx) const
+{
+    for (int i = 0; i < m_colNum; ++i) {
+        if (m_colId[i] == colIdx)
+            return i;
+    }
+    return -1;
+}
+
 /*
  * @Description: set m_timing_on according state->ps.instrument and its timer
  * @IN state: cstore scan state
@@ -187,6 +187,8 @@ void CU::Reset()
     m_bpNullCompressedSize = 0;
     m_offset = NULL;
     m_offsetSize = 0;
+    m_dictCodes = NULL;
+    m_dictCodesSize = 0;
     m_cuSizeExcludePadding = 0;
 
     m_tmpinfo = NULL;
@@ -980,6 +982,8 @@ void CU::UnCompressData(char* buf, int rowCount)
         out.sz = m_srcDataSize;
         int eachValSize = m_eachValSize;
         int err_code;
+        DicCodeType* dictCodes = NULL;
+        int dictCodesNum = 0;
 
         if (CU_Delta2Compressed == (m_infoMode & CU_COMPRESS_MASK1)) {
             ereport(DEBUG1,
@@ -1021,8 +1025,11 @@ void CU::UnCompressData(char* buf, int rowCount)
                 err_code = intDecoder.Decompress(in, out);
             } else {
                 // String Type Decompress
+                // keep the dictionary codes of varlena values, see ToVectorDict()
                 StringCoder strDecoder;
+                strDecoder.m_keep_dict_codes = (m_eachValSize == -1);
                 err_code = strDecoder.Decompress(in, out);
+                dictCodes = strDecoder.TakeDicCodes(&dictCodesNum);
             }
         }
 
@@ -1035,6 +1042,11 @@ void CU::UnCompressData(char* buf, int rowCount)
                 ereport(PANIC, (errmsg("data corrupts during decompressing CU for integer type %d", (m_eachValSize))));
         }
         Assert(err_code == out.sz);
+
+        if (dictCodes != NULL) {
+            FormDictCodes(rowCount, dictCodes, dictCodesNum);
+            pfree(dictCodes);
+        }
     } else {
         Assert(m_srcDataSize == (m_cuSizeExcludePadding - GetCUHeaderSize() - m_bpNullCompressedSize));
         errno_t rc = memcpy_s(m_srcData, m_srcDataSize, buf, m_srcDataSize);
@@ -1065,6 +1077,36 @@ void CU::UnCompressData(char* buf, int rowCount)
     return;
 }
 
+/*
+ * @Description: remember the dictionary code of each row, so that the rows
+ *               of the same value can be recognized without comparing them.
+ * @in rowCount: the number of rows in this CU.
+ * @in codes: dictionary codes of all the not-null values.
+ * @in codesNum: the number of codes.
+ */
+void CU::FormDictCodes(int rowCount, const uint16* codes, int codesNum)
+{
+    Assert(m_dictCodes == NULL);
+
+    /* the codes must cover all the not-null values, otherwise ignore them */
+    if (codesNum != rowCount - CountNullValuesBefore(rowCount)) {
+        return;
+    }
+
+    m_dictCodesSize = sizeof(uint16) * rowCount;
+    m_dictCodes = (uint16*)CStoreMemAlloc::Palloc(m_dictCodesSize, !m_inCUCache);
+
+    int codeIdx = 0;
+    for (int row = 0; row < rowCount; ++row) {
+        if (HasNullValue() && IsNull(row)) {
+            m_dictCodes[row] = 0;
+        } else {
+            m_dictCodes[row] = codes[codeIdx++];
+        }
+    }
+    Assert(codeIdx == codesNum);
+}
+
 template <bool bpcharType>
 void CU::DeFormNumberStringCU()
 {
@@ -1560,12 +1602,76 @@ int CU::ToVectorT<8, false, false>(_out_ ScalarVector* vec, _in_ int leftRows, _
     return totalRows;
 }
 
+/*
+ * @Description: fill the vector from a CU compressed by dictionary method.
+ *               Only the first row of each dictionary value within the batch
+ *               is copied into the vector, the later rows of the same value
+ *               share its pointer. So functions over this batch can be computed
+ *               once for each distinct value, see VarMemo.
+ * @template hasNull: whether the cu has null value.
+ * @template hasDeadRow: whether the cu has dead rows.
+ * @return the number of rows filled.
+ */
+template <bool hasNull, bool hasDeadRow>
+int CU::ToVectorDict(_out_ ScalarVector* vec, _in_ int leftRows, _in_ int rowCursorInCU, __inout int& curScanPos,
+                     _out_ int& deadRows, _in_ uint8* cuDelMask)
+{
+    /* vector position of the copy of a code, direct mapped by the code */
+    uint16 slotCode[CU_DICT_VEC_SLOTS];
+    int16 slotPos[CU_DICT_VEC_SLOTS];
+    ScalarValue* dest = vec->m_vals;
+    int pos = 0;
+    int i = 0;
+
+    Assert(m_dictCodes != NULL && m_offset != NULL);
+    errno_t rc = memset_s(slotPos, sizeof(slotPos), 0xFF, sizeof(slotPos));
+    securec_check(rc, "\0", "\0");
+
+    for (; i < leftRows && pos < BatchMaxSize; ++i) {
+        uint32 row = (uint32)(i + rowCursorInCU);
+
+        if (hasDeadRow && ((cuDelMask[row >> 3] & (1 << (row % 8))) != 0)) {
+            ++deadRows;
+            continue;
+        }
+
+        if (hasNull && IsNull(row)) {
+            vec->SetNull(pos);
+            ++pos;
+            continue;
+        }
+
+        uint16 code = m_dictCodes[row];
+        int slot = code & (CU_DICT_VEC_SLOTS - 1);
+        if (slotPos[slot] >= 0 && slotCode[slot] == code) {
+            dest[pos] = dest[slotPos[slot]];
+        } else {
+            vec->AddVar(PointerGetDatum(m_srcData + m_offset[row]), pos);
+            slotCode[slot] = code;
+            slotPos[slot] = (int16)pos;
+        }
+        ++pos;
+    }
+
+    /* keep the scan position the same as ToVectorT() does */
+    curScanPos = m_offset[rowCursorInCU + i];
+    return pos;
+}
+
 template <int attlen, bool hasDeadRow>
 int CU::ToVector(_out_ ScalarVector* vec, _in_ int leftRows, _in_ int rowCursorInCU, __inout int& curScanPos,
                  _out_ int& deadRows, _in_ uint8* cuDelMask)
 {
     int num = 0;
 
+    if (attlen == -1 && this->m_dictCodes != NULL) {
+        if (!this->HasNullValue())
+            num = this->ToVectorDict<false, hasDeadRow>(vec, leftRows, rowCursorInCU, curScanPos, deadRows, cuDelMask);
+        else
+            num = this->ToVectorDict<true, hasDeadRow>(vec, leftRows, rowCursorInCU, curScanPos, deadRows, cuDelMask);
+        return num;
+    }
+
     if (!this->HasNullValue())
         num = this->ToVectorT<attlen, false, hasDeadRow>(vec, leftRows, rowCursorInCU, curScanPos, deadRows, cuDelMask);
     else
@@ -1628,6 +1734,12 @@ void CU::FreeSrcBuf()
     }
     m_offset = NULL;
     m_offsetSize = 0;
+
+    if (m_dictCodes) {
+        CStoreMemAlloc::Pfree(m_dictCodes, !m_inCUCache);
+    }
+    m_dictCodes = NULL;
+    m_dictCodesSize = 0;
 }
 
 FORCE_INLINE
@@ -1653,7 +1765,7 @@ int CU::GetCompressBufSize() const
 FORCE_INLINE
 int CU::GetUncompressBufSize() const
 {
-    return m_srcBufSize + m_offsetSize;
+    return m_srcBufSize + m_offsetSize + m_dictCodesSize;
 }
 
 FORCE_INLINE
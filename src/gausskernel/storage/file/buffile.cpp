@@ -610,6 +610,53 @@ int BufFileSeekBlock(BufFile* file, long blknum)
     return BufFileSeek(file, (int)(blknum / BUFFILE_SEG_SIZE), (off_t)(blknum % BUFFILE_SEG_SIZE) * BLCKSZ, SEEK_SET);
 }
 
+/*
+ * Hand a range of blocks of the file to the kernel: either start an
+ * asynchronous read of it, or start writeback of it without waiting.
+ * The range may cross the boundary of the physical files; blocks past
+ * the end of the last file are ignored.  Both are only hints, so errors
+ * are not reported.
+ */
+static void BufFileHintBlocks(BufFile* file, long blknum, int nblocks, bool writeback)
+{
+    /* our own buffer may hold a part of the range not yet written out */
+    if (writeback && file->dirty)
+        (void)BufFileFlush(file);
+
+    while (nblocks > 0) {
+        int fileno = (int)(blknum / BUFFILE_SEG_SIZE);
+        long segblk = blknum % BUFFILE_SEG_SIZE;
+        int n = (int)Min((long)nblocks, BUFFILE_SEG_SIZE - segblk);
+
+        if (fileno >= file->numFiles)
+            break;
+        if (writeback)
+            FileWriteback(file->files[fileno], (off_t)segblk * BLCKSZ, (off_t)n * BLCKSZ);
+        else
+            (void)FilePrefetch(file->files[fileno], (off_t)segblk * BLCKSZ, n * BLCKSZ);
+        blknum += n;
+        nblocks -= n;
+    }
+}
+
+/*
+ * BufFilePrefetchBlocks --- start reading nblocks blocks from blknum in
+ * the background, so that a later BufFileRead finds them in the OS cache.
+ */
+void BufFilePrefetchBlocks(BufFile* file, long blknum, int nblocks)
+{
+    BufFileHintBlocks(file, blknum, nblocks, false);
+}
+
+/*
+ * BufFileWritebackBlocks --- start writing out nblocks blocks from blknum
+ * that have been written, without waiting for the writes to complete.
+ */
+void BufFileWritebackBlocks(BufFile* file, long blknum, int nblocks)
+{
+    BufFileHintBlocks(file, blknum, nblocks, true);
+}
+
 #ifdef NOT_USED
 /*
  * BufFileTellBlock --- block-oriented tell
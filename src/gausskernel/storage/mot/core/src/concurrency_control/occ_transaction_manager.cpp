@@ -45,6 +45,7 @@ OccTransactionManager::OccTransactionManager()
       m_rowsSetSize(0),
       m_deleteSetSize(0),
       m_insertSetSize(0),
+      m_versionHorizon(CSNManager::INVALID_CSN),
       m_dynamicSleep(100),
       m_rowsLocked(false),
       m_preAbort(true),
@@ -366,6 +367,16 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
         goto final;
     }
 
+    // Pre-allocate the rows keeping replaced versions, the commit itself cannot fail
+    if (!PreAllocRowVersions(txMan)) {
+        if (GetGlobalConfiguration().m_enableCheckpoint) {
+            GetCheckpointManager()->FreePreAllocStableRows(txMan);
+            GetCheckpointManager()->EndCommit(txMan);
+        }
+        rc = RC_MEMORY_ALLOCATION_ERROR;
+        goto final;
+    }
+
 final:
     if (likely(rc == RC_OK)) {
         MOT_ASSERT(numSentinelLock == m_writeSetSize);
@@ -403,6 +414,137 @@ void OccTransactionManager::ApplyWrite(TxnManager* txMan)
     }
 }
 
+bool OccTransactionManager::PreAllocRowVersions(TxnManager* txMan)
+{
+    if (!GetGlobalConfiguration().m_enableMvccSnapshotRead) {
+        return true;
+    }
+
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        Access* access = raPair.second;
+        bool isUpgrade = (access->m_type == INS && access->m_params.IsUpgradeInsert());
+        if ((access->m_type != WR && access->m_type != DEL && !isUpgrade) || !access->m_params.IsPrimarySentinel()) {
+            continue;
+        }
+        Row* version = access->GetRowFromHeader()->GetTable()->CreateNewRow();
+        if (version == nullptr) {
+            ReleaseRowVersions(txMan);
+            return false;
+        }
+        access->m_versionRow = version;
+    }
+    return true;
+}
+
+void OccTransactionManager::ReleaseRowVersions(TxnManager* txMan)
+{
+    if (!GetGlobalConfiguration().m_enableMvccSnapshotRead) {
+        return;
+    }
+
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        Access* access = raPair.second;
+        if (access->m_versionRow != nullptr) {
+            access->m_versionRow->GetTable()->DestroyRow(access->m_versionRow);
+            access->m_versionRow = nullptr;
+        }
+    }
+}
+
+void OccTransactionManager::KeepRowVersions(TxnManager* txMan)
+{
+    if (!GetGlobalConfiguration().m_enableMvccSnapshotRead) {
+        return;
+    }
+
+    uint64_t csn = txMan->GetCommitSequenceNumber();
+    uint64_t horizon = GetVersionHorizon();
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        Access* access = raPair.second;
+        Row* version = access->m_versionRow;
+        if (version == nullptr) {
+            continue;
+        }
+        access->m_versionRow = nullptr;
+
+        Row* row = access->GetRowFromHeader();
+        Table* table = row->GetTable();
+        if (access->m_type == INS) {
+            // The key is inserted again over a deleted row some snapshot may still read. The new row takes over the
+            // history of the deleted one, starting with a version marking the deletion.
+            if (row->GetCommitSequenceNumber() > horizon) {
+                version->DeepCopy(row);
+                version->m_rowHeader.SetAbsentBit();
+                version->m_prevVersion = row->m_prevVersion;
+                access->m_auxRow->m_prevVersion = version;
+                // Readers still holding the deleted row walk the same history, which the row no longer owns
+                row->m_prevVersion = version;
+            } else {
+                table->DestroyRow(version);
+            }
+            continue;
+        }
+
+        Row* chain = row->m_prevVersion;
+        Row* retired = nullptr;
+        if (csn > horizon) {
+            // Some snapshot may still read the current contents of the row
+            version->DeepCopy(row);
+            version->m_prevVersion = chain;
+            chain = version;
+            // Every snapshot reads the first version at or below the horizon or a newer one
+            Row* oldest = chain;
+            while (oldest != nullptr && oldest->GetCommitSequenceNumber() > horizon) {
+                oldest = oldest->m_prevVersion;
+            }
+            if (oldest != nullptr) {
+                retired = oldest->m_prevVersion;
+                oldest->m_prevVersion = nullptr;
+            }
+        } else {
+            table->DestroyRow(version);
+            retired = chain;
+            chain = nullptr;
+        }
+        COMPILER_BARRIER
+        row->m_prevVersion = chain;
+
+        // Snapshots that already walked into the retired versions hold an older GC epoch
+        if (retired != nullptr) {
+            txMan->GetGcSession()->GcRecordObject(table->GetPrimaryIndex()->GetIndexId(),
+                retired,
+                nullptr,
+                Row::RowDtor,
+                ROW_SIZE_FROM_POOL(table));
+        }
+    }
+}
+
+uint64_t OccTransactionManager::GetVersionHorizon()
+{
+    if (m_versionHorizon == CSNManager::INVALID_CSN) {
+        m_versionHorizon = GcManager::SnapshotHorizon(GetCSNManager().GetCurrentCSN());
+    }
+    return m_versionHorizon;
+}
+
+bool OccTransactionManager::KeepTombstone(TxnManager* txMan, const Access* access)
+{
+    // A primary key with a stable row is removed by the checkpoint
+    if (!GetGlobalConfiguration().m_enableMvccSnapshotRead || !access->m_params.IsPrimarySentinel() ||
+        access->m_origSentinel->GetStable() != nullptr) {
+        return false;
+    }
+    uint64_t csn = txMan->GetCommitSequenceNumber();
+    if (csn <= GetVersionHorizon()) {
+        return false;
+    }
+    return access->GetTxnRow()->GetTable()->AddTombstone(access->GetTxnRow(), csn);
+}
+
 void OccTransactionManager::WriteChanges(TxnManager* txMan)
 {
     if (m_writeSetSize == 0 && m_insertSetSize == 0) {
@@ -414,6 +556,9 @@ void OccTransactionManager::WriteChanges(TxnManager* txMan)
     // Stable rows for checkpoint needs to be created (copied from original row) before modifying the global rows.
     ApplyWrite(txMan);
 
+    // So do the versions kept for snapshot reads
+    KeepRowVersions(txMan);
+
     TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
 
     // Update CSN with all relevant information on global rows
@@ -456,11 +601,11 @@ void OccTransactionManager::WriteChanges(TxnManager* txMan)
                     Row* row = access->GetRowFromHeader();
                     access->m_localInsertRow = row;
                     access->m_origSentinel->SetNextPtr(access->m_auxRow);
-                    // Add row to GC!
+                    // Add row to GC! The versions are left alone if the new row took them over
                     txMan->GetGcSession()->GcRecordObject(row->GetTable()->GetPrimaryIndex()->GetIndexId(),
                         row,
                         nullptr,
-                        Row::RowDtor,
+                        (access->m_auxRow->GetPrevVersion() != nullptr) ? Row::RowOnlyDtor : Row::RowDtor,
                         ROW_SIZE_FROM_POOL(row->GetTable()));
                 } else {
                     // Set Sentinel for
@@ -502,10 +647,16 @@ void OccTransactionManager::CleanRowsFromIndexes(TxnManager* txMan)
         const Access* access = raPair.second;
         if (access->m_type == DEL) {
             numOfDeletes--;
-            access->GetTxnRow()->GetTable()->UpdateRowCount(-1);
+            Table* table = access->GetTxnRow()->GetTable();
+            table->UpdateRowCount(-1);
             MOT_ASSERT(access->m_params.IsUpgradeInsert() == false);
             // Use Txn Row as row may change INSERT after DELETE leaves residue
-            txMan->RemoveKeyFromIndex(access->GetTxnRow(), access->m_origSentinel);
+            if (!KeepTombstone(txMan, access)) {
+                txMan->RemoveKeyFromIndex(access->GetTxnRow(), access->m_origSentinel);
+            }
+            if (GetGlobalConfiguration().m_enableMvccSnapshotRead && access->m_params.IsPrimarySentinel()) {
+                table->PurgeTombstones(GetVersionHorizon(), txMan->GetThdId(), txMan->GetGcSession());
+            }
         }
         if (!numOfDeletes) {
             break;
@@ -569,6 +720,7 @@ void OccTransactionManager::ReleaseRowsLocks(TxnManager* txMan, uint32_t numOfLo
 
 void OccTransactionManager::CleanUp()
 {
+    m_versionHorizon = CSNManager::INVALID_CSN;
     m_writeSetSize = 0;
     m_insertSetSize = 0;
     m_rowsSetSize = 0;
@@ -98,6 +98,9 @@ public:
     /** @brief Rollack insert-set due to an abort   */
     void RollbackInserts(TxnManager* txMan);
 
+    /** @brief Release the row versions pre-allocated for MVCC snapshot read   */
+    void ReleaseRowVersions(TxnManager* txMan);
+
     void ReleaseLocks(TxnManager* txMan)
     {
         if (m_rowsLocked) {
@@ -175,6 +178,24 @@ private:
     /** @brief Sets stable row according to the checkpoint state. */
     void ApplyWrite(TxnManager* txMan);
 
+    /** @brief Pre-allocates a row for the replaced version of each updated or deleted row (MVCC snapshot read). */
+    bool PreAllocRowVersions(TxnManager* txMan);
+
+    /**
+     * @brief Chains the replaced version to each updated or deleted row and retires the versions no active
+     * snapshot can read anymore. Rows must be locked.
+     */
+    void KeepRowVersions(TxnManager* txMan);
+
+    /** @brief Calculates the snapshot horizon once per commit, see GcManager::SnapshotHorizon(). */
+    uint64_t GetVersionHorizon();
+
+    /**
+     * @brief Keeps the primary key of a deleted row in the index while some snapshot may still read the row.
+     * @return False if the key is to be removed now.
+     */
+    bool KeepTombstone(TxnManager* txMan, const Access* access);
+
     /** @var transaction counter   */
     uint32_t m_txnCounter;
 
@@ -193,6 +214,9 @@ private:
     /** @var Write set size. */
     uint32_t m_insertSetSize;
 
+    /** @var Snapshot horizon of the commit, INVALID_CSN until calculated. */
+    uint64_t m_versionHorizon;
+
     uint16_t m_dynamicSleep;
 
     /** @var flag indicating whether we locked the rows   */
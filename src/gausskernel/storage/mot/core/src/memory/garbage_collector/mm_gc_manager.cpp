@@ -34,12 +34,22 @@ class Table;
 volatile GcEpochType g_gcGlobalEpoch;
 /** @var Current lowest epoch among all active GC Managers */
 volatile GcEpochType g_gcActiveEpoch;
+/** @var Snapshot CSNs of the read-only transactions, one slot per GC Manager, zero if the slot has no snapshot */
+volatile uint64_t g_gcSnapshotCsns[MAX_THREAD_COUNT];
+/** @var Number of snapshot slots ever handed out, the horizon scan stops there */
+volatile uint32_t g_gcSnapshotSlotCount;
+/** @var Number of snapshot slots holding a snapshot */
+volatile uint32_t g_gcActiveSnapshots;
+/** @var Snapshot slots in use, guarded by g_gcGlobalEpochLock */
+static bool g_gcSnapshotSlotUsed[MAX_THREAD_COUNT];
 
 /** @var Lock to sync GC Manager's Limbo groups access by other threads */
 GcLock g_gcGlobalEpochLock;
 
 GcManager* GcManager::allGcManagers = nullptr;
 
+constexpr uint32_t GcManager::INVALID_SNAPSHOT_SLOT;
+
 inline GcManager::GcManager(GC_TYPE purpose, int getThreadId, int rcuMaxFreeCount)
     : m_rcuFreeCount(rcuMaxFreeCount), m_tid(getThreadId), m_purpose(purpose)
 {}
@@ -280,6 +290,25 @@ bool GcManager::RefillLimboGroup()
     return true;
 }
 
+uint32_t GcManager::AllocSnapshotSlot()
+{
+    // Sessions come and go, reuse the slots they released first
+    for (uint32_t i = 0; i < g_gcSnapshotSlotCount; ++i) {
+        if (!g_gcSnapshotSlotUsed[i]) {
+            g_gcSnapshotSlotUsed[i] = true;
+            return i;
+        }
+    }
+    if (g_gcSnapshotSlotCount == MAX_THREAD_COUNT) {
+        MOT_LOG_WARN("No snapshot slot left, the session reads without a snapshot");
+        return INVALID_SNAPSHOT_SLOT;
+    }
+    uint32_t slot = g_gcSnapshotSlotCount;
+    g_gcSnapshotSlotUsed[slot] = true;
+    g_gcSnapshotSlotCount = slot + 1;
+    return slot;
+}
+
 void GcManager::RemoveFromGcList(GcManager* n)
 {
     // When node to be deleted is head node
@@ -289,6 +318,12 @@ void GcManager::RemoveFromGcList(GcManager* n)
     MOT_ASSERT(n != nullptr);
     g_gcGlobalEpochLock.lock();
 
+    if (n->m_snapshotSlot != INVALID_SNAPSHOT_SLOT) {
+        (void)n->SetSnapshotCsn(0);
+        g_gcSnapshotSlotUsed[n->m_snapshotSlot] = false;
+        n->m_snapshotSlot = INVALID_SNAPSHOT_SLOT;
+    }
+
     GcManager* head = allGcManagers;
 
     if (head == n) {
@@ -30,6 +30,7 @@
 #include "utilities.h"
 #include "memory_statistics.h"
 #include "mm_session_api.h"
+#include "thread_id.h"
 
 namespace MOT {
 class GcManager;
@@ -42,6 +43,9 @@ typedef MOT::spin_lock GcLock;
 typedef uint32_t (*DestroyValueCbFunc)(void*, void*, bool);
 extern volatile GcEpochType g_gcGlobalEpoch;
 extern volatile GcEpochType g_gcActiveEpoch;
+extern volatile uint64_t g_gcSnapshotCsns[MAX_THREAD_COUNT];
+extern volatile uint32_t g_gcSnapshotSlotCount;
+extern volatile uint32_t g_gcActiveSnapshots;
 extern GcLock g_gcGlobalEpochLock;
 
 inline uint64_t GetGlobalEpoch()
@@ -165,6 +169,9 @@ public:
     /** @var GC managers types   */
     enum GC_TYPE : uint8_t { GC_MAIN, GC_INDEX, GC_LOG, GC_CHECKPOINT };
 
+    /** @var Snapshot slot of a GC manager that has none   */
+    static constexpr uint32_t INVALID_SNAPSHOT_SLOT = (uint32_t)-1;
+
     /** @var List of all GC Managers */
     static GcManager* allGcManagers;
 
@@ -196,6 +203,7 @@ public:
         g_gcGlobalEpochLock.lock();
         m_next = allGcManagers;
         allGcManagers = this;
+        m_snapshotSlot = AllocSnapshotSlot();
         g_gcGlobalEpochLock.unlock();
     }
 
@@ -446,13 +454,53 @@ public:
         return m_rcuFreeCount;
     }
 
+    /**
+     * @brief Publishes the snapshot CSN of the read-only transaction running in this session, so that the row
+     * versions it may still read are not retired
+     * @param csn The snapshot CSN, zero when the session has no snapshot
+     * @return False if the session has no snapshot slot, it cannot read a snapshot then
+     */
+    bool SetSnapshotCsn(uint64_t csn)
+    {
+        if (m_snapshotSlot == INVALID_SNAPSHOT_SLOT) {
+            return false;
+        }
+        uint64_t prev = g_gcSnapshotCsns[m_snapshotSlot];
+        // The counter is updated first, its full barrier orders it before the slot on publish
+        if (csn != 0 && prev == 0) {
+            (void)__sync_fetch_and_add(&g_gcActiveSnapshots, 1);
+        } else if (csn == 0 && prev != 0) {
+            (void)__sync_fetch_and_sub(&g_gcActiveSnapshots, 1);
+        }
+        g_gcSnapshotCsns[m_snapshotSlot] = csn;
+        return true;
+    }
+
+    /**
+     * @brief Calculates the oldest snapshot any session may still read. Row versions superseded by a commit at or
+     * below the horizon are not read by anyone and may be retired. Takes no lock, and scans the snapshot slots
+     * only while some read-only transaction holds a snapshot.
+     * @param currentCsn The current CSN, read by the caller before this call
+     * @return The snapshot horizon
+     */
+    static inline uint64_t SnapshotHorizon(uint64_t currentCsn);
+
 private:
+    /**
+     * @brief Hands out a free slot of g_gcSnapshotCsns. Must be called with g_gcGlobalEpochLock held.
+     * @return The slot, or INVALID_SNAPSHOT_SLOT if all are taken
+     */
+    static uint32_t AllocSnapshotSlot();
+
     /** @var Current snapshot of the global epoch   */
     GcEpochType m_gcEpoch;
 
     /** @var Calculated perform epoch   */
     GcEpochType m_performGcEpoch;
 
+    /** @var Slot in g_gcSnapshotCsns publishing the snapshot of this session   */
+    uint32_t m_snapshotSlot = INVALID_SNAPSHOT_SLOT;
+
     /** @var Limbo group HEAD   */
     LimboGroup* m_limboHead = nullptr;
 
@@ -544,6 +592,24 @@ inline GcEpochType GcManager::MinActiveEpoch()
     return ae;
 }
 
+inline uint64_t GcManager::SnapshotHorizon(uint64_t currentCsn)
+{
+    uint64_t horizon = currentCsn;
+    // A snapshot published after the counter is read is taken after currentCsn, so it is above the horizon
+    __sync_synchronize();
+    if (g_gcActiveSnapshots == 0) {
+        return horizon;
+    }
+    uint32_t slotCount = g_gcSnapshotSlotCount;
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        uint64_t snapshot = g_gcSnapshotCsns[i];
+        if (snapshot != 0 && snapshot < horizon) {
+            horizon = snapshot;
+        }
+    }
+    return horizon;
+}
+
 inline bool GcManager::ClearIndexElements(uint32_t indexId, bool dropIndex)
 {
     g_gcGlobalEpochLock.lock();
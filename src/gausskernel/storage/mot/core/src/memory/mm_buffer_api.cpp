@@ -138,6 +138,16 @@ extern void MemBufferClearSessionCache()
     }
 }
 
+extern void MemBufferClearGlobalClassCache(MemBufferClass bufferClass)
+{
+    // buffers are freed into the allocator of their chunk node, so all nodes are cleared
+    if ((MOTCurrentNumaNodeId != MEM_INVALID_NODE) && (MOTCurrThreadId != INVALID_THREAD_ID)) {
+        for (int node = 0; node < (int)g_memGlobalCfg.m_nodeCount; ++node) {
+            MemBufferAllocatorClearThreadCache(&g_globalAllocators[node][bufferClass]);
+        }
+    }
+}
+
 extern void MemBufferApiPrint(const char* name, LogLevel logLevel, MemReportMode reportMode /* = MEM_REPORT_SUMMARY */)
 {
     if (MOT_CHECK_LOG_LEVEL(logLevel)) {
@@ -179,6 +179,13 @@ extern void MemBufferFreeLocal(void* buffer, MemBufferClass bufferClass);
  */
 extern void MemBufferClearSessionCache();
 
+/**
+ * @brief Clears the current session caches of a single buffer class on the global buffer allocators of all nodes,
+ * so that chunks emptied by previous de-allocations are returned to the chunk pool.
+ * @param bufferClass The class of the buffers.
+ */
+extern void MemBufferClearGlobalClassCache(MemBufferClass bufferClass);
+
 /**
  * @brief Prints all buffer API status into log.
  * @param name The name to prepend to the log message.
@@ -38,10 +38,11 @@ CompactHandler::CompactHandler(ObjAllocInterface* pool, const char* prefix)
       m_poolsToCompact(0),
       m_compactedPools(nullptr),
       m_curr(nullptr),
+      m_reclaimedBytes(0),
       m_logPrefix(prefix)
 {}
 
-void CompactHandler::StartCompaction(CompactTypeT type)
+void CompactHandler::StartCompaction(CompactTypeT type, uint32_t thresholdPercent)
 {
     PoolStatsSt stats;
     errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
@@ -49,10 +50,17 @@ void CompactHandler::StartCompaction(CompactTypeT type)
     stats.m_type = PoolStatsT::POOL_STATS_ALL;
 
     m_ctype = type;
+    ReleaseDrainedPools();
     m_orig->GetStats(stats);
     m_orig->PrintStats(stats, m_logPrefix, LogLevel::LL_INFO);
 
-    if (stats.m_fragmentationPercent <= 0 && stats.m_freeObjCount < stats.m_perPoolTotalCount) {
+    if (type == COMPACT_ONLINE) {
+        if (stats.m_freeObjCount * 100 < stats.m_totalObjCount * thresholdPercent ||
+            stats.m_freeObjCount < stats.m_perPoolTotalCount) {
+            m_compactionNeeded = false;
+            return;
+        }
+    } else if (stats.m_fragmentationPercent <= 0 && stats.m_freeObjCount < stats.m_perPoolTotalCount) {
         m_compactionNeeded = false;
         return;
     }
@@ -64,6 +72,22 @@ void CompactHandler::StartCompaction(CompactTypeT type)
         m_poolsToCompact = m_orig->m_nextFree;
     } while (!CAS(m_orig->m_nextFree, m_poolsToCompact, p));
 
+    if (type == COMPACT_ONLINE) {
+        // only sparse pools are drained, the rest are immediately given back for allocation
+        ObjPoolPtr sparsePools = nullptr;
+        p = m_poolsToCompact;
+        while (p.Get() != nullptr) {
+            ObjPoolPtr tmp = p->m_objNext;
+            if (p->m_freeCount * 100 >= p->m_totalCount * thresholdPercent) {
+                PUSH_NOLOCK(sparsePools, p);
+            } else {
+                PUSH(m_orig->m_nextFree, p);
+            }
+            p = tmp;
+        }
+        m_poolsToCompact = sparsePools;
+    }
+
     p = m_poolsToCompact;
     while (p.Get() != nullptr) {
         ObjPool* op = p.Get();
@@ -113,9 +137,10 @@ void CompactHandler::EndCompaction()
         while (p.Get() != nullptr) {
             ObjPoolPtr tmp = p->m_objNext;
             if (p->m_freeCount == p->m_totalCount) {
-                ObjPool* op = p.Get();
-                DEL_FROM_LIST(m_orig->m_listLock, m_orig->m_objList, op);
-                ObjPool::DelObjPool(op, m_orig->m_type, true);
+                DeletePool(p.Get());
+            } else if (m_ctype == COMPACT_ONLINE) {
+                // relocated objects are still waiting in GC, keep the pool out of allocation until the next round
+                PUSH_NOLOCK(m_orig->m_drainingPools, p);
             } else {
                 if (m_ctype != COMPACT_SIMPLE)
                     MOT_LOG_ERROR("Compaction error: pool not empty, re-inserting to free pools");
@@ -123,10 +148,41 @@ void CompactHandler::EndCompaction()
             }
             p = tmp;
         }
+        m_poolsToCompact = nullptr;
+    }
+
+#ifdef MEM_ACTIVE
+    // released pools may still be cached by this session, so flush them for their chunks to be freed
+    if (m_reclaimedBytes > 0) {
+        MemBufferClearGlobalClassCache(m_orig->m_type);
     }
+#endif
 
     m_orig->Print(m_logPrefix, LogLevel::LL_INFO);
 
     m_compactionNeeded = false;
 }
+
+void CompactHandler::ReleaseDrainedPools()
+{
+    ObjPoolPtr p = m_orig->m_drainingPools;
+    m_orig->m_drainingPools = nullptr;
+    while (p.Get() != nullptr) {
+        ObjPoolPtr tmp = p->m_objNext;
+        if (p->m_freeCount == p->m_totalCount) {
+            DeletePool(p.Get());
+        } else {
+            // some relocated objects are still in use (or the pool was not entirely drained), reuse it
+            PUSH(m_orig->m_nextFree, p);
+        }
+        p = tmp;
+    }
+}
+
+void CompactHandler::DeletePool(ObjPool* op)
+{
+    DEL_FROM_LIST(m_orig->m_listLock, m_orig->m_objList, op);
+    ObjPool::DelObjPool(op, m_orig->m_type, true);
+    m_reclaimedBytes += 1024 * MemBufferClassToSizeKb(m_orig->m_type);
+}
 }  // namespace MOT
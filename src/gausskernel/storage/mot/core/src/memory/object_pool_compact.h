@@ -30,7 +30,7 @@
 
 namespace MOT {
 #define PTR_MASK (((uint64_t)-1) << 10)
-typedef enum : uint8_t { COMPACT_SIMPLE = 0, COMPACT_REALLOC = 1, COMPACT_DEEP = 2 } CompactTypeT;
+typedef enum : uint8_t { COMPACT_SIMPLE = 0, COMPACT_REALLOC = 1, COMPACT_DEEP = 2, COMPACT_ONLINE = 3 } CompactTypeT;
 
 struct hashing_func {
     uint64_t operator()(const ObjPool* key) const
@@ -58,8 +58,11 @@ public:
     /**
      * @brief Prepares orig for compaction, calculates fragmentation percent, initializes addrMap and set
      * comactionNeeded to true (if indeed)
+     * @param type The compaction type.
+     * @param thresholdPercent Online compaction only: the free space percentage above which the pool (and each of
+     * its sub-pools) is compacted.
      */
-    void StartCompaction(CompactTypeT type = COMPACT_REALLOC);
+    void StartCompaction(CompactTypeT type = COMPACT_REALLOC, uint32_t thresholdPercent = 0);
     /** @brief Applies new ObjPools to a general use, and releases empty ObjPools.
      */
     void EndCompaction();
@@ -69,7 +72,16 @@ public:
         return m_compactionNeeded;
     }
 
-    /** @brief Reallocates the object. Allocates a new memory buffer and calls the copy constructor of T.
+    /** @brief Retrieves the amount of memory returned by this compaction so far. */
+    uint64_t GetReclaimedBytes() const
+    {
+        return m_reclaimedBytes;
+    }
+
+    /**
+     * @brief Reallocates the object. Allocates a new memory buffer and calls the copy constructor of T.
+     * In online compaction the source object is not released, the caller retires it through the GC once the new
+     * object is published.
      */
     template <typename T>
     T* CompactObj(T const* obj)
@@ -88,6 +100,9 @@ public:
 
             if (m_curr == nullptr) {
                 m_curr = ObjPool::GetObjPool(m_orig->m_size, m_orig, m_orig->m_type, true);
+                if (m_curr == nullptr) {
+                    return res;
+                }
             }
 
             m_curr->Alloc(&data, &state);
@@ -99,15 +114,26 @@ public:
 
             res = new (data) T(*(const T*)obj);
 
-            OBJ_RELEASE_MARK(oix_ptr);
-            state = PAS_NONE;
-            obj->~T();
-            op->Release(oix, &state);
+            if (m_ctype != COMPACT_ONLINE) {
+                OBJ_RELEASE_MARK(oix_ptr);
+                state = PAS_NONE;
+                obj->~T();
+                op->Release(oix, &state);
+            }
         }
 
         return res;
     }
 
+    /**
+     * @brief Releases the pools drained by a previous online compaction. Pools that became empty are returned to
+     * the buffer allocator, other pools are made available again for allocation.
+     */
+    void ReleaseDrainedPools();
+
+    /** @brief Releases an empty pool back to the buffer allocator. */
+    void DeletePool(ObjPool* op);
+
     ObjAllocInterface* m_orig;
     bool m_compactionNeeded;
     CompactTypeT m_ctype;
@@ -116,6 +142,7 @@ public:
     ObjPoolPtr m_poolsToCompact;
     ObjPool* m_compactedPools;
     ObjPool* m_curr;
+    uint64_t m_reclaimedBytes;
 
     const char* m_logPrefix;
     DECLARE_CLASS_LOGGER();
@@ -308,6 +308,7 @@ public:
     spin_lock m_listLock;
     ObjPool* m_objList;
     ObjPoolPtr m_nextFree;
+    ObjPoolPtr m_drainingPools;  // pools emptied by online compaction, waiting for relocated objects to be reclaimed
     uint16_t m_size;
     uint16_t m_oixOffset;
     MemBufferClass m_type;
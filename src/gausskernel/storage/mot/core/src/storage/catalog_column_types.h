@@ -99,6 +99,17 @@ typedef struct __attribute__((packed)) _decimal {
 #define DECIMAL_MAX_SIZE (sizeof(MOT::DecimalSt) + DECIMAL_MAX_DIGITS * sizeof(uint16_t))
 #define DECIMAL_SIZE(d) (sizeof(MOT::DecimalSt) + d->m_hdr.m_ndigits * sizeof(int16_t))
 
+// Decimal index key encoding (order-preserving): class byte, biased weight and base-10000 digits (all big-endian),
+// followed by a marker byte which is set when digits beyond the column precision were dropped from a search value
+#define DECIMAL_KEY_NEGATIVE 0x01
+#define DECIMAL_KEY_ZERO 0x02
+#define DECIMAL_KEY_POSITIVE 0x03
+#define DECIMAL_KEY_NAN 0x04
+#define DECIMAL_KEY_INEXACT 0x01
+#define DECIMAL_KEY_WEIGHT_BIAS 0x8000
+#define DECIMAL_KEY_HDR_SIZE (sizeof(uint8_t) + sizeof(uint16_t))
+#define DECIMAL_KEY_SIZE(ndigits) (DECIMAL_KEY_HDR_SIZE + (ndigits) * sizeof(uint16_t) + sizeof(uint8_t))
+
 typedef struct __attribute__((packed)) _interval {
     uint64_t m_time;
     int32_t m_day;
@@ -33,6 +33,7 @@
 extern uint16_t MOTTimestampToStr(uintptr_t src, char* destBuf, size_t len);
 extern uint16_t MOTTimestampTzToStr(uintptr_t src, char* destBuf, size_t len);
 extern uint16_t MOTDateToStr(uintptr_t src, char* destBuf, size_t len);
+extern uint16_t MOTNumericToStr(uintptr_t src, char* destBuf, size_t len);
 
 namespace MOT {
 DECLARE_LOGGER(Column, Storage)
@@ -718,11 +719,45 @@ bool ColumnDECIMAL::PackKey(uint8_t* dest, uintptr_t src, size_t len, uint8_t fi
 {
     DecimalSt* d = (DecimalSt*)src;
 
-    if (len > m_size)
-        len = m_size;
-    errno_t erc = memcpy_s(dest, m_size, (void*)d, len);
+    errno_t erc = memset_s(dest, m_keySize, 0x00, m_keySize);
     securec_check(erc, "\0", "\0");
 
+    if (d->m_hdr.m_flags & DECIMAL_NAN) {
+        *dest = DECIMAL_KEY_NAN;
+        return true;
+    }
+
+    if (d->m_hdr.m_ndigits == 0) {
+        *dest = DECIMAL_KEY_ZERO;
+        return true;
+    }
+
+    // digits are stored without leading and trailing zeros, so a larger weight always means a larger magnitude
+    int32_t weight = (int16_t)d->m_hdr.m_weight;
+    *(uint16_t*)(dest + 1) = htobe16((uint16_t)(weight + DECIMAL_KEY_WEIGHT_BIAS));
+
+    uint8_t* digits = dest + DECIMAL_KEY_HDR_SIZE;
+    uint32_t maxDigits = (m_keySize - DECIMAL_KEY_SIZE(0)) / sizeof(uint16_t);
+    for (uint32_t i = 0; i < d->m_hdr.m_ndigits; i++) {
+        if (i < maxDigits) {
+            *(uint16_t*)(digits + i * sizeof(uint16_t)) = htobe16(d->m_digits[i]);
+        } else if (d->m_digits[i] != 0) {
+            // search value is more precise than the column, place it between its truncated neighbours
+            dest[m_keySize - 1] = DECIMAL_KEY_INEXACT;
+            break;
+        }
+    }
+
+    if (d->m_hdr.m_flags & DECIMAL_NEGATIVE) {
+        // a larger magnitude is a smaller negative value
+        *dest = DECIMAL_KEY_NEGATIVE;
+        for (uint32_t i = 1; i < m_keySize; i++) {
+            dest[i] = ~dest[i];
+        }
+    } else {
+        *dest = DECIMAL_KEY_POSITIVE;
+    }
+
     return true;
 }
 
@@ -733,15 +768,14 @@ void ColumnDECIMAL::Unpack(uint8_t* data, uintptr_t* dest, size_t& len)
 
 void ColumnDECIMAL::SetKeySize()
 {
-    m_keySize = m_size;
+    // column size is derived from the declared precision, so the key can hold every digit of a stored value
+    m_keySize = DECIMAL_KEY_SIZE((m_size - sizeof(DecimalSt)) / sizeof(uint16_t));
 }
 
 uint16_t ColumnDECIMAL::PrintValue(uint8_t* data, char* destBuf, size_t len)
 {
-    if (len >= 3) {
-        errno_t erc = snprintf_s(destBuf, len, len - 1, "NaN");
-        securec_check_ss(erc, "\0", "\0");
-        return erc;
+    if (len >= MOT_MAXDATELEN) {
+        return MOTNumericToStr(GetBytes8(data + m_offset), destBuf, len);
     }
     return 0;
 }
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Index implementation using a resizable concurrent hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "mm_gc_manager.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+constexpr uint64_t HashPrimaryIndex::INITIAL_BUCKET_COUNT;
+constexpr uint64_t HashPrimaryIndex::MAX_LOAD_FACTOR;
+constexpr uint64_t HashPrimaryIndex::MOVE_BATCH_SIZE;
+constexpr uint64_t HashPrimaryIndex::BUCKET_LOCK_BIT;
+constexpr uint64_t HashPrimaryIndex::BUCKET_MOVED_BIT;
+constexpr uint32_t HashPrimaryIndex::HashIterator::MAX_PENDING_BUCKETS;
+
+static inline uint64_t HashMix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t HashPrimaryIndex::HashKeyBuf(const uint8_t* buf, uint32_t len)
+{
+    uint64_t h = len;
+    uint32_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        h = HashMix(h ^ *reinterpret_cast<const uint64_t*>(buf + i));
+    }
+
+    if (i < len) {
+        uint64_t tail = 0;
+        for (; i < len; i++) {
+            tail = (tail << 8) | buf[i];
+        }
+        h = HashMix(h ^ tail);
+    }
+    return h;
+}
+
+HashPrimaryIndex::BucketArray* HashPrimaryIndex::AllocBucketArray(uint64_t bucketCount)
+{
+    uint64_t size = BucketArraySize(bucketCount);
+    BucketArray* array = (BucketArray*)MemGlobalAllocAligned(size, CACHE_LINE_SIZE);
+    if (array == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Hash Index",
+            "Failed to allocate %" PRIu64 " bytes for %" PRIu64 " hash buckets",
+            size,
+            bucketCount);
+        return nullptr;
+    }
+
+    errno_t erc = memset_s(array, size, 0, size);
+    securec_check(erc, "\0", "\0");
+    array->m_mask = bucketCount - 1;
+    return array;
+}
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    m_nodePool = ObjAllocInterface::GetObjPool(sizeof(HashNode) + ALIGN8(m_keyLength), false);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_array = AllocBucketArray(INITIAL_BUCKET_COUNT);
+    if (m_array == nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to initialize hash index");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_count = 0;
+    m_moveCursor = 0;
+    m_movedCount = 0;
+    m_retryCursor = 0;
+    m_resizing = false;
+    m_initialized = true;
+    return RC_OK;
+}
+
+void HashPrimaryIndex::DestroyTable()
+{
+    // All the nodes are released with their pool
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+    if (m_array != nullptr) {
+        if (m_array->m_next != nullptr) {
+            MemGlobalFree(m_array->m_next);
+        }
+        MemGlobalFree(m_array);
+        m_array = nullptr;
+    }
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::ChainHead(const BucketArray* array, uint64_t hash)
+{
+    while (true) {
+        uint64_t head = (uint64_t)array->m_buckets[hash & array->m_mask];
+        if ((head & BUCKET_MOVED_BIT) == 0) {
+            return (HashNode*)(head & ~BUCKET_LOCK_BIT);
+        }
+        // The keys of a moved bucket are found in the next array from then on
+        array = array->m_next;
+    }
+}
+
+HashPrimaryIndex::BucketArray* HashPrimaryIndex::LockBucket(uint64_t hash, uint64_t& bucket)
+{
+    BucketArray* array = m_array;
+    while (true) {
+        bucket = hash & array->m_mask;
+        uint64_t head = (uint64_t)array->m_buckets[bucket];
+        if ((head & BUCKET_MOVED_BIT) != 0) {
+            // A moved bucket stays moved, so a writer that lost the race with MoveBucket() follows it
+            array = array->m_next;
+            continue;
+        }
+        if ((head & BUCKET_LOCK_BIT) == 0 && __sync_bool_compare_and_swap(
+                &array->m_buckets[bucket], (HashNode*)head, (HashNode*)(head | BUCKET_LOCK_BIT))) {
+            return array;
+        }
+        PAUSE
+    }
+}
+
+void HashPrimaryIndex::RetireNode(GcManager* gcSession, HashNode* node)
+{
+    MOT_ASSERT(gcSession != nullptr);
+    gcSession->GcRecordObject(GetIndexId(), (void*)m_nodePool, node, DeallocateFromPoolCallBack, m_nodePool->m_size);
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    uint64_t hash = HashKey(key);
+    uint64_t bucket = 0;
+
+    inserted = false;
+    HashNode* newNode = (HashNode*)m_nodePool->Alloc();
+    if (newNode == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Insert", "Failed to allocate hash node for index %s", m_name.c_str());
+        return nullptr;
+    }
+    new (newNode) HashNode();
+    newNode->m_sentinel = sentinel;
+    newNode->m_hash = hash;
+    newNode->m_key.InitKey(m_keyLength, IsPrimaryKey() ? KeyType::PRIMARY_KEY : KeyType::SECONDARY_KEY);
+    newNode->m_key.CpKey(key->GetKeyBuf(), m_keyLength);
+
+    BucketArray* array = LockBucket(hash, bucket);
+    HashNode* head = BucketHead(array, bucket);
+    for (HashNode* node = head; node != nullptr; node = node->m_next) {
+        if (node->m_hash == hash && memcmp(node->m_key.GetKeyBuf(), key->GetKeyBuf(), m_keyLength) == 0) {
+            UnlockBucket(array, bucket, head);
+            m_nodePool->Release(newNode);
+            return node->m_sentinel;
+        }
+    }
+
+    newNode->m_next = head;
+    UnlockBucket(array, bucket, newNode);
+    inserted = true;
+
+    if (m_count.fetch_add(1, std::memory_order_relaxed) + 1 > (m_array->m_mask + 1) * MAX_LOAD_FACTOR) {
+        Grow();
+    }
+    MoveBuckets();
+    return nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    uint64_t hash = HashKey(key);
+
+    for (HashNode* node = ChainHead(m_array, hash); node != nullptr; node = node->m_next) {
+        if (node->m_hash == hash && memcmp(node->m_key.GetKeyBuf(), key->GetKeyBuf(), m_keyLength) == 0) {
+            return node->m_sentinel;
+        }
+    }
+    return nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    uint64_t hash = HashKey(key);
+    uint64_t bucket = 0;
+    HashNode* prev = nullptr;
+
+    BucketArray* array = LockBucket(hash, bucket);
+    HashNode* head = BucketHead(array, bucket);
+    HashNode* node = head;
+    while (node != nullptr &&
+           (node->m_hash != hash || memcmp(node->m_key.GetKeyBuf(), key->GetKeyBuf(), m_keyLength) != 0)) {
+        prev = node;
+        node = node->m_next;
+    }
+
+    if (node == nullptr) {
+        UnlockBucket(array, bucket, head);
+        return nullptr;
+    }
+
+    // The removed node keeps its next pointer, so readers standing on it continue with the rest of the chain
+    if (prev == nullptr) {
+        head = node->m_next;
+    } else {
+        prev->m_next = node->m_next;
+    }
+    UnlockBucket(array, bucket, head);
+    m_count.fetch_sub(1, std::memory_order_relaxed);
+
+    Sentinel* sentinel = node->m_sentinel;
+    RetireNode(MOTEngine::GetInstance()->GetCurrentGcSession(), node);
+    MoveBuckets();
+    return sentinel;
+}
+
+void HashPrimaryIndex::Grow()
+{
+    if (m_resizing || !__sync_bool_compare_and_swap(&m_resizing, false, true)) {
+        return;
+    }
+
+    BucketArray* oldArray = m_array;
+    uint64_t oldCount = oldArray->m_mask + 1;
+    if (m_count.load(std::memory_order_relaxed) <= oldCount * MAX_LOAD_FACTOR) {
+        m_resizing = false;
+        return;
+    }
+
+    // Without a larger array the table keeps working, only with longer chains
+    BucketArray* newArray = AllocBucketArray(oldCount * 2);
+    if (newArray == nullptr) {
+        m_resizing = false;
+        return;
+    }
+
+    // From now on each insert and remove moves a few buckets, see MoveBucketBatch()
+    m_moveCursor = 0;
+    m_movedCount = 0;
+    m_retryCursor = oldCount;
+    COMPILER_BARRIER
+    oldArray->m_next = newArray;
+    MOT_LOG_DEBUG("Hash index %s grows to %" PRIu64 " buckets", m_name.c_str(), oldCount * 2);
+}
+
+void HashPrimaryIndex::MoveBucketBatch()
+{
+    // A moved bucket stays moved, so a thread that still sees an array whose growth is complete moves nothing
+    BucketArray* oldArray = m_array;
+    if (oldArray->m_next == nullptr) {
+        return;
+    }
+    uint64_t oldCount = oldArray->m_mask + 1;
+    uint64_t movedCount = 0;
+
+    for (uint64_t i = 0; i < MOVE_BATCH_SIZE; i++) {
+        uint64_t bucket = m_moveCursor.fetch_add(1, std::memory_order_relaxed);
+        if (bucket >= oldCount) {
+            // All the buckets were handed out, the ones still moving are completed by their threads, and only the
+            // buckets whose move ran out of memory are left behind. The scan for them resumes where it stopped
+            uint64_t retry = m_retryCursor.load(std::memory_order_relaxed);
+            bucket = retry;
+            while (bucket < oldCount && IsBucketMoved(oldArray, bucket)) {
+                bucket++;
+            }
+            if (bucket != retry) {
+                // Fails if a move ran out of memory meanwhile and lowered the cursor, which is then kept
+                (void)m_retryCursor.compare_exchange_strong(retry, bucket, std::memory_order_relaxed);
+            }
+            if (bucket >= oldCount) {
+                break;
+            }
+        }
+
+        bool moved = false;
+        if (!MoveBucket(oldArray, bucket, moved)) {
+            // Retry this bucket once all the others are handed out
+            uint64_t retry = m_retryCursor.load(std::memory_order_relaxed);
+            while (bucket < retry &&
+                   !m_retryCursor.compare_exchange_weak(retry, bucket, std::memory_order_relaxed)) {
+            }
+            break;
+        }
+        if (moved) {
+            movedCount++;
+        }
+    }
+
+    if (movedCount > 0 && m_movedCount.fetch_add(movedCount) + movedCount == oldCount) {
+        CompleteGrow(oldArray);
+    }
+}
+
+bool HashPrimaryIndex::MoveBucket(BucketArray* oldArray, uint64_t bucket, bool& moved)
+{
+    BucketArray* newArray = oldArray->m_next;
+    HashNode* head = nullptr;
+
+    moved = false;
+    while (true) {
+        uint64_t value = (uint64_t)oldArray->m_buckets[bucket];
+        if ((value & BUCKET_MOVED_BIT) != 0) {
+            return true;
+        }
+        if ((value & BUCKET_LOCK_BIT) == 0 && __sync_bool_compare_and_swap(
+                &oldArray->m_buckets[bucket], (HashNode*)value, (HashNode*)(value | BUCKET_LOCK_BIT))) {
+            head = (HashNode*)value;
+            break;
+        }
+        PAUSE
+    }
+
+    // Only the keys of this bucket map to its two buckets in the new array, and writers reach those only after the
+    // bucket is marked as moved, so they are filled without locking. Nodes are copied rather than relinked, because
+    // readers may still walk the old chain, and relinking its nodes would make them miss keys
+    uint64_t lowBucket = bucket;
+    uint64_t highBucket = bucket + oldArray->m_mask + 1;
+    for (HashNode* node = head; node != nullptr; node = node->m_next) {
+        HashNode* newNode = (HashNode*)m_nodePool->Alloc();
+        if (newNode == nullptr) {
+            MOT_LOG_WARN("Failed to move hash bucket %" PRIu64 " of index %s: out of memory", bucket, m_name.c_str());
+            uint64_t copyBuckets[] = {lowBucket, highBucket};
+            for (uint64_t copyBucket : copyBuckets) {
+                HashNode* copy = newArray->m_buckets[copyBucket];
+                while (copy != nullptr) {
+                    HashNode* next = copy->m_next;
+                    m_nodePool->Release(copy);
+                    copy = next;
+                }
+                newArray->m_buckets[copyBucket] = nullptr;
+            }
+            UnlockBucket(oldArray, bucket, head);
+            return false;
+        }
+        errno_t erc = memcpy_s(newNode, m_nodePool->m_size, node, m_nodePool->m_size);
+        securec_check(erc, "\0", "\0");
+        uint64_t newBucket = node->m_hash & newArray->m_mask;
+        newNode->m_next = newArray->m_buckets[newBucket];
+        newArray->m_buckets[newBucket] = newNode;
+    }
+
+    COMPILER_BARRIER
+    oldArray->m_buckets[bucket] = (HashNode*)BUCKET_MOVED_BIT;
+
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    while (head != nullptr) {
+        HashNode* next = head->m_next;
+        RetireNode(gcSession, head);
+        head = next;
+    }
+    moved = true;
+    return true;
+}
+
+void HashPrimaryIndex::CompleteGrow(BucketArray* oldArray)
+{
+    BucketArray* newArray = oldArray->m_next;
+    uint64_t oldSize = BucketArraySize(oldArray->m_mask + 1);
+
+    COMPILER_BARRIER
+    m_array = newArray;
+
+    // Lookups that started from the old array are safe until the GC releases it
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    gcSession->GcRecordObject(GetIndexId(), oldArray, (void*)oldSize, DeallocateArrayCallBack, (uint32_t)oldSize);
+
+    MOT_LOG_DEBUG("Hash index %s grew to %" PRIu64 " buckets", m_name.c_str(), newArray->m_mask + 1);
+    m_resizing = false;
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    uint64_t arraySize = BucketArraySize(m_array->m_mask + 1);
+    if (m_array->m_next != nullptr) {
+        arraySize += BucketArraySize(m_array->m_next->m_mask + 1);
+    }
+    res += arraySize;
+    netto += arraySize;
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    IndexIterator* itr = new (std::nothrow) HashIterator(this, m_array, nullptr);
+    if (!itr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create iterator");
+    }
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    HashIterator* itr = new (std::nothrow) HashIterator(this, m_array, key);
+    if (!itr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create iterator");
+        found = false;
+        return nullptr;
+    }
+    found = itr->IsValid();
+    return itr;
+}
+
+HashPrimaryIndex::HashIterator::HashIterator(
+    const HashPrimaryIndex* index, const BucketArray* array, const Key* key)
+    : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false),
+      m_index(index),
+      m_array(array),
+      m_bucket(0),
+      m_node(nullptr),
+      m_pendingCount(0),
+      m_matchPrefix(key != nullptr),
+      m_hash(0)
+{
+    if (m_matchPrefix) {
+        errno_t erc = memcpy_s(m_prefix, MAX_KEY_SIZE, key->GetKeyBuf(), index->GetKeySizeNoSuffix());
+        securec_check(erc, "\0", "\0");
+        m_hash = index->HashKey(key);
+        Settle(ChainHead(array, m_hash));
+    } else {
+        Settle(EnterBucket(array, 0));
+    }
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::HashIterator::EnterBucket(const BucketArray* array, uint64_t bucket)
+{
+    while (true) {
+        uint64_t head = (uint64_t)array->m_buckets[bucket];
+        if ((head & BUCKET_MOVED_BIT) == 0) {
+            return (HashNode*)(head & ~BUCKET_LOCK_BIT);
+        }
+        // Each array doubles the previous one, so there is at most one pending bucket per array
+        MOT_ASSERT(m_pendingCount < MAX_PENDING_BUCKETS);
+        m_pending[m_pendingCount].m_array = array->m_next;
+        m_pending[m_pendingCount].m_bucket = bucket + array->m_mask + 1;
+        m_pendingCount++;
+        array = array->m_next;
+    }
+}
+
+void HashPrimaryIndex::HashIterator::Next()
+{
+    if (m_node != nullptr) {
+        Settle(m_node->m_next);
+    }
+}
+
+void HashPrimaryIndex::HashIterator::Settle(HashNode* node)
+{
+    if (m_matchPrefix) {
+        uint32_t prefixLength = m_index->GetKeySizeNoSuffix();
+        while (node != nullptr &&
+               (node->m_hash != m_hash || memcmp(node->m_key.GetKeyBuf(), m_prefix, prefixLength) != 0)) {
+            node = node->m_next;
+        }
+    } else {
+        while (node == nullptr) {
+            if (m_pendingCount > 0) {
+                m_pendingCount--;
+                node = EnterBucket(m_pending[m_pendingCount].m_array, m_pending[m_pendingCount].m_bucket);
+            } else if (m_bucket < m_array->m_mask) {
+                node = EnterBucket(m_array, ++m_bucket);
+            } else {
+                break;
+            }
+        }
+    }
+    m_node = node;
+}
+}  // namespace MOT
@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Index implementation using a resizable concurrent hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include <atomic>
+
+#include "index.h"
+#include "index_base.h"
+#include "utilities.h"
+#include "mm_global_api.h"
+
+namespace MOT {
+class GcManager;
+
+/**
+ * @class HashPrimaryIndex.
+ * @brief Index implementation using a chained hash table for point lookups.
+ * @detail Readers never lock. Writers lock a single bucket through the low bit of its head pointer. The table
+ * grows incrementally into a bucket array twice as large: every insert and remove moves a few more buckets, by
+ * copying the chain of an old bucket and marking the old bucket as moved. Lookups that reach a moved bucket
+ * continue in the new array. Once all the buckets are moved, the new array replaces the old one, and the old
+ * array and its nodes are retired to the GC, so readers that still walk them stay safe.
+ * Keys are hashed without the suffix of non-unique indexes, so all the rows of one key share a chain and a search
+ * iterates over them. There is no order between keys, so only exact key searches are supported.
+ */
+class HashPrimaryIndex : public Index {
+private:
+    /**
+     * @struct HashNode
+     * @brief A single key mapping in a bucket chain. Nodes are never changed once they are linked, except for the
+     * next pointer of the node before a removed node.
+     */
+    struct HashNode {
+        /** @var The next node in the bucket chain. */
+        HashNode* volatile m_next;
+
+        /** @var The sentinel mapped to the key. */
+        Sentinel* m_sentinel;
+
+        /** @var The hash code of the key prefix. */
+        uint64_t m_hash;
+
+        /** @var The key, followed by its buffer. Must be the last member. */
+        Key m_key;
+    };
+
+    /**
+     * @struct BucketArray
+     * @brief The bucket heads of the hash table. The low bit of a head is set while a writer locks the bucket,
+     * and the next bit is set once the bucket is moved to the next bucket array.
+     */
+    struct BucketArray {
+        /** @var The number of buckets minus one (the number of buckets is a power of two). */
+        uint64_t m_mask;
+
+        /** @var The bucket array into which the buckets are moved while the table grows, otherwise null. */
+        BucketArray* volatile m_next;
+
+        /** @var The bucket heads. */
+        HashNode* volatile m_buckets[0];
+    };
+
+    /**
+     * @class HashIterator
+     * @brief An index iterator implementation for a hash index. Iterates either over the whole table or over
+     * the nodes of one chain that match a key prefix.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param index The iterated index.
+         * @param array The bucket array to iterate over.
+         * @param key The key whose prefix to match, or null to iterate over the whole table.
+         */
+        HashIterator(const HashPrimaryIndex* index, const BucketArray* array, const Key* key);
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~HashIterator()
+        {}
+
+        /**
+         * @brief Queries whether this iterator is valid.
+         * @return True if the iterator points to an index item.
+         */
+        virtual bool IsValid() const
+        {
+            return m_valid && m_node != nullptr;
+        }
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to the key of the currently iterated item.
+         */
+        virtual const void* GetKey() const
+        {
+            return &m_node->m_key;
+        }
+
+        /**
+         * @brief Retrieves the row of the currently iterated item.
+         * @return A pointer to the row of the currently iterated item.
+         */
+        virtual Row* GetRow() const
+        {
+            return m_node->m_sentinel->GetData();
+        }
+
+        /**
+         * @brief Retrieves the currently iterated primary sentinel.
+         * @return The primary sentinel.
+         */
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item.
+         */
+        virtual void Next();
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported, hash iterators are forward only.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        /**
+         * @brief Queries whether this index iterator equals to another index iterator.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if iterators point to the same index item, otherwise false.
+         */
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         * @param serializeFunc The serialization function.
+         * @param buff The buffer into which the iterator is to be serialized.
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         * @param deserializeFunc The deserialization function.
+         * @param buff The buffer from which the iterator is to be deserialized.
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+    private:
+        /** @var The maximum number of pending buckets, one per bucket array that the table may grow into. */
+        static constexpr uint32_t MAX_PENDING_BUCKETS = 64;
+
+        /**
+         * @struct BucketRef
+         * @brief A bucket of a newer bucket array that is still to be iterated.
+         */
+        struct BucketRef {
+            /** @var The bucket array. */
+            const BucketArray* m_array;
+
+            /** @var The bucket. */
+            uint64_t m_bucket;
+        };
+
+        /**
+         * @brief Moves to the first matching node starting at the given node, or to the first node of the
+         * following non-empty bucket when iterating over the whole table.
+         */
+        void Settle(HashNode* node);
+
+        /**
+         * @brief Retrieves the chain of a bucket. When the bucket was moved, retrieves the chain of its first
+         * bucket in the next array, and keeps its second bucket to be iterated later.
+         */
+        HashNode* EnterBucket(const BucketArray* array, uint64_t bucket);
+
+        /** @var The iterated index. */
+        const HashPrimaryIndex* m_index;
+
+        /** @var The iterated bucket array. */
+        const BucketArray* m_array;
+
+        /** @var The current bucket. */
+        uint64_t m_bucket;
+
+        /** @var The current node. */
+        HashNode* m_node;
+
+        /** @var The buckets of newer bucket arrays that hold the remaining keys of moved buckets. */
+        BucketRef m_pending[MAX_PENDING_BUCKETS];
+
+        /** @var The number of pending buckets. */
+        uint32_t m_pendingCount;
+
+        /** @var Specifies whether only the nodes matching the key prefix are iterated. */
+        bool m_matchPrefix;
+
+        /** @var The hash code of the matched key prefix. */
+        uint64_t m_hash;
+
+        /** @var The matched key prefix. */
+        uint8_t m_prefix[MAX_KEY_SIZE];
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_array(nullptr),
+          m_nodePool(nullptr),
+          m_count(0),
+          m_moveCursor(0),
+          m_movedCount(0),
+          m_retryCursor(0),
+          m_resizing(false),
+          m_initialized(false)
+    {}
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashPrimaryIndex()
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyTable();
+        }
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index.
+     * @return The number of rows stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy the table and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyTable();
+
+        return IndexInitImpl(nullptr);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    /**
+     * @brief Searches for all the items whose key matches the given key, without the suffix of non-unique
+     * indexes. The matchKey and forward arguments are ignored since hash keys are not ordered.
+     */
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Static callback function for deallocate memory from pools.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to allocated memory.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateFromPoolCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+        if (dropIndex == false) {
+            localPoolPtr->Release(ptr);
+        }
+        return localPoolPtr->m_size;
+    }
+
+    /**
+     * @brief Static callback function for deallocate a retired bucket array.
+     * @param array The bucket array.
+     * @param size The size of the bucket array.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateArrayCallBack(void* array, void* size, bool dropIndex)
+    {
+        // Bucket arrays are not allocated from the index pools, so they are freed on drop as well
+        MemGlobalFree(array);
+        return (uint32_t)(uint64_t)size;
+    }
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Initial number of buckets. */
+    static constexpr uint64_t INITIAL_BUCKET_COUNT = 1024;
+
+    /** @var The average chain length that triggers doubling the number of buckets. */
+    static constexpr uint64_t MAX_LOAD_FACTOR = 2;
+
+    /** @var The number of buckets that each insert or remove moves while the table grows. */
+    static constexpr uint64_t MOVE_BATCH_SIZE = 8;
+
+    /** @var The bit of a bucket head that locks the bucket. */
+    static constexpr uint64_t BUCKET_LOCK_BIT = 1;
+
+    /** @var The bit of a bucket head that marks the bucket as moved to the next bucket array. */
+    static constexpr uint64_t BUCKET_MOVED_BIT = 2;
+
+    /** @var The current bucket array, from which every lookup starts. */
+    BucketArray* volatile m_array;
+
+    /** @var Memory pool for hash nodes. */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var The number of nodes in the table. */
+    std::atomic<uint64_t> m_count;
+
+    /** @var The next bucket of the current array to hand out for moving while the table grows. */
+    std::atomic<uint64_t> m_moveCursor;
+
+    /** @var The number of buckets of the current array moved so far while the table grows. */
+    std::atomic<uint64_t> m_movedCount;
+
+    /** @var The first bucket of the current array whose move may have run out of memory, past the end if none. */
+    std::atomic<uint64_t> m_retryCursor;
+
+    /** @var Set while the table grows. */
+    volatile bool m_resizing;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    static inline HashNode* BucketHead(const BucketArray* array, uint64_t bucket)
+    {
+        return (HashNode*)((uint64_t)array->m_buckets[bucket] & ~(BUCKET_LOCK_BIT | BUCKET_MOVED_BIT));
+    }
+
+    static inline bool IsBucketMoved(const BucketArray* array, uint64_t bucket)
+    {
+        return ((uint64_t)array->m_buckets[bucket] & BUCKET_MOVED_BIT) != 0;
+    }
+
+    /**
+     * @brief Retrieves the chain of a key, following moved buckets into the newer bucket arrays.
+     */
+    static HashNode* ChainHead(const BucketArray* array, uint64_t hash);
+
+    static inline uint64_t BucketArraySize(uint64_t bucketCount)
+    {
+        return sizeof(BucketArray) + bucketCount * sizeof(HashNode*);
+    }
+
+    inline uint64_t HashKey(const Key* key) const
+    {
+        return HashKeyBuf(key->GetKeyBuf(), GetKeySizeNoSuffix());
+    }
+
+    static uint64_t HashKeyBuf(const uint8_t* buf, uint32_t len);
+
+    static BucketArray* AllocBucketArray(uint64_t bucketCount);
+
+    /**
+     * @brief Locks the bucket of a key, in the first bucket array where that bucket is not moved yet.
+     * @param hash The hash code of the key.
+     * @param[out] bucket The locked bucket.
+     * @return The bucket array of the locked bucket.
+     */
+    BucketArray* LockBucket(uint64_t hash, uint64_t& bucket);
+
+    /**
+     * @brief Releases a bucket lock and sets the bucket head.
+     */
+    static inline void UnlockBucket(BucketArray* array, uint64_t bucket, HashNode* head)
+    {
+        COMPILER_BARRIER
+        array->m_buckets[bucket] = head;
+    }
+
+    /**
+     * @brief Starts doubling the number of buckets, unless the table already grows.
+     */
+    void Grow();
+
+    /**
+     * @brief Moves a few buckets while the table grows, and completes the growth after the last one.
+     */
+    inline void MoveBuckets()
+    {
+        if (unlikely(m_array->m_next != nullptr)) {
+            MoveBucketBatch();
+        }
+    }
+
+    void MoveBucketBatch();
+
+    /**
+     * @brief Copies the chain of an old bucket into the next bucket array, and marks the old bucket as moved.
+     * @param oldArray The bucket array being moved.
+     * @param bucket The bucket to move.
+     * @param[out] moved Set if this call moved the bucket, rather than finding it already moved.
+     * @return False if there was not enough memory to copy the chain.
+     */
+    bool MoveBucket(BucketArray* oldArray, uint64_t bucket, bool& moved);
+
+    /**
+     * @brief Replaces the current bucket array with its next one, after all its buckets are moved.
+     */
+    void CompleteGrow(BucketArray* oldArray);
+
+    /**
+     * @brief Retires a node to the GC of the current session.
+     */
+    void RetireNode(GcManager* gcSession, HashNode* node);
+
+    /**
+     * @brief Frees the node pool and the bucket arrays.
+     */
+    void DestroyTable();
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
@@ -256,6 +256,12 @@ bool Index::IndexInsert(Sentinel*& outputSentinel, const Key* key, uint32_t pid,
 
     while (retryInsert) {
         outputSentinel = IndexInsertImpl(key, sentinel, inserted, pid);
+        if (unlikely(inserted == false && outputSentinel == nullptr)) {
+            // the index failed to allocate its own memory for the key mapping
+            m_sentinelPool->Release<Sentinel>(sentinel);
+            rc = RC_MEMORY_ALLOCATION_ERROR;
+            return false;
+        }
         // sync between rollback/delete and insert
         if (inserted == false) {
             // Spin if the counter is 0 - aborting in parallel or sentinel is marks for commit
@@ -296,7 +302,10 @@ Sentinel* Index::IndexInsert(const Key* key, Row* row, uint32_t pid)
     sentinel->Init(this, nullptr);
     sentinel->UnSetDirty();
     currSentinel = IndexInsertImpl(key, sentinel, inserted, pid);
-    if (currSentinel != nullptr) {
+    if (unlikely(!inserted && currSentinel == nullptr)) {
+        m_sentinelPool->Release<Sentinel>(sentinel);
+        return nullptr;
+    } else if (currSentinel != nullptr) {
         // no need to report to full error stack
         SetLastError(MOT_ERROR_UNIQUE_VIOLATION, MOT_SEVERITY_NORMAL);
         m_sentinelPool->Release<Sentinel>(sentinel);
@@ -349,72 +358,19 @@ Sentinel* Index::IndexRemove(const Key* key, uint32_t pid)
     return sentinel;
 }
 
-void Index::Compact(Table* table, uint32_t pid)
+uint64_t Index::Compact()
 {
-    IndexIterator* it = nullptr;
-    char ixPrefix[256];
     char sentinelPrefix[256];
-    errno_t erc = snprintf_s(ixPrefix, sizeof(ixPrefix), sizeof(ixPrefix) - 1, "%s(key pool)", m_name.c_str());
-    securec_check_ss(erc, "\0", "\0");
-    ixPrefix[erc] = 0;
-    erc = snprintf_s(
+    errno_t erc = snprintf_s(
         sentinelPrefix, sizeof(sentinelPrefix), sizeof(sentinelPrefix) - 1, "%s(sentinel pool)", m_name.c_str());
     securec_check_ss(erc, "\0", "\0");
     sentinelPrefix[erc] = 0;
 
-    do {
-        CompactHandler chSentinel(m_sentinelPool, sentinelPrefix);
-
-        chSentinel.StartCompaction(CompactTypeT::COMPACT_SIMPLE);
-        it = Begin(pid);
-        if (it == nullptr) {
-            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Compaction", "Failed to begin iterating over index");
-            return;
-        }
-
-        if (m_indexOrder == IndexOrder::INDEX_ORDER_PRIMARY) {
-            char tabPrefix[256];
-            erc = snprintf_s(
-                tabPrefix, sizeof(tabPrefix), sizeof(tabPrefix) - 1, "%s(row pool)", table->GetTableName().c_str());
-            securec_check_ss(erc, "\0", "\0");
-            tabPrefix[erc] = 0;
-            CompactHandler chRow(table->m_rowPool, tabPrefix);
-
-            chRow.StartCompaction();
-
-            if (!chRow.IsCompactionNeeded()) {
-                break;
-            }
-
-            // return if empty
-            if (it == nullptr || !it->IsValid()) {
-                break;
-            }
-
-            // do compaction
-            while (it->IsValid()) {
-                Sentinel* ps = it->GetPrimarySentinel();
-                Row* row = ps->GetData();
-                if (row != nullptr) {
-                    Row* newRow = chRow.CompactObj<Row>(row);
-                    if (newRow != nullptr) {
-                        ps->SetNextPtr(newRow);
-                    }
-                }
-                it->Next();
-            }
-
-            // end compaction
-            chRow.EndCompaction();
-        }
-
-        chSentinel.EndCompaction();
-    } while (false);
-
-    if (it != nullptr) {
-        it->Destroy();
-        delete it;
-    }
+    // sentinels are referenced by the index itself, so they are not relocated, only empty pools are released
+    CompactHandler chSentinel(m_sentinelPool, sentinelPrefix);
+    chSentinel.StartCompaction(CompactTypeT::COMPACT_SIMPLE);
+    chSentinel.EndCompaction();
+    return chSentinel.GetReclaimedBytes();
 }
 
 uint64_t Index::GetIndexSize()
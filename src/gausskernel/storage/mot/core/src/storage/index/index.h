@@ -610,7 +610,11 @@ public:
 
     void Truncate(bool isDrop);
 
-    void Compact(Table* table, uint32_t pid);
+    /**
+     * @brief Releases the sentinel pool buffers left empty by removed keys.
+     * @return The amount of memory in bytes returned by the compaction.
+     */
+    uint64_t Compact();
 
     virtual uint64_t GetIndexSize();
 
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * index_builder.cpp
+ *    Builds the data of a new secondary index in parallel.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/index_builder.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <algorithm>
+#include "index_builder.h"
+#include "table.h"
+#include "mot_engine.h"
+#include "mot_error.h"
+
+namespace MOT {
+DECLARE_LOGGER(IndexBuilder, Storage)
+
+IndexBuilder::IndexBuilder(Table* table, Index* index, uint32_t numWorkers)
+    : m_table(table),
+      m_index(index),
+      m_numWorkers(numWorkers),
+      m_scanDone(false),
+      m_rc(RC_OK),
+      m_errorRow(nullptr),
+      m_rowCount(0)
+{}
+
+IndexBuilder::~IndexBuilder()
+{
+    StopWorkers();
+    for (Batch* batch : m_batches) {
+        delete batch;
+    }
+    m_batches.clear();
+}
+
+RC IndexBuilder::Build(uint32_t pid)
+{
+    IndexIterator* it = m_table->GetPrimaryIndex()->Begin(pid);
+    if (it == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Build Index", "Failed to begin iterating over primary index");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    Batch* batch = new (std::nothrow) Batch();
+    if (batch == nullptr) {
+        delete it;
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Build Index", "Failed to allocate row batch");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    batch->reserve(BATCH_SIZE);
+
+    // consecutive rows of the primary index make up each batch, so runs are built from disjoint key ranges.
+    // Deleted rows kept in the primary index for the snapshots are not part of the table
+    while (it->IsValid() && !HasError()) {
+        Row* row = it->GetRow();
+        if (row != nullptr && !row->IsRowDeleted()) {
+            batch->push_back(row);
+            if (batch->size() == BATCH_SIZE) {
+                if (m_workers.empty()) {
+                    StartWorkers();
+                }
+                PushBatch(batch);
+                batch = new (std::nothrow) Batch();
+                if (batch == nullptr) {
+                    MOT_REPORT_ERROR(MOT_ERROR_OOM, "Build Index", "Failed to allocate row batch");
+                    OnError(RC_MEMORY_ALLOCATION_ERROR, nullptr);
+                    break;
+                }
+                batch->reserve(BATCH_SIZE);
+            }
+        }
+        it->Next();
+    }
+    delete it;
+
+    if (batch != nullptr && !batch->empty() && !HasError()) {
+        if (m_workers.empty()) {
+            // the whole table fits in a single batch, so it is not worth starting any worker
+            uint8_t* keyBuf = new (std::nothrow) uint8_t[batch->size() * m_index->GetKeyLength()];
+            uint32_t* order = new (std::nothrow) uint32_t[batch->size()];
+            if (keyBuf == nullptr || order == nullptr) {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM, "Build Index", "Failed to allocate sort buffers");
+                OnError(RC_MEMORY_ALLOCATION_ERROR, nullptr);
+            } else {
+                (void)BuildRun(*batch, keyBuf, order, pid);
+            }
+            delete[] keyBuf;
+            delete[] order;
+        } else {
+            PushBatch(batch);
+            batch = nullptr;
+        }
+    }
+    delete batch;
+
+    StopWorkers();
+
+    if (!HasError()) {
+        MOT_LOG_TRACE("Built index %s of table %s with %" PRIu64 " rows using %u workers",
+            m_index->GetName().c_str(),
+            m_table->GetLongTableName().c_str(),
+            m_rowCount.load(),
+            (unsigned)m_workers.size());
+    }
+    return m_rc;
+}
+
+bool IndexBuilder::BuildRun(const Batch& batch, uint8_t* keyBuf, uint32_t* order, uint32_t pid)
+{
+    uint32_t keyLength = m_index->GetKeyLength();
+    uint32_t rowCount = (uint32_t)batch.size();
+    MaxKey key;
+
+    for (uint32_t i = 0; i < rowCount; ++i) {
+        key.InitKey(keyLength);
+        m_index->BuildKey(m_table, batch[i], &key);
+        errno_t erc = memcpy_s(keyBuf + i * keyLength, keyLength, key.GetKeyBuf(), keyLength);
+        securec_check(erc, "\0", "\0");
+        order[i] = i;
+    }
+
+    // inserting the run in key order keeps consecutive inserts on the same index leaves
+    std::sort(order, order + rowCount, [keyBuf, keyLength](uint32_t lhs, uint32_t rhs) {
+        return memcmp(keyBuf + lhs * keyLength, keyBuf + rhs * keyLength, keyLength) < 0;
+    });
+
+    for (uint32_t i = 0; i < rowCount; ++i) {
+        uint32_t pos = order[i];
+        key.InitKey(keyLength);
+        key.CpKey(keyBuf + pos * keyLength, keyLength);
+        if (m_index->IndexInsert(&key, batch[pos], pid) == nullptr) {
+            OnError(MOT_IS_ERROR(MOT_ERROR_UNIQUE_VIOLATION) ? RC_UNIQUE_VIOLATION : RC_MEMORY_ALLOCATION_ERROR,
+                batch[pos]);
+            return false;
+        }
+    }
+
+    m_rowCount += rowCount;
+    return true;
+}
+
+void IndexBuilder::StartWorkers()
+{
+    MOT_LOG_DEBUG("Starting %u workers to build index %s", m_numWorkers, m_index->GetName().c_str());
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        m_workers.push_back(std::thread(WorkerFunc, this));
+    }
+}
+
+void IndexBuilder::StopWorkers()
+{
+    m_lock.lock();
+    m_scanDone = true;
+    m_lock.unlock();
+    m_batchReady.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void IndexBuilder::PushBatch(Batch* batch)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    // bound the pending batches, so the scan does not run too far ahead of the workers
+    m_batchTaken.wait(lock, [this] { return m_batches.size() < 2 * m_numWorkers || HasError(); });
+    if (HasError()) {
+        lock.unlock();
+        delete batch;
+        return;
+    }
+    m_batches.push_back(batch);
+    lock.unlock();
+    m_batchReady.notify_one();
+}
+
+IndexBuilder::Batch* IndexBuilder::PopBatch()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_batchReady.wait(lock, [this] { return !m_batches.empty() || m_scanDone || HasError(); });
+    if (m_batches.empty() || HasError()) {
+        return nullptr;
+    }
+    Batch* batch = m_batches.front();
+    m_batches.pop_front();
+    lock.unlock();
+    m_batchTaken.notify_one();
+    return batch;
+}
+
+void IndexBuilder::OnError(RC rc, Row* row)
+{
+    m_lock.lock();
+    if (m_rc == RC_OK) {
+        m_errorRow = row;
+        m_rc = rc;
+    }
+    m_lock.unlock();
+    m_batchReady.notify_all();
+    m_batchTaken.notify_all();
+}
+
+void IndexBuilder::WorkerFunc(IndexBuilder* builder)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        MOT_LOG_ERROR("IndexBuilder::WorkerFunc: Failed to initialize Session Context");
+        builder->OnError(RC_MEMORY_ALLOCATION_ERROR, nullptr);
+        engine->OnCurrentThreadEnding();
+        return;
+    }
+
+    uint32_t pid = MOTCurrThreadId;
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetAffinity(pid)) {
+        MOT_LOG_WARN("Failed to set affinity of index build worker, index build performance may be affected");
+    }
+
+    uint8_t* keyBuf = new (std::nothrow) uint8_t[BATCH_SIZE * builder->m_index->GetKeyLength()];
+    uint32_t* order = new (std::nothrow) uint32_t[BATCH_SIZE];
+    if (keyBuf == nullptr || order == nullptr) {
+        MOT_LOG_ERROR("IndexBuilder::WorkerFunc: Failed to allocate sort buffers");
+        builder->OnError(RC_MEMORY_ALLOCATION_ERROR, nullptr);
+    } else {
+        Batch* batch = nullptr;
+        while ((batch = builder->PopBatch()) != nullptr) {
+            bool succeeded = builder->BuildRun(*batch, keyBuf, order, pid);
+            delete batch;
+            if (!succeeded) {
+                break;
+            }
+        }
+    }
+
+    delete[] keyBuf;
+    delete[] order;
+
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    engine->OnCurrentThreadEnding();
+}
+}  // namespace MOT
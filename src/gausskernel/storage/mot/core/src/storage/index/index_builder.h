@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * index_builder.h
+ *    Builds the data of a new secondary index in parallel.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/index_builder.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef MOT_INDEX_BUILDER_H
+#define MOT_INDEX_BUILDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "global.h"
+
+namespace MOT {
+class Table;
+class Index;
+class Row;
+
+/**
+ * @class IndexBuilder
+ * @brief Builds the data of a new secondary index from the committed rows of a populated table.
+ * @detail The calling thread scans the primary index and splits it into batches of consecutive rows, which are
+ * consumed by a pool of worker threads. Each worker turns its batch into a sorted run of keys and inserts the run
+ * into the new index in key order. Tables which fit in a single batch are indexed by the calling thread alone.
+ * The caller must hold the table write lock for the whole build, so no rows are added or removed meanwhile, and the
+ * new index must not be visible yet. The entries are inserted as committed, and on failure they are released along
+ * with the index itself.
+ */
+class IndexBuilder {
+public:
+    /**
+     * @brief Constructor.
+     * @param table The table being indexed.
+     * @param index The new secondary index.
+     * @param numWorkers The number of worker threads to use.
+     */
+    IndexBuilder(Table* table, Index* index, uint32_t numWorkers);
+
+    /** @brief Destructor. */
+    ~IndexBuilder();
+
+    /**
+     * @brief Builds the index data.
+     * @param pid The logical thread identifier of the calling thread.
+     * @return RC_OK on success, RC_UNIQUE_VIOLATION if two rows have the same key in a unique index, or
+     * RC_MEMORY_ALLOCATION_ERROR.
+     */
+    RC Build(uint32_t pid);
+
+    /** @brief Retrieves the row whose key could not be inserted (valid only after a failed build). */
+    inline Row* GetErrorRow() const
+    {
+        return m_errorRow;
+    }
+
+    /** @brief Retrieves the number of rows inserted into the index. */
+    inline uint64_t GetRowCount() const
+    {
+        return m_rowCount;
+    }
+
+    /** @var The number of rows in each batch. */
+    static constexpr uint32_t BATCH_SIZE = 4096;
+
+    IndexBuilder(const IndexBuilder& orig) = delete;
+    IndexBuilder& operator=(const IndexBuilder& orig) = delete;
+
+private:
+    typedef std::vector<Row*> Batch;
+
+    /** @brief Worker thread function. */
+    static void WorkerFunc(IndexBuilder* builder);
+
+    /**
+     * @brief Inserts the keys of a batch of rows into the index in key order.
+     * @param batch The rows to index.
+     * @param keyBuf Buffer of the batch keys, holding BATCH_SIZE keys.
+     * @param order Array of BATCH_SIZE entries used to sort the keys.
+     * @param pid The logical thread identifier of the calling thread.
+     * @return True on success.
+     */
+    bool BuildRun(const Batch& batch, uint8_t* keyBuf, uint32_t* order, uint32_t pid);
+
+    /** @brief Starts the worker threads. */
+    void StartWorkers();
+
+    /** @brief Signals the workers that no more batches will be pushed and waits for them to finish. */
+    void StopWorkers();
+
+    /** @brief Hands a batch over to the workers, waiting while too many batches are pending. */
+    void PushBatch(Batch* batch);
+
+    /** @brief Retrieves the next pending batch, or null when the scan is done and all batches were consumed. */
+    Batch* PopBatch();
+
+    /** @brief Records a failure of the build. The first failure wins. */
+    void OnError(RC rc, Row* row);
+
+    inline bool HasError() const
+    {
+        return m_rc != RC_OK;
+    }
+
+    /** @var The table being indexed. */
+    Table* m_table;
+
+    /** @var The new index. */
+    Index* m_index;
+
+    /** @var The number of worker threads. */
+    uint32_t m_numWorkers;
+
+    /** @var The worker threads. */
+    std::vector<std::thread> m_workers;
+
+    /** @var Synchronizes the pending batch list and the build status. */
+    std::mutex m_lock;
+
+    /** @var Signaled when a batch is pushed or the scan is done. */
+    std::condition_variable m_batchReady;
+
+    /** @var Signaled when a worker takes a pending batch. */
+    std::condition_variable m_batchTaken;
+
+    /** @var The batches waiting for a worker. */
+    std::list<Batch*> m_batches;
+
+    /** @var Specifies whether the scan of the primary index is done. */
+    bool m_scanDone;
+
+    /** @var The build status. */
+    std::atomic<RC> m_rc;
+
+    /** @var The row which caused the build to fail. */
+    Row* m_errorRow;
+
+    /** @var The number of rows inserted into the index. */
+    std::atomic<uint64_t> m_rowCount;
+};
+}  // namespace MOT
+
+#endif /* MOT_INDEX_BUILDER_H */
@@ -86,6 +86,12 @@ public:
      */
     static Index* CreatePrimaryTreeIndex(IndexTreeFlavor flavor);
 
+    /**
+     * @brief Factory function for creating a primary hash index.
+     * @return The created hash index.
+     */
+    static Index* CreatePrimaryHashIndex();
+
     DECLARE_CLASS_LOGGER()
 };
 }  // namespace MOT
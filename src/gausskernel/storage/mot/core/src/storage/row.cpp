@@ -67,6 +67,48 @@ RC Row::GetRow(AccessType type, TxnAccess* txn, Row* row, TransactionId& lastTid
     return this->m_rowHeader.GetLocalCopy(txn, type, row, this, lastTid);
 }
 
+RC Row::GetSnapshotRow(uint64_t snapshotCsn, Row* row) const
+{
+    const Sentinel* sentinel = m_pSentinel;
+    row->m_table = GetTable();
+
+    while (true) {
+        // A commit that precedes the snapshot locks the primary sentinel before taking its CSN and releases it only
+        // after the row is written, so wait for it unless the row already moved past the snapshot
+        if (sentinel != nullptr && sentinel->IsLocked() && m_rowHeader.GetCSN() <= snapshotCsn) {
+            PAUSE
+            continue;
+        }
+
+        uint64_t v = m_rowHeader.m_csnWord;
+        if (v & LOCK_BIT) {
+            PAUSE
+            continue;
+        }
+        Row* version = m_prevVersion;
+        row->Copy(this);
+        COMPILER_BARRIER
+        if (v != m_rowHeader.m_csnWord) {
+            continue;
+        }
+
+        if ((v & CSN_BITS) <= snapshotCsn) {
+            return (v & ABSENT_BIT) ? RC_ABORT : RC_OK;
+        }
+
+        // Versions are immutable, and the ones retired meanwhile are older than any active snapshot reads
+        while (version != nullptr && version->GetCommitSequenceNumber() > snapshotCsn) {
+            version = version->m_prevVersion;
+        }
+        // A version marking a deletion is kept when the key is inserted again
+        if (version == nullptr || version->IsAbsentRow()) {
+            return RC_ABORT;
+        }
+        row->Copy(version);
+        return RC_OK;
+    }
+}
+
 Row* Row::CreateCopy()
 {
     Row* row = m_table->CreateNewRow();
@@ -268,6 +268,23 @@ public:
      */
     RC GetRow(AccessType type, TxnAccess* txn, Row* row, TransactionId& lastTid) const;
 
+    /**
+     * @brief Reads the version of the row visible to a CSN snapshot, without any validation.
+     * @param snapshotCsn The snapshot commit sequence number.
+     * @param[out] row Receives a copy of the visible version.
+     * @return RC_OK if a version is visible, RC_ABORT if the row was inserted after the snapshot or is deleted.
+     */
+    RC GetSnapshotRow(uint64_t snapshotCsn, Row* row) const;
+
+    /**
+     * @brief Retrieves the previous committed version of the row (MVCC snapshot read).
+     * @return The previous version, or null if none is kept.
+     */
+    inline Row* GetPrevVersion() const
+    {
+        return m_prevVersion;
+    }
+
     /**
      * @brief Class specific in-place new operator.
      * @param size Object size in bytes.
@@ -511,11 +528,37 @@ public:
         MOT_ASSERT(t != nullptr);
         size += t->GetRowSizeFromPool();
         if (!dropIndex) {
+            // A row owns the older versions chained to it
+            Row* version = r->m_prevVersion;
             t->DestroyRow(r);
+            while (version != nullptr) {
+                Row* prev = version->m_prevVersion;
+                size += t->GetRowSizeFromPool();
+                t->DestroyRow(version);
+                version = prev;
+            }
         }
         return size;
     }
 
+    /**
+     * @brief a callback function to destroy a row replaced by a new row that took over its older versions.
+     * @param gcParam1 A place holder for first paramater passed by the GC.
+     * @param gcParam1 A place holder for second param passed by the GC.
+     * @param dropIndex An indicator for drop index operator.
+     */
+    static uint32_t RowOnlyDtor(void* gcParam1, void* gcParam2, bool dropIndex)
+    {
+        Row* r = reinterpret_cast<Row*>(gcParam1);
+        MOT_ASSERT(r != nullptr);
+        Table* t = r->GetTable();
+        MOT_ASSERT(t != nullptr);
+        if (!dropIndex) {
+            t->DestroyRow(r);
+        }
+        return t->GetRowSizeFromPool();
+    }
+
     static constexpr uint64_t INVALID_ROW_ID = 0;
 
 private:
@@ -580,6 +623,9 @@ protected:
     /** @var the row id. */
     uint64_t m_rowId;
 
+    /** @var Previous committed version of the row, kept for MVCC snapshot reads. */
+    Row* volatile m_prevVersion = nullptr;
+
     /** @var The key type. */
     KeyType m_keyType;
 
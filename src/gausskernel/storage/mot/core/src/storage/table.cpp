@@ -33,6 +33,8 @@
 #include "txn_insert_action.h"
 #include "redo_log_writer.h"
 #include "recovery_manager.h"
+#include "object_pool_compact.h"
+#include "index_builder.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(Table, Storage);
@@ -69,6 +71,12 @@ Table::~Table()
         ObjAllocInterface::FreeObjPool(&m_rowPool);
     }
 
+    while (m_tombstoneHead != nullptr) {
+        Tombstone* next = m_tombstoneHead->m_next;
+        free(m_tombstoneHead);
+        m_tombstoneHead = next;
+    }
+
     int destroyRc = pthread_rwlock_destroy(&m_rwLock);
     if (destroyRc != 0) {
         MOT_LOG_ERROR("~Table: rwlock destroy failed (%d)", destroyRc);
@@ -259,10 +267,10 @@ bool Table::CreateSecondaryIndexDataNonTransactional(MOT::Index* index, uint32_t
         return false;
     }
 
-    // iterate over primary index and insert secondary index keys
+    // iterate over primary index and insert secondary index keys, deleted rows kept for the snapshots are skipped
     while (it->IsValid()) {
         Row* row = it->GetRow();
-        if (row == nullptr) {
+        if (row == nullptr || row->IsRowDeleted()) {
             it->Next();
             continue;
         }
@@ -286,8 +294,39 @@ bool Table::CreateSecondaryIndexDataNonTransactional(MOT::Index* index, uint32_t
     }
     return ret;
 }
+bool Table::CreateSecondaryIndexDataParallel(MOT::Index* index, TxnManager* txn)
+{
+    IndexBuilder builder(this, index, GetGlobalConfiguration().m_indexBuildWorkers);
+    RC rc = builder.Build(txn->GetThdId());
+    if (rc == RC_OK) {
+        return true;
+    }
+
+    // the entries inserted so far are released along with the index, which is not part of the table yet
+    GcManager::ClearIndexElements(index->GetIndexId());
+    txn->m_err = rc;
+    txn->m_errIx = nullptr;
+    Row* errorRow = builder.GetErrorRow();
+    if (rc == RC_UNIQUE_VIOLATION && errorRow != nullptr) {
+        index->BuildErrorMsg(this, errorRow, txn->m_errMsgBuf, sizeof(txn->m_errMsgBuf));
+    } else {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Create Secondary Index",
+            "Failed to build secondary index %s in table %s",
+            index->GetName().c_str(),
+            m_longTableName.c_str());
+    }
+    return false;
+}
+
 bool Table::CreateSecondaryIndexData(MOT::Index* index, TxnManager* txn)
 {
+    // rows modified by the current transaction are visible only through its access set, so only the serial path
+    // can index them
+    if (GetGlobalConfiguration().m_indexBuildWorkers > 1 && txn->m_accessMgr->m_rowCnt == 0) {
+        return CreateSecondaryIndexDataParallel(index, txn);
+    }
+
     RC status = RC_OK;
     bool error = false;
     Key* key = nullptr;
@@ -319,9 +358,13 @@ bool Table::CreateSecondaryIndexData(MOT::Index* index, TxnManager* txn)
                     row = nullptr;
                     break;
                 case RC::RC_LOCAL_ROW_NOT_FOUND:
+                    // a deleted row kept for the snapshots is not part of the table
+                    if (row != nullptr && row->IsRowDeleted()) {
+                        row = nullptr;
+                    }
                     break;
                 case RC::RC_LOCAL_ROW_FOUND:
-                    if (row == nullptr) {
+                    if (row == nullptr || row->IsRowDeleted()) {
                         row = tmpRow;
                     }
                     break;
@@ -596,6 +639,90 @@ Row* Table::RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcMan
     return OutputRow;
 }
 
+bool Table::AddTombstone(Row* row, uint64_t csn)
+{
+    MOT::Index* ix = GetPrimaryIndex();
+    uint16_t keyLength = (uint16_t)ix->GetKeyLength();
+    // the key is stored right after the tombstone
+    Tombstone* tombstone = (Tombstone*)malloc(sizeof(Tombstone) + keyLength);
+    if (tombstone == nullptr) {
+        return false;
+    }
+    MaxKey key;
+    key.InitKey(keyLength);
+    ix->BuildKey(this, row, &key);
+    tombstone->m_next = nullptr;
+    tombstone->m_csn = csn;
+    tombstone->m_indexId = ix->GetIndexId();
+    tombstone->m_key = (uint8_t*)(tombstone + 1);
+    errno_t erc = memcpy_s(tombstone->m_key, keyLength, key.GetKeyBuf(), keyLength);
+    securec_check(erc, "\0", "\0");
+
+    m_tombstoneLock.lock();
+    if (m_tombstoneTail == nullptr) {
+        m_tombstoneHead = tombstone;
+    } else {
+        m_tombstoneTail->m_next = tombstone;
+    }
+    m_tombstoneTail = tombstone;
+    ++m_tombstoneCount;
+    m_tombstoneLock.unlock();
+    return true;
+}
+
+void Table::PurgeTombstones(uint64_t horizon, uint64_t tid, GcManager* gc)
+{
+    // another thread purging the table meanwhile will do
+    if (m_tombstoneCount == 0 || !m_tombstoneLock.try_lock()) {
+        return;
+    }
+
+    // deletions are appended roughly in CSN order, stop at the first one some snapshot may still read
+    while (m_tombstoneHead != nullptr && m_tombstoneHead->m_csn <= horizon) {
+        Tombstone* tombstone = m_tombstoneHead;
+        if (!PurgeTombstone(tombstone, tid, gc)) {
+            break;
+        }
+        m_tombstoneHead = tombstone->m_next;
+        if (m_tombstoneHead == nullptr) {
+            m_tombstoneTail = nullptr;
+        }
+        --m_tombstoneCount;
+        free(tombstone);
+    }
+    m_tombstoneLock.unlock();
+}
+
+bool Table::PurgeTombstone(const Tombstone* tombstone, uint64_t tid, GcManager* gc)
+{
+    // a truncate replaced the index, and the key with it
+    MOT::Index* ix = GetPrimaryIndex();
+    if (ix->GetIndexId() != tombstone->m_indexId) {
+        return true;
+    }
+
+    MaxKey key;
+    key.InitKey((uint16_t)ix->GetKeyLength());
+    key.CpKey(tombstone->m_key, (uint16_t)ix->GetKeyLength());
+    Sentinel* sentinel = ix->IndexReadHeader(&key, tid);
+    if (sentinel == nullptr) {
+        return true;
+    }
+
+    // the caller may hold row locks of its own transaction, so do not wait for a committing one
+    if (!sentinel->TryLock(tid)) {
+        return false;
+    }
+    // the key may have been inserted again, then the new row owns the index entry
+    Row* row = sentinel->GetData();
+    if (row != nullptr && row->IsRowDeleted() && row->GetCommitSequenceNumber() == tombstone->m_csn &&
+        sentinel->GetStable() == nullptr) {
+        (void)RemoveKeyFromIndex(row, sentinel, tid, gc);
+    }
+    sentinel->Release();
+    return true;
+}
+
 Row* Table::CreateNewRow()
 {
     Row* row = m_rowPool->Alloc<Row>(this);
@@ -780,14 +907,97 @@ void Table::Truncate(TxnManager* txn)
     (void)pthread_rwlock_unlock(&m_rwLock);
 }
 
-void Table::Compact(TxnManager* txn)
+uint64_t Table::Compact(TxnManager* txn, uint32_t thresholdPercent)
 {
-    uint32_t pid = txn->GetThdId();
-    // first destroy secondary index data
+    // a concurrent compaction of the same table has nothing left to do
+    if (m_compactionActive.exchange(true)) {
+        MOT_LOG_TRACE("Skipping compaction of table %s: already in progress", m_longTableName.c_str());
+        return 0;
+    }
+
+    uint64_t reclaimedBytes = CompactRows(txn, thresholdPercent);
     for (int i = 0; i < m_numIndexes; i++) {
-        GcManager::ClearIndexElements(m_indexes[i]->GetIndexId(), false);
-        m_indexes[i]->Compact(this, pid);
+        reclaimedBytes += m_indexes[i]->Compact();
+    }
+
+    m_compactionReclaimedBytes += reclaimedBytes;
+    ++m_compactionCount;
+    m_compactionActive = false;
+    MOT_LOG_INFO("Compaction of table %s reclaimed %" PRIu64 " bytes", m_longTableName.c_str(), reclaimedBytes);
+    return reclaimedBytes;
+}
+
+uint64_t Table::CompactRows(TxnManager* txn, uint32_t thresholdPercent)
+{
+    uint32_t pid = txn->GetThdId();
+    GcManager* gc = txn->GetGcSession();
+    uint64_t relocatedRows = 0;
+    char tabPrefix[256];
+    errno_t erc =
+        snprintf_s(tabPrefix, sizeof(tabPrefix), sizeof(tabPrefix) - 1, "%s(row pool)", m_tableName.c_str());
+    securec_check_ss(erc, "\0", "\0");
+    tabPrefix[erc] = 0;
+
+    CompactHandler chRow(m_rowPool, tabPrefix);
+    chRow.StartCompaction(CompactTypeT::COMPACT_ONLINE, thresholdPercent);
+    if (chRow.IsCompactionNeeded()) {
+        // concurrent readers of relocated rows are protected by the GC epoch
+        gc->GcStartTxn();
+        IndexIterator* it = GetPrimaryIndex()->Begin(pid);
+        if (it == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "Table Compaction",
+                "Failed to begin iterating over table %s",
+                m_longTableName.c_str());
+        } else {
+            while (it->IsValid()) {
+                if (RelocateRow(chRow, it->GetPrimarySentinel(), pid, gc)) {
+                    ++relocatedRows;
+                }
+                it->Next();
+            }
+            it->Destroy();
+            delete it;
+        }
+
+        // reclaim the rows no longer seen by any reader, so that their pools can be released right away
+        gc->GcCheckPointClean();
+    }
+    chRow.EndCompaction();
+
+    MOT_LOG_TRACE("Relocated %" PRIu64 " rows of table %s", relocatedRows, m_longTableName.c_str());
+    return chRow.GetReclaimedBytes();
+}
+
+bool Table::RelocateRow(CompactHandler& compactHandler, Sentinel* sentinel, uint64_t tid, GcManager* gc)
+{
+    // rows locked by committing transactions or by the checkpoint are left in place
+    if (!sentinel->TryLock(tid)) {
+        return false;
     }
+
+    bool relocated = false;
+    Row* row = sentinel->GetData();
+    // a row that is being deleted, has a stable copy or older versions, keeps its location
+    if (row != nullptr && sentinel->IsCommited() && sentinel->GetStable() == nullptr && !row->IsAbsentRow() &&
+        !row->IsRowDeleted() && row->GetPrevVersion() == nullptr && !row->GetTwoPhaseMode()) {
+        Row* newRow = compactHandler.CompactObj<Row>(row);
+        if (newRow != nullptr) {
+            sentinel->SetNextPtr(newRow);
+            gc->GcRecordObject(GetPrimaryIndex()->GetIndexId(), row, nullptr, Row::RowDtor, ROW_SIZE_FROM_POOL(this));
+            relocated = true;
+        }
+    }
+    sentinel->Release();
+    return relocated;
+}
+
+void Table::GetRowPoolStats(PoolStatsSt& stats)
+{
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_rowPool->GetStats(stats);
 }
 
 uint64_t Table::GetTableSize()
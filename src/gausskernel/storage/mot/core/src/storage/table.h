@@ -48,6 +48,7 @@ class TxnManager;
 class TxnInsertAction;
 class RecoveryManager;
 class TxnDDLAccess;
+class CompactHandler;
 
 /**
  * @class Table
@@ -285,10 +286,32 @@ public:
     void Truncate(TxnManager* txn);
 
     /**
-     * @brief Performs a compact operation on the table.
+     * @brief Performs an online compact operation on the table. Live rows are relocated out of sparse row pool
+     * buffers while transactions keep running, and the emptied buffers are returned to the memory allocator.
      * @param txn The txn manager object.
+     * @param thresholdPercent The free space percentage above which the row pool (and each of its buffers) is
+     * compacted.
+     * @return The amount of memory in bytes returned by the compaction.
      */
-    void Compact(TxnManager* txn);
+    uint64_t Compact(TxnManager* txn, uint32_t thresholdPercent = 0);
+
+    /**
+     * @brief Retrieves the memory statistics of the table row pool.
+     * @param[out] stats The row pool statistics.
+     */
+    void GetRowPoolStats(PoolStatsSt& stats);
+
+    /** @brief Retrieves the total amount of memory in bytes returned by compactions of the table. */
+    inline uint64_t GetCompactionReclaimedBytes() const
+    {
+        return m_compactionReclaimedBytes;
+    }
+
+    /** @brief Retrieves the number of compactions performed on the table. */
+    inline uint64_t GetCompactionCount() const
+    {
+        return m_compactionCount;
+    }
 
     /**
      * @brief Count number of absent sentinels in a table
@@ -594,6 +617,14 @@ public:
      */
     bool CreateSecondaryIndexDataNonTransactional(MOT::Index* index, uint32_t tid);
 
+    /**
+     * @brief Indexes the committed rows of the table using several worker threads.
+     * @param index The new secondary index.
+     * @param txn The txn manager object.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateSecondaryIndexDataParallel(MOT::Index* index, TxnManager* txn);
+
     /**
      * @brief Inserts a new row into transactional storage.
      * @param row. New row to be inserted
@@ -850,7 +881,45 @@ public:
 
     Row* RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcManager* gc);
 
+    /**
+     * @brief Keeps the primary key of a deleted row in the index, so that snapshots taken before the deletion still
+     * find the row (MVCC snapshot read). The key is removed by PurgeTombstones once no snapshot reads it.
+     * @param row The deleted row.
+     * @param csn The commit sequence number of the deletion.
+     * @return False if the tombstone could not be recorded, the key must be removed right away then.
+     */
+    bool AddTombstone(Row* row, uint64_t csn);
+
+    /**
+     * @brief Removes from the primary index the keys of deleted rows that no active snapshot reads anymore.
+     * @param horizon The snapshot horizon, see GcManager::SnapshotHorizon().
+     * @param tid The logical identifier of the requesting thread.
+     * @param gc The GC session of the requesting thread.
+     */
+    void PurgeTombstones(uint64_t horizon, uint64_t tid, GcManager* gc);
+
 private:
+    /** @struct Tombstone The primary key of a deleted row kept for the snapshots, see AddTombstone(). */
+    struct Tombstone {
+        /** @var Next tombstone, in the order of the deletions. */
+        Tombstone* m_next;
+
+        /** @var Commit sequence number of the deletion. */
+        uint64_t m_csn;
+
+        /** @var The primary index holding the key, the table may have been truncated since. */
+        uint32_t m_indexId;
+
+        /** @var The primary key, of the key length of the index. */
+        uint8_t* m_key;
+    };
+
+    /**
+     * @brief Removes the key of a single tombstone, unless the key was inserted again meanwhile.
+     * @return False if the sentinel is locked by a committing transaction, the tombstone is kept then.
+     */
+    bool PurgeTombstone(const Tombstone* tombstone, uint64_t tid, GcManager* gc);
+
     inline MOT::ObjAllocInterface* GetRowPool()
     {
         return m_rowPool;
@@ -867,6 +936,25 @@ private:
         ObjAllocInterface::FreeObjPool(&rowPool);
     }
 
+    /**
+     * @brief Relocates live rows out of the sparse buffers of the row pool.
+     * @param txn The txn manager object.
+     * @param thresholdPercent The free space percentage above which a buffer is drained.
+     * @return The amount of memory in bytes returned by the compaction.
+     */
+    uint64_t CompactRows(TxnManager* txn, uint32_t thresholdPercent);
+
+    /**
+     * @brief Moves a single row to a new location and publishes it in its primary sentinel. The old row is
+     * retired through the GC, since concurrent readers may still access it.
+     * @param compactHandler The row pool compaction handler.
+     * @param sentinel The primary sentinel of the row.
+     * @param tid The identifier of the compacting thread.
+     * @param gc The GC session of the compacting thread.
+     * @return True if the row was relocated.
+     */
+    bool RelocateRow(CompactHandler& compactHandler, Sentinel* sentinel, uint64_t tid, GcManager* gc);
+
     /** @var Global atomic table identifier. */
     static std::atomic<uint32_t> tableCounter;
 
@@ -931,6 +1019,27 @@ private:
 
     uint32_t m_rowCount = 0;
 
+    /** @var Set while the table is being compacted. */
+    std::atomic<bool> m_compactionActive{false};
+
+    /** @var Total amount of memory in bytes returned by compactions of the table. */
+    std::atomic<uint64_t> m_compactionReclaimedBytes{0};
+
+    /** @var Number of compactions performed on the table. */
+    std::atomic<uint64_t> m_compactionCount{0};
+
+    /** @var Lock guarding the tombstone list. */
+    spin_lock m_tombstoneLock;
+
+    /** @var Oldest tombstone of the table. */
+    Tombstone* m_tombstoneHead = nullptr;
+
+    /** @var Newest tombstone of the table. */
+    Tombstone* m_tombstoneTail = nullptr;
+
+    /** @var Number of tombstones, read without the lock to skip the purge. */
+    std::atomic<uint32_t> m_tombstoneCount{0};
+
     DECLARE_CLASS_LOGGER();
 
 public:
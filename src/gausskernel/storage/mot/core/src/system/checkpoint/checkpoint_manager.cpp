@@ -57,7 +57,13 @@ CheckpointManager::CheckpointManager()
       m_id(CheckpointControlFile::invalidId),
       m_inProgressId(CheckpointControlFile::invalidId),
       m_lastReplayLsn(0),
-      m_emptyCheckpoint(false)
+      m_emptyCheckpoint(false),
+      m_deleteJournals(nullptr),
+      m_journalGen(0),
+      m_captureCsn(CSNManager::INVALID_CSN),
+      m_chainCsn(CSNManager::INVALID_CSN),
+      m_isDelta(false),
+      m_needFullCheckpoint(false)
 {}
 
 bool CheckpointManager::Initialize()
@@ -68,6 +74,15 @@ bool CheckpointManager::Initialize()
         return false;
     }
 
+    if (GetGlobalConfiguration().m_enableDeltaCheckpoint) {
+        m_deleteJournals = new (std::nothrow) DeleteJournal[GetMaxThreadCount()];
+        if (m_deleteJournals == nullptr) {
+            MOT_LOG_ERROR("Failed to initialize CheckpointManager, could not allocate delete journals");
+            (void)pthread_rwlock_destroy(&m_fetchLock);
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -85,11 +100,23 @@ CheckpointManager::~CheckpointManager()
         delete m_checkpointers;
         m_checkpointers = nullptr;
     }
+    if (m_deleteJournals != nullptr) {
+        delete[] m_deleteJournals;
+        m_deleteJournals = nullptr;
+    }
     (void)pthread_rwlock_destroy(&m_fetchLock);
 }
 
 bool CheckpointManager::CreateSnapShot()
 {
+    // A standby restartpoint covers the log up to the last replayed checkpoint record, so the transactions
+    // committed before it and still queued to the redo workers must be in the snapshot
+    if (MOTEngine::GetInstance()->IsRecovering() && !GetRecoveryManager()->WaitDispatchedTransactions()) {
+        MOT_LOG_ERROR("Could not begin checkpoint, redo replay failed");
+        OnError(CheckpointWorkerPool::ErrCodes::CALC, "Could not begin checkpoint, redo replay failed");
+        return false;
+    }
+
     if (!CheckpointManager::CreateCheckpointId(m_inProgressId)) {
         MOT_LOG_ERROR("Could not begin checkpoint, checkpoint id creation failed");
         OnError(CheckpointWorkerPool::ErrCodes::CALC, "Could not begin checkpoint, checkpoint id creation failed");
@@ -125,12 +152,15 @@ bool CheckpointManager::CreateSnapShot()
     // It is safe now to obtain a list of all tables to included in this checkpoint.
     // The tables are read locked in order to avoid drop/truncate during checkpoint.
     FillTasksQueue();
+    PrepareDelta();
 
     // Move to CAPTURE phase
     m_lock.WrLock();
     MoveToNextPhase();
     m_lock.WrUnlock();
 
+    CollectDeletedKeys();
+
     return !m_errorSet;
 }
 
@@ -176,6 +206,7 @@ bool CheckpointManager::BeginCheckpoint()
     if (!m_errorSet) {
         CompleteCheckpoint();
     }
+    EndDelta(!m_errorSet);
 
     // No locking required here, as the checkpoint workers have already exited.
     UnlockAndClearTables(m_tasksList);
@@ -218,6 +249,7 @@ bool CheckpointManager::Abort()
         UnlockAndClearTables(m_tasksList);
         UnlockAndClearTables(m_finishedTasks);
         m_numCpTasks = 0;
+        EndDelta(false);
 
         // Move to rest
         m_lock.WrLock();
@@ -349,6 +381,14 @@ void CheckpointManager::MoveToNextPhase()
             // it is safe to ignore any redo replay before this LSN.
             SetLastReplayLsn(GetRecoveryManager()->GetLastReplayLsn());
         }
+        if (m_deleteJournals != nullptr) {
+            // Rows committed up to this point have a CSN not above the snapshot CSN, and the deletes journaled
+            // so far are exactly the ones that precede the snapshot. Replayed transactions carry the CSN of
+            // the primary, so on standby the snapshot CSN is the highest CSN replayed.
+            m_captureCsn = MOTEngine::GetInstance()->IsRecovering() ? GetRecoveryManager()->GetMaxRecoveredCsn()
+                                                                     : GetCSNManager().GetCurrentCSN();
+            m_journalGen = !m_journalGen;
+        }
     }
 
     // there are no open transactions from previous phase, we can move forward to next phase
@@ -435,6 +475,143 @@ void CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType
             MOT_LOG_ERROR("Unknown transaction start phase: %s", CheckpointManager::PhaseToString(startPhase));
             MOT_ASSERT(false);
     }
+
+    if (m_deleteJournals != nullptr) {
+        TrackDeltaWrite(txnMan, origRow, type);
+    }
+}
+
+void CheckpointManager::TrackDeltaWrite(TxnManager* txnMan, Row* origRow, AccessType type)
+{
+    Table* table = origRow->GetTable();
+    if (type == DEL) {
+        MaxKey key;
+        Index* index = table->GetPrimaryIndex();
+        key.InitKey(index->GetKeyLength());
+        index->BuildKey(table, origRow, &key);
+
+        uint32_t tableId = table->GetTableId();
+        uint16_t keyLen = key.GetKeyLength();
+        MOT_ASSERT(MOTCurrThreadId < GetMaxThreadCount());
+        std::string& entries = m_deleteJournals[MOTCurrThreadId].m_entries[m_journalGen];
+        (void)entries.append((const char*)&tableId, sizeof(tableId));
+        (void)entries.append((const char*)&keyLen, sizeof(keyLen));
+        (void)entries.append((const char*)key.GetKeyBuf(), keyLen);
+    }
+
+    // A transaction that obtained its CSN before the last snapshot but commits after it (e.g. while waiting for
+    // the RESOLVE phase to end) would be missed by the next delta, so its table is written in full instead
+    if (txnMan->GetCommitSequenceNumber() <= m_captureCsn) {
+        SetTableFullCheckpoint(table->GetTableId());
+    }
+}
+
+void CheckpointManager::SetTableFullCheckpoint(uint32_t tableId)
+{
+    if (m_deleteJournals == nullptr) {
+        return;
+    }
+
+    m_fullTablesLock.lock();
+    (void)m_fullTables.insert(tableId);
+    m_fullTablesLock.unlock();
+}
+
+void CheckpointManager::SetChain(
+    const std::vector<uint64_t>& chain, uint64_t snapshotCsn, const std::set<uint32_t>& tableIds)
+{
+    m_chain = chain;
+    m_chainCsn = snapshotCsn;
+    m_captureCsn = snapshotCsn;
+    m_chainTables = tableIds;
+}
+
+void CheckpointManager::PrepareDelta()
+{
+    if (m_deleteJournals == nullptr) {
+        return;
+    }
+
+    m_isDelta = !m_needFullCheckpoint && !m_chain.empty() &&
+                m_chain.size() < GetGlobalConfiguration().m_checkpointFullInterval;
+
+    // The tables of this checkpoint are locked, so a truncate that happens from now on is recorded for the
+    // next checkpoint
+    m_fullTablesLock.lock();
+    m_inProgressFullTables.swap(m_fullTables);
+    m_fullTables.clear();
+    m_fullTablesLock.unlock();
+
+    MOT_LOG_DEBUG("Checkpoint %lu is a %s checkpoint (chain length %lu, %lu tables written in full)",
+        m_inProgressId,
+        m_isDelta ? "delta" : "full",
+        m_chain.size(),
+        m_inProgressFullTables.size());
+}
+
+void CheckpointManager::CollectDeletedKeys()
+{
+    if (m_deleteJournals == nullptr) {
+        return;
+    }
+
+    uint8_t gen = !m_journalGen;
+    uint16_t maxThreads = GetMaxThreadCount();
+    for (uint16_t i = 0; i < maxThreads; ++i) {
+        std::string& entries = m_deleteJournals[i].m_entries[gen];
+        size_t pos = 0;
+        while (m_isDelta && pos + sizeof(uint32_t) + sizeof(uint16_t) <= entries.length()) {
+            uint32_t tableId = *(const uint32_t*)(entries.data() + pos);
+            uint16_t keyLen = *(const uint16_t*)(entries.data() + pos + sizeof(uint32_t));
+            pos += sizeof(uint32_t) + sizeof(uint16_t);
+
+            CheckpointUtils::EntryHeader entryHeader;
+            entryHeader.m_csn = CSNManager::INVALID_CSN;
+            entryHeader.m_rowId = Row::INVALID_ROW_ID;
+            entryHeader.m_dataLen = 0;
+            entryHeader.m_keyLen = keyLen;
+            DeletedKeys& deletedKeys = m_deletedKeys[tableId];
+            (void)deletedKeys.m_entries.append((const char*)&entryHeader, sizeof(CheckpointUtils::EntryHeader));
+            (void)deletedKeys.m_entries.append(entries.data() + pos, keyLen);
+            deletedKeys.m_numKeys++;
+            pos += keyLen;
+        }
+        entries.clear();
+        entries.shrink_to_fit();
+    }
+}
+
+bool CheckpointManager::GetTableDelta(uint32_t tableId, uint64_t& baseCsn, const DeletedKeys*& deletedKeys)
+{
+    baseCsn = CSNManager::INVALID_CSN;
+    deletedKeys = nullptr;
+
+    // New tables and tables that could not be tracked since the previous checkpoint are written in full
+    if (!m_isDelta || m_chainTables.count(tableId) == 0 || m_inProgressFullTables.count(tableId) != 0) {
+        return false;
+    }
+
+    baseCsn = m_chainCsn;
+    std::map<uint32_t, DeletedKeys>::const_iterator it = m_deletedKeys.find(tableId);
+    if (it != m_deletedKeys.end()) {
+        deletedKeys = &it->second;
+    }
+    return true;
+}
+
+void CheckpointManager::EndDelta(bool success)
+{
+    if (m_deleteJournals == nullptr) {
+        return;
+    }
+
+    if (!success) {
+        // The deletes collected by this checkpoint are lost, so the next checkpoint can not be a delta
+        m_needFullCheckpoint = true;
+    }
+    m_isDelta = false;
+    m_deletedKeys.clear();
+    m_inProgressFullTables.clear();
 }
 
 void CheckpointManager::FillTasksQueue()
@@ -502,11 +679,28 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    std::set<uint32_t> tableIds;
+    for (std::list<MapFileEntry*>::iterator it = m_mapfileInfo.begin(); it != m_mapfileInfo.end(); ++it) {
+        (void)tableIds.insert((*it)->m_tableId);
+    }
+
     if (!CreateCheckpointMap()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create map file");
         return;
     }
 
+    std::vector<uint64_t> chain;
+    if (m_deleteJournals != nullptr) {
+        if (m_isDelta) {
+            chain = m_chain;
+        }
+        chain.push_back(m_inProgressId);
+        if (!CreateChainFile(chain)) {
+            OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create chain file");
+            return;
+        }
+    }
+
     if (!CreateTpcRecoveryFile()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create 2pc recovery file");
         return;
@@ -532,6 +726,8 @@ void CheckpointManager::CompleteCheckpoint()
 
         // Update checkpoint Id
         SetId(m_inProgressId);
+        SetChain(chain, m_captureCsn, tableIds);
+        m_needFullCheckpoint = false;
         finishedUpdatingFiles = true;
     } while (0);
     (void)pthread_rwlock_unlock(&m_fetchLock);
@@ -601,7 +797,7 @@ void CheckpointManager::RemoveOldCheckpoints(uint64_t curCheckcpointId)
             }
 
             uint64_t chkptId = strtoll(p->d_name + strlen(CheckpointUtils::dirPrefix), NULL, 10);
-            if (chkptId == curCheckcpointId) {
+            if (chkptId == curCheckcpointId || std::find(m_chain.begin(), m_chain.end(), chkptId) != m_chain.end()) {
                 MOT_LOG_DEBUG("RemoveOldCheckpoints: exclude %lu", chkptId);
                 continue;
             }
@@ -931,6 +1127,56 @@ RC CheckpointManager::SerializeInProcessTxns(int fd)
     return MOTEngine::GetInstance()->GetInProcessTransactions().ForEachTransaction(serializeLambda, false);
 }
 
+bool CheckpointManager::CreateChainFile(const std::vector<uint64_t>& chain)
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    bool ret = false;
+
+    do {
+        if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            break;
+        }
+
+        CheckpointUtils::MakeChainFilename(fileName, workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR(
+                "CreateChainFile: failed to create file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+            break;
+        }
+
+        CheckpointUtils::ChainFileHeader chainFileHeader{CP_MGR_MAGIC, m_captureCsn, chain.size()};
+        if (CheckpointUtils::WriteFile(fd, (char*)&chainFileHeader, sizeof(CheckpointUtils::ChainFileHeader)) !=
+            sizeof(CheckpointUtils::ChainFileHeader)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to write chain file's header [%d %s]", errno, gs_strerror(errno));
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        size_t len = chain.size() * sizeof(uint64_t);
+        if (CheckpointUtils::WriteFile(fd, (char*)chain.data(), len) != len) {
+            MOT_LOG_ERROR("CreateChainFile: failed to write chain file's links [%d %s]", errno, gs_strerror(errno));
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to flush chain file");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to close chain file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    return ret;
+}
+
 bool CheckpointManager::CreateEndFile()
 {
     int fd = -1;
@@ -33,6 +33,9 @@
 #include "txn.h"
 #include "txn_access.h"
 #include <queue>
+#include <map>
+#include <set>
+#include <vector>
 #include "checkpoint_worker.h"
 #include "checkpoint_ctrlfile.h"
 #include "spin_lock.h"
@@ -131,9 +134,42 @@ public:
      */
     virtual void OnError(int errCode, const char* errMsg, const char* optionalMsg = nullptr);
 
+    /**
+     * @brief Queries whether only the changes of a table are written in the current checkpoint.
+     * @param tableId The table id.
+     * @param[out] baseCsn Only the rows whose CSN is above this value are written.
+     * @param[out] deletedKeys The keys deleted from the table since the previous checkpoint, or null.
+     * @return True if the table is written as a delta, false if it is written in full.
+     */
+    virtual bool GetTableDelta(uint32_t tableId, uint64_t& baseCsn, const DeletedKeys*& deletedKeys);
+
+    /**
+     * @brief Requests that a table is written in full in the next checkpoint, since its changes can not be
+     * tracked as a delta (e.g. after truncate).
+     * @param tableId The table id.
+     */
+    void SetTableFullCheckpoint(uint32_t tableId);
+
+    /**
+     * @brief Sets the chain of the last valid checkpoint, after recovering it.
+     * @param chain The checkpoint ids of the chain, starting with the full base checkpoint.
+     * @param snapshotCsn The snapshot CSN of the last checkpoint in the chain.
+     * @param tableIds The tables of the last checkpoint in the chain.
+     */
+    void SetChain(const std::vector<uint64_t>& chain, uint64_t snapshotCsn, const std::set<uint32_t>& tableIds);
+
+    /**
+     * @brief Retrieves the checkpoint ids of the chain of the last valid checkpoint, starting with the full
+     * base checkpoint. Empty if the last checkpoint is not part of a delta checkpoint chain.
+     */
+    const std::vector<uint64_t>& GetChain() const
+    {
+        return m_chain;
+    }
+
     /**
      * @brief Deletes 'old' checkpoint directories
-     * @param the current checkpoint id which should not be deleted
+     * @param the current checkpoint id which should not be deleted, along with the checkpoints of its chain
      */
     void RemoveOldCheckpoints(uint64_t curCheckcpointId);
 
@@ -273,6 +309,52 @@ private:
     // this lock guards gs_ctl checkpoint fetching
     pthread_rwlock_t m_fetchLock;
 
+    /**
+     * @struct DeleteJournal
+     * @brief Per thread journal of the primary keys deleted by committed transactions, with one generation
+     * for the deletes before the checkpoint snapshot and one for the deletes after it. Each entry is the table
+     * id, followed by the key length and the key.
+     */
+    struct DeleteJournal {
+        std::string m_entries[2];
+    };
+
+    // Delete journals indexed by thread id, allocated only in delta checkpoint mode
+    DeleteJournal* m_deleteJournals;
+
+    // The journal generation to which deletes are currently recorded
+    uint8_t m_journalGen;
+
+    // The CSN of the most recent checkpoint snapshot
+    uint64_t m_captureCsn;
+
+    // The snapshot CSN of the last valid checkpoint
+    uint64_t m_chainCsn;
+
+    // The checkpoint ids of the chain of the last valid checkpoint, starting with its full base
+    std::vector<uint64_t> m_chain;
+
+    // The tables of the last valid checkpoint
+    std::set<uint32_t> m_chainTables;
+
+    // Tables that must be written in full in the next checkpoint
+    std::set<uint32_t> m_fullTables;
+
+    // Guards m_fullTables
+    spin_lock m_fullTablesLock;
+
+    // Tables that are written in full in the current delta checkpoint
+    std::set<uint32_t> m_inProgressFullTables;
+
+    // The keys deleted since the previous checkpoint, per table, written by the current delta checkpoint
+    std::map<uint32_t, DeletedKeys> m_deletedKeys;
+
+    // Indicates the current checkpoint is a delta checkpoint
+    bool m_isDelta;
+
+    // Indicates a checkpoint failed, so the next one must be a full base
+    bool m_needFullCheckpoint;
+
     CheckpointPhase GetPhase() const
     {
         return m_phase;
@@ -379,6 +461,40 @@ private:
      */
     bool CreateTpcRecoveryFile();
 
+    /**
+     * @brief Creates the checkpoint's chain file, which lists the checkpoints a delta checkpoint
+     * is applied on.
+     * @param chain The checkpoint ids of the chain, ending with the current checkpoint.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateChainFile(const std::vector<uint64_t>& chain);
+
+    /**
+     * @brief Decides whether the current checkpoint is a delta checkpoint and which of its tables are
+     * written in full. Called in RESOLVE phase, after the tables of the checkpoint are locked.
+     */
+    void PrepareDelta();
+
+    /**
+     * @brief Collects the keys deleted before the snapshot from the per thread journals, grouped by table.
+     * Called after moving to CAPTURE phase.
+     */
+    void CollectDeletedKeys();
+
+    /**
+     * @brief Records a committed write for delta checkpoint purposes.
+     * @param txnMan The committing transaction.
+     * @param origRow The written row.
+     * @param type The access type.
+     */
+    void TrackDeltaWrite(TxnManager* txnMan, Row* origRow, AccessType type);
+
+    /**
+     * @brief Releases the delta state of the current checkpoint.
+     * @param success Indicates whether the checkpoint completed successfully.
+     */
+    void EndDelta(bool success);
+
     /**
      * @brief Creates a file that indicates checkpoint completion.
      * @return Boolean value denoting success or failure.
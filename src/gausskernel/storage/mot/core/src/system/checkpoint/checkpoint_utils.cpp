@@ -26,6 +26,7 @@
 #include "checkpoint_utils.h"
 #include "utilities.h"
 #include "mot_error.h"
+#include "lz4.h"
 
 namespace MOT {
 DECLARE_LOGGER(CheckpointUtils, Checkpoint);
@@ -141,6 +142,62 @@ bool SeekFile(int fd, uint64_t offset)
     return (rc != -1);
 }
 
+size_t CompressBound(size_t len)
+{
+    return (size_t)LZ4_compressBound((int)len);
+}
+
+bool WriteCompressedBlock(int fd, const char* data, size_t len, char* compressBuf, size_t compressLen)
+{
+    int compressed = LZ4_compress_default(data, compressBuf, (int)len, (int)compressLen);
+    if (compressed <= 0) {
+        MOT_LOG_ERROR("WriteCompressedBlock: failed to compress %lu bytes", len);
+        return false;
+    }
+
+    BlockHeader blockHeader{(uint32_t)len, (uint32_t)compressed};
+    if (WriteFile(fd, (char*)&blockHeader, sizeof(BlockHeader)) != sizeof(BlockHeader)) {
+        MOT_LOG_ERROR("WriteCompressedBlock: failed to write block header (%d:%s)", errno, gs_strerror(errno));
+        return false;
+    }
+
+    if (WriteFile(fd, compressBuf, (size_t)compressed) != (size_t)compressed) {
+        MOT_LOG_ERROR("WriteCompressedBlock: failed to write %d bytes (%d:%s)", compressed, errno, gs_strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool ReadCompressedBlock(int fd, char* data, size_t maxLen, size_t& len, char* compressBuf, size_t compressLen)
+{
+    BlockHeader blockHeader;
+    if (ReadFile(fd, (char*)&blockHeader, sizeof(BlockHeader)) != sizeof(BlockHeader)) {
+        MOT_LOG_ERROR("ReadCompressedBlock: failed to read block header");
+        return false;
+    }
+
+    if (blockHeader.m_rawLen > maxLen || blockHeader.m_compressedLen > compressLen) {
+        MOT_LOG_ERROR("ReadCompressedBlock: invalid block, rawLen %u, compressedLen %u",
+            blockHeader.m_rawLen,
+            blockHeader.m_compressedLen);
+        return false;
+    }
+
+    if (ReadFile(fd, compressBuf, blockHeader.m_compressedLen) != blockHeader.m_compressedLen) {
+        MOT_LOG_ERROR("ReadCompressedBlock: failed to read %u bytes", blockHeader.m_compressedLen);
+        return false;
+    }
+
+    int decompressed =
+        LZ4_decompress_safe(compressBuf, data, (int)blockHeader.m_compressedLen, (int)blockHeader.m_rawLen);
+    if (decompressed != (int)blockHeader.m_rawLen) {
+        MOT_LOG_ERROR("ReadCompressedBlock: failed to decompress block (%d / %u)", decompressed, blockHeader.m_rawLen);
+        return false;
+    }
+    len = blockHeader.m_rawLen;
+    return true;
+}
+
 bool GetWorkingDir(std::string& dir)
 {
     dir.clear();
@@ -35,6 +35,9 @@
 
 const uint64_t CP_MGR_MAGIC = 0xaabbccdd;
 
+// Magic of checkpoint data files that hold LZ4 compressed blocks of entries
+const uint64_t CP_MGR_COMPRESSED_MAGIC = 0xaabbccde;
+
 namespace MOT {
 namespace CheckpointUtils {
 
@@ -180,6 +183,12 @@ static const char* tpcFileSuffix = ".tpc";
 // End file suffix
 static const char* validFileSuffix = ".end";
 
+// Deleted keys file suffix
+static const char* delFileSuffix = ".del";
+
+// Chain file suffix
+static const char* chainFileSuffix = ".chain";
+
 // Max path len
 static const size_t maxPath = 1024;
 
@@ -300,6 +309,34 @@ inline void MakeEndFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(validFileSuffix);
 }
 
+/**
+ * @brief Creates a checkpoint table deleted keys filename. The file exists only for tables
+ * that are written as a delta.
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ */
+inline void MakeDelFilename(uint64_t tableId, std::string& fileName, std::string& workingDir)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append("tab_");
+    fileName.append(std::to_string(tableId));
+    fileName.append(delFileSuffix);
+}
+
+/**
+ * @brief Creates a checkpoint chain filename
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeChainFilename(std::string& fileName, std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(std::to_string(cpId));
+    fileName.append(chainFileSuffix);
+}
+
 /**
  * @brief Sets the cpu affinity for a given thread
  * @param cpu The cpu that the thread should run on.
@@ -348,6 +385,56 @@ struct TpcEntryHeader {
     uint64_t m_len;
 };
 
+/**
+ * @struct ChainFileHeader
+ * @brief Header of the chain file of a delta checkpoint, followed by the ids of the checkpoints
+ * in the chain, starting with the full base checkpoint and ending with the checkpoint itself.
+ */
+struct ChainFileHeader {
+    uint64_t m_magic;
+    uint64_t m_snapshotCsn;
+    uint64_t m_numLinks;
+};
+
+/**
+ * @struct BlockHeader
+ * @brief Header of a compressed block of entries in a checkpoint data file.
+ */
+struct BlockHeader {
+    uint32_t m_rawLen;
+    uint32_t m_compressedLen;
+};
+
+/**
+ * @brief Retrieves the size of the buffer needed to compress a block.
+ * @param len The length of the block.
+ * @return The maximum size of the compressed block.
+ */
+size_t CompressBound(size_t len);
+
+/**
+ * @brief Compresses a block of entries with LZ4 and writes it to a file fd.
+ * @param fd The file descriptor to write to.
+ * @param data The block to write.
+ * @param len The length of the block.
+ * @param compressBuf A buffer of at least CompressBound(len) bytes.
+ * @param compressLen The size of the compression buffer.
+ * @return Boolean value denoting success or failure.
+ */
+bool WriteCompressedBlock(int fd, const char* data, size_t len, char* compressBuf, size_t compressLen);
+
+/**
+ * @brief Reads and decompresses a block of entries from a file fd.
+ * @param fd The file descriptor to read from.
+ * @param data The buffer to decompress the block into.
+ * @param maxLen The size of the data buffer.
+ * @param len The returned length of the block.
+ * @param compressBuf A buffer of at least CompressBound(maxLen) bytes.
+ * @param compressLen The size of the compression buffer.
+ * @return Boolean value denoting success or failure.
+ */
+bool ReadCompressedBlock(int fd, char* data, size_t maxLen, size_t& len, char* compressBuf, size_t compressLen);
+
 /**
  * @brief Produces a pretty hex printout of a given buffer to stderr
  * @param msg A text the will be displayed before the hex data printout.
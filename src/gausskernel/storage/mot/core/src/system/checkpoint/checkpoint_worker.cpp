@@ -42,6 +42,7 @@ struct WorkerThreads {
 void CheckpointWorkerPool::Start()
 {
     MOT_LOG_DEBUG("CheckpointWorkerPool::start() %d workers", m_numWorkers.load());
+    m_compress = GetGlobalConfiguration().m_enableCheckpointCompression;
 
     if (!CheckpointUtils::SetWorkingDir(m_workingDir, m_checkpointId))
         m_cpManager.OnError(ErrCodes::FILE_IO, "failed to setup working dir");
@@ -77,7 +78,7 @@ CheckpointWorkerPool::~CheckpointWorkerPool()
     MOT_LOG_DEBUG("~CheckpointWorkerPool: done");
 }
 
-bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
+bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd, char* compressBuf)
 {
     MaxKey key;
     Key* primaryKey = &key;
@@ -87,10 +88,10 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     if (buffer->Size() + primaryKey->GetKeyLength() + row->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader) >
         buffer->MaxSize()) {
         // need to flush the buffer before serializing the next row
-        size_t wrSta = CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size());
-        if (wrSta != buffer->Size()) {
+        uint32_t bufferSize = buffer->Size();
+        if (!FlushBuffer(fd, buffer, compressBuf)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to write %u bytes to [%d] (%d:%s)",
-                buffer->Size(),
+                bufferSize,
                 fd,
                 errno,
                 gs_strerror(errno));
@@ -101,7 +102,6 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
             MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to flush [%d]", fd);
             return false;
         }
-        buffer->Reset();
     }
     CheckpointUtils::EntryHeader entryHeader;
     entryHeader.m_keyLen = primaryKey->GetKeyLength();
@@ -124,7 +124,8 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted)
+int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted,
+    uint64_t baseCsn, char* compressBuf)
 {
     Row* mainRow = sentinel->GetData();
     Row* stableRow = nullptr;
@@ -144,6 +145,13 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
         sentinel->Lock(threadId);
     }
 
+    // the row might have been relocated by a table compaction before the sentinel was locked
+    mainRow = sentinel->GetData();
+    if (mainRow == nullptr) {
+        sentinel->Release();
+        return 0;
+    }
+
     stableRow = sentinel->GetStable();
     if (mainRow->IsRowDeleted()) {
         if (stableRow) {
@@ -165,14 +173,16 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                 break;
             }
 
-            if (!Write(buffer, stableRow, fd)) {
+            // in a delta checkpoint, rows that did not change since the previous checkpoint are skipped
+            bool changed = (stableRow->GetCommitSequenceNumber() > baseCsn);
+            if (changed && !Write(buffer, stableRow, fd, compressBuf)) {
                 wrote = -1;
             } else {
                 if (isDeleted == false) {
                     CheckpointUtils::DestroyStableRow(stableRow);
                     sentinel->SetStable(nullptr);
                 }
-                wrote = 1;
+                wrote = changed ? 1 : 0;
             }
             break;
         } else { /* no stable version */
@@ -182,7 +192,9 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
-                if (!Write(buffer, mainRow, fd)) {
+                if (mainRow->GetCommitSequenceNumber() <= baseCsn) {
+                    wrote = 0;
+                } else if (!Write(buffer, mainRow, fd, compressBuf)) {
                     wrote = -1;  // we failed to write, set error
                 } else {
                     wrote = 1;
@@ -272,6 +284,20 @@ void CheckpointWorkerPool::WorkerFunc()
         return;
     }
 
+    char* compressBuf = nullptr;
+    if (m_compress) {
+        compressBuf = new (nothrow) char[CheckpointUtils::CompressBound(buffer.MaxSize())];
+        if (compressBuf == nullptr) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to allocate compression buffer");
+            m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
+            delete[] deletedList;
+            GetSessionManager()->DestroySessionContext(sessionContext);
+            MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
+            MOT_LOG_DEBUG("thread exiting");
+            return;
+        }
+    }
+
     while (true) {
         uint32_t tableId = 0;
         uint64_t exId = 0;
@@ -287,6 +313,9 @@ void CheckpointWorkerPool::WorkerFunc()
             do {
                 tableId = table->GetTableId();
                 exId = table->GetTableExId();
+                uint64_t baseCsn = CSNManager::INVALID_CSN;
+                const DeletedKeys* deletedKeys = nullptr;
+                bool isDelta = m_cpManager.GetTableDelta(tableId, baseCsn, deletedKeys);
 
                 ErrCodes errCode = WriteTableMetadataFile(table);
                 if (errCode != ErrCodes::SUCCESS) {
@@ -297,11 +326,24 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                if (isDelta) {
+                    errCode = WriteTableDelFile(table, deletedKeys);
+                    if (errCode != ErrCodes::SUCCESS) {
+                        MOT_LOG_ERROR(
+                            "CheckpointWorkerPool::WorkerFunc: failed to write deleted keys file for table %u", tableId);
+                        m_cpManager.OnError(errCode,
+                            "Failed to write deleted keys file for table - ",
+                            std::to_string(tableId).c_str());
+                        break;
+                    }
+                }
+
                 struct timespec start, end;
                 uint64_t numOps = 0;
                 clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                errCode = WriteTableDataFile(
+                    table, &buffer, deletedList, gcSession, threadId, baseCsn, compressBuf, maxSegId, numOps);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WorkerFunc: failed to write table data file for table %u", tableId);
@@ -310,6 +352,14 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                // Tables nobody deletes from anymore still get rid of the keys kept for the snapshots
+                if (GetGlobalConfiguration().m_enableMvccSnapshotRead) {
+                    gcSession->GcStartTxn();
+                    table->PurgeTombstones(
+                        GcManager::SnapshotHorizon(GetCSNManager().GetCurrentCSN()), threadId, gcSession);
+                    gcSession->GcCheckPointClean();
+                }
+
                 taskSucceeded = true;
                 clock_gettime(CLOCK_MONOTONIC, &end);
                 /*
@@ -318,10 +368,11 @@ void CheckpointWorkerPool::WorkerFunc()
                  */
                 uint64_t deltaUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
                 MOT_LOG_DEBUG(
-                    "CheckpointWorkerPool::WorkerFunc: checkpoint of table %u completed in %luus, (%lu elements)",
+                    "CheckpointWorkerPool::WorkerFunc: checkpoint of table %u completed in %luus, (%lu elements%s)",
                     tableId,
                     deltaUs,
-                    numOps);
+                    numOps,
+                    isDelta ? ", delta" : "");
             } while (0);
 
             m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
@@ -333,6 +384,9 @@ void CheckpointWorkerPool::WorkerFunc()
             break;
         }
     }
+    if (compressBuf != nullptr) {
+        delete[] compressBuf;
+    }
     delete[] deletedList;
     GetSessionManager()->DestroySessionContext(sessionContext);
     MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
@@ -348,7 +402,7 @@ bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_
         return false;
     }
     MOT_LOG_DEBUG("CheckpointWorkerPool::beginFile: %s", fileName.c_str());
-    CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, 0};
+    CheckpointUtils::FileHeader fileHeader{m_compress ? CP_MGR_COMPRESSED_MAGIC : CP_MGR_MAGIC, tableId, exId, 0};
     if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
         sizeof(CheckpointUtils::FileHeader)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::BeginFile: failed to write file header: %s", fileName.c_str());
@@ -367,7 +421,8 @@ bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps
             MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to seek in file (id: %u)", tableId);
             break;
         }
-        CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, numOps};
+        CheckpointUtils::FileHeader fileHeader{
+            m_compress ? CP_MGR_COMPRESSED_MAGIC : CP_MGR_MAGIC, tableId, exId, numOps};
         if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
             sizeof(CheckpointUtils::FileHeader)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to write to file (id: %u)", tableId);
@@ -455,10 +510,63 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableMetadataFile(Tabl
     return ErrCodes::SUCCESS;
 }
 
-bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
+CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDelFile(Table* table, const DeletedKeys* deletedKeys)
+{
+    uint32_t tableId = table->GetTableId();
+    int fd = -1;
+
+    std::string fileName;
+    CheckpointUtils::MakeDelFilename(tableId, fileName, m_workingDir);
+    if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to create file: %s", fileName.c_str());
+        return ErrCodes::FILE_IO;
+    }
+
+    uint64_t numKeys = (deletedKeys != nullptr) ? deletedKeys->m_numKeys : 0;
+    CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, table->GetTableExId(), numKeys};
+    if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
+        sizeof(CheckpointUtils::FileHeader)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to write file header: %s", fileName.c_str());
+        (void)CheckpointUtils::CloseFile(fd);
+        return ErrCodes::FILE_IO;
+    }
+
+    if (numKeys > 0) {
+        size_t len = deletedKeys->m_entries.length();
+        if (CheckpointUtils::WriteFile(fd, (char*)deletedKeys->m_entries.data(), len) != len) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to write %lu keys to file: %s",
+                numKeys,
+                fileName.c_str());
+            (void)CheckpointUtils::CloseFile(fd);
+            return ErrCodes::FILE_IO;
+        }
+    }
+
+    if (CheckpointUtils::FlushFile(fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to flush file: %s", fileName.c_str());
+        (void)CheckpointUtils::CloseFile(fd);
+        return ErrCodes::FILE_IO;
+    }
+
+    if (CheckpointUtils::CloseFile(fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDelFile: failed to close file: %s", fileName.c_str());
+        return ErrCodes::FILE_IO;
+    }
+    return ErrCodes::SUCCESS;
+}
+
+bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer, char* compressBuf)
 {
     if (buffer->Size() > 0) {  // there is data in the buffer that needs to be written
-        if (CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
+        if (compressBuf != nullptr) {
+            if (!CheckpointUtils::WriteCompressedBlock(fd,
+                (const char*)buffer->Data(),
+                buffer->Size(),
+                compressBuf,
+                CheckpointUtils::CompressBound(buffer->MaxSize()))) {
+                return false;
+            }
+        } else if (CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
             return false;
         }
         buffer->Reset();
@@ -467,7 +575,8 @@ bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 }
 
 CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint64_t baseCsn, char* compressBuf,
+    uint32_t& maxSegId, uint64_t& numOps)
 {
     uint32_t tableId = table->GetTableId();
     uint64_t exId = table->GetTableExId();
@@ -508,7 +617,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             it->Next();
             continue;
         }
-        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted);
+        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted, baseCsn, compressBuf);
         if (isDeleted) {
             deletedList[deletedListLocation++] = sentinel;
             ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE);
@@ -517,7 +626,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             currFileOps++;
             curSegLen += table->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader);
             if (m_checkpointSegsize > 0 && curSegLen >= m_checkpointSegsize) {
-                if (!FlushBuffer(fd, buffer)) {
+                if (!FlushBuffer(fd, buffer, compressBuf)) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WriteTableDataFile: failed to write remaining buffer data (%u bytes) to "
                             "data file %u for table %u",
@@ -576,7 +685,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
         return errCode;
     }
 
-    if (!FlushBuffer(fd, buffer)) {
+    if (!FlushBuffer(fd, buffer, compressBuf)) {
         MOT_LOG_ERROR(
             "CheckpointWorkerPool::WriteTableDataFile: failed to write remaining buffer data (%u bytes) to "
                 "data file %u for table %u",
@@ -38,6 +38,19 @@
 namespace MOT {
 const int CHECKPOINT_BUFFER_SIZE = 4096 * 1000;
 
+/**
+ * @struct DeletedKeys
+ * @brief The primary keys deleted from a table since the previous checkpoint, serialized
+ * as entries of the table's deleted keys file.
+ */
+struct DeletedKeys {
+    /** @var The number of keys. */
+    uint64_t m_numKeys = 0;
+
+    /** @var The serialized entries. */
+    std::string m_entries;
+};
+
 /**
  * @class CheckpointManagerCallbacks
  * @brief This class describes the interface for callback methods
@@ -68,6 +81,15 @@ public:
      */
     virtual void OnError(int errCode, const char* errMsg, const char* optionalMsg = nullptr) = 0;
 
+    /**
+     * @brief Queries whether only the changes of a table are written in the current checkpoint.
+     * @param tableId The table id.
+     * @param[out] baseCsn Only the rows whose CSN is above this value are written.
+     * @param[out] deletedKeys The keys deleted from the table since the previous checkpoint, or null.
+     * @return True if the table is written as a delta, false if it is written in full.
+     */
+    virtual bool GetTableDelta(uint32_t tableId, uint64_t& baseCsn, const DeletedKeys*& deletedKeys) = 0;
+
     virtual ~CheckpointManagerCallbacks()
     {}
 };
@@ -79,7 +101,13 @@ public:
 class CheckpointWorkerPool {
 public:
     CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, CheckpointManagerCallbacks& m)
-        : m_numWorkers(n), m_tasksList(l), m_checkpointId(id), m_na(b), m_cpManager(m), m_checkpointSegsize(s)
+        : m_numWorkers(n),
+          m_tasksList(l),
+          m_checkpointId(id),
+          m_na(b),
+          m_cpManager(m),
+          m_checkpointSegsize(s),
+          m_compress(false)
     {
         Start();
     }
@@ -103,9 +131,10 @@ private:
      * @param buffer The buffer to fill.
      * @param row The row to write.
      * @param fd The file descriptor to write to.
+     * @param compressBuf The compression buffer, or null if the file is not compressed.
      * @return Boolean value denoting success or failure.
      */
-    bool Write(Buffer* buffer, Row* row, int fd);
+    bool Write(Buffer* buffer, Row* row, int fd, char* compressBuf);
 
     /**
      * @brief Checkpoints a row, according to whether a stable version exists or not.
@@ -114,9 +143,12 @@ private:
      * @param fd The file descriptor to write to.
      * @param threadId The thread id.
      * @param isDeleted The row delete status.
+     * @param baseCsn Rows whose CSN is not above this value are not written.
+     * @param compressBuf The compression buffer, or null if the file is not compressed.
      * @return -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted);
+    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, uint64_t baseCsn,
+        char* compressBuf);
 
     /**
      * @brief Pops a task (table pointer) from the tasks queue.
@@ -167,14 +199,32 @@ private:
      * @param deletedList Array to collect the sentinels deleted rows to be cleaned.
      * @param gcSession GC manager object.
      * @param threadId The thread id.
+     * @param baseCsn Rows whose CSN is not above this value are not written.
+     * @param compressBuf The compression buffer, or null if the files are not compressed.
      * @param maxSegId The maximum segment ID of the table.
      * @param numOps The number of rows written.
      * @return Returns the error code of type ErrCodes.
      */
     ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, Sentinel** deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+        uint16_t threadId, uint64_t baseCsn, char* compressBuf, uint32_t& maxSegId, uint64_t& numOps);
+
+    /**
+     * @brief Writes the keys deleted from a table since the previous checkpoint to the deleted keys file,
+     * which also marks the table as written as a delta.
+     * @param table The table's pointer.
+     * @param deletedKeys The deleted keys, or null if none.
+     * @return Returns the error code of type ErrCodes.
+     */
+    ErrCodes WriteTableDelFile(Table* table, const DeletedKeys* deletedKeys);
 
-    bool FlushBuffer(int fd, Buffer* buffer);
+    /**
+     * @brief Writes the buffer to the file, compressed if a compression buffer is given, and resets it.
+     * @param fd The file descriptor to write to.
+     * @param buffer The buffer to write.
+     * @param compressBuf The compression buffer, or null if the file is not compressed.
+     * @return Boolean value denoting success or failure.
+     */
+    bool FlushBuffer(int fd, Buffer* buffer, char* compressBuf);
 
     // Workers
     void* m_workers;
@@ -201,6 +251,9 @@ private:
 
     // Size threshold
     uint32_t m_checkpointSegsize;
+
+    // Compress the data files
+    bool m_compress;
 };
 }  // namespace MOT
 
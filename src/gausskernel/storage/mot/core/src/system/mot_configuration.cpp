@@ -69,10 +69,20 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_DELTA_CHECKPOINT;
+constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_FULL_INTERVAL;
+constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_FULL_INTERVAL;
+constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_FULL_INTERVAL;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT_COMPRESSION;
+// transaction configuration members
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_MVCC_SNAPSHOT_READ;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_REDO_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_REDO_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_REDO_RECOVERY_WORKERS;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_LOG_RECOVERY_STATS;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
@@ -156,6 +166,10 @@ constexpr const char* MOTConfiguration::DEFAULT_SESSION_MAX_HUGE_OBJECT_SIZE;
 constexpr uint64_t MOTConfiguration::DEFAULT_SESSION_MAX_HUGE_OBJECT_SIZE_MB;
 constexpr uint64_t MOTConfiguration::MIN_SESSION_MAX_HUGE_OBJECT_SIZE_MB;
 constexpr uint64_t MOTConfiguration::MAX_SESSION_MAX_HUGE_OBJECT_SIZE_MB;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_ONLINE_COMPACTION;
+constexpr uint32_t MOTConfiguration::DEFAULT_COMPACTION_THRESHOLD_PERCENT;
+constexpr uint32_t MOTConfiguration::MIN_COMPACTION_THRESHOLD_PERCENT;
+constexpr uint32_t MOTConfiguration::MAX_COMPACTION_THRESHOLD_PERCENT;
 // GC configuration members
 constexpr bool MOTConfiguration::DEFAULT_GC_ENABLE;
 constexpr const char* MOTConfiguration::DEFAULT_GC_RECLAIM_THRESHOLD;
@@ -179,6 +193,9 @@ constexpr uint32_t MOTConfiguration::MAX_MOT_CODEGEN_LIMIT;
 // storage configuration
 constexpr bool MOTConfiguration::DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN;
 constexpr IndexTreeFlavor MOTConfiguration::DEFAULT_INDEX_TREE_FLAVOR;
+constexpr uint32_t MOTConfiguration::DEFAULT_INDEX_BUILD_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_INDEX_BUILD_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_INDEX_BUILD_WORKERS;
 // general configuration members
 constexpr const char* MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD;
 constexpr uint64_t MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD_SECONDS;
@@ -451,10 +468,15 @@ MOTConfiguration::MOTConfiguration()
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_enableDeltaCheckpoint(DEFAULT_ENABLE_DELTA_CHECKPOINT),
+      m_checkpointFullInterval(DEFAULT_CHECKPOINT_FULL_INTERVAL),
+      m_enableCheckpointCompression(DEFAULT_ENABLE_CHECKPOINT_COMPRESSION),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_redoRecoveryWorkers(DEFAULT_REDO_RECOVERY_WORKERS),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
+      m_enableMvccSnapshotRead(DEFAULT_ENABLE_MVCC_SNAPSHOT_READ),
       m_numaNodes(DEFAULT_NUMA_NODES),
       m_coresPerCpu(DEFAULT_CORES_PER_CPU),
       m_dataNodeId(DEFAULT_DATA_NODE_ID),
@@ -495,6 +517,8 @@ MOTConfiguration::MOTConfiguration()
       m_sessionLargeBufferStoreSizeMB(DEFAULT_SESSION_LARGE_BUFFER_STORE_SIZE_MB),
       m_sessionLargeBufferStoreMaxObjectSizeMB(DEFAULT_SESSION_LARGE_BUFFER_STORE_MAX_OBJECT_SIZE_MB),
       m_sessionMaxHugeObjectSizeMB(DEFAULT_SESSION_MAX_HUGE_OBJECT_SIZE_MB),
+      m_enableOnlineCompaction(DEFAULT_ENABLE_ONLINE_COMPACTION),
+      m_compactionThresholdPercent(DEFAULT_COMPACTION_THRESHOLD_PERCENT),
       m_gcEnable(DEFAULT_GC_ENABLE),
       m_gcReclaimThresholdBytes(DEFAULT_GC_RECLAIM_THRESHOLD_BYTES),
       m_gcReclaimBatchSize(DEFAULT_GC_RECLAIM_BATCH_SIZE),
@@ -505,6 +529,7 @@ MOTConfiguration::MOTConfiguration()
       m_codegenLimit(DEFAULT_MOT_CODEGEN_LIMIT),
       m_allowIndexOnNullableColumn(DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN),
       m_indexTreeFlavor(DEFAULT_INDEX_TREE_FLAVOR),
+      m_indexBuildWorkers(DEFAULT_INDEX_BUILD_WORKERS),
       m_configMonitorPeriodSeconds(DEFAULT_CFG_MONITOR_PERIOD_SECONDS),
       m_runInternalConsistencyValidation(DEFAULT_RUN_INTERNAL_CONSISTENCY_VALIDATION),
       m_totalMemoryMb(DEFAULT_TOTAL_MEMORY_MB),
@@ -556,10 +581,15 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseBool(name, "enable_delta_checkpoint", value, &m_enableDeltaCheckpoint)) {
+    } else if (ParseUint32(name, "checkpoint_full_interval", value, &m_checkpointFullInterval)) {
+    } else if (ParseBool(name, "enable_checkpoint_compression", value, &m_enableCheckpointCompression)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
+    } else if (ParseUint32(name, "redo_recovery_workers", value, &m_redoRecoveryWorkers)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
+    } else if (ParseBool(name, "enable_mvcc_snapshot_read", value, &m_enableMvccSnapshotRead)) {
     } else if (ParseBool(name, "enable_stats", value, &m_enableStats)) {
     } else if (ParseUint64(name, "stats_period_seconds", value, &m_statPrintPeriodSeconds)) {
     } else if (ParseUint64(name, "full_stats_period_seconds", value, &m_statPrintFullPeriodSeconds)) {
@@ -598,12 +628,15 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
                    value,
                    &m_sessionLargeBufferStoreMaxObjectSizeMB)) {
     } else if (ParseUint64(name, "session_max_huge_object_size_mb", value, &m_sessionMaxHugeObjectSizeMB)) {
+    } else if (ParseBool(name, "enable_online_compaction", value, &m_enableOnlineCompaction)) {
+    } else if (ParseUint32(name, "compaction_threshold_percent", value, &m_compactionThresholdPercent)) {
     } else if (ParseBool(name, "enable_mot_codegen", value, &m_enableCodegen)) {
     } else if (ParseBool(name, "force_mot_pseudo_codegen", value, &m_forcePseudoCodegen)) {
     } else if (ParseBool(name, "enable_mot_codegen_print", value, &m_enableCodegenPrint)) {
     } else if (ParseUint32(name, "mot_codegen_limit", value, &m_codegenLimit)) {
     } else if (ParseBool(name, "allow_index_on_nullable_column", value, &m_allowIndexOnNullableColumn)) {
     } else if (ParseIndexTreeFlavor(name, "index_tree_flavor", value, &m_indexTreeFlavor)) {
+    } else if (ParseUint32(name, "index_build_workers", value, &m_indexBuildWorkers)) {
     } else if (ParseUint64(name, "config_monitor_period_seconds", value, &m_configMonitorPeriodSeconds)) {
     } else if (ParseBool(name, "run_internal_consistency_validation", value, &m_runInternalConsistencyValidation)) {
     } else {
@@ -875,6 +908,12 @@ void MOTConfiguration::LoadMemConfig()
         SCALE_MEGA_BYTES,
         MIN_SESSION_MAX_HUGE_OBJECT_SIZE_MB,
         MAX_SESSION_MAX_HUGE_OBJECT_SIZE_MB);
+    UPDATE_BOOL_CFG(m_enableOnlineCompaction, "enable_online_compaction", DEFAULT_ENABLE_ONLINE_COMPACTION);
+    UPDATE_INT_CFG(m_compactionThresholdPercent,
+        "compaction_threshold_percent",
+        DEFAULT_COMPACTION_THRESHOLD_PERCENT,
+        MIN_COMPACTION_THRESHOLD_PERCENT,
+        MAX_COMPACTION_THRESHOLD_PERCENT);
 }
 
 void MOTConfiguration::LoadConfig()
@@ -936,6 +975,14 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_BOOL_CFG(m_enableDeltaCheckpoint, "enable_delta_checkpoint", DEFAULT_ENABLE_DELTA_CHECKPOINT);
+    UPDATE_INT_CFG(m_checkpointFullInterval,
+        "checkpoint_full_interval",
+        DEFAULT_CHECKPOINT_FULL_INTERVAL,
+        MIN_CHECKPOINT_FULL_INTERVAL,
+        MAX_CHECKPOINT_FULL_INTERVAL);
+    UPDATE_BOOL_CFG(
+        m_enableCheckpointCompression, "enable_checkpoint_compression", DEFAULT_ENABLE_CHECKPOINT_COMPRESSION);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -943,6 +990,11 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_RECOVERY_WORKERS,
         MIN_CHECKPOINT_RECOVERY_WORKERS,
         MAX_CHECKPOINT_RECOVERY_WORKERS);
+    UPDATE_INT_CFG(m_redoRecoveryWorkers,
+        "redo_recovery_workers",
+        DEFAULT_REDO_RECOVERY_WORKERS,
+        MIN_REDO_RECOVERY_WORKERS,
+        MAX_REDO_RECOVERY_WORKERS);
 
     // Tx configuration - not configurable yet
     if (m_loadExtraParams) {
@@ -1008,6 +1060,15 @@ void MOTConfiguration::LoadConfig()
         MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES,
         MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES);
 
+    // MVCC configuration, old row versions are reclaimed only by the GC
+    UPDATE_BOOL_CFG(m_enableMvccSnapshotRead, "enable_mvcc_snapshot_read", DEFAULT_ENABLE_MVCC_SNAPSHOT_READ);
+    if (m_enableMvccSnapshotRead && !m_gcEnable) {
+        if (m_suppressLog == 0) {
+            MOT_LOG_WARN("Disabling enable_mvcc_snapshot_read forcibly as the garbage collector is disabled");
+        }
+        UpdateBoolConfigItem(m_enableMvccSnapshotRead, false, "enable_mvcc_snapshot_read");
+    }
+
     // JIT configuration
     UPDATE_BOOL_CFG(m_enableCodegen, "enable_mot_codegen", DEFAULT_ENABLE_MOT_CODEGEN);
     UPDATE_BOOL_CFG(m_forcePseudoCodegen, "force_mot_pseudo_codegen", DEFAULT_FORCE_MOT_PSEUDO_CODEGEN);
@@ -1021,6 +1082,11 @@ void MOTConfiguration::LoadConfig()
             m_allowIndexOnNullableColumn, "allow_index_on_nullable_column", DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN);
         UPDATE_USER_CFG(m_indexTreeFlavor, "index_tree_flavor", DEFAULT_INDEX_TREE_FLAVOR);
     }
+    UPDATE_INT_CFG(m_indexBuildWorkers,
+        "index_build_workers",
+        DEFAULT_INDEX_BUILD_WORKERS,
+        MIN_INDEX_BUILD_WORKERS,
+        MAX_INDEX_BUILD_WORKERS);
 
     // general configuration
     if (m_loadExtraParams) {
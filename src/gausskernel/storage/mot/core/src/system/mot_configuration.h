@@ -178,6 +178,15 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Write only the rows changed since the previous checkpoint (delta checkpoint). */
+    bool m_enableDeltaCheckpoint;
+
+    /** @var Number of checkpoints after which a full base checkpoint is taken in delta checkpoint mode. */
+    uint32_t m_checkpointFullInterval;
+
+    /** @var Compress checkpoint data files with LZ4. */
+    bool m_enableCheckpointCompression;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -185,6 +194,9 @@ public:
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /** @var Specifies the number of workers used to replay the redo log (one means serial replay). */
+    uint32_t m_redoRecoveryWorkers;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -193,6 +205,9 @@ public:
     bool m_preAbort;
     TxnValidation m_validationLock;
 
+    /** @var Keep committed row versions, so that read-only transactions read a CSN snapshot. */
+    bool m_enableMvccSnapshotRead;
+
     /**********************************************************************/
     // Machine configuration (not configurable, but loaded from system info)
     /**********************************************************************/
@@ -325,6 +340,12 @@ public:
     /** @var The largest single huge object size that can be allocated by any session directly from kernel. */
     uint64_t m_sessionMaxHugeObjectSizeMB;
 
+    /** @var Specifies whether autovacuum compacts MOT table rows online. */
+    bool m_enableOnlineCompaction;
+
+    /** @var Free space percentage of a table row pool above which it is compacted. */
+    uint32_t m_compactionThresholdPercent;
+
     /**********************************************************************/
     // Garbage Collection configuration
     /**********************************************************************/
@@ -364,6 +385,9 @@ public:
     /** @var Specifies the tree flavor for tree indexes. */
     IndexTreeFlavor m_indexTreeFlavor;
 
+    /** @var Specifies the number of workers used to build a new secondary index (one means serial build). */
+    uint32_t m_indexBuildWorkers;
+
     /**********************************************************************/
     // General configuration
     /**********************************************************************/
@@ -465,12 +489,32 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default enable delta checkpoint. */
+    static constexpr bool DEFAULT_ENABLE_DELTA_CHECKPOINT = false;
+
+    /** @var Default number of checkpoints between full base checkpoints. */
+    static constexpr uint32_t DEFAULT_CHECKPOINT_FULL_INTERVAL = 8;
+    static constexpr uint32_t MIN_CHECKPOINT_FULL_INTERVAL = 1;
+    static constexpr uint32_t MAX_CHECKPOINT_FULL_INTERVAL = 256;
+
+    /** @var Default enable checkpoint compression. */
+    static constexpr bool DEFAULT_ENABLE_CHECKPOINT_COMPRESSION = false;
+
+    /** ------------------ Default Transaction Configuration ------------ */
+    /** @var Default enable MVCC snapshot read. */
+    static constexpr bool DEFAULT_ENABLE_MVCC_SNAPSHOT_READ = false;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
     static constexpr uint32_t MIN_CHECKPOINT_RECOVERY_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_RECOVERY_WORKERS = 1024;
 
+    /** @var Default number of workers used to replay the redo log. */
+    static constexpr uint32_t DEFAULT_REDO_RECOVERY_WORKERS = 1;
+    static constexpr uint32_t MIN_REDO_RECOVERY_WORKERS = 1;
+    static constexpr uint32_t MAX_REDO_RECOVERY_WORKERS = 256;
+
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
 
@@ -635,6 +679,14 @@ public:
     static constexpr uint64_t MIN_SESSION_MAX_HUGE_OBJECT_SIZE_MB = 8;              // 8 MB
     static constexpr uint64_t MAX_SESSION_MAX_HUGE_OBJECT_SIZE_MB = 8 * KILO_BYTE;  // 8 GB
 
+    /** @var Default enable online compaction of table rows by autovacuum. */
+    static constexpr bool DEFAULT_ENABLE_ONLINE_COMPACTION = true;
+
+    /** @var Default free space percentage of a row pool above which it is compacted. */
+    static constexpr uint32_t DEFAULT_COMPACTION_THRESHOLD_PERCENT = 30;
+    static constexpr uint32_t MIN_COMPACTION_THRESHOLD_PERCENT = 5;
+    static constexpr uint32_t MAX_COMPACTION_THRESHOLD_PERCENT = 90;
+
     /** ------------------ Default Garbage-Collection Configuration ------------ */
     /** @var Enable/disable garbage collection. */
     static constexpr bool DEFAULT_GC_ENABLE = true;
@@ -678,6 +730,11 @@ public:
     /** @var The default tree flavor for tree indexes. */
     static constexpr IndexTreeFlavor DEFAULT_INDEX_TREE_FLAVOR = IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE;
 
+    /** @var Default number of workers used to build a new secondary index. */
+    static constexpr uint32_t DEFAULT_INDEX_BUILD_WORKERS = 4;
+    static constexpr uint32_t MIN_INDEX_BUILD_WORKERS = 1;
+    static constexpr uint32_t MAX_INDEX_BUILD_WORKERS = 256;
+
     /** ------------------ Default General Configuration ------------ */
     /** @var Default configuration monitor period in seconds. */
     static constexpr const char* DEFAULT_CFG_MONITOR_PERIOD = "5 seconds";
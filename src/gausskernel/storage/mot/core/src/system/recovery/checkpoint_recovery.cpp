@@ -27,6 +27,7 @@
 #include "checkpoint_recovery.h"
 #include "checkpoint_utils.h"
 #include "irecovery_manager.h"
+#include "buffer.h"
 #include "redo_log_transaction_iterator.h"
 
 namespace MOT {
@@ -41,6 +42,7 @@ bool CheckpointRecovery::Recover()
     }
 
     m_tasksList.clear();
+    m_rounds.clear();
     if (CheckpointControlFile::GetCtrlFile() == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Checkpoint Recovery Initialization", "Failed to allocate ctrlfile object");
         return false;
@@ -86,7 +88,7 @@ bool CheckpointRecovery::Recover()
         return true;
     }
 
-    if (m_tasksList.size() > 0) {
+    if (!m_rounds.empty()) {
         if (GetGlobalConfiguration().m_enableIncrementalCheckpoint) {
             MOT_LOG_ERROR(
                 "CheckpointRecovery: recovery of MOT tables failed. MOT does not support incremental checkpoint");
@@ -114,10 +116,15 @@ bool CheckpointRecovery::Recover()
      * we will need to retrieve it before a new checkpoint is created.
      */
     engine->GetCheckpointManager()->SetId(m_checkpointId);
+    if (m_hasChain) {
+        // the next checkpoint can be a delta of the recovered one
+        engine->GetCheckpointManager()->SetChain(m_chain, m_snapshotCsn, m_tableIds);
+    }
 
-    MOT_LOG_INFO("Checkpoint Recovery: finished recovering %lu tables from checkpoint id: %lu",
+    MOT_LOG_INFO("Checkpoint Recovery: finished recovering %lu tables from checkpoint id: %lu (chain length %lu)",
         m_tableIds.size(),
-        m_checkpointId);
+        m_checkpointId,
+        m_chain.size());
 
     m_tableIds.clear();
     MOTEngine::GetInstance()->GetCheckpointManager()->RemoveOldCheckpoints(m_checkpointId);
@@ -137,23 +144,104 @@ bool CheckpointRecovery::PerformRecovery()
         }
     }
 
-    std::vector<std::thread> threadPool;
-    for (uint32_t i = 0; i < m_numWorkers; ++i) {
-        threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
+    // Each round must complete before the next one starts, as rows of a delta checkpoint replace the rows
+    // recovered from the checkpoints before it
+    for (size_t round = 0; round < m_rounds.size() && m_stopWorkers == false; ++round) {
+        if (m_rounds[round].empty()) {
+            continue;
+        }
+        m_tasksLock.lock();
+        m_tasksList.splice(m_tasksList.end(), m_rounds[round]);
+        m_tasksLock.unlock();
+
+        std::vector<std::thread> threadPool;
+        for (uint32_t i = 0; i < m_numWorkers; ++i) {
+            threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
+        }
+
+        MOT_LOG_DEBUG("CheckpointRecovery: waiting for all tasks of round %lu to finish", round);
+        while (HaveTasks() && m_stopWorkers == false) {
+            sleep(1);
+        }
+
+        MOT_LOG_DEBUG("CheckpointRecovery: tasks of round %lu finished (%s)", round, m_errorSet ? "error" : "ok");
+        for (auto& worker : threadPool) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    // release the tasks that were not recovered due to an error
+    for (auto& roundTasks : m_rounds) {
+        for (Task* task : roundTasks) {
+            delete task;
+        }
+        roundTasks.clear();
     }
+    for (Task* task : m_tasksList) {
+        delete task;
+    }
+    m_tasksList.clear();
+
+    return true;
+}
 
-    MOT_LOG_DEBUG("CheckpointRecovery: waiting for all tasks to finish");
-    while (HaveTasks() && m_stopWorkers == false) {
-        sleep(1);
+bool CheckpointRecovery::ReadChainFile()
+{
+    std::string fileName;
+    CheckpointUtils::MakeChainFilename(fileName, m_workingDir, m_checkpointId);
+    m_chain.clear();
+    m_chainDirs.clear();
+    if (!CheckpointUtils::IsFileExists(fileName)) {
+        // a full checkpoint that was not written as part of a chain
+        m_hasChain = false;
+        m_chain.push_back(m_checkpointId);
+        m_chainDirs.push_back(m_workingDir);
+        return true;
     }
 
-    MOT_LOG_DEBUG("CheckpointRecovery: tasks finished (%s)", m_errorSet ? "error" : "ok");
-    for (auto& worker : threadPool) {
-        if (worker.joinable()) {
-            worker.join();
+    int fd = -1;
+    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to open chain file '%s'", fileName.c_str());
+        return false;
+    }
+
+    CheckpointUtils::ChainFileHeader chainFileHeader;
+    if (CheckpointUtils::ReadFile(fd, (char*)&chainFileHeader, sizeof(CheckpointUtils::ChainFileHeader)) !=
+        sizeof(CheckpointUtils::ChainFileHeader)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to read chain file '%s' header", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    if (chainFileHeader.m_magic != CP_MGR_MAGIC || chainFileHeader.m_numLinks == 0 ||
+        chainFileHeader.m_numLinks > MOTConfiguration::MAX_CHECKPOINT_FULL_INTERVAL) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to verify chain file '%s'", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    m_chain.resize(chainFileHeader.m_numLinks);
+    size_t len = chainFileHeader.m_numLinks * sizeof(uint64_t);
+    if (CheckpointUtils::ReadFile(fd, (char*)m_chain.data(), len) != len || m_chain.back() != m_checkpointId) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to read chain file '%s' links", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+    CheckpointUtils::CloseFile(fd);
+
+    for (uint64_t id : m_chain) {
+        std::string workingDir;
+        if (!CheckpointUtils::SetWorkingDir(workingDir, id)) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to obtain checkpoint %lu working dir", id);
+            return false;
         }
+        m_chainDirs.push_back(workingDir);
     }
 
+    m_hasChain = true;
+    m_snapshotCsn = chainFileHeader.m_snapshotCsn;
     return true;
 }
 
@@ -163,53 +251,124 @@ int CheckpointRecovery::FillTasksFromMapFile()
         return 0;  // fresh install probably. no error
     }
 
+    if (!ReadChainFile()) {
+        return -1;
+    }
+
+    // The tables to recover are the ones in the latest checkpoint. Each table is recovered starting from the
+    // latest checkpoint in which it was written in full, which is the one without a deleted keys file.
+    uint32_t lastLevel = (uint32_t)(m_chain.size() - 1);
+    std::map<uint32_t, uint32_t> maxSegIds;
+    if (!ReadMapFile(lastLevel, maxSegIds)) {
+        return -1;
+    }
+
+    std::map<uint32_t, uint32_t> startLevels;
+    for (auto it = maxSegIds.begin(); it != maxSegIds.end(); ++it) {
+        uint32_t level = lastLevel;
+        std::string fileName;
+        CheckpointUtils::MakeDelFilename(it->first, fileName, m_chainDirs[level]);
+        while (level > 0 && CheckpointUtils::IsFileExists(fileName)) {
+            --level;
+            CheckpointUtils::MakeDelFilename(it->first, fileName, m_chainDirs[level]);
+        }
+        startLevels[it->first] = level;
+        m_tableIds.insert(it->first);
+    }
+
+    size_t numTasks = 0;
+    for (uint32_t level = 0; level <= lastLevel; ++level) {
+        std::map<uint32_t, uint32_t> levelSegIds;
+        bool mapRead = false;
+        for (auto it = startLevels.begin(); it != startLevels.end(); ++it) {
+            uint32_t tableId = it->first;
+            if (it->second > level) {
+                continue;
+            }
+
+            if (!mapRead && level != lastLevel && !ReadMapFile(level, levelSegIds)) {
+                return -1;
+            }
+            mapRead = true;
+            const std::map<uint32_t, uint32_t>& segIds = (level == lastLevel) ? maxSegIds : levelSegIds;
+            auto segIt = segIds.find(tableId);
+            if (segIt == segIds.end()) {
+                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: table %u is missing from checkpoint %lu",
+                    tableId,
+                    m_chain[level]);
+                return -1;
+            }
+
+            bool isDelta = (level > it->second);
+            if (isDelta && !AddTask(tableId, 0, level, TaskType::DELETED_KEYS)) {
+                return -1;
+            }
+            for (uint32_t seg = 0; seg <= segIt->second; seg++) {
+                if (!AddTask(tableId, seg, level, isDelta ? TaskType::DELTA_SEGMENT : TaskType::SEGMENT)) {
+                    return -1;
+                }
+            }
+            numTasks += segIt->second + (isDelta ? 2 : 1);
+        }
+    }
+
+    MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: filled %lu tasks", numTasks);
+    return 1;
+}
+
+bool CheckpointRecovery::ReadMapFile(uint32_t level, std::map<uint32_t, uint32_t>& maxSegIds)
+{
     std::string mapFile;
-    CheckpointUtils::MakeMapFilename(mapFile, m_workingDir, m_checkpointId);
+    CheckpointUtils::MakeMapFilename(mapFile, m_chainDirs[level], m_chain[level]);
     int fd = -1;
     if (!CheckpointUtils::OpenFileRead(mapFile, fd)) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to open map file '%s'", mapFile.c_str());
-        return -1;
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to open map file '%s'", mapFile.c_str());
+        return false;
     }
 
     CheckpointUtils::MapFileHeader mapFileHeader;
     if (CheckpointUtils::ReadFile(fd, (char*)&mapFileHeader, sizeof(CheckpointUtils::MapFileHeader)) !=
         sizeof(CheckpointUtils::MapFileHeader)) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read map file '%s' header", mapFile.c_str());
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to read map file '%s' header", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
-        return -1;
+        return false;
     }
 
     if (mapFileHeader.m_magic != CP_MGR_MAGIC) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to verify map file'%s'", mapFile.c_str());
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to verify map file'%s'", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
-        return -1;
+        return false;
     }
 
     CheckpointManager::MapFileEntry entry;
     for (uint64_t i = 0; i < mapFileHeader.m_numEntries; i++) {
         if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointManager::MapFileEntry)) !=
             sizeof(CheckpointManager::MapFileEntry)) {
-            MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read map file '%s' entry: %lu",
-                mapFile.c_str(),
-                i);
+            MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to read map file '%s' entry: %lu", mapFile.c_str(), i);
             CheckpointUtils::CloseFile(fd);
-            return -1;
-        }
-        m_tableIds.insert(entry.m_tableId);
-        for (uint32_t i = 0; i <= entry.m_maxSegId; i++) {
-            Task* recoveryTask = new (std::nothrow) Task(entry.m_tableId, i);
-            if (recoveryTask == nullptr) {
-                CheckpointUtils::CloseFile(fd);
-                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to allocate task object");
-                return -1;
-            }
-            m_tasksList.push_back(recoveryTask);
+            return false;
         }
+        maxSegIds[entry.m_tableId] = entry.m_maxSegId;
     }
 
     CheckpointUtils::CloseFile(fd);
-    MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: filled %lu tasks", m_tasksList.size());
-    return 1;
+    return true;
+}
+
+bool CheckpointRecovery::AddTask(uint32_t tableId, uint32_t segId, uint32_t level, TaskType type)
+{
+    Task* recoveryTask = new (std::nothrow) Task(tableId, segId, level, type);
+    if (recoveryTask == nullptr) {
+        MOT_LOG_ERROR("CheckpointRecovery::AddTask: failed to allocate task object");
+        return false;
+    }
+
+    size_t round = (size_t)level * 2 + ((type == TaskType::DELETED_KEYS) ? 0 : 1);
+    if (m_rounds.size() <= round) {
+        m_rounds.resize(round + 1);
+    }
+    m_rounds[round].push_back(recoveryTask);
+    return true;
 }
 
 bool CheckpointRecovery::RecoverTableMetadata(uint32_t tableId)
@@ -365,7 +524,10 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
         CheckpointRecovery::Task* task = checkpointRecovery->GetTask();
         if (task != nullptr) {
             bool hadError = false;
-            if (!checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status)) {
+            bool recovered = (task->m_type == TaskType::DELETED_KEYS)
+                                 ? checkpointRecovery->RecoverDeletedKeys(task, keyData, status)
+                                 : checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status);
+            if (!recovered) {
                 MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc recovery of table %lu's data failed", task->m_tableId);
                 checkpointRecovery->OnError(status,
                     "CheckpointRecovery::WorkerFunc failed to recover table: ",
@@ -418,7 +580,7 @@ bool CheckpointRecovery::RecoverTableRows(
     }
 
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    CheckpointUtils::MakeCpFilename(tableId, fileName, m_chainDirs[task->m_level], seg);
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
@@ -432,7 +594,8 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
-    if (fileHeader.m_magic != CP_MGR_MAGIC || fileHeader.m_tableId != tableId) {
+    bool compressed = (fileHeader.m_magic == CP_MGR_COMPRESSED_MAGIC);
+    if ((fileHeader.m_magic != CP_MGR_MAGIC && !compressed) || fileHeader.m_tableId != tableId) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: file: %s is corrupted", fileName.c_str());
         CheckpointUtils::CloseFile(fd);
         return false;
@@ -442,91 +605,223 @@ bool CheckpointRecovery::RecoverTableRows(
     if (tableExId != fileHeader.m_exId) {
         MOT_LOG_ERROR(
             "CheckpointRecovery::RecoverTableRows: exId mismatch: my %lu - pkt %lu", tableExId, fileHeader.m_exId);
+        CheckpointUtils::CloseFile(fd);
         return false;
     }
 
     if (IsMemoryLimitReached(m_numWorkers, GetGlobalConfiguration().m_checkpointSegThreshold)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: Memory hard limit reached. Cannot recover datanode");
+        CheckpointUtils::CloseFile(fd);
         return false;
     }
 
+    BlockReader blockReader;
+    if (compressed) {
+        blockReader.m_compressLen = CheckpointUtils::CompressBound(DEFAULT_BUFFER_SIZE);
+        blockReader.m_data = new (std::nothrow) char[DEFAULT_BUFFER_SIZE];
+        blockReader.m_compressBuf = new (std::nothrow) char[blockReader.m_compressLen];
+        if (blockReader.m_data == nullptr || blockReader.m_compressBuf == nullptr) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to allocate block buffers");
+            delete[] blockReader.m_data;
+            delete[] blockReader.m_compressBuf;
+            CheckpointUtils::CloseFile(fd);
+            status = RC_MEMORY_ALLOCATION_ERROR;
+            return false;
+        }
+    }
+
     CheckpointUtils::EntryHeader entry;
     for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
-        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
-        if (reader != sizeof(CheckpointUtils::EntryHeader)) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
+        char* key = keyData;
+        char* data = entryData;
+        bool entryRead = compressed ? ReadBlockEntry(fd, blockReader, entry, key, data)
+                                    : ReadEntry(fd, entry, keyData, entryData);
+        if (!entryRead) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry (elem: %lu / %lu) from %s",
                 i,
                 fileHeader.m_numOps,
-                reader);
+                fileName.c_str());
             status = RC_ERROR;
             break;
         }
 
-        if (entry.m_keyLen > MAX_KEY_SIZE || entry.m_dataLen > MAX_TUPLE_SIZE) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: invalid entry (elem: %lu / %lu), keyLen %u, dataLen %u",
-                i,
-                fileHeader.m_numOps,
-                entry.m_keyLen,
-                entry.m_dataLen);
-            status = RC_ERROR;
-            break;
+        if (task->m_type == TaskType::DELTA_SEGMENT) {
+            // the row changed since the previous checkpoint in the chain
+            RemoveRow(table, key, entry.m_keyLen, status);
+            if (status != RC_OK) {
+                break;
+            }
         }
 
-        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
-        if (reader != entry.m_keyLen) {
+        InsertRow(table, key, entry.m_keyLen, data, entry.m_dataLen, entry.m_csn, MOTCurrThreadId, sState, status,
+            entry.m_rowId);
+
+        if (status != RC_OK) {
             MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
-                i,
-                fileHeader.m_numOps,
-                reader);
-            status = RC_ERROR;
+                "CheckpointRecovery: failed to insert row %s (error code: %d)", RcToString(status), (int)status);
             break;
         }
+        MOT_LOG_DEBUG("Inserted into table %u row with CSN %" PRIu64, tableId, entry.m_csn);
+        if (entry.m_csn > maxCsn)
+            maxCsn = entry.m_csn;
+    }
+    CheckpointUtils::CloseFile(fd);
+    if (compressed) {
+        delete[] blockReader.m_data;
+        delete[] blockReader.m_compressBuf;
+    }
 
-        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
-        if (reader != entry.m_dataLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
+    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered from checkpoint %lu (%s)",
+        MOTCurrThreadId,
+        tableId,
+        seg,
+        fileHeader.m_numOps,
+        m_chain[task->m_level],
+        (status == RC_OK) ? "OK" : "Error");
+    return (status == RC_OK);
+}
+
+bool CheckpointRecovery::RecoverDeletedKeys(Task* task, char* keyData, RC& status)
+{
+    int fd = -1;
+    uint32_t tableId = task->m_tableId;
+
+    Table* table = GetTableManager()->GetTable(tableId);
+    if (table == nullptr) {
+        MOT_REPORT_ERROR(
+            MOT_ERROR_INTERNAL, "CheckpointRecovery::RecoverDeletedKeys", "Table %llu does not exist", tableId);
+        return false;
+    }
+
+    std::string fileName;
+    CheckpointUtils::MakeDelFilename(tableId, fileName, m_chainDirs[task->m_level]);
+    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverDeletedKeys: failed to open file: %s", fileName.c_str());
+        return false;
+    }
+
+    CheckpointUtils::FileHeader fileHeader;
+    size_t reader = CheckpointUtils::ReadFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader));
+    if (reader != sizeof(CheckpointUtils::FileHeader) || fileHeader.m_magic != CP_MGR_MAGIC ||
+        fileHeader.m_tableId != tableId || fileHeader.m_exId != table->GetTableExId()) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverDeletedKeys: file: %s is corrupted", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    CheckpointUtils::EntryHeader entry;
+    for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
+        if (!ReadEntry(fd, entry, keyData, nullptr) || entry.m_dataLen != 0) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverDeletedKeys: failed to read key (elem: %lu / %lu) from %s",
                 i,
                 fileHeader.m_numOps,
-                reader);
+                fileName.c_str());
             status = RC_ERROR;
             break;
         }
 
-        InsertRow(table,
-            keyData,
-            entry.m_keyLen,
-            entryData,
-            entry.m_dataLen,
-            entry.m_csn,
-            MOTCurrThreadId,
-            sState,
-            status,
-            entry.m_rowId);
-
+        RemoveRow(table, keyData, entry.m_keyLen, status);
         if (status != RC_OK) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery: failed to insert row %s (error code: %d)", RcToString(status), (int)status);
             break;
         }
-        MOT_LOG_DEBUG("Inserted into table %u row with CSN %" PRIu64, tableId, entry.m_csn);
-        if (entry.m_csn > maxCsn)
-            maxCsn = entry.m_csn;
     }
     CheckpointUtils::CloseFile(fd);
 
-    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered (%s)",
+    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverDeletedKeys table %u, %lu keys removed by checkpoint %lu (%s)",
         MOTCurrThreadId,
         tableId,
-        seg,
         fileHeader.m_numOps,
+        m_chain[task->m_level],
         (status == RC_OK) ? "OK" : "Error");
     return (status == RC_OK);
 }
 
+bool CheckpointRecovery::ReadEntry(int fd, CheckpointUtils::EntryHeader& entry, char* keyData, char* entryData)
+{
+    size_t reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
+    if (reader != sizeof(CheckpointUtils::EntryHeader)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadEntry: failed to read entry header, reader %lu", reader);
+        return false;
+    }
+
+    if (entry.m_keyLen > MAX_KEY_SIZE || entry.m_dataLen > MAX_TUPLE_SIZE ||
+        (entryData == nullptr && entry.m_dataLen != 0)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadEntry: invalid entry, keyLen %u, dataLen %u",
+            entry.m_keyLen,
+            entry.m_dataLen);
+        return false;
+    }
+
+    reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
+    if (reader != entry.m_keyLen) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadEntry: failed to read entry key, reader %lu", reader);
+        return false;
+    }
+
+    if (entry.m_dataLen != 0) {
+        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
+        if (reader != entry.m_dataLen) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadEntry: failed to read entry data, reader %lu", reader);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CheckpointRecovery::ReadBlockEntry(
+    int fd, BlockReader& reader, CheckpointUtils::EntryHeader& entry, char*& keyData, char*& entryData)
+{
+    if (reader.m_pos == reader.m_len) {
+        // blocks hold whole entries, so the next entry starts a new block
+        if (!CheckpointUtils::ReadCompressedBlock(
+                fd, reader.m_data, DEFAULT_BUFFER_SIZE, reader.m_len, reader.m_compressBuf, reader.m_compressLen)) {
+            return false;
+        }
+        reader.m_pos = 0;
+    }
+
+    if (reader.m_len - reader.m_pos < sizeof(CheckpointUtils::EntryHeader)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadBlockEntry: truncated entry header");
+        return false;
+    }
+    errno_t erc = memcpy_s(&entry,
+        sizeof(CheckpointUtils::EntryHeader),
+        reader.m_data + reader.m_pos,
+        sizeof(CheckpointUtils::EntryHeader));
+    securec_check(erc, "\0", "\0");
+    reader.m_pos += sizeof(CheckpointUtils::EntryHeader);
+
+    if (entry.m_keyLen > MAX_KEY_SIZE || entry.m_dataLen > MAX_TUPLE_SIZE ||
+        reader.m_len - reader.m_pos < (size_t)entry.m_keyLen + entry.m_dataLen) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadBlockEntry: invalid entry, keyLen %u, dataLen %u",
+            entry.m_keyLen,
+            entry.m_dataLen);
+        return false;
+    }
+
+    keyData = reader.m_data + reader.m_pos;
+    entryData = keyData + entry.m_keyLen;
+    reader.m_pos += (size_t)entry.m_keyLen + entry.m_dataLen;
+    return true;
+}
+
+void CheckpointRecovery::RemoveRow(Table* table, char* keyData, uint16_t keyLen, RC& status)
+{
+    MaxKey key;
+    Row* row = nullptr;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    status = RC_OK;
+    if (table->FindRow(&key, row, MOTCurrThreadId) != RC_OK) {
+        // the row was inserted and deleted between the checkpoints
+        return;
+    }
+
+    if (table->RemoveRow(row, MOTCurrThreadId) == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "Checkpoint Recovery Remove Row", "failed to remove row");
+        status = RC_ERROR;
+    }
+}
+
 CheckpointRecovery::Task* CheckpointRecovery::GetTask()
 {
     Task* task = nullptr;
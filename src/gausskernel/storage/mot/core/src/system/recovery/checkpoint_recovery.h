@@ -25,13 +25,16 @@
 #ifndef CHECKPOINT_RECOVERY_H
 #define CHECKPOINT_RECOVERY_H
 
+#include <map>
 #include <set>
 #include <list>
 #include <mutex>
+#include <vector>
 #include "global.h"
 #include "spin_lock.h"
 #include "table.h"
 #include "surrogate_state.h"
+#include "checkpoint_utils.h"
 
 namespace MOT {
 class CheckpointRecovery {
@@ -40,6 +43,8 @@ public:
         : m_checkpointId(0),
           m_lsn(0),
           m_lastReplayLsn(0),
+          m_snapshotCsn(0),
+          m_hasChain(false),
           m_numWorkers(GetGlobalConfiguration().m_checkpointRecoveryWorkers),
           m_stopWorkers(false),
           m_errorSet(false),
@@ -66,17 +71,35 @@ public:
         return m_stopWorkers;
     }
 
+    /**
+     * @enum TaskType
+     * @brief The kind of file a checkpoint recovery task reads.
+     */
+    enum class TaskType : uint8_t {
+        /** @var A data segment of a table written in full. */
+        SEGMENT,
+
+        /** @var A data segment of a table written as a delta, whose rows replace existing rows. */
+        DELTA_SEGMENT,
+
+        /** @var The keys deleted from a table written as a delta. */
+        DELETED_KEYS
+    };
+
     /**
      * @struct Task
-     * @brief Describes a checkpoint recovery task by its table id and
-     * segment file number.
+     * @brief Describes a checkpoint recovery task by its table id,
+     * segment file number and the checkpoint in the chain it belongs to.
      */
     struct Task {
-        explicit Task(uint32_t tableId = 0, uint32_t segId = 0) : m_tableId(tableId), m_segId(segId)
+        explicit Task(uint32_t tableId = 0, uint32_t segId = 0, uint32_t level = 0, TaskType type = TaskType::SEGMENT)
+            : m_tableId(tableId), m_segId(segId), m_level(level), m_type(type)
         {}
 
         uint32_t m_tableId;
         uint32_t m_segId;
+        uint32_t m_level;
+        TaskType m_type;
     };
 
     /**
@@ -99,6 +122,15 @@ public:
     bool RecoverTableRows(
         Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
 
+    /**
+     * @brief Removes the rows of the keys in a deleted keys file of a delta checkpoint
+     * @param task The task (tableid / checkpoint) to recover from.
+     * @param keyData A key buffer.
+     * @param status RC returned from the Remove function.
+     * @return Boolean value denoting success or failure.
+     */
+    bool RecoverDeletedKeys(Task* task, char* keyData, RC& status);
+
     uint64_t GetLsn() const
     {
         return m_lsn;
@@ -111,6 +143,56 @@ public:
     static void CheckpointRecoveryWorker(CheckpointRecovery* checkpointRecovery);
 
 private:
+    /**
+     * @struct BlockReader
+     * @brief Holds the current decompressed block of a compressed checkpoint data file.
+     */
+    struct BlockReader {
+        char* m_data = nullptr;
+        char* m_compressBuf = nullptr;
+        size_t m_compressLen = 0;
+        size_t m_len = 0;
+        size_t m_pos = 0;
+    };
+
+    /**
+     * @brief Reads the chain file of the checkpoint, if it was written as part of a
+     * delta checkpoint chain, and sets the working directory of each checkpoint in the chain.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadChainFile();
+
+    /**
+     * @brief Reads the map file of a checkpoint in the chain.
+     * @param level The index of the checkpoint in the chain.
+     * @param maxSegIds The returned max segment id of each table in the map.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadMapFile(uint32_t level, std::map<uint32_t, uint32_t>& maxSegIds);
+
+    /**
+     * @brief Reads an entry header and the entry's key and data from a checkpoint file.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadEntry(int fd, CheckpointUtils::EntryHeader& entry, char* keyData, char* entryData);
+
+    /**
+     * @brief Reads an entry from a compressed checkpoint data file, decompressing the next block when the
+     * current one is consumed. The returned key and data point into the block.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadBlockEntry(int fd, BlockReader& reader, CheckpointUtils::EntryHeader& entry, char*& keyData,
+        char*& entryData);
+
+    /**
+     * @brief Removes a row by its primary key, if it exists.
+     * @param table the table's object pointer.
+     * @param keyData key's data buffer.
+     * @param keyLen key's data buffer len.
+     * @param status the returned status of the operation
+     */
+    void RemoveRow(Table* table, char* keyData, uint16_t keyLen, RC& status);
+
     /**
      * @brief Reads and creates a table's definition from a checkpoint
      * metadata file
@@ -127,6 +209,14 @@ private:
      */
     int FillTasksFromMapFile();
 
+    /**
+     * @brief Adds a task to the round it should be recovered in. Deleted keys of a
+     * checkpoint in the chain are removed before its rows are recovered, and each checkpoint
+     * is recovered after the one it is a delta of.
+     * @return Boolean value denoting success or failure.
+     */
+    bool AddTask(uint32_t tableId, uint32_t segId, uint32_t level, TaskType type);
+
     /**
      * @brief Checks if there are any more tasks left in the queue
      * @return Int value where 0 means failure and 1 success
@@ -194,10 +284,20 @@ private:
 
     uint64_t m_lastReplayLsn;
 
+    uint64_t m_snapshotCsn;
+
+    bool m_hasChain;
+
     uint32_t m_numWorkers;
 
     std::string m_workingDir;
 
+    /** @var The checkpoint ids in the chain, starting with the full checkpoint. */
+    std::vector<uint64_t> m_chain;
+
+    /** @var The working directory of each checkpoint in the chain. */
+    std::vector<std::string> m_chainDirs;
+
     std::string m_errorMessage;
 
     bool m_stopWorkers;
@@ -213,6 +313,9 @@ private:
     std::set<uint32_t> m_tableIds;
 
     std::list<Task*> m_tasksList;
+
+    /** @var The tasks of each recovery round, the current round is moved to the tasks list. */
+    std::vector<std::list<Task*>> m_rounds;
 };
 }  // namespace MOT
 
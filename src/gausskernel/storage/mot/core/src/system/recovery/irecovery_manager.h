@@ -104,6 +104,13 @@ public:
     virtual bool IsErrorSet() const = 0;
     virtual void AddSurrogateArrayToList(SurrogateState& surrogate) = 0;
     virtual void SetCsn(uint64_t csn) = 0;
+    virtual uint64_t GetMaxRecoveredCsn() const = 0;
+
+    /**
+     * @brief Waits until the transactions already handed to the redo workers are replayed.
+     * @return False if a redo worker failed.
+     */
+    virtual bool WaitDispatchedTransactions() = 0;
 
 protected:
     // constructor
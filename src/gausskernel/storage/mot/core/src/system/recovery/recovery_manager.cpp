@@ -31,11 +31,14 @@
 #include "checkpoint_manager.h"
 #include "spin_lock.h"
 #include "redo_log_transaction_iterator.h"
+#include "cycles.h"
 #include "mot_engine.h"
 
 namespace MOT {
 DECLARE_LOGGER(RecoveryManager, Recovery);
 
+constexpr size_t RecoveryManager::MAX_QUEUED_REDO_TASKS;
+
 bool RecoveryManager::Initialize()
 {
     // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
@@ -95,6 +98,14 @@ bool RecoveryManager::RecoverDbStart()
 
 bool RecoveryManager::RecoverDbEnd()
 {
+    // replay the transactions still queued to the redo workers, their surrogate state is merged below
+    bool redoDone = WaitRedoWorkers();
+    StopRedoWorkers();
+    if (!redoDone) {
+        MOT_LOG_ERROR("RecoverDbEnd: redo replay failed");
+        return false;
+    }
+
     if (ApplyInProcessTransactions() != RC_OK) {
         MOT_LOG_ERROR("applyInProcessTransactions failed!");
         return false;
@@ -126,6 +137,8 @@ void RecoveryManager::CleanUp()
         return;
     }
 
+    StopRedoWorkers();
+
     if (m_logStats != nullptr) {
         delete m_logStats;
         m_logStats = nullptr;
@@ -223,20 +236,19 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     uint64_t internalTransactionId, uint64_t externalTransactionId, RecoveryOps::RecoveryOpState rState)
 {
     RC status = RC_OK;
+    if (rState == RecoveryOps::RecoveryOpState::COMMIT && IsParallelRedo()) {
+        return DispatchRecoveredTransaction(internalTransactionId);
+    }
+
     if (rState != RecoveryOps::RecoveryOpState::ABORT) {
+        // all the transactions dispatched before this one must be replayed first
+        if (!WaitRedoWorkers()) {
+            MOT_LOG_ERROR("OperateOnRecoveredTransaction: redo worker failed");
+            return false;
+        }
+
         auto operateLambda = [this](RedoLogTransactionSegments* segments, uint64_t id) -> RC {
-            RC redoStatus = RC_OK;
-            LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
-            uint64_t csn = segment->m_controlBlock.m_csn;
-            for (uint32_t i = 0; i < segments->GetCount(); i++) {
-                segment = segments->GetSegment(i);
-                redoStatus = RedoSegment(segment, csn, id, RecoveryOps::RecoveryOpState::COMMIT);
-                if (redoStatus != RC_OK) {
-                    MOT_LOG_ERROR("OperateOnRecoveredTransaction failed with rc %d", redoStatus);
-                    return redoStatus;
-                }
-            }
-            return redoStatus;
+            return RedoTransaction(segments, id, m_sState, 0);
         };
 
         status = MOTEngine::GetInstance()->GetInProcessTransactions().ForUniqueTransaction(
@@ -249,8 +261,29 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     return true;
 }
 
-RC RecoveryManager::RedoSegment(
-    LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState)
+RC RecoveryManager::RedoTransaction(
+    RedoLogTransactionSegments* segments, uint64_t transactionId, SurrogateState& sState, uint64_t commitSeq)
+{
+    RC status = RC_OK;
+    uint64_t startTime = (m_logStats != nullptr) ? CpuCyclesLevelTime::Rdtsc() : 0;
+    LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
+    uint64_t csn = segment->m_controlBlock.m_csn;
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        segment = segments->GetSegment(i);
+        status = RedoSegment(segment, csn, transactionId, RecoveryOps::RecoveryOpState::COMMIT, sState, commitSeq);
+        if (status != RC_OK) {
+            MOT_LOG_ERROR("OperateOnRecoveredTransaction failed with rc %d", status);
+            return status;
+        }
+    }
+    if (m_logStats != nullptr) {
+        m_logStats->AddReplay(commitSeq != 0, CpuCyclesLevelTime::Rdtsc() - startTime);
+    }
+    return status;
+}
+
+RC RecoveryManager::RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId,
+    RecoveryOps::RecoveryOpState rState, SurrogateState& sState, uint64_t commitSeq)
 {
     RC status = RC_OK;
     bool is2pcRecovery = !MOTEngine::GetInstance()->IsRecovering();
@@ -260,8 +293,7 @@ RC RecoveryManager::RedoSegment(
     bool wasCommit = false;
 
     while (operationData < endPosition) {
-        // redo log recovery - single threaded
-        if (IsRecoveryMemoryLimitReached(NUM_REDO_RECOVERY_THREADS)) {
+        if (IsRecoveryMemoryLimitReached(m_numRedoWorkers)) {
             status = RC_ERROR;
             MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
             break;
@@ -279,8 +311,17 @@ RC RecoveryManager::RedoSegment(
         }
 
         if (!is2pcRecovery) {
+            // commits of transactions replayed by the redo workers are applied in log order
+            bool orderedCommit = (commitSeq != 0) && IsCommitOp(*(OperationCode*)operationData);
+            if (orderedCommit && !WaitCommitTurn(commitSeq)) {
+                status = RC_ERROR;
+                break;
+            }
             operationData += RecoveryOps::RecoverLogOperation(
-                MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, m_sState, status, wasCommit);
+                MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, sState, status, wasCommit);
+            if (orderedCommit) {
+                EndCommitTurn(commitSeq);
+            }
             // check operation result status
             if (status != RC_OK) {
                 MOT_REPORT_ERROR(MOT_ERROR_RESOURCE_LIMIT, "Recover Redo Segment", "Failed to recover redo segment");
@@ -292,16 +333,15 @@ RC RecoveryManager::RedoSegment(
             }
         } else {
             operationData += RecoveryOps::TwoPhaseRecoverOp(
-                MOTCurrTxn, rState, operationData, csn, transactionId, MOTCurrThreadId, m_sState, status);
+                MOTCurrTxn, rState, operationData, csn, transactionId, MOTCurrThreadId, sState, status);
         }
         if (status != RC_OK) {
             break;
         }
     }
 
-    // single threaded, no need for locking or CAS
-    if (!is2pcRecovery && csn > m_maxRecoveredCsn) {
-        m_maxRecoveredCsn = csn;
+    if (!is2pcRecovery) {
+        SetCsn(csn);
     }
     if (status != RC_OK) {
         MOT_LOG_ERROR("RecoveryManager::redoSegment: got error %u on tid %lu", status, transactionId);
@@ -309,24 +349,280 @@ RC RecoveryManager::RedoSegment(
     return status;
 }
 
-bool RecoveryManager::LogStats::FindIdx(uint64_t tableId, uint64_t& id)
+bool RecoveryManager::IsParallelRedo() const
+{
+    // The engine is recovering from MOTRecover() at the start of StartupXLOG() until MOTRecoveryDone() at its
+    // end, so this covers both the startup recovery and the whole standby replay until promotion. Outside of
+    // recovery, only prepared transactions are resolved, and those are never dispatched.
+    return m_numRedoWorkers > 1 && MOTEngine::GetInstance()->IsRecovering();
+}
+
+bool RecoveryManager::DispatchRecoveredTransaction(uint64_t internalTransactionId)
+{
+    RedoLogTransactionSegments* segments =
+        MOTEngine::GetInstance()->GetInProcessTransactions().PopTransaction(internalTransactionId);
+    if (segments == nullptr) {
+        return true;
+    }
+
+    uint64_t exId = 0;
+    if (!GetSingleTable(segments, exId)) {
+        // replay alone, once all the transactions before it are replayed
+        bool result = WaitRedoWorkers();
+        if (result && RedoTransaction(segments, internalTransactionId, m_sState, 0) != RC_OK) {
+            MOT_LOG_ERROR("DispatchRecoveredTransaction: wal recovery failed");
+            result = false;
+        }
+        delete segments;
+        return result;
+    }
+
+    if (m_redoWorkers.empty() && !StartRedoWorkers()) {
+        delete segments;
+        return false;
+    }
+    if (m_errorSet) {
+        MOT_LOG_ERROR("DispatchRecoveredTransaction: redo worker failed");
+        delete segments;
+        return false;
+    }
+
+    // all the transactions of a table are replayed by the same worker, so they never conflict with each other.
+    // A standby replays without end, so the queues are bounded, which also bounds how far the replayed log
+    // position may run ahead of the rows visible to standby readers
+    RedoWorkerQueue& queue = m_redoQueues[exId % m_numRedoWorkers];
+    {
+        std::unique_lock<std::mutex> lock(queue.m_lock);
+        queue.m_spaceCond.wait(lock, [this, &queue] {
+            return queue.m_tasks.size() < MAX_QUEUED_REDO_TASKS || m_errorSet;
+        });
+        if (m_errorSet) {
+            lock.unlock();
+            MOT_LOG_ERROR("DispatchRecoveredTransaction: redo worker failed");
+            delete segments;
+            return false;
+        }
+        queue.m_tasks.push({segments, internalTransactionId, ++m_dispatchedSeq});
+    }
+    queue.m_cond.notify_one();
+    return true;
+}
+
+bool RecoveryManager::GetSingleTable(RedoLogTransactionSegments* segments, uint64_t& exId)
+{
+    bool found = false;
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        LogSegment* segment = segments->GetSegment(i);
+        uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
+        uint8_t* operationData = (uint8_t*)(segment->m_data);
+        while (operationData < endPosition) {
+            OperationCode opCode = *(OperationCode*)operationData;
+            if (IsCommitOp(opCode) || opCode == PARTIAL_REDO_TX) {
+                operationData += sizeof(EndSegmentBlock);
+                continue;
+            }
+
+            // schema changes and unknown operations are never replayed in parallel
+            uint64_t opExId = 0;
+            uint32_t opSize = RecoveryOps::GetRowOperationTable(operationData, opExId);
+            if (opSize == 0 || (found && opExId != exId)) {
+                return false;
+            }
+            exId = opExId;
+            found = true;
+            operationData += opSize;
+        }
+    }
+    return found;
+}
+
+bool RecoveryManager::StartRedoWorkers()
+{
+    m_redoQueues = new (std::nothrow) RedoWorkerQueue[m_numRedoWorkers];
+    if (m_redoQueues == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Redo Recovery", "Failed to allocate %u redo worker queues", m_numRedoWorkers);
+        return false;
+    }
+
+    m_stopRedoWorkers = false;
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        m_redoWorkers.push_back(std::thread(RedoRecoveryWorker, this, i));
+    }
+    MOT_LOG_INFO("Started %u redo recovery workers", m_numRedoWorkers);
+    return true;
+}
+
+void RecoveryManager::StopRedoWorkers()
+{
+    if (m_redoQueues == nullptr) {
+        return;
+    }
+
+    m_stopRedoWorkers = true;
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        std::lock_guard<std::mutex> lock(m_redoQueues[i].m_lock);
+        m_redoQueues[i].m_cond.notify_all();
+    }
+    for (auto& worker : m_redoWorkers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_redoWorkers.clear();
+
+    // transactions are left in the queues only after a failure
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        while (!m_redoQueues[i].m_tasks.empty()) {
+            delete m_redoQueues[i].m_tasks.front().m_segments;
+            m_redoQueues[i].m_tasks.pop();
+        }
+    }
+    delete[] m_redoQueues;
+    m_redoQueues = nullptr;
+    MOT_LOG_INFO("Stopped redo recovery workers");
+}
+
+bool RecoveryManager::WaitRedoWorkers()
+{
+    if (m_redoQueues == nullptr) {
+        return !m_errorSet;
+    }
+
+    uint64_t startTime = (m_logStats != nullptr) ? CpuCyclesLevelTime::Rdtsc() : 0;
+    {
+        std::unique_lock<std::mutex> lock(m_commitLock);
+        m_commitCond.wait(lock, [this] { return m_committedSeq == m_dispatchedSeq || m_errorSet; });
+    }
+    if (m_logStats != nullptr) {
+        m_logStats->AddDrain(CpuCyclesLevelTime::Rdtsc() - startTime);
+    }
+    return !m_errorSet;
+}
+
+bool RecoveryManager::WaitDispatchedTransactions()
+{
+    // the replay keeps dispatching while we wait, so only the transactions dispatched so far are waited for
+    uint64_t dispatchedSeq = m_dispatchedSeq;
+    std::unique_lock<std::mutex> lock(m_commitLock);
+    m_commitCond.wait(lock, [this, dispatchedSeq] { return m_committedSeq >= dispatchedSeq || m_errorSet; });
+    return !m_errorSet;
+}
+
+bool RecoveryManager::WaitCommitTurn(uint64_t commitSeq)
+{
+    uint64_t startTime = (m_logStats != nullptr) ? CpuCyclesLevelTime::Rdtsc() : 0;
+    {
+        std::unique_lock<std::mutex> lock(m_commitLock);
+        m_commitCond.wait(lock, [this, commitSeq] { return m_committedSeq + 1 == commitSeq || m_errorSet; });
+    }
+    if (m_logStats != nullptr) {
+        m_logStats->AddCommitWait(CpuCyclesLevelTime::Rdtsc() - startTime);
+    }
+    return !m_errorSet;
+}
+
+void RecoveryManager::EndCommitTurn(uint64_t commitSeq)
+{
+    std::lock_guard<std::mutex> lock(m_commitLock);
+    m_committedSeq = commitSeq;
+    m_commitCond.notify_all();
+}
+
+bool RecoveryManager::GetRedoTask(uint32_t workerId, RedoTask& task)
+{
+    RedoWorkerQueue& queue = m_redoQueues[workerId];
+    std::unique_lock<std::mutex> lock(queue.m_lock);
+    queue.m_cond.wait(lock, [this, &queue] { return !queue.m_tasks.empty() || m_stopRedoWorkers || m_errorSet; });
+    if (queue.m_tasks.empty() || m_errorSet) {
+        return false;
+    }
+    task = queue.m_tasks.front();
+    queue.m_tasks.pop();
+    lock.unlock();
+    queue.m_spaceCond.notify_one();
+    return true;
+}
+
+void RecoveryManager::OnRedoError(RC status, uint64_t transactionId)
+{
+    MOT_LOG_ERROR("Redo recovery worker failed to replay transaction %lu: %s (error code: %d)",
+        transactionId,
+        RcToString(status),
+        (int)status);
+    {
+        std::lock_guard<std::mutex> lock(m_commitLock);
+        m_errorSet = true;
+        m_commitCond.notify_all();
+    }
+
+    // the dispatcher may wait for room in the queue of this worker, which no longer takes any task
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        std::lock_guard<std::mutex> lock(m_redoQueues[i].m_lock);
+        m_redoQueues[i].m_spaceCond.notify_all();
+    }
+}
+
+void RecoveryManager::RedoRecoveryWorker(RecoveryManager* recoveryManager, uint32_t workerId)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        recoveryManager->OnRedoError(RC_MEMORY_ALLOCATION_ERROR, INVALID_TRANSACTION_ID);
+        engine->OnCurrentThreadEnding();
+        return;
+    }
+    int threadId = MOTCurrThreadId;
+
+    // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetAffinity(threadId)) {
+        MOT_LOG_WARN("Failed to set affinity of redo recovery worker, redo replay performance may be affected");
+    }
+
+    SurrogateState sState;
+    if (sState.IsValid() == false) {
+        recoveryManager->OnRedoError(RC_MEMORY_ALLOCATION_ERROR, INVALID_TRANSACTION_ID);
+    } else {
+        MOT_LOG_DEBUG("RedoRecoveryWorker start [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
+        RedoTask task;
+        while (recoveryManager->GetRedoTask(workerId, task)) {
+            RC status =
+                recoveryManager->RedoTransaction(task.m_segments, task.m_transactionId, sState, task.m_commitSeq);
+            delete task.m_segments;
+            if (status != RC_OK) {
+                recoveryManager->OnRedoError(status, task.m_transactionId);
+                break;
+            }
+        }
+
+        if (sState.IsEmpty() == false) {
+            recoveryManager->AddSurrogateArrayToList(sState);
+        }
+    }
+
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    engine->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("RedoRecoveryWorker end [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
+}
+
+RecoveryManager::LogStats::Entry* RecoveryManager::LogStats::FindEntry(uint64_t tableId)
 {
-    id = m_numEntries;
     std::map<uint64_t, uint64_t>::iterator it;
     std::lock_guard<spin_lock> lock(m_slock);
     it = m_idToIdx.find(tableId);
     if (it == m_idToIdx.end()) {
         Entry* newEntry = new (std::nothrow) Entry(tableId);
         if (newEntry == nullptr) {
-            return false;
+            return nullptr;
         }
         m_tableStats.push_back(newEntry);
         m_idToIdx.insert(std::pair<uint64_t, uint64_t>(tableId, m_numEntries));
         m_numEntries++;
-    } else {
-        id = it->second;
+        return newEntry;
     }
-    return true;
+    return m_tableStats[it->second];
 }
 
 void RecoveryManager::LogStats::Print()
@@ -340,6 +636,14 @@ void RecoveryManager::LogStats::Print()
             m_tableStats[i]->m_deletes.load());
     }
     MOT_LOG_ERROR("Overall tcls: %lu", m_commits.load());
+    MOT_LOG_ERROR("Replayed transactions: %lu parallel, %lu serial, replay time: %lu us",
+        m_parallelTxns.load(),
+        m_serialTxns.load(),
+        CpuCyclesLevelTime::CyclesToMicroseconds(m_replayCycles.load()));
+    MOT_LOG_ERROR("Commit order wait time: %lu us, waits for all workers: %lu, time: %lu us",
+        CpuCyclesLevelTime::CyclesToMicroseconds(m_commitWaitCycles.load()),
+        m_drains.load(),
+        CpuCyclesLevelTime::CyclesToMicroseconds(m_drainCycles.load()));
 }
 
 void RecoveryManager::SetCsn(uint64_t csn)
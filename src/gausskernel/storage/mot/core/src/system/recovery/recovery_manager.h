@@ -25,10 +25,16 @@
 #ifndef RECOVERY_MANAGER_H
 #define RECOVERY_MANAGER_H
 
+#include <atomic>
 #include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "checkpoint_ctrlfile.h"
 #include "redo_log_global.h"
 #include "redo_log_transaction_iterator.h"
+#include "redo_log_transaction_segments.h"
 #include "txn.h"
 #include "global.h"
 #include "mot_configuration.h"
@@ -57,7 +63,12 @@ public:
           m_errorSet(false),
           m_clogCallback(nullptr),
           m_threadId(AllocThreadId()),
-          m_maxConnections(GetGlobalConfiguration().m_maxConnections)
+          m_maxConnections(GetGlobalConfiguration().m_maxConnections),
+          m_numRedoWorkers(GetGlobalConfiguration().m_redoRecoveryWorkers),
+          m_redoQueues(nullptr),
+          m_stopRedoWorkers(false),
+          m_dispatchedSeq(0),
+          m_committedSeq(0)
     {}
 
     ~RecoveryManager() override
@@ -116,6 +127,11 @@ public:
 
     void SetCsn(uint64_t csn) override;
 
+    uint64_t GetMaxRecoveredCsn() const override
+    {
+        return m_maxRecoveredCsn;
+    }
+
     /**
      * @brief adds the surrogate array inside surrogate to the surrogate list
      */
@@ -126,6 +142,13 @@ public:
         return m_errorSet;
     }
 
+    /**
+     * @brief Waits until the transactions already handed to the redo workers are replayed. Unlike
+     * WaitRedoWorkers(), it may be called by another thread while the replay dispatches more transactions.
+     * @return False if a redo worker failed.
+     */
+    bool WaitDispatchedTransactions() override;
+
     /**
      * @brief performs a commit or abort on an in-process transaction
      * @param id the transaction id.
@@ -189,7 +212,15 @@ public:
             uint64_t m_id;
         };
 
-        LogStats() : m_commits(0), m_numEntries(0)
+        LogStats()
+            : m_commits(0),
+              m_parallelTxns(0),
+              m_serialTxns(0),
+              m_replayCycles(0),
+              m_commitWaitCycles(0),
+              m_drains(0),
+              m_drainCycles(0),
+              m_numEntries(0)
         {}
 
         ~LogStats()
@@ -203,25 +234,25 @@ public:
 
         void IncInsert(uint64_t id)
         {
-            uint64_t idx = 0;
-            if (FindIdx(id, idx)) {
-                m_tableStats[idx]->IncInsert();
+            Entry* entry = FindEntry(id);
+            if (entry != nullptr) {
+                entry->IncInsert();
             }
         }
 
         void IncUpdate(uint64_t id)
         {
-            uint64_t idx = 0;
-            if (FindIdx(id, idx)) {
-                m_tableStats[idx]->IncUpdate();
+            Entry* entry = FindEntry(id);
+            if (entry != nullptr) {
+                entry->IncUpdate();
             }
         }
 
         void IncDelete(uint64_t id)
         {
-            uint64_t idx = 0;
-            if (FindIdx(id, idx)) {
-                m_tableStats[idx]->IncDelete();
+            Entry* entry = FindEntry(id);
+            if (entry != nullptr) {
+                entry->IncDelete();
             }
         }
 
@@ -230,6 +261,40 @@ public:
             ++m_commits;
         }
 
+        /**
+         * @brief Accounts for the replay of a single transaction.
+         * @param parallel Specifies whether the transaction was replayed by a redo worker.
+         * @param cycles The CPU cycles spent replaying the transaction.
+         */
+        inline void AddReplay(bool parallel, uint64_t cycles)
+        {
+            if (parallel) {
+                ++m_parallelTxns;
+            } else {
+                ++m_serialTxns;
+            }
+            m_replayCycles += cycles;
+        }
+
+        /**
+         * @brief Accounts for the time a redo worker waited for the commits that precede its own.
+         * @param cycles The CPU cycles spent waiting.
+         */
+        inline void AddCommitWait(uint64_t cycles)
+        {
+            m_commitWaitCycles += cycles;
+        }
+
+        /**
+         * @brief Accounts for the time the redo dispatcher waited for all the redo workers to finish.
+         * @param cycles The CPU cycles spent waiting.
+         */
+        inline void AddDrain(uint64_t cycles)
+        {
+            ++m_drains;
+            m_drainCycles += cycles;
+        }
+
         /**
          * @brief Prints the stats data to the log
          */
@@ -237,13 +302,12 @@ public:
 
     private:
         /**
-         * @brief Returns a table id array index. it will create
+         * @brief Returns the stats entry of a table. it will create
          * a new table entry if necessary.
          * @param tableId The id of the table.
-         * @param id The returned array index.
-         * @return Boolean value denoting success or failure.
+         * @return The table entry, or null if it could not be allocated.
          */
-        bool FindIdx(uint64_t tableId, uint64_t& id);
+        Entry* FindEntry(uint64_t tableId);
 
         std::map<uint64_t, uint64_t> m_idToIdx;
 
@@ -251,6 +315,24 @@ public:
 
         std::atomic<uint64_t> m_commits;
 
+        /** @var Number of transactions replayed by the redo workers. */
+        std::atomic<uint64_t> m_parallelTxns;
+
+        /** @var Number of transactions replayed by the redo dispatcher. */
+        std::atomic<uint64_t> m_serialTxns;
+
+        /** @var CPU cycles spent replaying transactions, including the commit wait. */
+        std::atomic<uint64_t> m_replayCycles;
+
+        /** @var CPU cycles the redo workers spent waiting for the commits that precede their own. */
+        std::atomic<uint64_t> m_commitWaitCycles;
+
+        /** @var Number of times the redo dispatcher waited for all the redo workers to finish. */
+        std::atomic<uint64_t> m_drains;
+
+        /** @var CPU cycles the redo dispatcher spent waiting for all the redo workers to finish. */
+        std::atomic<uint64_t> m_drainCycles;
+
         spin_lock m_slock;
 
         uint64_t m_numEntries;
@@ -261,7 +343,38 @@ public:
     std::map<uint64_t, RecoveryOps::TableInfo*> m_preCommitedTables;
 
 private:
-    static constexpr uint32_t NUM_REDO_RECOVERY_THREADS = 1;
+    /**
+     * @struct RedoTask
+     * @brief A committed transaction queued for replay by a redo worker.
+     */
+    struct RedoTask {
+        /** @var The segments of the transaction, owned by the task. */
+        RedoLogTransactionSegments* m_segments;
+
+        /** @var The internal transaction id. */
+        uint64_t m_transactionId;
+
+        /** @var The position of the transaction commit in the log order (starting at one). */
+        uint64_t m_commitSeq;
+    };
+
+    /**
+     * @struct RedoWorkerQueue
+     * @brief The queue of transactions dispatched to a single redo worker.
+     */
+    struct RedoWorkerQueue {
+        std::mutex m_lock;
+
+        std::condition_variable m_cond;
+
+        /** @var Signaled when the worker takes a task, so the dispatcher may queue another one. */
+        std::condition_variable m_spaceCond;
+
+        std::queue<RedoTask> m_tasks;
+    };
+
+    /** @var The maximum number of transactions queued to a single redo worker. */
+    static constexpr size_t MAX_QUEUED_REDO_TASKS = 1024;
 
     /**
      * @brief performs a redo on a segment, which is either a recovery op
@@ -270,9 +383,96 @@ private:
      * @param csn the segment's csn
      * @param transactionId the transaction id of the segment
      * @param rState the operation to perform on the segment.
+     * @param sState the surrogate state of the replaying thread.
+     * @param commitSeq the position of the transaction commit in the log order, or
+     * zero if the transaction is replayed by the calling thread alone.
+     * @return RC value denoting the operation's status
+     */
+    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState,
+        SurrogateState& sState, uint64_t commitSeq);
+
+    /**
+     * @brief performs a redo on all the segments of a committed transaction.
+     * @param segments the segments of the transaction.
+     * @param transactionId the internal transaction id.
+     * @param sState the surrogate state of the replaying thread.
+     * @param commitSeq the position of the transaction commit in the log order, or zero.
      * @return RC value denoting the operation's status
      */
-    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState);
+    RC RedoTransaction(
+        RedoLogTransactionSegments* segments, uint64_t transactionId, SurrogateState& sState, uint64_t commitSeq);
+
+    /**
+     * @brief Queries whether committed transactions are replayed by the redo workers.
+     */
+    bool IsParallelRedo() const;
+
+    /**
+     * @brief Passes a committed transaction to the redo worker of the table it modifies. Transactions that
+     * modify several tables or change the schema are replayed by the calling thread, after all the
+     * transactions dispatched before them are replayed.
+     * @param internalTransactionId the internal transaction id.
+     * @return Boolean value denoting success or failure.
+     */
+    bool DispatchRecoveredTransaction(uint64_t internalTransactionId);
+
+    /**
+     * @brief Finds the single table modified by a transaction.
+     * @param segments the segments of the transaction.
+     * @param[out] exId the external id of the table.
+     * @return True if the transaction only modifies rows of a single table.
+     */
+    static bool GetSingleTable(RedoLogTransactionSegments* segments, uint64_t& exId);
+
+    /**
+     * @brief Starts the redo workers.
+     * @return Boolean value denoting success or failure.
+     */
+    bool StartRedoWorkers();
+
+    /**
+     * @brief Stops the redo workers and releases the transactions still queued to them.
+     */
+    void StopRedoWorkers();
+
+    /**
+     * @brief Waits until all the transactions dispatched to the redo workers are replayed.
+     * @return False if a redo worker failed.
+     */
+    bool WaitRedoWorkers();
+
+    /**
+     * @brief Waits until all the transactions whose commit precede the given one are committed.
+     * @param commitSeq the position of the transaction commit in the log order.
+     * @return False if a redo worker failed meanwhile.
+     */
+    bool WaitCommitTurn(uint64_t commitSeq);
+
+    /**
+     * @brief Marks a transaction commit as applied and lets the next one proceed.
+     * @param commitSeq the position of the transaction commit in the log order.
+     */
+    void EndCommitTurn(uint64_t commitSeq);
+
+    /**
+     * @brief Retrieves the next transaction of a redo worker.
+     * @param workerId the redo worker id.
+     * @param[out] task the transaction.
+     * @return False if the redo worker should stop.
+     */
+    bool GetRedoTask(uint32_t workerId, RedoTask& task);
+
+    /**
+     * @brief Records a redo worker failure and wakes up all the threads waiting for replay progress.
+     */
+    void OnRedoError(RC status, uint64_t transactionId);
+
+    /**
+     * @brief The redo worker thread function.
+     * @param recoveryManager The recovery manager.
+     * @param workerId The redo worker id.
+     */
+    static void RedoRecoveryWorker(RecoveryManager* recoveryManager, uint32_t workerId);
 
     /**
      * @brief inserts a segment in to the in-process transactions map
@@ -361,7 +561,7 @@ private:
 
     std::list<uint64_t*> m_surrogateList;
 
-    bool m_errorSet;
+    std::atomic<bool> m_errorSet;
 
     CommitLogStatusCallback m_clogCallback;
 
@@ -372,6 +572,30 @@ private:
     uint16_t m_maxConnections;
 
     CheckpointRecovery m_checkpointRecovery;
+
+    /** @var The number of redo workers (one means serial replay). */
+    uint32_t m_numRedoWorkers;
+
+    /** @var The redo worker threads, started on the first dispatched transaction. */
+    std::vector<std::thread> m_redoWorkers;
+
+    /** @var The transaction queue of each redo worker. */
+    RedoWorkerQueue* m_redoQueues;
+
+    /** @var Set when the redo workers should exit. */
+    std::atomic<bool> m_stopRedoWorkers;
+
+    /** @var The commit position of the last transaction dispatched to the redo workers. */
+    std::atomic<uint64_t> m_dispatchedSeq;
+
+    /** @var The commit position of the last transaction committed by the redo workers. */
+    uint64_t m_committedSeq;
+
+    /** @var Guards the commit position. */
+    std::mutex m_commitLock;
+
+    /** @var Signaled when the commit position advances. */
+    std::condition_variable m_commitCond;
 };
 }  // namespace MOT
 
@@ -82,6 +82,50 @@ uint32_t RecoveryOps::RecoverLogOperation(TxnManager* txn, uint8_t* data, uint64
     }
 }
 
+uint32_t RecoveryOps::GetRowOperationTable(uint8_t* data, uint64_t& exId)
+{
+    uint64_t tableId, rowId, rowLength;
+    uint16_t keyLength;
+    uint8_t* start = data;
+
+    OperationCode opCode = *(OperationCode*)data;
+    if (opCode != CREATE_ROW && opCode != UPDATE_ROW && opCode != OVERWRITE_ROW && opCode != REMOVE_ROW) {
+        return 0;
+    }
+    data += sizeof(OperationCode);
+
+    Extract(data, tableId);
+    Extract(data, exId);
+    if (opCode == CREATE_ROW) {
+        Extract(data, rowId);
+    }
+    Extract(data, keyLength);
+    (void)ExtractPtr(data, keyLength);
+    if (opCode == CREATE_ROW || opCode == OVERWRITE_ROW) {
+        Extract(data, rowLength);
+        (void)ExtractPtr(data, rowLength);
+    } else if (opCode == UPDATE_ROW) {
+        // the size of a delta update depends on the columns of the table
+        Table* table = GetTableManager()->GetTableByExternal(exId);
+        if (table == nullptr) {
+            return 0;
+        }
+        uint16_t numColumns = table->GetFieldCount() - 1;
+        BitmapSet updatedColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+        BitmapSet validColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+        BitmapSet::BitmapSetIterator updatedColumnsIt(updatedColumns);
+        BitmapSet::BitmapSetIterator validColumnsIt(validColumns);
+        while (!updatedColumnsIt.End()) {
+            if (updatedColumnsIt.IsSet() && validColumnsIt.IsSet()) {
+                data += table->GetField(updatedColumnsIt.GetPosition() + 1)->m_size;
+            }
+            validColumnsIt.Next();
+            updatedColumnsIt.Next();
+        }
+    }
+    return (uint32_t)(data - start);
+}
+
 uint32_t RecoveryOps::RecoverLogOperationCreateTable(
     TxnManager* txn, uint8_t* data, RC& status, RecoveryOpState state, uint64_t transactionId)
 {
@@ -1047,6 +1091,8 @@ void RecoveryOps::RecoverTwoPhaseCommit(Table* table, OperationCode opCode, uint
             row->m_rowHeader.Release();
         } else if (opCode == REMOVE_ROW) {
             MOT_LOG_DEBUG("recoverTwoPhaseCommit: - remove row [%lu]", transactionId);
+            // the removal bypasses the checkpoint delete journal
+            GetCheckpointManager()->SetTableFullCheckpoint(table->GetTableId());
             if (!table->RemoveRow(row, tid)) {
                 if (MOT_IS_OOM()) {
                     // report error if remove row failed due to OOM (what about other errors?)
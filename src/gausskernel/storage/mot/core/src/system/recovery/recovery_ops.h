@@ -119,6 +119,15 @@ public:
      */
     static RC BeginTransaction(TxnManager* txn, uint64_t replayLsn = 0);
 
+    /**
+     * @brief parses a row operation without recovering it.
+     * @param data the buffer of the operation.
+     * @param[out] exId the external id of the table the operation modifies.
+     * @return Int value denoting the number of bytes of the operation, or 0
+     * if this is not a row operation or its table does not exist.
+     */
+    static uint32_t GetRowOperationTable(uint8_t* data, uint64_t& exId);
+
 private:
     /**
      * @brief performs an insert operation of a data buffer.
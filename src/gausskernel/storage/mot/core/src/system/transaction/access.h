@@ -47,6 +47,7 @@ public:
     {
         m_localInsertRow = nullptr;
         m_auxRow = nullptr;
+        m_versionRow = nullptr;
         m_origSentinel = nullptr;
         m_stmtCount = 0;
         m_params.AssignParams(0);
@@ -80,6 +81,9 @@ public:
     /** @var The auxiliary row */
     Row* m_auxRow = nullptr;
 
+    /** @var Pre-allocated row receiving the replaced version (MVCC snapshot read). */
+    Row* m_versionRow = nullptr;
+
     /** @var The original row header */
     Sentinel* m_origSentinel = nullptr;
 
@@ -102,6 +102,10 @@ Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSenti
         case RC::RC_LOCAL_ROW_FOUND:
             return local_row;
         case RC::RC_LOCAL_ROW_NOT_FOUND:
+            // A snapshot also reads the rows deleted after it was taken, their sentinels are no longer committed
+            if (m_snapshotCsn != CSNManager::INVALID_CSN and type == AccessType::RD) {
+                return m_accessMgr->GetSnapshotRow(originalSentinel, m_snapshotCsn);
+            }
             if (likely(originalSentinel->IsCommited() == true)) {
                 // For Read-Only Txn return the Commited row
                 if (GetTxnIsoLevel() == READ_COMMITED and type == AccessType::RD) {
@@ -162,10 +166,28 @@ RC TxnManager::StartTransaction(uint64_t transactionId, int isolationLevel)
     m_transactionId = transactionId;
     m_isolationLevel = isolationLevel;
     m_state = TxnState::TXN_START;
+    m_accessModeSet = false;
     GcSessionStart();
     return RC_OK;
 }
 
+void TxnManager::SetTxnReadOnly(bool isReadOnly)
+{
+    if (m_accessModeSet) {
+        return;
+    }
+    m_accessModeSet = true;
+
+    // Publish a snapshot older than any commit while the CSN is read, so that writers computing the snapshot
+    // horizon meanwhile do not retire a version this transaction needs
+    if (isReadOnly && GetGlobalConfiguration().m_enableMvccSnapshotRead && !m_isLightSession &&
+        m_gcSession->SetSnapshotCsn(CSNManager::INVALID_CSN + 1)) {
+        __sync_synchronize();
+        m_snapshotCsn = GetCSNManager().GetCurrentCSN();
+        (void)m_gcSession->SetSnapshotCsn(m_snapshotCsn);
+    }
+}
+
 void TxnManager::LiteRollback()
 {
     if (m_txnDdlAccess->Size() > 0) {
@@ -187,6 +209,8 @@ void TxnManager::LiteRollbackPrepared()
 
 void TxnManager::RollbackInternal(bool isPrepared)
 {
+    // Release row versions pre-allocated by a successful validation
+    m_occManager.ReleaseRowVersions(this);
     if (isPrepared) {
         if (GetGlobalConfiguration().m_enableCheckpoint) {
             GetCheckpointManager()->FreePreAllocStableRows(this);
@@ -369,6 +393,11 @@ void TxnManager::Cleanup()
     m_txnDdlAccess->Reset();
     m_checkpointPhase = CheckpointPhase::NONE;
     m_csn = CSNManager::INVALID_CSN;
+    if (m_snapshotCsn != CSNManager::INVALID_CSN) {
+        m_snapshotCsn = CSNManager::INVALID_CSN;
+        (void)m_gcSession->SetSnapshotCsn(CSNManager::INVALID_CSN);
+    }
+    m_accessModeSet = false;
     m_occManager.CleanUp();
     m_err = RC_OK;
     m_errIx = nullptr;
@@ -585,6 +614,10 @@ void TxnManager::CleanDDLChanges()
             case DDL_ACCESS_TRUNCATE_TABLE:
                 indexArr = (MOTIndexArr*)ddl_access->GetEntry();
                 table = indexArr->GetTable();
+                if (GetGlobalConfiguration().m_enableCheckpoint) {
+                    // The truncated rows leave no trace in the delete journal
+                    GetCheckpointManager()->SetTableFullCheckpoint(table->GetTableId());
+                }
                 if (indexArr->GetNumIndexes() > 0) {
                     table->m_rowCount = 0;
                     for (int i = 0; i < indexArr->GetNumIndexes(); i++) {
@@ -661,6 +694,8 @@ TxnManager::TxnManager(SessionContext* session_context)
       m_checkpointPhase(CheckpointPhase::NONE),
       m_checkpointNABit(false),
       m_csn(CSNManager::INVALID_CSN),
+      m_snapshotCsn(CSNManager::INVALID_CSN),
+      m_accessModeSet(false),
       m_transactionId(INVALID_TRANSACTION_ID),
       m_replayLsn(0),
       m_surrogateGen(),
@@ -159,6 +159,15 @@ public:
      */
     RC StartTransaction(uint64_t transactionId, int isolationLevel);
 
+    /**
+     * @brief Retrieves the snapshot CSN of a read-only transaction.
+     * @return The snapshot CSN, or INVALID_CSN if the transaction does not read a snapshot.
+     */
+    inline uint64_t GetSnapshotCSN() const
+    {
+        return m_snapshotCsn;
+    }
+
     /**
      * @brief Performs pre-commit validation (OCC validation).
      * @return Result code denoting success or failure.
@@ -377,6 +386,14 @@ public:
      */
     void SetTxnIsoLevel(int envelopeIsoLevel);
 
+    /**
+     * @brief Sets the access mode of the transaction at each statement. Only the first call of the transaction
+     * counts, since the envelope may change the access mode until its first query. With MVCC snapshot read
+     * enabled, a read-only transaction then reads a CSN snapshot taken here and is never validated.
+     * @param isReadOnly Whether the transaction is read-only.
+     */
+    void SetTxnReadOnly(bool isReadOnly);
+
     inline void IncStmtCount()
     {
         m_internalStmtCount++;
@@ -549,6 +566,12 @@ private:
     /** @var CSN taken at the commit stage. */
     uint64_t m_csn;
 
+    /** @var Snapshot CSN of a read-only transaction (MVCC snapshot read). */
+    uint64_t m_snapshotCsn;
+
+    /** @var Whether the access mode of the transaction was already set by its first statement. */
+    bool m_accessModeSet;
+
     /** @var transaction_id Provided by envelop on start transaction. */
     uint64_t m_transactionId;
 
@@ -699,6 +699,18 @@ Row* TxnAccess::GetReadCommitedRow(Sentinel* sentinel)
     } else
         return nullptr;
 }
+
+Row* TxnAccess::GetSnapshotRow(Sentinel* sentinel, uint64_t snapshotCsn)
+{
+    // Deleted rows keep their primary key until no snapshot reads them, so the sentinel need not be committed.
+    // A sentinel without a row belongs to an insert that is not committed yet.
+    Row* row = sentinel->GetData();
+    if (row == nullptr || row->GetSnapshotRow(snapshotCsn, m_rowZero) != RC::RC_OK) {
+        return nullptr;
+    }
+    return m_rowZero;
+}
+
 RC TxnAccess::GenerateDeletes(Access* element)
 {
     RC rc = RC_OK;
@@ -79,6 +79,14 @@ private:
         MOT::MOTConfiguration& motCfg = MOT::GetGlobalConfiguration();
         startupThreadCount = motCfg.m_checkpointRecoveryWorkers + motCfg.m_chunkPreallocWorkerCount;
         runtimeThreadCount = motCfg.m_checkpointWorkers + 1;  // add one for statistics reporting thread
+        if (motCfg.m_redoRecoveryWorkers > 1) {
+            // redo replay workers keep running on a standby, alongside the user sessions
+            runtimeThreadCount += motCfg.m_redoRecoveryWorkers;
+        }
+        if (motCfg.m_indexBuildWorkers > 1) {
+            // index build workers run on behalf of a session creating an index
+            runtimeThreadCount += motCfg.m_indexBuildWorkers;
+        }
 
         // get the number of threads used to manage user sessions
         sessionThreadCount = 0;
@@ -70,6 +70,7 @@
 #include "postmaster/bgwriter.h"
 #include "storage/lmgr.h"
 #include "storage/ipc.h"
+#include "vecexecutor/vecnodes.h"
 
 #include "mot_internal.h"
 #include "storage/mot/jit_exec.h"
@@ -131,6 +132,7 @@ static ForeignScan* MOTGetForeignPlan(PlannerInfo* root, RelOptInfo* baserel, Oi
 static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es);
 static void MOTBeginForeignScan(ForeignScanState* node, int eflags);
 static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node);
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node);
 static void MOTReScanForeignScan(ForeignScanState* node);
 static void MOTEndForeignScan(ForeignScanState* node);
 static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRte, Relation targetRelation);
@@ -159,6 +161,7 @@ static void MOTVacuumForeignTable(VacuumStmt* stmt, Relation rel);
 static uint64_t MOTGetForeignRelationMemSize(Oid reloid, Oid ixoid);
 static MotMemoryDetail* MOTGetForeignMemSize(uint32_t* nodeCount, bool isGlobal);
 static MotSessionMemoryDetail* MOTGetForeignSessionMemSize(uint32_t* sessionCount);
+static MotTableFragmentationDetail* MOTGetForeignTableFragmentation(uint32_t* tableCount);
 static void MOTNotifyForeignConfigChange();
 
 static void MOTCheckpointCallback(CheckpointEvent checkpointEvent, uint64_t lsn, void* arg);
@@ -318,6 +321,7 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->ExplainForeignScan = MOTExplainForeignScan;
     fdwroutine->BeginForeignScan = MOTBeginForeignScan;
     fdwroutine->IterateForeignScan = MOTIterateForeignScan;
+    fdwroutine->VecIterateForeignScan = MOTVecIterateForeignScan;
     fdwroutine->ReScanForeignScan = MOTReScanForeignScan;
     fdwroutine->EndForeignScan = MOTEndForeignScan;
     fdwroutine->AnalyzeForeignTable = MOTAnalyzeForeignTable;
@@ -337,6 +341,7 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->GetForeignRelationMemSize = MOTGetForeignRelationMemSize;
     fdwroutine->GetForeignMemSize = MOTGetForeignMemSize;
     fdwroutine->GetForeignSessionMemSize = MOTGetForeignSessionMemSize;
+    fdwroutine->GetForeignTableFragmentation = MOTGetForeignTableFragmentation;
     fdwroutine->NotifyForeignConfigChange = MOTNotifyForeignConfigChange;
 
     if (!u_sess->mot_cxt.callbacks_set) {
@@ -806,8 +811,15 @@ static ForeignScan* MOTGetForeignPlan(
     if (tmpLocal != nullptr)
         list_free(tmpLocal);
 
+    // aggregating queries may scan the table in batches in the vector engine (unique key lookups return a single row
+    // anyway); the planner falls back to the row engine if the rest of the plan cannot be vectorized
+    bool vecScan = (root->parse->commandType == CMD_SELECT && root->parse->rowMarks == nullptr &&
+                    (root->parse->hasAggs || root->parse->groupClause != nullptr) &&
+                    !(planstate->m_bestIx != nullptr && planstate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+                        planstate->m_bestIx->m_ix->GetUnique()));
+
     List* quals = planstate->m_localConds;
-    return make_foreignscan(tlist,
+    ForeignScan* fscan = make_foreignscan(tlist,
         quals,
         scanRelid,
         remote, /* no expressions to evaluate */
@@ -819,6 +831,8 @@ static ForeignScan* MOTGetForeignPlan(
         nullptr
 #endif
     );
+    ((Plan*)fscan)->vec_output = vecScan;
+    return fscan;
 }
 
 /*
@@ -900,6 +914,7 @@ static void MOTBeginForeignScan(ForeignScanState* node, int eflags)
             RelationGetRelid(node->ss.ss_currentRelation))
         node->ss.ps.state->es_result_relation_info->ri_FdwState = festate;
     festate->m_currTxn->SetTxnIsoLevel(u_sess->utils_cxt.XactIsoLevel);
+    festate->m_currTxn->SetTxnReadOnly(u_sess->attr.attr_common.XactReadOnly);
 
     foreach (t, node->ss.ps.plan->targetlist) {
         TargetEntry* tle = (TargetEntry*)lfirst(t);
@@ -962,6 +977,7 @@ static void MOTBeginForeignModify(
     festate->m_cmdOper = mtstate->operation;
     MOTAdaptor::GetCmdOper(festate);
     festate->m_currTxn->SetTxnIsoLevel(u_sess->utils_cxt.XactIsoLevel);
+    festate->m_currTxn->SetTxnReadOnly(u_sess->attr.attr_common.XactReadOnly);
 }
 
 static TupleTableSlot* IterateForeignScanStopAtFirst(
@@ -1113,6 +1129,84 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
     }
 }
 
+/*
+ * Fills the scan batch with the projected columns of the next rows, for the vector engine.
+ */
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node)
+{
+    MOT::RC rc = MOT::RC_OK;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    VectorBatch* batch = node->m_pScanBatch;
+
+    batch->Reset(true);
+    if (node->ss.is_scan_end) {
+        return batch;
+    }
+
+    if (!festate->m_cursorOpened) {
+        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
+        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
+        festate->m_econtext = node->ss.ps.ps_ExprContext;
+        CleanCursors(festate);
+        MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
+
+        festate->m_cursorOpened = true;
+    }
+
+    // festate->cursor[1] might be NULL (in case it is not in use)
+    if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
+        (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
+        node->ss.is_scan_end = true;
+        return batch;
+    }
+
+    // numeric values are converted in the scan context, and copied into the batch
+    MemoryContextReset(node->m_scanCxt);
+    MemoryContext oldContext = MemoryContextSwitchTo(node->m_scanCxt);
+    while (batch->m_rows < BatchMaxSize) {
+        if (!festate->m_cursor[0]->IsValid()) {
+            node->ss.is_scan_end = true;
+            break;
+        }
+
+        MOT::Sentinel* Sentinel = festate->m_cursor[0]->GetPrimarySentinel();
+        MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
+        if (currRow == nullptr) {
+            if (rc != MOT::RC_OK) {
+                (void)MemoryContextSwitchTo(oldContext);
+                if (MOT_IS_SEVERE()) {
+                    MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTVecIterateForeignScan", "Failed to lookup row");
+                    MOT_LOG_ERROR_STACK("Failed to lookup row");
+                }
+
+                CleanQueryStatesOnError(festate->m_currTxn);
+                report_pg_error(rc,
+                    (void*)(festate->m_currTxn->m_errIx != nullptr ? festate->m_currTxn->m_errIx->GetName().c_str()
+                                                                   : "unknown"),
+                    (void*)festate->m_currTxn->m_errMsgBuf);
+                return batch;
+            }
+            festate->m_cursor[0]->Next();
+            continue;
+        }
+
+        // check end condition for range search
+        if (MOTAdaptor::IsScanEnd(festate)) {
+            festate->m_cursor[0]->Invalidate();
+            node->ss.is_scan_end = true;
+            break;
+        }
+
+        MOTAdaptor::UnpackRowToBatch(
+            batch, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
+        festate->m_cursor[0]->Next();
+    }
+    (void)MemoryContextSwitchTo(oldContext);
+
+    festate->m_rowsFound += batch->m_rows;
+    return batch;
+}
+
 /*
  *
  */
@@ -1883,18 +1977,24 @@ static void MOTTruncateForeignTable(TruncateStmt* stmt, Relation rel)
 
 static void MOTVacuumForeignTable(VacuumStmt* stmt, Relation rel)
 {
+    // autovacuum compacts only tables whose row memory is fragmented enough, an explicit vacuum always compacts
+    uint32_t thresholdPercent = 0;
     if (stmt->options & VACOPT_AUTOVAC) {
-        elog(LOG,
-            "skipping vacuum table %s, oid: %u, vacuum initiated by autovacuum",
-            NameStr(rel->rd_rel->relname),
-            rel->rd_id);
-        return;
+        MOT::MOTConfiguration& cfg = MOT::GetGlobalConfiguration();
+        if (!cfg.m_enableOnlineCompaction) {
+            elog(LOG,
+                "skipping vacuum table %s, oid: %u, vacuum initiated by autovacuum",
+                NameStr(rel->rd_rel->relname),
+                rel->rd_id);
+            return;
+        }
+        thresholdPercent = cfg.m_compactionThresholdPercent;
     }
     ::TransactionId tid = GetCurrentTransactionId();
 
     PG_TRY();
     {
-        MOTAdaptor::VacuumTable(rel, tid);
+        MOTAdaptor::VacuumTable(rel, tid, thresholdPercent);
     }
     PG_CATCH();
     {
@@ -1919,6 +2019,11 @@ static MotSessionMemoryDetail* MOTGetForeignSessionMemSize(uint32_t* sessionCoun
     return MOTAdaptor::GetSessionMemSize(sessionCount);
 }
 
+static MotTableFragmentationDetail* MOTGetForeignTableFragmentation(uint32_t* tableCount)
+{
+    return MOTAdaptor::GetTableFragmentation(tableCount);
+}
+
 static void MOTNotifyForeignConfigChange()
 {
     MOTAdaptor::NotifyConfigChange();
@@ -2014,6 +2119,33 @@ bool MOTCheckpointExists(
     return true;
 }
 
+bool MOTCheckpointChainDir(int index, char* checkpointDir, size_t checkpointLen)
+{
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    if (engine == nullptr || engine->GetCheckpointManager() == nullptr) {
+        return false;
+    }
+
+    // the last checkpoint in the chain is the current one, which is sent by the caller
+    const std::vector<uint64_t>& chain = engine->GetCheckpointManager()->GetChain();
+    if (index < 0 || (size_t)index + 1 >= chain.size()) {
+        return false;
+    }
+
+    std::string workingDir;
+    std::string dirName;
+    if (!MOT::CheckpointUtils::GetWorkingDir(workingDir) ||
+        !MOT::CheckpointUtils::SetDirName(dirName, chain[(size_t)index])) {
+        ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmodule(MOD_MOT), errmsg("Failed to obtain chain dir")));
+        return false;
+    }
+
+    errno_t rc =
+        snprintf_s(checkpointDir, checkpointLen, checkpointLen - 1, "%s%s", workingDir.c_str(), dirName.c_str());
+    securec_check_ss(rc, "", "");
+    return true;
+}
+
 inline bool IsNotEqualOper(OpExpr* op)
 {
     switch (op->opno) {
@@ -2414,3 +2546,21 @@ uint16_t MOTDateToStr(uintptr_t src, char* destBuf, size_t len)
     securec_check_ss(erc, "\0", "\0");
     return erc;
 }
+
+uint16_t MOTNumericToStr(uintptr_t src, char* destBuf, size_t len)
+{
+    char* tmp = nullptr;
+    Numeric n = MOTAdaptor::MOTNumericToPG((MOT::DecimalSt*)src);
+    tmp = DatumGetCString(DirectFunctionCall1(numeric_out, NumericGetDatum(n)));
+    // numeric values may be longer than the destination buffer, so truncate instead of failing
+    size_t tmpLen = strlen(tmp);
+    if (tmpLen >= len) {
+        tmpLen = len - 1;
+    }
+    errno_t erc = memcpy_s(destBuf, len, tmp, tmpLen);
+    securec_check(erc, "\0", "\0");
+    destBuf[tmpLen] = 0;
+    pfree_ext(tmp);
+    pfree_ext(n);
+    return (uint16_t)tmpLen;
+}
@@ -29,6 +29,7 @@
 #include "global.h"
 #include "postgres.h"
 #include "access/xlog.h"
+#include "access/xloginsert.h"
 #include "mot_fdw_xlog.h"
 #include "mot_engine.h"
 #include "recovery_manager.h"
@@ -78,7 +79,24 @@ void MOTRedo(XLogReaderState* record)
 
 uint64_t XLOGLogger::AddToLog(MOT::RedoLogBuffer** redoLogBufferArray, uint32_t size)
 {
-    return MOT::ILogger::AddToLog(redoLogBufferArray, size);
+    // the buffers of a commit group are registered as they are, as the data chunks of a shared WAL record, so the
+    // group takes a single WAL insertion instead of one per transaction (each buffer starts with its own length, so
+    // recovery splits the record back into transactions)
+    uint64_t written = 0;
+    uint32_t i = 0;
+    while (i < size) {
+        START_CRIT_SECTION();
+        XLogBeginInsert();
+        for (uint32_t chunks = 0; i < size && chunks < XLR_NORMAL_RDATAS; ++chunks, ++i) {
+            uint32_t length;
+            uint8_t* data = redoLogBufferArray[i]->Serialize(&length);
+            XLogRegisterData((char*)data, length);
+            written += length;
+        }
+        XLogInsert(RM_MOT_ID, MOT_REDO_DATA);
+        END_CRIT_SECTION();
+    }
+    return written;
 }
 
 uint64_t XLOGLogger::AddToLog(uint8_t* data, uint32_t size)
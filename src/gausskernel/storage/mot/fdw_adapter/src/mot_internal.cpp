@@ -38,6 +38,7 @@
 #include "parser/parse_type.h"
 #include "utils/syscache.h"
 #include "executor/executor.h"
+#include "vecexecutor/vectorbatch.h"
 #include "storage/ipc.h"
 #include "commands/dbcommands.h"
 #include "knl/knl_session.h"
@@ -909,6 +910,20 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
     } while (0);
 }
 
+static int16 DecimalFieldSize(int32_t typmod)
+{
+    // an unconstrained NUMERIC may use every digit a decimal can hold
+    if (typmod < (int32_t)VARHDRSZ) {
+        return DECIMAL_MAX_SIZE;
+    }
+
+    // otherwise the precision and scale bound the base-10000 digits on each side of the decimal point
+    int32_t precision = ((typmod - VARHDRSZ) >> 16) & 0xffff;
+    int32_t scale = (typmod - VARHDRSZ) & 0xffff;
+    int32_t ndigits = (scale + DEC_DIGITS - 1) / DEC_DIGITS + (precision - scale + DEC_DIGITS - 1) / DEC_DIGITS;
+    return (int16)(sizeof(MOT::DecimalSt) + ndigits * sizeof(NumericDigit));
+}
+
 static void VarLenFieldType(
     Form_pg_type typeDesc, Oid typoid, int32_t colLen, int16* typeLen, bool& isBlob, MOT::RC& res)
 {
@@ -922,7 +937,7 @@ static void VarLenFieldType(
             case 'x':
             case 'm':
                 if (typoid == NUMERICOID) {
-                    *typeLen = DECIMAL_MAX_SIZE;
+                    *typeLen = DecimalFieldSize(colLen);
                     break;
                 }
                 /* fall through */
@@ -1056,8 +1071,17 @@ void MOTAdaptor::ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::Tx
         return;
     }
 
-    if (strcmp(stmt->accessMethod, "btree") != 0) {
-        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
+    if (strcmp(stmt->accessMethod, "btree") != 0 && strcmp(stmt->accessMethod, "hash") != 0) {
+        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE or HASH only")));
+        return;
+    }
+
+    if (stmt->primary && strcmp(stmt->accessMethod, "hash") == 0) {
+        ereport(ERROR,
+            (errmodule(MOD_MOT),
+                errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("Can't create primary index of type HASH"),
+                errdetail("Full table scans are served by the primary index and need a BTREE index")));
         return;
     }
 
@@ -1100,9 +1124,12 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
     MOT::Index* index = nullptr;
     MOT::IndexOrder index_order = MOT::IndexOrder::INDEX_ORDER_SECONDARY;
 
-    // Use the default index tree flavor from configuration file
+    // Use the default index tree flavor from configuration file, hash indexes serve point lookups only
     MOT::IndexingMethod indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
     MOT::IndexTreeFlavor flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
+    if (strcmp(stmt->accessMethod, "hash") == 0) {
+        indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+    }
 
     // check if we have primary and delete previous definition
     if (stmt->primary) {
@@ -1146,14 +1173,23 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
             return MOT::RC_ERROR;
         }
 
-        // Temp solution, we have to support DECIMAL and NUMERIC indexes as well
-        if (col->m_type == MOT::MOT_CATALOG_FIELD_TYPES::MOT_TYPE_DECIMAL) {
+        // DECIMAL and NUMERIC keys are sized by the declared precision, unconstrained columns do not fit in a key
+        if (col->m_type == MOT::MOT_CATALOG_FIELD_TYPES::MOT_TYPE_DECIMAL && col->m_size == DECIMAL_MAX_SIZE) {
             delete index;
             ereport(ERROR,
                 (errmodule(MOD_MOT),
                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                     errmsg("Can't create index on field"),
-                    errdetail("INDEX on NUMERIC or DECIMAL fields not supported yet")));
+                    errdetail("INDEX on NUMERIC or DECIMAL fields requires a declared precision")));
+            return MOT::RC_ERROR;
+        }
+        if (col->m_type == MOT::MOT_CATALOG_FIELD_TYPES::MOT_TYPE_DECIMAL && col->m_keySize > MAX_KEY_SIZE) {
+            delete index;
+            ereport(ERROR,
+                (errmodule(MOD_MOT),
+                    errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                    errmsg("Can't create index on field"),
+                    errdetail("Precision of column %s is too large for an index key", col->m_name)));
             return MOT::RC_ERROR;
         }
         if (col->m_keySize > MAX_KEY_SIZE) {
@@ -1227,51 +1263,6 @@ void MOTAdaptor::AddTableColumns(MOT::Table* table, List *tableElts, bool& hasBl
         }
         hasBlob |= isBlob;
 
-        if (colType == MOT::MOT_CATALOG_FIELD_TYPES::MOT_TYPE_DECIMAL) {
-            if (list_length(colDef->typname->typmods) > 0) {
-                bool canMakeShort = true;
-                int precision = 0;
-                int scale = 0;
-                int count = 0;
-
-                ListCell* c = nullptr;
-                foreach (c, colDef->typname->typmods) {
-                    Node* d = (Node*)lfirst(c);
-                    if (!IsA(d, A_Const)) {
-                        canMakeShort = false;
-                        break;
-                    }
-                    A_Const* ac = (A_Const*)d;
-
-                    if (ac->val.type != T_Integer) {
-                        canMakeShort = false;
-                        break;
-                    }
-
-                    if (count == 0) {
-                        precision = ac->val.val.ival;
-                    } else {
-                        scale = ac->val.val.ival;
-                    }
-
-                    count++;
-                }
-
-                if (canMakeShort) {
-                    int len = 0;
-
-                    len += scale / DEC_DIGITS;
-                    len += (scale % DEC_DIGITS > 0 ? 1 : 0);
-
-                    precision -= scale;
-
-                    len += precision / DEC_DIGITS;
-                    len += (precision % DEC_DIGITS > 0 ? 1 : 0);
-
-                    typeLen = sizeof(MOT::DecimalSt) + len * sizeof(NumericDigit);
-                }
-            }
-        }
         res = table->AddColumn(colDef->colname, typeLen, colType, colDef->is_not_null);
         if (res != MOT::RC_OK) {
             delete table;
@@ -1509,7 +1500,7 @@ MOT::RC MOTAdaptor::TruncateTable(Relation rel, ::TransactionId tid)
     return res;
 }
 
-MOT::RC MOTAdaptor::VacuumTable(Relation rel, ::TransactionId tid)
+MOT::RC MOTAdaptor::VacuumTable(Relation rel, ::TransactionId tid, uint32_t thresholdPercent)
 {
     MOT::RC res = MOT::RC_OK;
     MOT::Table* tab = nullptr;
@@ -1525,7 +1516,7 @@ MOT::RC MOTAdaptor::VacuumTable(Relation rel, ::TransactionId tid)
             break;
         }
 
-        tab->Compact(txn);
+        (void)tab->Compact(txn, thresholdPercent);
         tab->Unlock();
     } while (0);
     return res;
@@ -1639,6 +1630,43 @@ MotSessionMemoryDetail* MOTAdaptor::GetSessionMemSize(uint32_t* sessionCount)
     return result;
 }
 
+MotTableFragmentationDetail* MOTAdaptor::GetTableFragmentation(uint32_t* tableCount)
+{
+    EnsureSafeThreadAccessInline();
+    MotTableFragmentationDetail* result = nullptr;
+    *tableCount = 0;
+
+    // tables are locked while in the list, so they cannot be dropped or truncated
+    std::list<MOT::Table*> tables;
+    uint32_t count = MOT::GetTableManager()->AddTablesToList(tables);
+    if (count > 0) {
+        result = (MotTableFragmentationDetail*)palloc(count * sizeof(MotTableFragmentationDetail));
+    }
+
+    uint32_t index = 0;
+    for (MOT::Table* table : tables) {
+        if (result != nullptr) {
+            MOT::PoolStatsSt stats;
+            table->GetRowPoolStats(stats);
+            MotTableFragmentationDetail* entry = &result[index++];
+            entry->relid = (Oid)table->GetTableExId();
+            errno_t erc = strncpy_s(
+                entry->tableName, NAMEDATALEN, table->GetTableName().c_str(), NAMEDATALEN - 1);
+            securec_check(erc, "\0", "\0");
+            entry->totalSize = stats.m_poolCount * stats.m_poolGrossSize;
+            entry->usedSize = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+            entry->fragmentationPercent =
+                (stats.m_totalObjCount > 0) ? (int32)(stats.m_freeObjCount * 100 / stats.m_totalObjCount) : 0;
+            entry->reclaimedSize = table->GetCompactionReclaimedBytes();
+            entry->compactionCount = table->GetCompactionCount();
+        }
+        table->Unlock();
+    }
+    *tableCount = index;
+
+    return result;
+}
+
 void MOTAdaptor::CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start)
 {
     uint8_t* buf = nullptr;
@@ -1868,6 +1896,55 @@ void MOTAdaptor::UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_
     }
 }
 
+void MOTAdaptor::UnpackRowToBatch(VectorBatch* batch, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow)
+{
+    EnsureSafeThreadAccessInline();
+    int row = batch->m_rows;
+
+    // only the projected columns are unpacked, directly into the column vectors of the batch
+    for (int i = 0; i < batch->m_cols; i++) {
+        ScalarVector* vec = &(batch->m_arr[i]);
+        vec->m_rows++;
+        if (!BITMAP_GET(attrs_used, i) || !BITMAP_GET(srcRow, i)) {
+            vec->SetNull(row);
+            continue;
+        }
+
+        MOT::Column* col = table->GetField(i + 1);
+        size_t len = 0;
+        switch (vec->m_desc.typeId) {
+            case VARCHAROID:
+            case BPCHAROID:
+            case TEXTOID:
+            case CLOBOID:
+            case BYTEAOID: {
+                // build the varlena in the vector buffer, without an intermediate copy
+                uintptr_t tmp;
+                col->Unpack(srcRow, &tmp, len);
+                (void)vec->AddVarCharWithoutHeader((const char*)tmp, (int)len, row);
+                break;
+            }
+            case NUMERICOID: {
+                MOT::DecimalSt* d;
+                col->Unpack(srcRow, (uintptr_t*)&d, len);
+                (void)vec->AddVar(NumericGetDatum(MOTNumericToPG(d)), row);
+                break;
+            }
+            default: {
+                Datum value;
+                col->Unpack(srcRow, &value, len);
+                if (vec->m_desc.encoded) {
+                    (void)vec->AddVar(value, row);
+                } else {
+                    vec->m_vals[row] = value;
+                }
+                break;
+            }
+        }
+    }
+    batch->m_rows++;
+}
+
 // useful functions for data conversion: utils/fmgr/gmgr.cpp
 void MOTAdaptor::MOTToDatum(MOT::Table* table, const Form_pg_attribute attr, uint8_t* data, Datum* value, bool* is_null)
 {
@@ -2029,6 +2106,31 @@ inline void MOTAdaptor::FloatToMOTKey(MOT::Column* col, ExprState* expr, Datum d
 
 inline void MOTAdaptor::NumericToMOTKey(MOT::Column* col, ExprState* expr, Datum datum, uint8_t* data)
 {
+    if (expr != nullptr) {  // LLVM passes nullptr for expr parameter
+        switch (expr->resultType) {
+            case INT1OID:
+                datum = DirectFunctionCall1(int1_numeric, datum);
+                break;
+            case INT2OID:
+                datum = DirectFunctionCall1(int2_numeric, datum);
+                break;
+            case INT4OID:
+                datum = DirectFunctionCall1(int4_numeric, datum);
+                break;
+            case INT8OID:
+                datum = DirectFunctionCall1(int8_numeric, datum);
+                break;
+            case FLOAT4OID:
+                datum = DirectFunctionCall1(float4_numeric, datum);
+                break;
+            case FLOAT8OID:
+                datum = DirectFunctionCall1(float8_numeric, datum);
+                break;
+            default:
+                break;
+        }
+    }
+
     Numeric n = DatumGetNumeric(datum);
     char buf[DECIMAL_MAX_SIZE];
     MOT::DecimalSt* d = (MOT::DecimalSt*)buf;
@@ -90,6 +90,8 @@ class Column;
 class MOTEngine;
 }  // namespace MOT
 
+class VectorBatch;
+
 #ifndef MOTFdwStateSt
 typedef struct MOTFdwState_St MOTFdwStateSt;
 #endif
@@ -204,10 +206,11 @@ public:
     static MOT::RC DropIndex(DropForeignStmt* stmt, TransactionId tid);
     static MOT::RC DropTable(DropForeignStmt* stmt, TransactionId tid);
     static MOT::RC TruncateTable(Relation rel, TransactionId tid);
-    static MOT::RC VacuumTable(Relation rel, TransactionId tid);
+    static MOT::RC VacuumTable(Relation rel, TransactionId tid, uint32_t thresholdPercent = 0);
     static uint64_t GetTableIndexSize(uint64_t tabId, uint64_t ixId);
     static MotMemoryDetail* GetMemSize(uint32_t* nodeCount, bool isGlobal);
     static MotSessionMemoryDetail* GetSessionMemSize(uint32_t* sessionCount);
+    static MotTableFragmentationDetail* GetTableFragmentation(uint32_t* tableCount);
     static MOT::RC ValidateCommit();
     static void RecordCommit(uint64_t csn);
     static MOT::RC Commit(uint64_t csn);  // Does both ValidateCommit and RecordCommit
@@ -269,6 +272,7 @@ public:
     static void PackRow(TupleTableSlot* slot, MOT::Table* table, uint8_t* attrs_used, uint8_t* destRow);
     static void PackUpdateRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* destRow);
     static void UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
+    static void UnpackRowToBatch(VectorBatch* batch, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
 
     // scan helpers
     static void OpenCursor(Relation rel, MOTFdwStateSt* festate);
@@ -27,12 +27,23 @@
 #include "utils/memutils.h"
 
 #include "jit_context_pool.h"
+#include "jit_statistics.h"
 #include "utilities.h"
 #include "mm_global_api.h"
+#include "thread_id.h"
 
 namespace JitExec {
 DECLARE_LOGGER(JitContextPool, JitExec)
 
+// the maximum number of free JIT context objects kept in a per-thread cache of the global pool
+#define JIT_CONTEXT_CACHE_SIZE 4
+
+static bool InitJitContextCaches(JitContextPool* contextPool);
+static void DestroyJitContextCaches(JitContextPool* contextPool);
+static JitContext* PopCachedJitContext(JitContextCache* cache);
+static JitContext* AllocCachedJitContext(JitContextPool* contextPool);
+static bool FreeCachedJitContext(JitContextPool* contextPool, JitContext* jitContext);
+
 extern bool InitJitContextPool(JitContextPool* contextPool, JitContextUsage usage, uint32_t poolSize)
 {
     MOT_ASSERT(contextPool->m_contextPool == nullptr);
@@ -41,6 +52,8 @@ extern bool InitJitContextPool(JitContextPool* contextPool, JitContextUsage usag
     contextPool->m_poolSize = 0;
     contextPool->m_freeContextList = nullptr;
     contextPool->m_freeContextCount = 0;
+    contextPool->m_threadCacheCount = 0;
+    contextPool->m_threadCaches = nullptr;
 
     if (usage == JIT_CONTEXT_GLOBAL) {
         int res = pthread_spin_init(&contextPool->m_lock, 0);
@@ -51,6 +64,11 @@ extern bool InitJitContextPool(JitContextPool* contextPool, JitContextUsage usag
                 "Failed to initialize spin lock for global pool");
             return false;
         }
+
+        if (!InitJitContextCaches(contextPool)) {
+            pthread_spin_destroy(&contextPool->m_lock);
+            return false;
+        }
     }
 
     size_t allocSize = sizeof(JitContext) * poolSize;
@@ -63,6 +81,7 @@ extern bool InitJitContextPool(JitContextPool* contextPool, JitContextUsage usag
             allocSize,
             usage == JIT_CONTEXT_GLOBAL ? "global" : "session-local");
         if (usage == JIT_CONTEXT_GLOBAL) {
+            DestroyJitContextCaches(contextPool);
             pthread_spin_destroy(&contextPool->m_lock);
         }
         return false;
@@ -91,6 +110,7 @@ extern void DestroyJitContextPool(JitContextPool* contextPool)
     MOT::MemGlobalFree(contextPool->m_contextPool);
 
     if (contextPool->m_usage == JIT_CONTEXT_GLOBAL) {
+        DestroyJitContextCaches(contextPool);
         int res = pthread_spin_destroy(&contextPool->m_lock);
         if (res != 0) {
             MOT_REPORT_SYSTEM_ERROR_CODE(res,
@@ -109,7 +129,19 @@ extern void DestroyJitContextPool(JitContextPool* contextPool)
 extern JitContext* AllocPooledJitContext(JitContextPool* contextPool)
 {
     if (contextPool->m_usage == JIT_CONTEXT_GLOBAL) {
-        int res = pthread_spin_lock(&contextPool->m_lock);
+        JitContext* result = AllocCachedJitContext(contextPool);
+        if (result != nullptr) {
+            errno_t erc = memset_s(result, sizeof(JitContext), 0, sizeof(JitContext));
+            securec_check(erc, "\0", "\0");
+            result->m_usage = contextPool->m_usage;
+            return result;
+        }
+
+        int res = pthread_spin_trylock(&contextPool->m_lock);
+        if (res == EBUSY) {
+            JitStatisticsProvider::GetInstance().AddContextPoolContention();
+            res = pthread_spin_lock(&contextPool->m_lock);
+        }
         if (res != 0) {
             MOT_REPORT_SYSTEM_ERROR_CODE(
                 res, pthread_spin_lock, "Global JIT Context Allocation", "Failed to acquire spin lock for global pool");
@@ -140,6 +172,13 @@ extern JitContext* AllocPooledJitContext(JitContextPool* contextPool)
         }
     }
 
+    if ((result == nullptr) && (contextPool->m_usage == JIT_CONTEXT_GLOBAL)) {
+        // the free objects might be held by the caches of other threads
+        for (uint32_t i = 0; (i < contextPool->m_threadCacheCount) && (result == nullptr); ++i) {
+            result = PopCachedJitContext(&contextPool->m_threadCaches[i]);
+        }
+    }
+
     if (result == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_RESOURCE_LIMIT,
             "JIT Context Allocation",
@@ -160,7 +199,15 @@ extern void FreePooledJitContext(JitContextPool* contextPool, JitContext* jitCon
     if (contextPool == nullptr)
         return;
     if (contextPool->m_usage == JIT_CONTEXT_GLOBAL) {
-        int res = pthread_spin_lock(&contextPool->m_lock);
+        if (FreeCachedJitContext(contextPool, jitContext)) {
+            return;
+        }
+
+        int res = pthread_spin_trylock(&contextPool->m_lock);
+        if (res == EBUSY) {
+            JitStatisticsProvider::GetInstance().AddContextPoolContention();
+            res = pthread_spin_lock(&contextPool->m_lock);
+        }
         if (res != 0) {
             MOT_REPORT_SYSTEM_ERROR_CODE(res,
                 pthread_spin_lock,
@@ -188,4 +235,100 @@ extern void FreePooledJitContext(JitContextPool* contextPool, JitContext* jitCon
         }
     }
 }
+
+static bool InitJitContextCaches(JitContextPool* contextPool)
+{
+    uint32_t cacheCount = MOT::GetMaxThreadCount();
+    size_t allocSize = sizeof(JitContextCache) * cacheCount;
+    JitContextCache* caches = (JitContextCache*)MOT::MemGlobalAllocAligned(allocSize, L1_CACHE_LINE);
+    if (caches == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "JIT Context Pool Initialization",
+            "Failed to allocate %u per-thread JIT context caches (%u bytes) for global JIT context pool",
+            cacheCount,
+            (unsigned)allocSize);
+        return false;
+    }
+    errno_t erc = memset_s(caches, allocSize, 0, allocSize);
+    securec_check(erc, "\0", "\0");
+
+    for (uint32_t i = 0; i < cacheCount; ++i) {
+        int res = pthread_spin_init(&caches[i].m_lock, 0);
+        if (res != 0) {
+            MOT_REPORT_SYSTEM_ERROR_CODE(res,
+                pthread_spin_init,
+                "JIT Context Pool Initialization",
+                "Failed to initialize spin lock for per-thread JIT context cache");
+            for (uint32_t j = 0; j < i; ++j) {
+                pthread_spin_destroy(&caches[j].m_lock);
+            }
+            MOT::MemGlobalFree(caches);
+            return false;
+        }
+    }
+
+    contextPool->m_threadCaches = caches;
+    contextPool->m_threadCacheCount = cacheCount;
+    return true;
+}
+
+static void DestroyJitContextCaches(JitContextPool* contextPool)
+{
+    if (contextPool->m_threadCaches == nullptr) {
+        return;
+    }
+
+    // cached objects belong to the pool array, so there is nothing else to release
+    for (uint32_t i = 0; i < contextPool->m_threadCacheCount; ++i) {
+        pthread_spin_destroy(&contextPool->m_threadCaches[i].m_lock);
+    }
+    MOT::MemGlobalFree(contextPool->m_threadCaches);
+    contextPool->m_threadCaches = nullptr;
+    contextPool->m_threadCacheCount = 0;
+}
+
+static JitContext* PopCachedJitContext(JitContextCache* cache)
+{
+    JitContext* result = nullptr;
+    if (cache->m_count > 0) {
+        pthread_spin_lock(&cache->m_lock);
+        result = cache->m_freeContextList;
+        if (result != nullptr) {
+            cache->m_freeContextList = result->m_next;
+            --cache->m_count;
+        }
+        pthread_spin_unlock(&cache->m_lock);
+    }
+    return result;
+}
+
+static JitContext* AllocCachedJitContext(JitContextPool* contextPool)
+{
+    // the cache lock is contended only when another thread steals from a depleted pool
+    MOT::MOTThreadId threadId = MOTCurrThreadId;
+    if (threadId >= contextPool->m_threadCacheCount) {
+        return nullptr;
+    }
+    return PopCachedJitContext(&contextPool->m_threadCaches[threadId]);
+}
+
+static bool FreeCachedJitContext(JitContextPool* contextPool, JitContext* jitContext)
+{
+    MOT::MOTThreadId threadId = MOTCurrThreadId;
+    if (threadId >= contextPool->m_threadCacheCount) {
+        return false;
+    }
+
+    bool result = false;
+    JitContextCache* cache = &contextPool->m_threadCaches[threadId];
+    pthread_spin_lock(&cache->m_lock);
+    if (cache->m_count < JIT_CONTEXT_CACHE_SIZE) {
+        jitContext->m_next = cache->m_freeContextList;
+        cache->m_freeContextList = jitContext;
+        ++cache->m_count;
+        result = true;
+    }
+    pthread_spin_unlock(&cache->m_lock);
+    return result;
+}
 }  // namespace JitExec
@@ -30,6 +30,21 @@
 #include "jit_context.h"
 
 namespace JitExec {
+/** @struct A per-thread cache of free JIT context objects of the global pool. */
+struct __attribute__((packed)) JitContextCache {
+    /** @var A lock to synchronize with threads stealing from the cache when the pool is depleted. */
+    pthread_spinlock_t m_lock;  // L1 offset 0 (4 bytes)
+
+    /** @var The number of cached JIT context objects. */
+    uint32_t m_count;  // L1 offset 4
+
+    /** @var The list of cached JIT context objects. */
+    JitContext* m_freeContextList;  // L1 offset 8
+
+    /** @var Align struct size to cache line. */
+    uint8_t m_padding[48];  // L1 offset 16
+};
+
 /** @struct A pool of JIT context objects. */
 struct __attribute__((packed)) JitContextPool {
     /** @var A lock to synchronize pool access. */
@@ -56,8 +71,14 @@ struct __attribute__((packed)) JitContextPool {
     /** @var The number of free JIT context objects. */
     uint32_t m_freeContextCount;  // L1 offset 24
 
+    /** @var The number of per-thread caches (global pool only). */
+    uint32_t m_threadCacheCount;  // L1 offset 28
+
+    /** @var Per-thread caches of free JIT context objects, avoiding the pool lock (global pool only). */
+    JitContextCache* m_threadCaches;  // L1 offset 32
+
     /** @var Align struct size to 2 cache lines. */
-    uint8_t m_padding3[36];  // align to cache line
+    uint8_t m_padding3[24];  // align to cache line
 };
 
 /**
@@ -278,65 +278,66 @@ extern JitContext* JitCodegenQuery(Query* query, const char* queryString, JitPla
 
     // search for a cached JIT source - either use an existing one or generate a new one
     JitSource* jitSource = nullptr;
-    do {                     // instead of goto
-        LockJitSourceMap();  // jit-source already exists, so wait for it to become ready
+    do {  // instead of goto
         jitSource = GetCachedJitSource(queryString);
-        if (jitSource != nullptr) {
-            MOT_LOG_TRACE("Found a jit-source %p", jitSource);
-            UnlockJitSourceMap();
-
-            // ATTENTION: JIT source cannot get expired at this phase, since DDL statements (that might cause the
-            // JIT Source to expire) cannot run in parallel with other statements
-            // Note: cached context was found, but maybe it is still being compiled, so we wait for it to be ready
-            MOT_LOG_TRACE("Waiting for context to be ready: %s", queryString);
-            JitContextStatus ctxStatus = WaitJitContextReady(jitSource, &jitContext);
-            if (ctxStatus == JIT_CONTEXT_READY) {
-                MOT_LOG_TRACE("Context is ready: %s", queryString);
-            } else if (ctxStatus == JIT_CONTEXT_EXPIRED) {  // need to regenerate context
-                // generate JIT context, install it and notify
-                MOT_LOG_TRACE("Regenerating real JIT code for expired context: %s", queryString);
-                // we must prepare the analysis variables again (because we did not call IsJittable())
-                // in addition, table/index definition might have change so we must re-analyze
-                if (jitPlan != MOT_READY_JIT_PLAN) {
-                    JitDestroyPlan(jitPlan);
-                }
-                jitPlan = IsJittable(query, queryString);
-                if (jitPlan == nullptr) {
-                    MOT_LOG_TRACE("Failed to re-analyze expired JIT source, notifying error status: %s", queryString);
-                    SetJitSourceError(jitSource, MOT_ERROR_INTERNAL);
-                } else {
-                    jitContext = GenerateJitContext(query, queryString, jitPlan, jitSource);
-                }
-            } else {  // code generation (by another session) failed
-                MOT_LOG_TRACE("Cached context status is not ready: %s", queryString);
-                break;  // goto cleanup
-            }
-        } else {                                        // jit-source is not ready, so we need to generate code
+        if (jitSource == nullptr) {                     // jit-source is not ready, so we need to generate code
             MOT_ASSERT(jitPlan != MOT_READY_JIT_PLAN);  // we must have a real plan, right?
             MOT_LOG_TRACE("JIT-source not found, generating code for query: %s", queryString);
-            if (GetJitSourceMapSize() == GetMotCodegenLimit()) {
+            if (GetJitSourceMapSize() >= GetMotCodegenLimit()) {
                 MOT_LOG_DEBUG("Skipping query code generation: Reached total maximum of JIT source objects %d",
                     GetMotCodegenLimit());
-                UnlockJitSourceMap();
                 break;  // goto cleanup
             }
             // we allocate an empty cached entry and install it in the global map, other threads can wait until it
             // is ready (thus only 1 thread regenerates code)
-            jitSource = AllocPooledJitSource(queryString);
-            if (jitSource != nullptr) {
-                MOT_LOG_TRACE("Created jit-source object %p", jitSource);
-                if (!AddCachedJitSource(jitSource)) {  // unexpected: entry already exists (this is a bug)
-                    MOT_LOG_TRACE("Failed to add jit-source object to map");
-                    UnlockJitSourceMap();
-                    FreePooledJitSource(jitSource);
-                    break;  // goto cleanup
-                }
-                UnlockJitSourceMap();  // let other operations continue
-
+            JitSource* newJitSource = AllocPooledJitSource(queryString);
+            if (newJitSource == nullptr) {
+                break;  // goto cleanup
+            }
+            MOT_LOG_TRACE("Created jit-source object %p", newJitSource);
+            jitSource = AddCachedJitSource(newJitSource);
+            if (jitSource == newJitSource) {
                 // generate JIT context, install it and notify
                 MOT_LOG_TRACE("Generating JIT code");
                 jitContext = GenerateJitContext(query, queryString, jitPlan, jitSource);
+                break;  // goto cleanup
+            }
+
+            // either the map is full, or another session installed a jit-source for the same query meanwhile
+            MOT_LOG_TRACE("Failed to add jit-source object to map");
+            FreePooledJitSource(newJitSource);
+            if (jitSource == nullptr) {
+                break;  // goto cleanup
+            }
+        }
+
+        // jit-source already exists, so wait for it to become ready
+        MOT_LOG_TRACE("Found a jit-source %p", jitSource);
+
+        // ATTENTION: JIT source cannot get expired at this phase, since DDL statements (that might cause the
+        // JIT Source to expire) cannot run in parallel with other statements
+        // Note: cached context was found, but maybe it is still being compiled, so we wait for it to be ready
+        MOT_LOG_TRACE("Waiting for context to be ready: %s", queryString);
+        JitContextStatus ctxStatus = WaitJitContextReady(jitSource, &jitContext);
+        if (ctxStatus == JIT_CONTEXT_READY) {
+            MOT_LOG_TRACE("Context is ready: %s", queryString);
+        } else if (ctxStatus == JIT_CONTEXT_EXPIRED) {  // need to regenerate context
+            // generate JIT context, install it and notify
+            MOT_LOG_TRACE("Regenerating real JIT code for expired context: %s", queryString);
+            // we must prepare the analysis variables again (because we did not call IsJittable())
+            // in addition, table/index definition might have change so we must re-analyze
+            if (jitPlan != MOT_READY_JIT_PLAN) {
+                JitDestroyPlan(jitPlan);
+            }
+            jitPlan = IsJittable(query, queryString);
+            if (jitPlan == nullptr) {
+                MOT_LOG_TRACE("Failed to re-analyze expired JIT source, notifying error status: %s", queryString);
+                SetJitSourceError(jitSource, MOT_ERROR_INTERNAL);
+            } else {
+                jitContext = GenerateJitContext(query, queryString, jitPlan, jitSource);
             }
+        } else {  // code generation (by another session) failed
+            MOT_LOG_TRACE("Cached context status is not ready: %s", queryString);
         }
     } while (0);
 
@@ -385,6 +386,7 @@ extern int JitExecQuery(
         JitStatisticsProvider::GetInstance().AddFailExecQuery();
         report_pg_error(MOT::RC_MEMORY_ALLOCATION_ERROR);  // execution control ends, calls ereport(error,...)
     }
+    u_sess->mot_cxt.jit_txn->SetTxnReadOnly(u_sess->attr.attr_common.XactReadOnly);
 
     // during the very first invocation of the query we need to setup the reusable search keys
     // This is also true after TRUNCATE TABLE, in which case we also need to re-fetch all index objects
@@ -540,7 +542,7 @@ extern bool JitInitialize()
         initState = JIT_SRC_POOL_INIT;
 
         // initialize global JIT source map
-        result = InitJitSourceMap();
+        result = InitJitSourceMap(GetMotCodegenLimit());
         if (!result) {
             MOT_REPORT_ERROR(MOT_ERROR_INTERNAL,
                 "JIT Initialization",
@@ -453,7 +453,7 @@ void buildDatumKey(
             value,
             (Oid)value_type,
             key->GetKeyBuf() + offset,
-            column->m_size,
+            size,
             KEY_OPER::READ_KEY_EXACT,
             0x00);
     }
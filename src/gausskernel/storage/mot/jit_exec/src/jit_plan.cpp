@@ -1033,6 +1033,10 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
     size_t alloc_size = sizeof(JitRangeSelectPlan);
 
     for (int index_id = 0; index_id < (int)table->GetNumIndexes(); ++index_id) {
+        if (table->GetIndex(index_id)->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+            MOT_LOG_TRACE("Skipping hash index %d: range scans are not supported", index_id);
+            continue;
+        }
         MOT_LOG_TRACE("Attempting to prepare plan with index %d", index_id);
         JitRangeSelectPlan* next_plan = (JitRangeSelectPlan*)JitPrepareRangeScanPlan(
             query, table, index_id, alloc_size, JIT_COMMAND_SELECT, join_clause_type);
@@ -25,135 +25,253 @@
 #include "global.h"
 #include "jit_source_map.h"
 #include "jit_source_pool.h"
+#include "jit_statistics.h"
 #include "utilities.h"
+#include "cycles.h"
+#include "mm_global_api.h"
 
-#include <map>
+#include <atomic>
 
 namespace JitExec {
 DECLARE_LOGGER(JitSourceMap, JitExec);
 
-// NOTE: Consider using oltp_map
-typedef std::map<std::string, JitSource*> JitSourceMapType;
+/**
+ * @struct A node in a bucket chain of the global JIT source map. Nodes are linked at the head of the chain and are
+ * never unlinked until the map is cleared, so readers traverse the chains without locking.
+ */
+struct JitSourceMapNode {
+    /** @var The next node in the bucket chain. */
+    JitSourceMapNode* volatile m_next;
+
+    /** @var The hash code of the query string. */
+    uint64_t m_hash;
+
+    /** @var The cached JIT source. */
+    JitSource* m_jitSource;
+};
+
+/** @struct A bucket of the global JIT source map. */
+struct JitSourceMapBucket {
+    /** @var Synchronizes writers of the bucket chain. */
+    pthread_spinlock_t m_lock;
+
+    /** @var The head of the bucket chain. */
+    JitSourceMapNode* volatile m_head;
+};
 
 /** @struct Global JIT source map. */
 struct JitSourceMap {
-    /** @var Synchronize global map access. */
-    pthread_mutex_t m_lock;  // 40 bytes
+    /** @var The map buckets. */
+    JitSourceMapBucket* m_buckets;
+
+    /** @var The number of buckets minus one (the number of buckets is a power of two). */
+    uint64_t m_bucketMask;
 
-    /** @var Keep noisy lock in its own cache line. */
-    uint8_t m_padding[24];
+    /** @var The maximum number of cached JIT sources. */
+    uint32_t m_maxSize;
 
     /** @var Initialization flag. */
-    uint64_t m_initialized = 0;
+    uint32_t m_initialized = 0;
+
+    /** @var Keep the noisy size counter in its own cache line. */
+    uint8_t m_padding[40];
 
-    /** @var The JIT source map. */
-    JitSourceMapType m_sourceMap;
+    /** @var The number of cached JIT sources. */
+    std::atomic<uint32_t> m_size;
 };
 
 // Globals
 static JitSourceMap g_jitSourceMap __attribute__((aligned(64)));
 
-extern bool InitJitSourceMap()
+// the minimal number of buckets, the map has at least twice as many buckets as the maximum number of sources
+#define MIN_JIT_SOURCE_MAP_BUCKETS 64
+
+static inline uint64_t HashQueryString(const char* queryString)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char* p = (const unsigned char*)queryString; *p != 0; ++p) {
+        hash = (hash ^ *p) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static JitSource* FindJitSource(const JitSourceMapBucket* bucket, uint64_t hash, const char* queryString)
+{
+    JitSourceMapNode* node = bucket->m_head;
+    while (node != nullptr) {
+        if ((node->m_hash == hash) && (strcmp(node->m_jitSource->_query_string, queryString) == 0)) {
+            return node->m_jitSource;
+        }
+        node = node->m_next;
+    }
+    return nullptr;
+}
+
+extern bool InitJitSourceMap(uint32_t maxSize)
 {
     g_jitSourceMap.m_initialized = 0;
-    int res = pthread_mutex_init(&g_jitSourceMap.m_lock, NULL);
-    if (res != 0) {
-        MOT_REPORT_SYSTEM_ERROR_CODE(
-            res, pthread_mutex_init, "Code Generation", "Failed to create mutex for global jit-source map");
-    } else {
-        g_jitSourceMap.m_initialized = 1;
+    uint64_t bucketCount = MIN_JIT_SOURCE_MAP_BUCKETS;
+    while (bucketCount < 2 * (uint64_t)maxSize) {
+        bucketCount <<= 1;
+    }
+
+    size_t allocSize = sizeof(JitSourceMapBucket) * bucketCount;
+    g_jitSourceMap.m_buckets = (JitSourceMapBucket*)MOT::MemGlobalAllocAligned(allocSize, L1_CACHE_LINE);
+    if (g_jitSourceMap.m_buckets == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Code Generation",
+            "Failed to allocate %u bytes for %" PRIu64 " buckets of global jit-source map",
+            (unsigned)allocSize,
+            bucketCount);
+        return false;
+    }
+
+    for (uint64_t i = 0; i < bucketCount; ++i) {
+        int res = pthread_spin_init(&g_jitSourceMap.m_buckets[i].m_lock, 0);
+        if (res != 0) {
+            MOT_REPORT_SYSTEM_ERROR_CODE(
+                res, pthread_spin_init, "Code Generation", "Failed to create spin lock for global jit-source map");
+            for (uint64_t j = 0; j < i; ++j) {
+                pthread_spin_destroy(&g_jitSourceMap.m_buckets[j].m_lock);
+            }
+            MOT::MemGlobalFree(g_jitSourceMap.m_buckets);
+            g_jitSourceMap.m_buckets = nullptr;
+            return false;
+        }
+        g_jitSourceMap.m_buckets[i].m_head = nullptr;
     }
-    return g_jitSourceMap.m_initialized != 0 ? true : false;
+
+    g_jitSourceMap.m_bucketMask = bucketCount - 1;
+    g_jitSourceMap.m_maxSize = maxSize;
+    g_jitSourceMap.m_size = 0;
+    g_jitSourceMap.m_initialized = 1;
+    return true;
 }
 
 extern void DestroyJitSourceMap()
 {
     if (g_jitSourceMap.m_initialized) {
         ClearJitSourceMap();
-        pthread_mutex_destroy(&g_jitSourceMap.m_lock);
+        for (uint64_t i = 0; i <= g_jitSourceMap.m_bucketMask; ++i) {
+            pthread_spin_destroy(&g_jitSourceMap.m_buckets[i].m_lock);
+        }
+        MOT::MemGlobalFree(g_jitSourceMap.m_buckets);
+        g_jitSourceMap.m_buckets = nullptr;
         g_jitSourceMap.m_initialized = 0;
     }
 }
 
 extern void ClearJitSourceMap()
 {
+    // called only when no other thread accesses the map
     MOT_LOG_TRACE("Clearing global jit-source map");
-    JitSourceMapType::iterator itr = g_jitSourceMap.m_sourceMap.begin();
-    while (itr != g_jitSourceMap.m_sourceMap.end()) {
-        JitSource* jitSource = itr->second;
-        FreePooledJitSource(jitSource);
-        itr = g_jitSourceMap.m_sourceMap.erase(itr);
+    for (uint64_t i = 0; i <= g_jitSourceMap.m_bucketMask; ++i) {
+        JitSourceMapNode* node = g_jitSourceMap.m_buckets[i].m_head;
+        while (node != nullptr) {
+            JitSourceMapNode* next = node->m_next;
+            FreePooledJitSource(node->m_jitSource);
+            MOT::MemGlobalFree(node);
+            node = next;
+        }
+        g_jitSourceMap.m_buckets[i].m_head = nullptr;
     }
-}
-
-extern void LockJitSourceMap()
-{
-    pthread_mutex_lock(&g_jitSourceMap.m_lock);
-}
-
-extern void UnlockJitSourceMap()
-{
-    pthread_mutex_unlock(&g_jitSourceMap.m_lock);
+    g_jitSourceMap.m_size = 0;
 }
 
 extern uint32_t GetJitSourceMapSize()
 {
-    return g_jitSourceMap.m_sourceMap.size();
+    return g_jitSourceMap.m_size.load(std::memory_order_relaxed);
 }
 
 extern JitSource* GetCachedJitSource(const char* queryString)
 {
-    JitSource* result = NULL;
-    JitSourceMapType::iterator itr = g_jitSourceMap.m_sourceMap.find(queryString);
-    if (itr != g_jitSourceMap.m_sourceMap.end()) {
-        result = itr->second;
-    }
+    uint64_t startTime = GetSysClock();
+    uint64_t hash = HashQueryString(queryString);
+    JitSource* result = FindJitSource(&g_jitSourceMap.m_buckets[hash & g_jitSourceMap.m_bucketMask], hash, queryString);
+    JitStatisticsProvider::GetInstance().AddSourceLookupTime(
+        MOT::CpuCyclesLevelTime::CyclesToNanoseconds(GetSysClock() - startTime));
     return result;
 }
 
-extern bool AddCachedJitSource(JitSource* cachedJitSource)
+extern JitSource* AddCachedJitSource(JitSource* cachedJitSource)
 {
-    MOT_LOG_TRACE("Inserting JIT source %p to global source map on query string: %s",
-        cachedJitSource,
-        cachedJitSource->_query_string);
-    char* queryString = cachedJitSource->_query_string;  // required due to compiler error
-    return g_jitSourceMap.m_sourceMap.insert(JitSourceMapType::value_type(queryString, cachedJitSource)).second;
+    const char* queryString = cachedJitSource->_query_string;
+    uint64_t hash = HashQueryString(queryString);
+    JitSourceMapBucket* bucket = &g_jitSourceMap.m_buckets[hash & g_jitSourceMap.m_bucketMask];
+
+    // reserve room for the new source
+    if (g_jitSourceMap.m_size.fetch_add(1) >= g_jitSourceMap.m_maxSize) {
+        g_jitSourceMap.m_size.fetch_sub(1);
+        return nullptr;
+    }
+
+    JitSourceMapNode* node = (JitSourceMapNode*)MOT::MemGlobalAlloc(sizeof(JitSourceMapNode));
+    if (node == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Code Generation",
+            "Failed to allocate %u bytes for jit-source map node",
+            (unsigned)sizeof(JitSourceMapNode));
+        g_jitSourceMap.m_size.fetch_sub(1);
+        return nullptr;
+    }
+    node->m_hash = hash;
+    node->m_jitSource = cachedJitSource;
+
+    if (pthread_spin_trylock(&bucket->m_lock) != 0) {
+        JitStatisticsProvider::GetInstance().AddSourceMapContention();
+        pthread_spin_lock(&bucket->m_lock);
+    }
+
+    // another session might have added a source for the same query since the caller searched for it
+    JitSource* result = FindJitSource(bucket, hash, queryString);
+    if (result == nullptr) {
+        MOT_LOG_TRACE("Inserting JIT source %p to global source map on query string: %s", cachedJitSource, queryString);
+        node->m_next = bucket->m_head;
+        COMPILER_BARRIER
+        bucket->m_head = node;
+        result = cachedJitSource;
+    }
+    pthread_spin_unlock(&bucket->m_lock);
+
+    if (result != cachedJitSource) {
+        MOT::MemGlobalFree(node);
+        g_jitSourceMap.m_size.fetch_sub(1);
+    }
+    return result;
 }
 
 extern bool ContainsReadyCachedJitSource(const char* queryString)
 {
     bool result = false;
-    LockJitSourceMap();
-    JitSourceMapType::iterator itr = g_jitSourceMap.m_sourceMap.find(queryString);
-    if (itr != g_jitSourceMap.m_sourceMap.end()) {
-        JitSource* jitSource = itr->second;
+    JitSource* jitSource = GetCachedJitSource(queryString);
+    if (jitSource != nullptr) {
         if ((jitSource->_status == JIT_CONTEXT_READY) && (jitSource->_source_jit_context != NULL)) {
             result = true;
         }
     }
-    UnlockJitSourceMap();
     return result;
 }
 
 extern void PurgeJitSourceMap(uint64_t relationId, bool purgeOnly)
 {
-    LockJitSourceMap();
-    JitSourceMapType::iterator itr = g_jitSourceMap.m_sourceMap.begin();
-    while (itr != g_jitSourceMap.m_sourceMap.end()) {
-        JitSource* jitSource = itr->second;
-        if (JitSourceRefersRelation(jitSource, relationId)) {
-            MOT_LOG_TRACE("Purging cached jit-source %p by relation id %" PRIu64 " with query: %s",
-                jitSource,
-                relationId,
-                jitSource->_query_string);
-            if (purgeOnly) {
-                PurgeJitSource(jitSource, relationId);
-            } else {
-                SetJitSourceExpired(jitSource, relationId);  // (containing jit-source deleted during db shutdown)
+    for (uint64_t i = 0; i <= g_jitSourceMap.m_bucketMask; ++i) {
+        JitSourceMapNode* node = g_jitSourceMap.m_buckets[i].m_head;
+        while (node != nullptr) {
+            JitSource* jitSource = node->m_jitSource;
+            if (JitSourceRefersRelation(jitSource, relationId)) {
+                MOT_LOG_TRACE("Purging cached jit-source %p by relation id %" PRIu64 " with query: %s",
+                    jitSource,
+                    relationId,
+                    jitSource->_query_string);
+                if (purgeOnly) {
+                    PurgeJitSource(jitSource, relationId);
+                } else {
+                    SetJitSourceExpired(jitSource, relationId);  // (containing jit-source deleted during db shutdown)
+                }
             }
+            node = node->m_next;
         }
-        ++itr;
     }
-    UnlockJitSourceMap();
 }
 }  // namespace JitExec
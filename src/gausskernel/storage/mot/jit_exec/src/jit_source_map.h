@@ -30,9 +30,10 @@
 namespace JitExec {
 /**
  * @brief Initializes the global JIT source map.
+ * @param maxSize The maximum number of cached JIT sources.
  * @return True if initialization succeeded, otherwise false.
  */
-extern bool InitJitSourceMap();
+extern bool InitJitSourceMap(uint32_t maxSize);
 
 /** @brief Destroys the global JIT source map. */
 extern void DestroyJitSourceMap();
@@ -40,33 +41,26 @@ extern void DestroyJitSourceMap();
 /** @brief Clears all entries in the global JIT source map, and releases all associated resources. */
 extern void ClearJitSourceMap();
 
-/**
- * @brief Locks the global JIT source map for synchronized access.
- */
-extern void LockJitSourceMap();
-
-/**
- * @brief Unlocks the global JIT source map for synchronized access.
- */
-extern void UnlockJitSourceMap();
-
 /**
  * @brief Retrieves the umber of cached jit-source objects in the global JIT source map. */
 extern uint32_t GetJitSourceMapSize();
 
 /**
- * @brief Retrieves a cached jit-source by its query string (not thread safe).
+ * @brief Retrieves a cached jit-source by its query string (thread safe, does not lock).
  * @param queryString The query string to search.
  * @return The cached JIT source or NULL if none was found or an error occurred.
  */
 extern JitSource* GetCachedJitSource(const char* queryString);
 
 /**
- * @brief Adds a new JIT source to the cached source map (not thread safe).
+ * @brief Adds a new JIT source to the cached source map, unless a source for the same query was already added
+ * (thread safe).
  * @param cachedJitSource The cached JIT source to add. This object is expected to be empty, and serves
  * as a temporary stub until JIT code is fully generated. Other threads can wait for the source to be ready.
+ * @return The given JIT source if it was added, the JIT source already cached for the same query, or NULL if the map
+ * is full or an error occurred.
  */
-extern bool AddCachedJitSource(JitSource* cachedJitSource);
+extern JitSource* AddCachedJitSource(JitSource* cachedJitSource);
 
 /**
  * @brief Queries whether a ready cached jit-source exists for the given query string (thread safe).
@@ -36,12 +36,18 @@ JitThreadStatistics::JitThreadStatistics(uint64_t threadId, void* inplaceBuffer)
       m_execQueryCount(MakeName("jit-exec", threadId).c_str()),
       m_invokeQueryCount(MakeName("jit-invoke", threadId).c_str()),
       m_execFailQueryCount(MakeName("jit-exec-fail", threadId).c_str()),
-      m_execAbortQueryCount(MakeName("jit-exec-abort", threadId).c_str())
+      m_execAbortQueryCount(MakeName("jit-exec-abort", threadId).c_str()),
+      m_sourceLookupTime(MakeName("jit-source-lookup-time", threadId).c_str(), 1, "nanos"),
+      m_sourceMapContentionCount(MakeName("jit-source-map-contention", threadId).c_str()),
+      m_contextPoolContentionCount(MakeName("jit-context-pool-contention", threadId).c_str())
 {
     RegisterStatistics(&m_execQueryCount);
     RegisterStatistics(&m_invokeQueryCount);
     RegisterStatistics(&m_execFailQueryCount);
     RegisterStatistics(&m_execAbortQueryCount);
+    RegisterStatistics(&m_sourceLookupTime);
+    RegisterStatistics(&m_sourceMapContentionCount);
+    RegisterStatistics(&m_contextPoolContentionCount);
 }
 
 JitGlobalStatistics::JitGlobalStatistics(GlobalStatistics::NamingScheme namingScheme)
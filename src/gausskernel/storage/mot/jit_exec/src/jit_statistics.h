@@ -73,6 +73,24 @@ public:
         m_execAbortQueryCount.AddSample();
     }
 
+    /** @brief Updates the JIT source map lookup time statistics. */
+    inline void AddSourceLookupTime(uint64_t nanos)
+    {
+        m_sourceLookupTime.AddSample(nanos);
+    }
+
+    /** @brief Updates the JIT source map contention count statistics. */
+    inline void AddSourceMapContention()
+    {
+        m_sourceMapContentionCount.AddSample();
+    }
+
+    /** @brief Updates the global JIT context pool contention count statistics. */
+    inline void AddContextPoolContention()
+    {
+        m_contextPoolContentionCount.AddSample();
+    }
+
 private:
     /** @var The successful JIT query execution count statistic variable. */
     MOT::FrequencyStatisticVariable m_execQueryCount;
@@ -85,6 +103,15 @@ private:
 
     /** @var The aborted JIT query execution count statistic variable. */
     MOT::FrequencyStatisticVariable m_execAbortQueryCount;
+
+    /** @var The JIT source map lookup time statistic variable. */
+    MOT::NumericStatisticVariable m_sourceLookupTime;
+
+    /** @var The count of insertions into the JIT source map that waited for a bucket lock. */
+    MOT::FrequencyStatisticVariable m_sourceMapContentionCount;
+
+    /** @var The count of global JIT context pool accesses that waited for the pool lock. */
+    MOT::FrequencyStatisticVariable m_contextPoolContentionCount;
 };
 
 class JitGlobalStatistics : public MOT::GlobalStatistics {
@@ -298,6 +325,33 @@ public:
         }
     }
 
+    /** @brief Records a JIT source map lookup. */
+    inline void AddSourceLookupTime(uint64_t nanos)
+    {
+        JitThreadStatistics* jts = GetCurrentThreadStatistics<JitThreadStatistics>();
+        if (jts != nullptr) {
+            jts->AddSourceLookupTime(nanos);
+        }
+    }
+
+    /** @brief Records a JIT source map insertion that waited for a bucket lock. */
+    inline void AddSourceMapContention()
+    {
+        JitThreadStatistics* jts = GetCurrentThreadStatistics<JitThreadStatistics>();
+        if (jts != nullptr) {
+            jts->AddSourceMapContention();
+        }
+    }
+
+    /** @brief Records a global JIT context pool access that waited for the pool lock. */
+    inline void AddContextPoolContention()
+    {
+        JitThreadStatistics* jts = GetCurrentThreadStatistics<JitThreadStatistics>();
+        if (jts != nullptr) {
+            jts->AddContextPoolContention();
+        }
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
@@ -607,6 +607,11 @@ void PerformMotCheckpointFetch()
         /* send the checkpoint dir */
         sendDir(fullChkptDir, (int)basePathLen, false, NIL, false);
 
+        /* send the checkpoints that a delta checkpoint depends on */
+        for (int i = 0; MOTCheckpointChainDir(i, fullChkptDir, MAXPGPATH); i++) {
+            sendDir(fullChkptDir, (int)basePathLen, false, NIL, false);
+        }
+
         /* CopyDone */
         pq_putemptymessage_noblock('c');
     }
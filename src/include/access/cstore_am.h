@@ -159,6 +159,9 @@ public:
     bool IsLateRead(int id) const;
     void ResetLateRead();
 
+    // position of a relation column in the accessed columns, -1 if not accessed
+    int GetColumnSeq(int colIdx) const;
+
     // update cstore scan timing flag
     void SetTiming(CStoreScanState *state);
 
@@ -273,6 +276,7 @@ private:  // private methods.
     bool NeedLoadCUDesc(int32 &cudesc_idx);
     void IncLoadCuDescIdx(int &idx) const;
     bool RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx);
+    bool RuntimeFilterRoughCheck(CStoreScanState *state, int cuDescIdx);
 
     void FillColMinMax(CUDesc *cuDescPtr, ScalarVector *vec, int pos);
 
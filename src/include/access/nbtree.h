@@ -140,6 +140,9 @@ typedef struct BTMetaPageData {
 #define BTREE_DEFAULT_FILLFACTOR 90
 #define BTREE_NONLEAF_FILLFACTOR 70
 
+/* upper limit of the parallel_workers option, see tuplesort_begin_index_btree */
+#define BTREE_MAX_SORT_WORKERS 32
+
 /*
  *	Test whether two btree entries are "the same".
  *
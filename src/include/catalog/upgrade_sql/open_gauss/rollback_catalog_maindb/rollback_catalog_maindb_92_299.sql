@@ -0,0 +1 @@
+DROP FUNCTION IF EXISTS pg_catalog.mot_table_fragmentation_detail() CASCADE;
@@ -0,0 +1,3 @@
+DROP FUNCTION IF EXISTS pg_catalog.mot_table_fragmentation_detail() CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 6205;
+CREATE FUNCTION pg_catalog.mot_table_fragmentation_detail(OUT relid oid, OUT table_name text, OUT total_size int8, OUT used_size int8, OUT fragmentation_percent int4, OUT reclaimed_size int8, OUT compaction_count int8) RETURNS SETOF record LANGUAGE INTERNAL STABLE ROWS 100 as 'mot_table_fragmentation_detail';
@@ -185,6 +185,7 @@ extern TupleHashEntry LookupTupleHashEntry(
     TupleHashTable hashtable, TupleTableSlot* slot, bool* isnew, bool isinserthashtbl = true);
 extern TupleHashEntry FindTupleHashEntry(
     TupleHashTable hashtable, TupleTableSlot* slot, FmgrInfo* eqfunctions, FmgrInfo* hashfunctions);
+extern void RemoveTupleHashEntry(TupleHashTable hashtable, TupleTableSlot* slot);
 
 /*
  * prototypes from functions in execJunk.c
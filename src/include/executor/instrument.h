@@ -111,6 +111,7 @@ typedef struct SortHashInfo {
     bool hash_writefile;
     int hash_spillNum;
     int hashtable_expand_times;
+    int64 sort_groups; /* number of batches sorted by an incremental sort */
     double hashbuild_time;
     double hashagg_time;
     long spill_size;      /* Totoal disk IO */
@@ -158,6 +159,8 @@ typedef struct RoughCheckInfo {
     uint64 m_CUFull;
     uint64 m_CUNone;
     uint64 m_CUSome;
+    uint64 m_lateReadRows; /* rows whose late read columns were filled */
+    uint64 m_lateSkipRows; /* rows filtered by the qual before the late read */
 
     inline void IncFullCUNum()
     {
@@ -171,6 +174,11 @@ typedef struct RoughCheckInfo {
     {
         ++m_CUSome;
     }
+    inline void AddLateReadRows(uint64 readRows, uint64 skipRows)
+    {
+        m_lateReadRows += readRows;
+        m_lateSkipRows += skipRows;
+    }
 
 } RCInfo;
 
@@ -227,6 +235,14 @@ typedef struct RecursiveInfo {
     bool has_reach_limit;
 } RecursiveInfo;
 
+typedef struct MemoizeInfo {
+    int64 hits;       /* lookups finding a complete cache entry */
+    int64 misses;     /* lookups running the subplan */
+    int64 evictions;  /* entries evicted to free memory */
+    int64 overflows;  /* entries too large to be cached */
+    int64 spacePeak;  /* peak memory of the cache in bytes */
+} MemoizeInfo;
+
 typedef struct Instrumentation {
     /* Parameters set at node creation: */
     bool need_timer;    /* TRUE if we need timer data */
@@ -319,6 +335,7 @@ typedef struct Instrumentation {
     int ec_libodbc_type;                       /* ec execute libodbc_type*/
     int64 ec_fetch_count;                      /* ec fetch count*/
     RecursiveInfo recursiveInfo;
+    MemoizeInfo memoizeinfo;
 } Instrumentation;
 
 /* instrumentation data */
@@ -45,6 +45,21 @@
 #define HASH_MIN_FILENUMBER 48
 #define HASH_MAX_FILENUMBER 512
 
+/* bits of the hash value used to pick spill files, over all spill levels */
+#define HASH_SPILL_HASH_BITS 32
+
+/*
+ * Spill files of one hash agg pass, aggregated one file after another
+ * once the pass has returned its in-memory groups.
+ */
+typedef struct AggSpillSet {
+    hashFileSource* source; /* the spill files */
+    int filenum;            /* number of files in source */
+    int curfile;            /* file being aggregated, -1 before the first */
+    int hashShift;          /* hash bits consumed by the levels above this one */
+    int depth;              /* 0 for the files spilled by the outer input */
+} AggSpillSet;
+
 typedef struct AggWriteFileControl {
     bool spillToDisk; /*whether data write to temp file*/
     bool finishwrite;
@@ -59,6 +74,10 @@ typedef struct AggWriteFileControl {
     int curfile;
     int64 maxMem;  /* mem spread memory, in bytes */
     int spreadNum; /* dynamic spread time */
+    List* spillSets;  /* stack of AggSpillSet still to be aggregated, only used by hash agg */
+    int hashShift;    /* hash bits consumed by the spill levels above the current pass */
+    int spillDepth;   /* spill level of the current pass */
+    int64 passGroups; /* most groups the current pass can see, to size its spill files */
 } AggWriteFileControl;
 
 /*
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * nodeIncrementalSort.h
+ *
+ *
+ *
+ * IDENTIFICATION
+ *        src/include/executor/nodeIncrementalSort.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef NODEINCREMENTALSORT_H
+#define NODEINCREMENTALSORT_H
+
+#include "nodes/execnodes.h"
+
+/* fewest tuples sorted in one batch, also assumed by cost_incremental_sort */
+#define INCSORT_MIN_GROUP_SIZE 32
+
+extern IncrementalSortState* ExecInitIncrementalSort(IncrementalSort* node, EState* estate, int eflags);
+extern TupleTableSlot* ExecIncrementalSort(IncrementalSortState* node);
+extern void ExecEndIncrementalSort(IncrementalSortState* node);
+extern void ExecReScanIncrementalSort(IncrementalSortState* node);
+
+#endif /* NODEINCREMENTALSORT_H */
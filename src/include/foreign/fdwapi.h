@@ -99,6 +99,7 @@ typedef void (*VacuumForeignTable_function)(VacuumStmt* stmt, Relation rel);
 typedef uint64_t (*GetForeignRelationMemSize_function)(Oid reloid, Oid ixoid);
 typedef MotMemoryDetail* (*GetForeignMemSize_function)(uint32* nodeCount, bool isGlobal);
 typedef MotSessionMemoryDetail* (*GetForeignSessionMemSize_function)(uint32* sessionCount);
+typedef MotTableFragmentationDetail* (*GetForeignTableFragmentation_function)(uint32* tableCount);
 typedef void (*NotifyForeignConfigChange_function)();
 
 typedef enum {
@@ -193,6 +194,9 @@ typedef struct FdwRoutine {
     /* Get all session memory size */
     GetForeignSessionMemSize_function GetForeignSessionMemSize;
 
+    /* Get memory fragmentation of all tables */
+    GetForeignTableFragmentation_function GetForeignTableFragmentation;
+
     /* Notify engine that envelope configuration changed */
     NotifyForeignConfigChange_function NotifyForeignConfigChange;
 } FdwRoutine;
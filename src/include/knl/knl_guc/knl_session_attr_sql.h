@@ -48,6 +48,7 @@ typedef struct knl_session_attr_sql {
     bool enable_valuepartition_pruning;
     bool enable_constraint_optimization;
     bool enable_bloom_filter;
+    bool enable_cstore_bloom_filter;
     bool enable_codegen;
     bool enable_codegen_print;
     bool enable_sonic_optspill;
@@ -64,9 +65,12 @@ typedef struct knl_session_attr_sql {
     bool enable_parallel_ddl;
     bool enable_tidscan;
     bool enable_sort;
+    bool enable_incremental_sort;
     bool enable_compress_spill;
+    bool enable_compress_sort_tape;
     bool enable_hashagg;
     bool enable_material;
+    bool enable_memoize;
     bool enable_nestloop;
     bool enable_mergejoin;
     bool enable_hashjoin;
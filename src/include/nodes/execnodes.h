@@ -878,6 +878,7 @@ typedef struct ScalarArrayOpExprState {
     bool typbyval;
     char typalign;
     bool* pSel; /* selection used to fast path of ALL/ANY */
+    bool vecMemo; /* vector results can be reused for equal arguments, see VarMemo */
     ScalarVector *tmpVecLeft;
     ScalarVector *tmpVecRight;
     ScalarVector* tmpVec;
@@ -1220,6 +1221,7 @@ typedef struct PlanState {
     bool ps_TupFromTlist;               /* state flag for processing set-valued functions in targetlist */
 
     bool vectorized;  // is vectorized?
+    bool vecAcceptSel; /* parent honors the selection vector of my result batches */
 
     MemoryContext nodeContext; /* Memory Context for this Node */
 
@@ -2112,6 +2114,44 @@ typedef struct MaterialState {
     Tuplestorestate* tuplestorestate;
 } MaterialState;
 
+/* ----------------
+ *	 MemoizeState information
+ *
+ *		memoize nodes cache the output of their parameterized subplan in a
+ *		hash table keyed by the parameter values.  Entries are evicted in
+ *		least recently used order when the cache outgrows its memory.
+ * ----------------
+ */
+struct MemoizeEntry;
+struct MemoizeTuple;
+
+typedef struct MemoizeState {
+    ScanState ss;                    /* its first field is NodeTag */
+    int mstatus;                     /* state of the ExecMemoize state machine */
+    int nkeys;                       /* number of cache keys */
+    List* param_exprs;               /* ExprStates of the cache keys */
+    TupleHashTable hashtable;        /* the cache, one entry per key */
+    TupleTableSlot* probeslot;       /* virtual slot holding the current key */
+    TupleTableSlot* evictslot;       /* slot used to look up entries to evict */
+    AttrNumber* keyColIdx;           /* key columns of probeslot, 1..nkeys */
+    FmgrInfo* eqfunctions;           /* equality functions of the keys */
+    FmgrInfo* hashfunctions;         /* hash functions of the keys */
+    MemoryContext tableContext;      /* memory of the cache entries */
+    MemoryContext tempContext;       /* short term memory of hash lookups */
+    struct MemoizeEntry* lru_head;   /* least recently used entry */
+    struct MemoizeEntry* lru_tail;   /* most recently used entry */
+    struct MemoizeEntry* entry;      /* entry being filled or returned */
+    struct MemoizeTuple* last_tuple; /* last tuple returned from entry */
+    Bitmapset* keyparamids;          /* PARAM_EXEC params used in the keys */
+    int64 mem_used;                  /* bytes used by the cache entries */
+    int64 mem_limit;                 /* bytes the cache may use */
+    int64 mem_peak;                  /* peak of mem_used */
+    int64 hits;                      /* lookups finding a complete entry */
+    int64 misses;                    /* lookups running the subplan */
+    int64 evictions;                 /* entries evicted to free memory */
+    int64 overflows;                 /* entries too large to be cached */
+} MemoizeState;
+
 /* ----------------
  *	 SortState information
  * ----------------
@@ -2132,6 +2172,31 @@ typedef struct SortState {
     int64* space_size;    /* spill size for temp table */
 } SortState;
 
+/* ----------------
+ *	 IncrementalSortState information
+ *
+ *		the input arrives sorted on the presorted columns.  Tuples are
+ *		collected in batches ending on a change of those columns, and each
+ *		batch is sorted on all the sort columns and returned on its own.
+ * ----------------
+ */
+typedef struct IncrementalSortState {
+    ScanState ss;                    /* its first field is NodeTag */
+    bool bounded;                    /* is the result set bounded? */
+    int64 bound;                     /* if bounded, how many tuples are needed */
+    int64 bound_Done;                /* tuples returned so far */
+    int status;                      /* loading or reading a batch */
+    bool outerNodeDone;              /* finished fetching tuples from outer node */
+    void* tuplesortstate;            /* private state of tuplesort.c for the batch */
+    FmgrInfo* presortedEqfuncs;      /* equality functions of the presorted columns */
+    TupleTableSlot* group_pivot;     /* tuple the rest of the batch must match */
+    TupleTableSlot* transfer_tuple;  /* first tuple of the next batch */
+    int64 groupsSorted;              /* number of batches sorted, for explain */
+    int sortMethodId;                /* sort method of the largest batch */
+    int spaceTypeId;                 /* space type of the largest batch */
+    long maxSpaceUsed;               /* space used by the largest batch */
+} IncrementalSortState;
+
 /* ---------------------
  *	GroupState information
  * -------------------------
@@ -2229,6 +2294,9 @@ typedef struct WindowAggState {
     struct WindowObjectData* agg_winobj; /* winobj for aggregate fetches */
     int64 aggregatedbase;                /* start row for current aggregates */
     int64 aggregatedupto;                /* rows before this one are aggregated */
+    bool slidingaggs;                    /* slide aggregates with the frame? */
+    int64 slidefrontend;                 /* rows before this one have suffixValues */
+    int64 slidequeuesize;                /* # of entries in rowValues etc */
 
     int frameOptions;       /* frame_clause options, see WindowDef */
     ExprState* startOffset; /* expression for starting bound offset */
@@ -71,7 +71,9 @@ typedef enum NodeTag {
     T_MergeJoin,
     T_HashJoin,
     T_Material,
+    T_Memoize,
     T_Sort,
+    T_IncrementalSort,
     T_Group,
     T_Agg,
     T_WindowAgg,
@@ -165,7 +167,9 @@ typedef enum NodeTag {
     T_MergeJoinState,
     T_HashJoinState,
     T_MaterialState,
+    T_MemoizeState,
     T_SortState,
+    T_IncrementalSortState,
     T_GroupState,
     T_AggState,
     T_WindowAggState,
@@ -311,6 +315,7 @@ typedef enum NodeTag {
     T_MergeAppendPath,
     T_ResultPath,
     T_MaterialPath,
+    T_MemoizePath,
     T_UniquePath,
     T_PartIteratorPath,
     T_EquivalenceClass,
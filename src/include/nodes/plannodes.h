@@ -1038,6 +1038,23 @@ typedef struct Material {
 typedef struct VecMaterial : public Material {
 } VecMaterial;
 
+/* ----------------
+ *		memoize node
+ *
+ * Caches the output of its parameterized subplan, keyed by the values of
+ * param_exprs, so that rescans with the same parameter values don't have
+ * to run the subplan again.
+ * ----------------
+ */
+typedef struct Memoize {
+    Plan plan;
+    int numKeys;          /* size of the array below */
+    Oid* hashOperators;   /* hash operators for each key */
+    List* param_exprs;    /* cache keys in the form of exprs containing parameters */
+    bool binary_mode;     /* match the keys by their binary image, not the operators */
+    double est_entries;   /* estimated number of distinct cache keys */
+} Memoize;
+
 /* ----------------
  *		sort node
  * ----------------
@@ -1058,6 +1075,18 @@ typedef struct Sort {
     OpMemInfo mem_info;    /* Memory info for sort */
 } Sort;
 
+/* ----------------
+ *		incremental sort node
+ *
+ * The input is already sorted on the first nPresortedCols sort columns,
+ * so only groups of tuples with equal values in them need sorting.
+ * ----------------
+ */
+typedef struct IncrementalSort {
+    Sort sort;
+    int nPresortedCols; /* number of presorted columns */
+} IncrementalSort;
+
 typedef struct VecSort : public Sort {
 } VecSort;
 
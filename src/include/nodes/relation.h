@@ -322,6 +322,8 @@ typedef struct PlannerInfo {
     double tuple_fraction; /* tuple_fraction passed to query_planner */
     double limit_tuples;   /* limit_tuples passed to query_planner */
 
+    Path* incremental_sort_path; /* path query_planner chose to sort incrementally for ORDER BY, or NULL */
+
     bool hasInheritedTarget;     /* true if parse->resultRelation is an
                                   * inheritance child rel */
     bool hasJoinRTEs;            /* true if any RTEs are RTE_JOIN kind */
@@ -1193,6 +1195,21 @@ typedef struct MaterialPath {
     OpMemInfo mem_info;   /* Memory info for materialize */
 } MaterialPath;
 
+/*
+ * MemoizePath represents a Memoize plan node, i.e., a cache of the results
+ * of a parameterized subpath keyed by the parameter values, which lets a
+ * nestloop skip rescanning its inner side for outer rows it has seen.
+ */
+typedef struct MemoizePath {
+    Path path;
+    Path* subpath;        /* outerpath to cache tuples from */
+    List* hash_operators; /* hash operators for each key */
+    List* param_exprs;    /* cache keys */
+    bool binary_mode;     /* match the keys by their binary image */
+    double calls;         /* expected number of rescans */
+    double est_entries;   /* estimated number of distinct cache keys */
+} MemoizePath;
+
 /*
  * UniquePath represents elimination of distinct rows from the output of
  * its subpath.
@@ -105,6 +105,8 @@ extern void cost_recursive_union(Plan* runion, Plan* nrterm, Plan* rterm);
 extern void cost_sort(Path* path, List* pathkeys, Cost input_cost, double tuples, int width, Cost comparison_cost,
     int sort_mem, double limit_tuples, bool col_store, int dop = 1, OpMemInfo* mem_info = NULL,
     bool index_sort = false);
+extern void cost_incremental_sort(Path* path, PlannerInfo* root, List* pathkeys, int presorted_keys,
+    Cost input_startup_cost, Cost input_total_cost, double input_tuples, int width, Cost comparison_cost, int sort_mem);
 extern void cost_merge_append(Path* path, PlannerInfo* root, List* pathkeys, int n_streams, Cost input_startup_cost,
     Cost input_total_cost, double tuples);
 extern void cost_material(Path* path, Cost input_startup_cost, Cost input_total_cost, double tuples, int width);
@@ -65,6 +65,8 @@ extern RecursiveUnion* make_recursive_union(
     List* tlist, Plan* lefttree, Plan* righttree, int wtParam, List* distinctList, long numGroups);
 extern Sort* make_sort_from_pathkeys(
     PlannerInfo* root, Plan* lefttree, List* pathkeys, double limit_tuples, bool can_parallel = false);
+extern IncrementalSort* make_incrementalsort_from_pathkeys(
+    PlannerInfo* root, Plan* lefttree, List* pathkeys, int presorted_keys, double limit_tuples);
 extern Sort* make_sort_from_sortclauses(PlannerInfo* root, List* sortcls, Plan* lefttree);
 extern Sort* make_sort_from_groupcols(PlannerInfo* root, List* groupcls, AttrNumber* grpColIdx, Plan* lefttree);
 extern Sort* make_sort_from_targetlist(PlannerInfo* root, Plan* lefttree, double limit_tuples);
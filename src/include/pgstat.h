@@ -1999,8 +1999,21 @@ typedef struct MotMemoryDetailPad {
     MotMemoryDetail* memoryDetail;
 } MotMemoryDetailPad;
 
+#define NUM_MOT_TABLE_FRAGMENTATION_DETAIL_ELEM 7
+
+typedef struct MotTableFragmentationDetail {
+    Oid relid;
+    char tableName[NAMEDATALEN];
+    int64 totalSize;
+    int64 usedSize;
+    int32 fragmentationPercent;
+    int64 reclaimedSize;
+    int64 compactionCount;
+} MotTableFragmentationDetail;
+
 extern MotSessionMemoryDetail* GetMotSessionMemoryDetail(uint32* num);
 extern MotMemoryDetail* GetMotMemoryDetail(uint32* num, bool isGlobal);
+extern MotTableFragmentationDetail* GetMotTableFragmentationDetail(uint32* num);
 
 #ifdef MEMORY_CONTEXT_CHECKING
 typedef enum { STANDARD_DUMP, SHARED_DUMP } DUMP_TYPE;
@@ -0,0 +1,59 @@
+/* ---------------------------------------------------------------------------------------
+ *
+ * pg_bytescan.h
+ *	  Find the first byte of a buffer that belongs to a small set of bytes.
+ *
+ * Line readers of COPY and of the bulkload parsers spend most of their time
+ * on bytes that are neither a line end, a quote, an escape nor the lead byte
+ * of a multibyte character.  pg_skip_plain_bytes() steps over such a run of
+ * plain bytes 16 or 32 bytes at a time, with SSE4.2 or AVX2 chosen at runtime
+ * on x86 and NEON on aarch64, so the reader only looks at the special bytes
+ * one by one.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * IDENTIFICATION
+ *        src/include/port/pg_bytescan.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef PG_BYTESCAN_H
+#define PG_BYTESCAN_H
+
+/* most bytes a scan can stop at, besides the bytes with the high bit set */
+#define PG_BYTESCAN_MAX_CHARS 8
+
+typedef struct PgByteScanSet {
+    int nchars;                         /* number of valid entries in chars */
+    char chars[PG_BYTESCAN_MAX_CHARS];  /* bytes that stop the scan */
+    bool highbit;                       /* bytes with the high bit set stop it too */
+} PgByteScanSet;
+
+/* Start an empty set, add the bytes to stop at with pg_bytescan_add */
+static inline void pg_bytescan_init(PgByteScanSet* set, bool highbit)
+{
+    set->nchars = 0;
+    set->highbit = highbit;
+}
+
+static inline void pg_bytescan_add(PgByteScanSet* set, char c)
+{
+    for (int i = 0; i < set->nchars; i++) {
+        if (set->chars[i] == c)
+            return;
+    }
+    Assert(set->nchars < PG_BYTESCAN_MAX_CHARS);
+    set->chars[set->nchars++] = c;
+}
+
+/*
+ * Returns the number of bytes at the start of s that are not in set, len if
+ * none of the len bytes is.
+ */
+typedef size_t (*PgSkipPlainBytesFunc)(const char* s, size_t len, const PgByteScanSet* set);
+
+extern size_t pg_skip_plain_bytes_scalar(const char* s, size_t len, const PgByteScanSet* set);
+
+extern PgSkipPlainBytesFunc pg_skip_plain_bytes;
+
+#endif /* PG_BYTESCAN_H */
@@ -41,5 +41,7 @@ extern size_t BufFileWrite(BufFile* file, void* ptr, size_t size);
 extern int BufFileSeek(BufFile* file, int fileno, off_t offset, int whence);
 extern void BufFileTell(BufFile* file, int* fileno, off_t* offset);
 extern int BufFileSeekBlock(BufFile* file, long blknum);
+extern void BufFilePrefetchBlocks(BufFile* file, long blknum, int nblocks);
+extern void BufFileWritebackBlocks(BufFile* file, long blknum, int nblocks);
 
 #endif /* BUFFILE_H */
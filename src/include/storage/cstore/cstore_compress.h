@@ -138,16 +138,34 @@ public:
     virtual ~StringCoder()
     {}
 
-    StringCoder() : m_adopt_rle(true), m_adopt_dict(true), m_dicCodes(NULL), m_dicCodesNum(0)
+    StringCoder()
+        : m_adopt_rle(true), m_adopt_dict(true), m_keep_dict_codes(false), m_dicCodes(NULL), m_dicCodesNum(0)
     {}
 
     int Compress(_in_ CompressionArg1& in, _in_ CompressionArg2& out);
     int Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg1& out);
 
+    /*
+     * Hand over the dictionary codes kept by Decompress(), one code for each
+     * not-null value. The caller takes the ownership and must pfree() it.
+     * NULL is returned if dictionary method is not applied to.
+     */
+    DicCodeType* TakeDicCodes(int* codesNum)
+    {
+        DicCodeType* codes = m_dicCodes;
+        *codesNum = m_dicCodesNum;
+        m_dicCodes = NULL;
+        m_dicCodesNum = 0;
+        return codes;
+    }
+
     /* optimizing flags */
     bool m_adopt_rle;
     bool m_adopt_dict;
 
+    /* keep the dictionary codes after decompressing, see TakeDicCodes() */
+    bool m_keep_dict_codes;
+
 private:
     /* inner implement for compress api */
     template <bool adopt_dict>
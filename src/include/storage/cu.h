@@ -74,6 +74,9 @@ public:
 
 #define MIN_MAX_LEN 32
 
+/* slots of the code-to-position map used by CU::ToVectorDict(), power of 2 */
+#define CU_DICT_VEC_SLOTS 256
+
 // CU_INFOMASK1 has all the compression mode info.
 // CU_INFOMASK2 has the other data attribute info.
 //
@@ -245,6 +248,13 @@ public:
     /* the number of m_offset items */
     int32 m_offsetSize;
 
+    /*
+     * dictionary code (DicCodeType) of each row, only set for var-length CUs
+     * compressed by dictionary method. rows with the same code hold the same value.
+     */
+    uint16* m_dictCodes;
+    int32 m_dictCodesSize;
+
     /* source buffer size. */
     uint32 m_srcBufSize;
 
@@ -377,6 +387,13 @@ public:
     template <int attlen, bool hasNull>
     int ToVectorLateRead(_in_ ScalarVector* tids, _out_ ScalarVector* vec);
 
+    /*
+     *  CU to Vector by dictionary codes, rows of the same value share one copy
+     */
+    template <bool hasNull, bool hasDeadRow>
+    int ToVectorDict(_out_ ScalarVector* vec, _in_ int leftRows, _in_ int rowCursorInCU, __inout int& curScanPos,
+        _out_ int& deadRows, _in_ uint8* cuDelMask);
+
     // GET method is used to set the CUDesc info after compressing CU.
     // SET method is used to set the CU info during decompressing CU data.
     //
@@ -429,6 +446,8 @@ private:
     template <bool char_type>
     void DeFormNumberStringCU();
 
+    void FormDictCodes(int rowCount, const uint16* codes, int codesNum);
+
     bool IsNumericDscaleCompress() const;
 
     // encrypt cu data
@@ -544,6 +563,15 @@ void CU::FreeMem()
         this->m_offset = NULL;
         this->m_offsetSize = 0;
     }
+    if (this->m_dictCodes) {
+        if (!freeByCUCacheMgr) {
+            CStoreMemAlloc::Pfree(this->m_dictCodes, !this->m_inCUCache);
+        } else {
+            free(this->m_dictCodes);
+        }
+        this->m_dictCodes = NULL;
+        this->m_dictCodesSize = 0;
+    }
 }
 
 #endif
@@ -89,4 +89,13 @@ extern void MOTCheckpointFetchUnlock();
 extern bool MOTCheckpointExists(
     char* ctrlFilePath, size_t ctrlLen, char* checkpointDir, size_t checkpointLen, size_t& basePathLen);
 
+/**
+ * @brief Retrieves the path of a checkpoint that the current delta checkpoint depends on.
+ * @param index the index of the checkpoint in the chain, starting with the full checkpoint.
+ * @param checkpointDir a buffer to hold the checkpoint path.
+ * @param checkpointLen the length of the given checkpoint path buffer.
+ * @return True if the checkpoint exists, False indicates that there are no more checkpoints in the chain.
+ */
+extern bool MOTCheckpointChainDir(int index, char* checkpointDir, size_t checkpointLen);
+
 #endif  // MOT_FDW_H
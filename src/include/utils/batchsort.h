@@ -116,6 +116,12 @@ public:
      */
     int m_bound;
 
+    /*
+     * In bounded heap mode, the sort key columns of the input row being
+     * checked against the heap top; other columns are left unset.
+     */
+    MultiColumns m_boundProbe;
+
     MultiColumnsData m_unsortColumns;
 
     bool* m_isSortKey;
@@ -267,6 +273,8 @@ public:
 
     void SortBoundedHeap();
 
+    bool BoundedHeapAccepts(VectorBatch* batch, int row);
+
     void DumpUnsortColumns(bool all);
 
     /*
@@ -350,6 +358,13 @@ void putbatch(Batchsortstate* state, VectorBatch* batch, int start, int end)
 {
     int64 memorySize = 0;
     for (int row = start; row < end; ++row) {
+        /*
+         * Once the bounded heap is full, most rows are thrown out; find that
+         * out from the sort keys in the batch before copying the whole row.
+         */
+        if (state->m_status == BS_BOUNDED && !state->BoundedHeapAccepts(batch, row))
+            continue;
+
         MultiColumns multiColumn = state->CopyMultiColumn<abbrevSortOptimize>(batch, row);
 
         if (abbrevSortOptimize) {
@@ -492,13 +507,10 @@ void putbatch(Batchsortstate* state, VectorBatch* batch, int start, int end)
 
             case BS_BOUNDED:
 
-                if (state->compareMultiColumn(&multiColumn, state->m_storeColumns.m_memValues, state) <= 0) {
-                    state->FreeMultiColumn(&multiColumn);
-                } else {
-                    state->FreeMultiColumn(state->m_storeColumns.m_memValues);
-                    state->BatchSortHeapSiftup<false>();
-                    state->BatchSortHeapInsert<false>(&multiColumn, 0);
-                }
+                /* the row beats the largest entry, which is discarded */
+                state->FreeMultiColumn(state->m_storeColumns.m_memValues);
+                state->BatchSortHeapSiftup<false>();
+                state->BatchSortHeapInsert<false>(&multiColumn, 0);
                 break;
 
             case BS_BUILDRUNS:
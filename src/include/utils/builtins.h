@@ -1559,6 +1559,7 @@ extern Datum hypopg_reset_index(PG_FUNCTION_ARGS);
 extern Datum mot_global_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_local_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_session_memory_detail(PG_FUNCTION_ARGS);
+extern Datum mot_table_fragmentation_detail(PG_FUNCTION_ARGS);
 
 #endif /* !FRONTEND_PARSER */
 #endif /* BUILTINS_H */
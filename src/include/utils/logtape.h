@@ -24,7 +24,8 @@ typedef struct LogicalTapeSet LogicalTapeSet;
  * prototypes for functions in logtape.c
  */
 
-extern LogicalTapeSet* LogicalTapeSetCreate(int ntapes);
+extern LogicalTapeSet* LogicalTapeSetCreate(int ntapes, bool compress);
+extern long LogicalTapeSetCompressSpace(int ntapes, bool compress);
 extern void LogicalTapeSetClose(LogicalTapeSet* lts);
 extern void LogicalTapeSetForgetFreeSpace(LogicalTapeSet* lts);
 extern size_t LogicalTapeRead(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size);
@@ -294,6 +294,7 @@ typedef struct StdRdOptions {
     int delta_rows_threshold;      /* the upmost rows delta table holds */
     int partial_cluster_rows;      /* row numbers of partial cluster feature */
     int compresslevel;             /* compress level, see relation storage options 'compresslevel' */
+    int parallel_workers;          /* threads sorting in parallel while building a btree index */
     int internalMask;              /*internal mask*/
     bool ignore_enable_hadoop_env; /* ignore enable_hadoop_env */
     bool user_catalog_table;       /* use as an additional catalog relation */
@@ -352,6 +353,13 @@ typedef struct StdRdOptions {
 #define RelationGetFillFactor(relation, defaultff) \
     ((relation)->rd_options ? ((StdRdOptions*)(relation)->rd_options)->fillfactor : (defaultff))
 
+/*
+ * RelationGetParallelWorkers
+ *		Returns the number of threads sorting in parallel for an index build.
+ */
+#define RelationGetParallelWorkers(relation, defaultpw) \
+    ((relation)->rd_options ? ((StdRdOptions*)(relation)->rd_options)->parallel_workers : (defaultpw))
+
 /*
  * RelationGetTargetPageUsage
  *		Returns the relation's desired space usage per page in bytes.
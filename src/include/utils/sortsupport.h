@@ -48,6 +48,7 @@
 #define SORTSUPPORT_H
 
 #include "access/attnum.h"
+#include "utils/relcache.h"
 
 typedef struct SortSupportData* SortSupport;
 
@@ -99,6 +100,13 @@ typedef struct SortSupportData {
      */
     int (*comparator)(Datum x, Datum y, SortSupport ssup);
 
+    /*
+     * Opclasses whose comparator orders the Datums just like signed integers
+     * of this many bytes (2, 4 or 8) may set it, so that single-key sorts can
+     * use a radix sort rather than calling the comparator.  Zero otherwise.
+     */
+    int ssup_int_width;
+
     /*
      * "Abbreviated key" infrastructure follows.
      *
@@ -224,5 +232,6 @@ extern int ApplySortComparator(Datum datum1, bool isNull1, Datum datum2, bool is
 /* Other functions in utils/sort/sortsupport.c */
 extern void PrepareSortSupportComparisonShim(Oid cmpFunc, SortSupport ssup);
 extern void PrepareSortSupportFromOrderingOp(Oid orderingOp, SortSupport ssup);
+extern void PrepareSortSupportFromIndexRel(Relation indexRel, int16 strategy, SortSupport ssup);
 
 #endif /* SORTSUPPORT_H */
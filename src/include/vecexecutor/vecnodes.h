@@ -236,6 +236,15 @@ typedef struct CStoreScanState : ScanState {
     vecqual_func jitted_vecqual;
 
     bool m_isReplicaTable; /* If it is a replication table? */
+
+    /*
+     * Runtime filters pushed down by the hash joins above this scan. They are
+     * collected on the first scan call, after the inner sides have been built.
+     */
+    filter::BloomFilter** m_runtimeFilters; /* usable runtime bloom filters */
+    int* m_runtimeFilterCols;               /* column index of each filter in scan batch */
+    int m_runtimeFilterNum;
+    bool m_runtimeFilterReady;
 } CStoreScanState;
 
 typedef struct DfsScanState : ScanState {
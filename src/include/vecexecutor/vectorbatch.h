@@ -339,6 +339,56 @@ private:
     Datum (ScalarVector::*m_addVar)(Datum data, int index);
 };
 
+#define VAR_MEMO_SIZE 64
+
+// A small direct mapped cache of function results keyed by the argument values.
+// Column store scans let the rows of the same dictionary value share one pointer
+// (see CU::ToVectorDict), so a function over var-length values can be computed
+// once for each distinct value of the batch. Pointers are only meaningful within
+// one batch, so the memo should live on the stack of one call.
+// This is not run-length encoding: every row is still looked up on its own, the
+// memo only saves the repeated evaluation of the function.
+//
+struct VarMemo {
+    ScalarValue m_key1[VAR_MEMO_SIZE];
+    ScalarValue m_key2[VAR_MEMO_SIZE];
+    ScalarValue m_result[VAR_MEMO_SIZE];
+    uint8 m_flag[VAR_MEMO_SIZE];
+    bool m_used[VAR_MEMO_SIZE];
+
+    VarMemo()
+    {
+        errno_t rc = memset_s(m_used, sizeof(m_used), 0, sizeof(m_used));
+        securec_check(rc, "\0", "\0");
+    }
+
+    static inline int Slot(ScalarValue key1, ScalarValue key2)
+    {
+        return (int)(((key1 >> 4) ^ (key2 >> 6) ^ key2) & (VAR_MEMO_SIZE - 1));
+    }
+
+    inline bool Lookup(ScalarValue key1, ScalarValue key2, ScalarValue* result, uint8* flag) const
+    {
+        int slot = Slot(key1, key2);
+        if (m_used[slot] && m_key1[slot] == key1 && m_key2[slot] == key2) {
+            *result = m_result[slot];
+            *flag = m_flag[slot];
+            return true;
+        }
+        return false;
+    }
+
+    inline void Remember(ScalarValue key1, ScalarValue key2, ScalarValue result, uint8 flag)
+    {
+        int slot = Slot(key1, key2);
+        m_key1[slot] = key1;
+        m_key2[slot] = key2;
+        m_result[slot] = result;
+        m_flag[slot] = flag;
+        m_used[slot] = true;
+    }
+};
+
 struct SysColContainer : public BaseObject {
     int sysColumns;
     ScalarVector* m_ppColumns;
@@ -434,6 +484,19 @@ public:
     //
     void Pack(const bool* sel);
 
+    // Keep the rows selected by sel in the selection vector instead of packing
+    // them now. The consumer either honors m_sel or calls PackSelection().
+    //
+    void DeferPack(const bool* sel);
+
+    // Pack the rows kept by DeferPack(), if any.
+    //
+    void PackSelection();
+
+    // Number of rows the consumer shall see.
+    //
+    int SelectedRows() const;
+
     /* Optimzed Pack function */
     void OptimizePack(const bool* sel, List* CopyVars);
 
@@ -34,6 +34,7 @@
 #include "vectorsonic/vsonicchar.h"
 #include "vectorsonic/vsonicencodingchar.h"
 #include "vectorsonic/vsonicfixlen.h"
+#include "vectorsonic/vsonicsimd.h"
 
 #define PROBE_FETCH 0
 #define PROBE_PARTITION_FILE 1
@@ -211,6 +212,17 @@ public:
         array->getArrayAtomIdx(nrows, m_loc, m_arrayIdx);
         array->getDatumFlagArrayWithMatch(nrows, m_arrayIdx, m_matchKeys, m_nullFlag, m_match);
 
+        /*
+         * Keys of the same width on both sides are equal iff their low
+         * bits are equal, so compare them with the batched kernel.
+         */
+        if (simpleType && sizeof(innerType) == sizeof(outerType)) {
+            uint64 key_mask = ~((uint64)0) >> ((sizeof(uint64) - sizeof(innerType)) * 8);
+            sonic_match_int_key(
+                val->m_vals, val->m_flag, m_selectIndx, m_matchKeys, m_nullFlag, m_match, nrows, key_mask, nulleqnull);
+            return;
+        }
+
         for (int i = 0; i < nrows; i++) {
             notnullcheck = BOTH_NOT_NULL(val->m_flag[*loc1], m_nullFlag[i]);
             nullcheck = nulleqnull & (uint8)BOTH_NULL((unsigned char)val->m_flag[*loc1], (unsigned char)m_nullFlag[i]);
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * vsonicsimd.h
+ *     Batched probe kernels for sonic hash join.
+ *     The key matching kernels compare a whole batch of fixed length
+ *     probe keys against the candidate build keys. On x86 an AVX2
+ *     version is chosen at runtime when the cpu supports it, on aarch64
+ *     the NEON version is always used.
+ *
+ * IDENTIFICATION
+ *        src/include/vectorsonic/vsonicsimd.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef SRC_INCLUDE_VECTORSONIC_VSONICSIMD_H_
+#define SRC_INCLUDE_VECTORSONIC_VSONICSIMD_H_
+
+#include "vecexecutor/vectorbatch.h"
+
+/* number of bucket heads prefetched ahead of the current probe row */
+#define SONIC_PROBE_PREFETCH_DISTANCE 16
+
+#define SonicPrefetch(addr) __builtin_prefetch((const void*)(addr), 0, 3)
+
+/*
+ * Compare fixed length keys of the probe batch with the build keys.
+ * outerVals/outerFlag are the probe ScalarVector, selIdx holds the probe
+ * row of every candidate, innerVals/innerFlag the candidate build keys.
+ * Only the bits in keyMask take part in the comparison, so that int1,
+ * int2, int4 and int8 keys of the same width can share one kernel.
+ * match[i] is cleared when the i-th candidate does not match.
+ */
+typedef void (*SonicMatchIntKeyFunc)(const ScalarValue* outerVals, const uint8* outerFlag, const uint16* selIdx,
+    const Datum* innerVals, const uint8* innerFlag, bool* match, int nrows, uint64 keyMask, bool nullEqNull);
+
+extern void sonic_match_int_key_scalar(const ScalarValue* outerVals, const uint8* outerFlag, const uint16* selIdx,
+    const Datum* innerVals, const uint8* innerFlag, bool* match, int nrows, uint64 keyMask, bool nullEqNull);
+
+extern SonicMatchIntKeyFunc sonic_match_int_key;
+
+#endif /* SRC_INCLUDE_VECTORSONIC_VSONICSIMD_H_ */
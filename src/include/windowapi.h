@@ -100,7 +100,8 @@ typedef struct WindowStatePerFuncData {
 typedef struct WindowStatePerAggData {
     /* Oids of transfer functions */
     Oid transfn_oid;
-    Oid finalfn_oid; /* may be InvalidOid */
+    Oid finalfn_oid;   /* may be InvalidOid */
+    Oid collectfn_oid; /* may be InvalidOid */
 
     /*
      * fmgr lookup data for transfer functions --- only valid when
@@ -109,6 +110,7 @@ typedef struct WindowStatePerAggData {
      */
     FmgrInfo transfn;
     FmgrInfo finalfn;
+    FmgrInfo collectfn;
 
     /*
      * initial value from pg_aggregate entry
@@ -136,6 +138,19 @@ typedef struct WindowStatePerAggData {
     bool transValueIsNull;
 
     bool noTransValue; /* true if transValue not set yet */
+
+    /*
+     * When the frame slides, the transition value of each row in the frame
+     * (rowValues) and, for the older rows, the combination of its value with
+     * the values of all later older rows (suffixValues), indexed by row
+     * position modulo the queue size.  backValue combines the newer rows.
+     */
+    Datum* rowValues;
+    bool* rowValueIsNull;
+    Datum* suffixValues;
+    bool* suffixValueIsNull;
+    Datum backValue;
+    bool backValueIsNull;
 } WindowStatePerAggData;
 
 #define PG_WINDOW_OBJECT() ((WindowObject)fcinfo->context)
@@ -0,0 +1,77 @@
+#!/bin/sh
+# a standby restartpoint taken while the MOT redo workers still have queued transactions
+# must not lose them when the standby restarts from it
+
+source ./util.sh
+
+mot_tables=4
+mot_rows=20000
+
+function check_mot_rows()
+{
+  for i in $(seq 1 $mot_tables); do
+    if [ $(gsql -d $db -p $dn1_standby_port -m -c "select count(1) from mot_rp_t$i;" | grep -w $mot_rows | wc -l) -eq 1 ]; then
+      echo "restartpoint success on dn1_standby mot_rp_t$i"
+    else
+      echo "restartpoint $failed_keyword on dn1_standby mot_rp_t$i"
+      exit 1
+    fi
+  done
+}
+
+function test_1()
+{
+  set_default
+  check_instance_multi_standby
+
+  # replay the MOT redo of the standby in parallel
+  kill_standby
+  echo "redo_recovery_workers = 4" >> $standby_data_dir/mot.conf
+  start_standby
+
+  for i in $(seq 1 $mot_tables); do
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_rp_t$i; create FOREIGN table mot_rp_t$i(c1 int primary key, c2 int) SERVER mot_server;"
+    for j in $(seq 1 $mot_rows); do
+      echo "insert into mot_rp_t$i values ($j, $j);"
+      if [ $((j % 5000)) -eq 0 ]; then
+        echo "checkpoint;"
+      fi
+    done > $scripts_dir/data/mot_rp_t$i.sql
+  done
+
+  # every insert is a single table transaction, generated while the standby is down so that
+  # its catchup fills the redo worker queues
+  kill_standby
+  for i in $(seq 1 $mot_tables); do
+    gsql -d $db -p $dn1_primary_port -f $scripts_dir/data/mot_rp_t$i.sql > /dev/null &
+  done
+  wait
+  echo "load success"
+
+  start_standby
+  for k in $(seq 1 20); do
+    gsql -d $db -p $dn1_standby_port -m -c "checkpoint;"
+  done
+  wait_catchup_finish
+  gsql -d $db -p $dn1_standby_port -m -c "checkpoint;"
+
+  # restart from the last restartpoint
+  kill_standby
+  start_standby
+  wait_catchup_finish
+  check_mot_rows
+}
+
+function tear_down()
+{
+  set_default
+  sleep 1
+  for i in $(seq 1 $mot_tables); do
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_rp_t$i;"
+    rm -f $scripts_dir/data/mot_rp_t$i.sql
+  done
+  sed -i '/^redo_recovery_workers = 4$/d' $standby_data_dir/mot.conf
+}
+
+test_1
+tear_down
@@ -0,0 +1,58 @@
+/*
+ * Bloom filters of hash joins applied on column store scans
+ */
+create schema cstore_bloom_filter;
+set current_schema = cstore_bloom_filter;
+
+create table bf_fact (id int, dim_id int, v int) with (orientation = column);
+create table bf_dim (id int, grp int) with (orientation = column);
+insert into bf_fact select i, i % 1000, i from generate_series(1, 20000) as i;
+insert into bf_dim select i, i % 10 from generate_series(1, 1000) as i;
+analyze bf_fact;
+analyze bf_dim;
+
+-- does the plan of the query push a bloom filter?
+create function bf_used(query text) returns bool as $$
+declare
+    ln text;
+begin
+    for ln in execute 'explain (costs off) ' || query loop
+        if ln like '%Bloom Filter%' then
+            return true;
+        end if;
+    end loop;
+    return false;
+end;
+$$ language plpgsql;
+
+set enable_nestloop = off;
+set enable_mergejoin = off;
+
+-- off by default
+select bf_used('select count(*) from bf_fact f join bf_dim d on f.dim_id = d.id where d.grp = 3');
+
+set enable_cstore_bloom_filter = on;
+select bf_used('select count(*) from bf_fact f join bf_dim d on f.dim_id = d.id where d.grp = 3');
+select count(*), sum(f.v) from bf_fact f join bf_dim d on f.dim_id = d.id where d.grp = 3;
+-- every rescan builds the hash table, and the filter, from other inner rows
+select g, (select count(*) from bf_fact f join bf_dim d on f.dim_id = d.id where d.grp = g) as cnt
+from generate_series(0, 3) as g order by g;
+-- the hash table spills, no filter is pushed then
+set work_mem = '64kB';
+select g, (select count(*) from bf_fact f join bf_dim d on f.dim_id = d.id where d.grp = g) as cnt
+from generate_series(0, 3) as g order by g;
+reset work_mem;
+
+-- same results without the filters
+set enable_cstore_bloom_filter = off;
+select count(*), sum(f.v) from bf_fact f join bf_dim d on f.dim_id = d.id where d.grp = 3;
+select g, (select count(*) from bf_fact f join bf_dim d on f.dim_id = d.id where d.grp = g) as cnt
+from generate_series(0, 3) as g order by g;
+
+reset enable_cstore_bloom_filter;
+reset enable_nestloop;
+reset enable_mergejoin;
+drop function bf_used(text);
+drop table bf_fact;
+drop table bf_dim;
+drop schema cstore_bloom_filter;
@@ -0,0 +1,27 @@
+/*
+ * Hash agg spill files that still do not fit in work_mem are spilled again
+ * on the next hash bits.  The skewed group stays in memory on every pass.
+ */
+create schema hashagg_respill;
+set current_schema = hashagg_respill;
+
+create table hashagg_skew (g int, v int);
+-- half of the rows fall in group 0, the others are groups of one row
+insert into hashagg_skew select case when i <= 100000 then 0 else i end, i from generate_series(1, 200000) as i;
+
+set work_mem = '64kB';
+set enable_sort = off;
+
+explain (costs off) select g, count(*), sum(v::numeric) from hashagg_skew group by g having count(*) > 1;
+select g, count(*), sum(v::numeric) from hashagg_skew group by g having count(*) > 1;
+select count(*) as groups, sum(c) as rows, max(c) as skew, sum(s) as total
+from (select g, count(*) as c, sum(v::numeric) as s from hashagg_skew group by g) x;
+
+-- the spilled hash table is built again on every rescan
+select k, (select count(*) from (select g from hashagg_skew where g % k = 0 group by g) x)
+from (values (1), (2)) as t(k) order by k;
+
+reset enable_sort;
+reset work_mem;
+drop table hashagg_skew;
+drop schema hashagg_respill;
@@ -0,0 +1,51 @@
+/*
+ * Incremental sort of inputs presorted on a prefix of the ORDER BY keys
+ */
+create schema incremental_sort;
+set current_schema = incremental_sort;
+
+-- 100 groups of 100 rows, b runs through 0..99 within each group
+create table incsort_t (a int, b int);
+insert into incsort_t select i / 100, (i * 37) % 100 from generate_series(0, 9999) as i;
+create index incsort_t_a on incsort_t (a);
+-- groups smaller than the minimal batch
+create table incsort_small (a int, b int);
+insert into incsort_small select i / 10, (i * 7) % 10 from generate_series(0, 999) as i;
+create index incsort_small_a on incsort_small (a);
+analyze incsort_t;
+analyze incsort_small;
+
+-- does the plan of the query have an Incremental Sort node?
+create function incsort_used(query text) returns bool as $$
+declare
+    ln text;
+begin
+    for ln in execute 'explain (costs off) ' || query loop
+        if ln like '%Incremental Sort%' then
+            return true;
+        end if;
+    end loop;
+    return false;
+end;
+$$ language plpgsql;
+
+-- off by default
+select incsort_used('select a, b from incsort_t order by a, b limit 5');
+
+set enable_incremental_sort = on;
+select incsort_used('select a, b from incsort_t order by a, b limit 5');
+select a, b from incsort_t order by a, b limit 5;
+-- the limit crosses a group boundary
+select a, b from incsort_t where a >= 3 order by a, b limit 3 offset 98;
+select a, b from incsort_t order by a, b desc limit 3;
+select a, b from incsort_small order by a, b limit 3 offset 40;
+-- the whole output is in order
+select md5(string_agg(a || ':' || b, ',')) from (select a, b from incsort_t order by a, b) s;
+
+reset enable_incremental_sort;
+select md5(string_agg(a || ':' || b, ',')) from (select a, b from incsort_t order by a, b) s;
+
+drop function incsort_used(text);
+drop table incsort_t;
+drop table incsort_small;
+drop schema incremental_sort;
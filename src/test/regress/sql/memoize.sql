@@ -0,0 +1,76 @@
+/*
+ * Memoize on the inner side of parameterized nestloops
+ */
+create schema memoize;
+set current_schema = memoize;
+
+create table memo_outer (id int, k int);
+create table memo_inner (k int, v int);
+insert into memo_outer select i, i % 10 from generate_series(1, 1000) as i;
+insert into memo_inner select i % 100, i from generate_series(1, 10000) as i;
+create index memo_inner_k on memo_inner (k);
+analyze memo_outer;
+analyze memo_inner;
+
+-- does the plan of the query have a Memoize node?
+create function memo_used(query text) returns bool as $$
+declare
+    ln text;
+begin
+    for ln in execute 'explain (costs off) ' || query loop
+        if ln like '%Memoize%' then
+            return true;
+        end if;
+    end loop;
+    return false;
+end;
+$$ language plpgsql;
+
+set enable_hashjoin = off;
+set enable_mergejoin = off;
+set enable_material = off;
+
+-- off by default
+select memo_used('select count(*), sum(i.v) from memo_outer o join memo_inner i on i.k = o.k');
+
+set enable_memoize = on;
+select memo_used('select count(*), sum(i.v) from memo_outer o join memo_inner i on i.k = o.k');
+select count(*), sum(i.v) from memo_outer o join memo_inner i on i.k = o.k;
+-- outer rows without a match are cached as empty entries
+select count(*), count(i.v) from memo_outer o left join memo_inner i on i.k = o.k + 95;
+-- the cross type operator can't compare two cache keys, no memoize then
+select memo_used('select count(*) from memo_outer o join memo_inner i on i.k = o.k::bigint');
+select count(*), sum(i.v) from memo_outer o join memo_inner i on i.k = o.k::bigint;
+-- tiny cache, entries get evicted
+set work_mem = '64kB';
+select count(*), sum(i.v) from memo_outer o join memo_inner i on i.k = o.k;
+reset work_mem;
+
+-- lateral keys are matched by their binary image: 1.0 and 1.00 are equal
+-- numerics, but the join clause pushed into the subquery tells them apart
+create table memo_num (n numeric);
+create table memo_txt (t text);
+insert into memo_num select case when i % 2 = 0 then 1.0 else 1.00 end from generate_series(1, 100) as i;
+insert into memo_txt select case when i % 3 = 0 then '1.0' else '1.00' end from generate_series(1, 30) as i;
+analyze memo_num;
+analyze memo_txt;
+set rewrite_rule = 'predpush';
+select o.n::text as n, sum(s.c) from memo_num o, (select t, count(*) as c from memo_txt group by t) s where s.t like o.n::text group by 1 order by 1;
+
+-- same results without memoize
+set enable_memoize = off;
+select count(*), sum(i.v) from memo_outer o join memo_inner i on i.k = o.k;
+select count(*), count(i.v) from memo_outer o left join memo_inner i on i.k = o.k + 95;
+select o.n::text as n, sum(s.c) from memo_num o, (select t, count(*) as c from memo_txt group by t) s where s.t like o.n::text group by 1 order by 1;
+
+reset rewrite_rule;
+reset enable_memoize;
+reset enable_hashjoin;
+reset enable_mergejoin;
+reset enable_material;
+drop function memo_used(text);
+drop table memo_outer;
+drop table memo_inner;
+drop table memo_num;
+drop table memo_txt;
+drop schema memoize;
@@ -0,0 +1,24 @@
+--
+-- Unique hash indexes, loaded past the first growth of the bucket array
+--
+create foreign table hash_index (id int not null, val int not null, grp int not null, primary key (id));
+create unique index hash_index_val on hash_index using hash (val);
+insert into hash_index select g, g * 3, g % 7 from generate_series(1, 10000) g;
+select count(*) from hash_index;
+select id, grp from hash_index where val = 3000;
+select id from hash_index where val = 3001;
+select count(*) from hash_index where val = 30000;
+-- a duplicate key fails the insert
+insert into hash_index values (10001, 300, 0);
+select id from hash_index where val = 300;
+delete from hash_index where id = 100;
+insert into hash_index values (10001, 300, 0);
+select id from hash_index where val = 300;
+-- a multi-column hash index built over the loaded rows
+create unique index hash_index_grp on hash_index using hash (grp, val);
+select id from hash_index where grp = 1 and val = 3;
+select id from hash_index where grp = 2 and val = 3;
+delete from hash_index where id > 5000;
+select count(*) from hash_index where val > 15000;
+select id from hash_index where val = 15000;
+drop foreign table hash_index;
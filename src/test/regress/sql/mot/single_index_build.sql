@@ -0,0 +1,20 @@
+--
+-- Secondary index builds over more rows than a build batch
+--
+create foreign table index_build (id int not null, grp int not null, val int not null, dup int not null, primary key (id));
+insert into index_build select g, g % 7, g * 2, case when g = 9000 then 5 else g end from generate_series(1, 10000) g;
+delete from index_build where id > 9990;
+create unique index index_build_val on index_build (val);
+create index index_build_grp on index_build (grp);
+select count(*) from index_build where grp = 3;
+select id, grp from index_build where val = 7000;
+select count(*) from index_build where val > 19900;
+select count(*) from index_build where val > 19980;
+-- a duplicate key fails the build of a unique index
+create unique index index_build_dup on index_build (dup);
+select count(*) from index_build where dup = 5;
+delete from index_build where id = 9000;
+create unique index index_build_dup on index_build (dup);
+select id from index_build where dup = 5;
+insert into index_build values (10001, 0, 20002, 5);
+drop foreign table index_build;
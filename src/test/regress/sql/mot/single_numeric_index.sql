@@ -0,0 +1,28 @@
+--
+-- NUMERIC index keys
+--
+create foreign table numeric_idx (id int not null, val numeric(10,2) not null);
+create index numeric_idx_val on numeric_idx (val);
+insert into numeric_idx values (6, 0);
+insert into numeric_idx values (2, -1000.5);
+insert into numeric_idx values (9, 100);
+insert into numeric_idx values (4, -2.2);
+insert into numeric_idx values (1, -12345678.99);
+insert into numeric_idx values (7, 0.01);
+insert into numeric_idx values (10, 12345678.99);
+insert into numeric_idx values (3, -2.25);
+insert into numeric_idx values (8, 1.5);
+insert into numeric_idx values (5, -0.01);
+select id, val from numeric_idx where val > -3 and val < 2 order by val;
+select id, val from numeric_idx where val >= -1000.5 order by val desc;
+select id, val from numeric_idx where val = -2.2;
+select id, val from numeric_idx where val = 1.505;
+select id, val from numeric_idx where val > 1.505 order by val;
+select id, val from numeric_idx where val < -2.205 order by val;
+select count(*) from numeric_idx where val < 0;
+select id from numeric_idx where val = 100;
+-- unconstrained NUMERIC can't be an index key
+create foreign table numeric_idx_any (id int not null, val numeric not null);
+create index numeric_idx_any_val on numeric_idx_any (val);
+drop foreign table numeric_idx_any;
+drop foreign table numeric_idx;
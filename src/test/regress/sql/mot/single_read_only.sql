@@ -0,0 +1,39 @@
+--
+-- Read-only MOT transactions
+--
+create foreign table read_only_t (id int primary key, val int);
+insert into read_only_t values (1, 10);
+insert into read_only_t values (2, 20);
+-- read-only from BEGIN
+begin read only;
+select * from read_only_t order by id;
+update read_only_t set val = 11 where id = 1;
+rollback;
+start transaction read only;
+select val from read_only_t where id = 2;
+commit;
+begin;
+set transaction read only;
+select val from read_only_t where id = 1;
+commit;
+-- read-only by default, switched to read-write before the first query
+set default_transaction_read_only = on;
+begin;
+set transaction read write;
+select val from read_only_t where id = 1;
+update read_only_t set val = val + 1 where id = 1;
+select val from read_only_t where id = 1;
+commit;
+begin;
+select count(*) from read_only_t;
+set transaction read write;
+rollback;
+reset default_transaction_read_only;
+-- read-write transaction switched to read-only after a write
+begin;
+update read_only_t set val = val + 1 where id = 2;
+set transaction read only;
+select * from read_only_t order by id;
+commit;
+select * from read_only_t order by id;
+drop foreign table read_only_t;
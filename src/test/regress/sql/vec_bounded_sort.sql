@@ -0,0 +1,21 @@
+/*
+ * Top-N of the vectorized sort: rows are checked against the bounded heap
+ * before they are copied, also for abbreviated text and numeric keys.
+ */
+create schema vec_bounded_sort;
+set current_schema = vec_bounded_sort;
+
+create table bounded_sort_t (id int, name text, val numeric(10,2)) with (orientation = column);
+-- every name and every val appears once, far more rows than twice the limits below
+insert into bounded_sort_t select i, 'name_' || lpad((i * 919 % 1000)::text, 4, '0'), (i * 37 % 1000) / 10.0 - 50 from generate_series(1, 1000) as i;
+insert into bounded_sort_t values (2000, null, null);
+analyze bounded_sort_t;
+
+select id, name from bounded_sort_t order by name limit 3;
+select id, name from bounded_sort_t order by name desc nulls last limit 3;
+select id, name from bounded_sort_t order by name nulls first limit 2;
+select id, val from bounded_sort_t order by val limit 3;
+select id, val from bounded_sort_t order by val desc nulls last limit 3;
+select id, name from bounded_sort_t order by name limit 2 offset 998;
+
+drop schema vec_bounded_sort cascade;
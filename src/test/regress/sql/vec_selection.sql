@@ -0,0 +1,26 @@
+/*
+ * Filtered vector scans under a Row Adapter keep the qual result in the
+ * selection vector instead of packing the batch.  Other parents always get
+ * packed batches.
+ */
+create schema vec_selection;
+set current_schema = vec_selection;
+
+create table sel_col (a int, b int) with (orientation = column);
+insert into sel_col select i, i % 10 from generate_series(1, 20) as i;
+analyze sel_col;
+
+-- most rows selected, the Row Adapter skips the others
+explain (costs off) select a, b from sel_col where b <> 3;
+select a, b from sel_col where b <> 3;
+-- few rows selected, the Row Adapter packs the batch first
+select a, b from sel_col where b = 3;
+-- the projection computes, so the scan packs
+select a + b from sel_col where b = 3;
+
+-- hash agg and hash join read every row of a batch, they get packed ones
+select b, count(*), sum(a) from sel_col where b <> 3 group by b order by b;
+select count(*), sum(t1.a), sum(t2.a) from sel_col t1 join sel_col t2 on t1.a = t2.b where t1.b <> 3 and t2.b <> 4;
+
+drop table sel_col;
+drop schema vec_selection;
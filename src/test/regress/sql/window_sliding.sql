@@ -0,0 +1,33 @@
+/*
+ * Window aggregates over a frame whose head moves slide the frame with the
+ * collection functions of the aggregates instead of rerunning them.
+ */
+create schema window_sliding;
+set current_schema = window_sliding;
+
+create table ws_t (id int, i int, f float8);
+insert into ws_t values (1, 5, 1e20), (2, null, 1), (3, null, 2), (4, 3, null),
+    (5, 7, null), (6, null, 3), (7, 1, 0.5), (8, 2, 0.25);
+
+-- min and max have no inverse, NULL inputs are skipped, and the float8 sum
+-- is exact again once 1e20 left the frame
+select id, sum(i) over w as s, count(i) over w as c, count(*) over w as n,
+    min(i) over w as mn, max(i) over w as mx, sum(f) over w as sf
+from ws_t window w as (order by id rows between 1 preceding and current row) order by id;
+
+-- empty frames at the start and at the end of the partition
+select id, sum(i) over w as s, count(*) over w as n, max(i) over w as mx, sum(f) over w as sf
+from ws_t window w as (order by id rows between 2 preceding and 1 preceding) order by id;
+select id, sum(i) over w as s, count(*) over w as n
+from ws_t window w as (order by id rows between 1 following and 2 following) order by id;
+
+-- the frame starts over in each partition
+select id, sum(i) over (partition by id % 2 order by id rows between 1 preceding and current row) as s
+from ws_t order by id;
+
+-- string_agg has no collection function, so these aggregates are rerun for each row
+select id, sum(i) over w as s, string_agg(i::text, ',') over w as str
+from ws_t window w as (order by id rows between 1 preceding and current row) order by id;
+
+drop table ws_t;
+drop schema window_sliding;